@@ -0,0 +1,107 @@
+#include "arena.h"
+
+// Chunk data starts one cache line after the chunk itself
+#define CHUNK_HEADER ((sizeof(ArenaChunk) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+
+static size_t align_up(size_t size) {
+    return (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+void arena_init(Arena *arena, size_t chunk_size) {
+    memset(arena, 0, sizeof(*arena));
+    arena->chunk_size = chunk_size ? align_up(chunk_size) : ARENA_DEFAULT_CHUNK;
+}
+
+void* arena_alloc(Arena *arena, size_t size) {
+    size = align_up(size ? size : 1);
+
+    // Use the current chunk, then chunks kept from before the last reset
+    while (arena->current) {
+        ArenaChunk *chunk = arena->current;
+        if (chunk->size - chunk->used >= size) {
+            void *block = (char *)chunk + CHUNK_HEADER + chunk->used;
+            chunk->used += size;
+            return block;
+        }
+        if (!chunk->next) break;
+        arena->current = chunk->next;
+        arena->current->used = 0;
+    }
+
+    // Out of room: get a new chunk, large enough for this block
+    size_t chunk_size = size > arena->chunk_size ? size : arena->chunk_size;
+    ArenaChunk *chunk = aligned_alloc(ARENA_ALIGNMENT, CHUNK_HEADER + chunk_size);
+    if (!chunk) return NULL;
+    chunk->next = NULL;
+    chunk->size = chunk_size;
+    chunk->used = size;
+    if (arena->current) arena->current->next = chunk;
+    else arena->first = chunk;
+    arena->current = chunk;
+    arena->reserved += CHUNK_HEADER + chunk_size;
+    arena->heap_allocations++;
+    return (char *)chunk + CHUNK_HEADER;
+}
+
+void arena_reset(Arena *arena) {
+    arena->current = arena->first;
+    if (arena->current) arena->current->used = 0;
+}
+
+void arena_destroy(Arena *arena) {
+    ArenaChunk *chunk = arena->first;
+    while (chunk) {
+        ArenaChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    memset(arena, 0, sizeof(*arena));
+}
+
+// Size class of a game: class k holds games of up to 4 << k players
+static int pool_class(int num_players) {
+    int size_class = 0;
+    while ((4 << size_class) < num_players) size_class++;
+    return size_class;
+}
+
+void game_pool_init(GamePool *pool, size_t chunk_size) {
+    memset(pool, 0, sizeof(*pool));
+    arena_init(&pool->arena, chunk_size);
+}
+
+GameState* game_pool_get(GamePool *pool, int num_players) {
+    if (num_players < 1 || num_players > MAX_PLAYERS) return NULL;
+    int size_class = pool_class(num_players);
+    GameState *game = pool->free_games[size_class];
+    if (game) {
+        pool->free_games[size_class] = *(GameState **)game;
+        return game;
+    }
+    game = arena_alloc(&pool->arena, game_state_size(4 << size_class));
+    if (game) pool->games_allocated++;
+    return game;
+}
+
+GameState* game_pool_create(GamePool *pool, const GameConfig *config, int num_players, unsigned int seed) {
+    GameState *game = game_pool_get(pool, num_players);
+    if (!game) return NULL;
+    game_state_init(game, config, num_players, seed);
+    return game;
+}
+
+void game_pool_put(GamePool *pool, GameState *game) {
+    int size_class = pool_class(game->num_players);
+    *(GameState **)game = pool->free_games[size_class];
+    pool->free_games[size_class] = game;
+}
+
+void game_pool_reset(GamePool *pool) {
+    memset(pool->free_games, 0, sizeof(pool->free_games));
+    arena_reset(&pool->arena);
+}
+
+void game_pool_destroy(GamePool *pool) {
+    arena_destroy(&pool->arena);
+    memset(pool, 0, sizeof(*pool));
+}
@@ -0,0 +1,58 @@
+// arena.h - Bump allocation for game state in batch runs
+// An Arena hands out memory from a few large chunks and frees all of it at
+// once with arena_reset(), which keeps the chunks for the next round of
+// allocations. A GamePool recycles GameState blocks on top of an arena: a
+// released game goes on a free list for its size and the next game of that
+// size reuses it, so once a worker has seen its largest game it plays every
+// further game without touching the heap.
+// Neither is thread-safe; give each worker its own (or guard a shared one).
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "game.h"
+
+#define ARENA_ALIGNMENT       64          // Every allocation starts on a cache line
+#define ARENA_DEFAULT_CHUNK   (1 << 20)
+#define GAME_POOL_CLASSES     11          // Games for up to 4, 8, ... 4096 players
+
+typedef struct ArenaChunk {
+    struct ArenaChunk *next;
+    size_t size;                // Usable bytes after the header
+    size_t used;
+} ArenaChunk;
+
+typedef struct {
+    ArenaChunk *first;
+    ArenaChunk *current;        // Chunk allocations are taken from
+    size_t chunk_size;
+    size_t reserved;            // Bytes obtained from the heap so far
+    long heap_allocations;      // Chunks obtained from the heap so far
+} Arena;
+
+void arena_init(Arena *arena, size_t chunk_size);
+// Returns NULL if out of memory
+void* arena_alloc(Arena *arena, size_t size);
+// Free everything allocated so far; the chunks are kept for reuse
+void arena_reset(Arena *arena);
+void arena_destroy(Arena *arena);
+
+typedef struct {
+    Arena arena;
+    GameState *free_games[GAME_POOL_CLASSES];   // Released games, linked through their first bytes
+    long games_allocated;                       // Games carved out of the arena
+} GamePool;
+
+void game_pool_init(GamePool *pool, size_t chunk_size);
+// Storage for a game of `num_players` players (up to MAX_PLAYERS), not yet
+// initialized; returns NULL if out of memory
+GameState* game_pool_get(GamePool *pool, int num_players);
+// Set up a pooled game the way game_state_create() does
+GameState* game_pool_create(GamePool *pool, const GameConfig *config, int num_players, unsigned int seed);
+// Give a game back; game->num_players must still be the count it was taken for
+void game_pool_put(GamePool *pool, GameState *game);
+// Release every game at once
+void game_pool_reset(GamePool *pool);
+void game_pool_destroy(GamePool *pool);
+
+#endif // ARENA_H
@@ -0,0 +1,389 @@
+// bench_macro.c - End-to-end throughput harness with stored baselines
+// Plays a fixed corpus of configurations and seeds through complete games on
+// any game executable (our own build or one of the prebuilt rule variants),
+// measures games/sec, turns/sec and peak RSS, and compares the results with
+// a committed baseline file. A regression past the threshold fails the run.
+//
+// The executables are treated as black boxes: each game runs in a scratch
+// directory holding seed.txt plus the case's config files, stdin is
+// /dev/null (so "Press Enter" prompts return immediately) and stdout is
+// scanned for "=== Player" turn headers and the "wins the game" line.
+//
+// Build: gcc -O2 -o bench_macro bench_macro.c
+// Usage: ./bench_macro [options] <executable>...
+//   --corpus FILE     corpus listing (default bench/corpus.txt)
+//   --baseline FILE   baseline file (default bench/baseline.txt)
+//   --threshold PCT   allowed regression in percent (default 10)
+//   --max-turns N     stop a game that runs longer than N turns (default 5000)
+//   --repeat N        play the corpus N times and keep the fastest pass (default 3)
+//   --runner CMD      launcher for foreign binaries, e.g. "wine" for the .exe variants
+//   --update          write the measured numbers into the baseline file
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <limits.h>
+#include <libgen.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#define MAX_CASES      64
+#define MAX_VARIANTS   32
+#define MAX_BASELINES  64
+
+static const char *config_file_names[] = {"stairs.txt", "poles.txt", "walls.txt", "flag.txt", "players.txt"};
+#define NUM_CONFIG_FILES (int)(sizeof(config_file_names) / sizeof(config_file_names[0]))
+
+// One corpus line: a configuration directory and a range of seeds
+typedef struct {
+    char name[64];
+    char config_dir[PATH_MAX]; // Empty for the built-in default layout
+    int first_seed;
+    int seed_count;
+} CorpusCase;
+
+// Measured or stored throughput for one executable
+typedef struct {
+    char variant[128];
+    double games_per_sec;
+    double turns_per_sec;
+    long peak_rss_kb;
+} Throughput;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Load the corpus listing; config dirs are resolved relative to the listing itself
+static int read_corpus(const char *filename, CorpusCase cases[], int *num_cases) {
+    FILE *corpus_file = fopen(filename, "r");
+    if (!corpus_file) {
+        fprintf(stderr, "Error: Could not open corpus %s\n", filename);
+        return 0;
+    }
+
+    char corpus_path[PATH_MAX];
+    snprintf(corpus_path, sizeof(corpus_path), "%s", filename);
+    char *corpus_dir = dirname(corpus_path);
+
+    char line_buffer[512];
+    *num_cases = 0;
+    while (fgets(line_buffer, sizeof(line_buffer), corpus_file) && *num_cases < MAX_CASES) {
+        char name[64], dir[256];
+        int first_seed, seed_count;
+        if (line_buffer[0] == '#') continue;
+        if (sscanf(line_buffer, "%63s %255s %d %d", name, dir, &first_seed, &seed_count) != 4) continue;
+
+        CorpusCase *c = &cases[*num_cases];
+        snprintf(c->name, sizeof(c->name), "%s", name);
+        if (strcmp(dir, "-") == 0) {
+            c->config_dir[0] = '\0';
+        } else {
+            snprintf(c->config_dir, sizeof(c->config_dir), "%s/%s", corpus_dir, dir);
+        }
+        c->first_seed = first_seed;
+        c->seed_count = seed_count;
+        (*num_cases)++;
+    }
+
+    fclose(corpus_file);
+    return *num_cases > 0;
+}
+
+static int copy_file(const char *from, const char *to) {
+    FILE *in = fopen(from, "rb");
+    if (!in) return 0;
+    FILE *out = fopen(to, "wb");
+    if (!out) { fclose(in); return 0; }
+
+    char block[4096];
+    size_t n;
+    while ((n = fread(block, 1, sizeof(block), in)) > 0) {
+        fwrite(block, 1, n, out);
+    }
+    fclose(in);
+    fclose(out);
+    return 1;
+}
+
+// Populate the scratch directory with one case's config files and seed
+static void prepare_scratch(const char *scratch_dir, const CorpusCase *c, int seed) {
+    char path[PATH_MAX], source[PATH_MAX];
+    for (int i = 0; i < NUM_CONFIG_FILES; i++) {
+        snprintf(path, sizeof(path), "%s/%s", scratch_dir, config_file_names[i]);
+        unlink(path);
+        if (c->config_dir[0]) {
+            snprintf(source, sizeof(source), "%s/%s", c->config_dir, config_file_names[i]);
+            copy_file(source, path);
+        }
+    }
+
+    snprintf(path, sizeof(path), "%s/seed.txt", scratch_dir);
+    FILE *seed_file = fopen(path, "w");
+    if (seed_file) {
+        fprintf(seed_file, "%d\n", seed);
+        fclose(seed_file);
+    }
+}
+
+// Run one game; returns 1 if it finished with a winner, 0 if it hit the turn cap,
+// -1 if the executable could not be run
+static int run_game(const char *executable, const char *runner, const char *scratch_dir,
+                    int max_turns, long *turns_out, long *rss_kb_out) {
+    int output_pipe[2];
+    if (pipe(output_pipe) != 0) return -1;
+
+    pid_t child = fork();
+    if (child < 0) return -1;
+
+    if (child == 0) {
+        int null_fd = open("/dev/null", O_RDWR);
+        if (chdir(scratch_dir) != 0) _exit(127);
+        dup2(null_fd, STDIN_FILENO);
+        dup2(output_pipe[1], STDOUT_FILENO);
+        dup2(null_fd, STDERR_FILENO);
+        close(output_pipe[0]);
+        close(output_pipe[1]);
+        if (runner) {
+            execlp(runner, runner, executable, (char *)NULL);
+        } else {
+            execl(executable, executable, (char *)NULL);
+        }
+        _exit(127);
+    }
+
+    close(output_pipe[1]);
+    FILE *game_output = fdopen(output_pipe[0], "r");
+    char *line = NULL;
+    size_t line_capacity = 0;
+    long turns = 0;
+    int finished = 0;
+
+    while (getline(&line, &line_capacity, game_output) != -1) {
+        if (strncmp(line, "=== Player", 10) == 0) {
+            turns++;
+            if (turns > max_turns) {
+                kill(child, SIGKILL);
+                break;
+            }
+        } else if (strstr(line, "wins the game")) {
+            finished = 1;
+        }
+    }
+    free(line);
+    fclose(game_output);
+
+    int status = 0;
+    struct rusage usage;
+    wait4(child, &status, 0, &usage);
+
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 127 && turns == 0) return -1;
+
+    *turns_out = turns;
+    *rss_kb_out = usage.ru_maxrss;
+    return finished;
+}
+
+// Play the whole corpus once on one executable
+static int measure_pass(const char *executable, const char *runner, const char *scratch_dir,
+                        const CorpusCase cases[], int num_cases, int max_turns, Throughput *result) {
+    long games = 0, capped = 0, total_turns = 0, peak_rss = 0;
+    double start = now_seconds();
+
+    for (int c = 0; c < num_cases; c++) {
+        for (int s = 0; s < cases[c].seed_count; s++) {
+            long turns = 0, rss_kb = 0;
+            prepare_scratch(scratch_dir, &cases[c], cases[c].first_seed + s);
+            int outcome = run_game(executable, runner, scratch_dir, max_turns, &turns, &rss_kb);
+            if (outcome < 0) {
+                fprintf(stderr, "Error: Could not run %s\n", executable);
+                return 0;
+            }
+            games++;
+            if (outcome == 0) capped++;
+            total_turns += turns;
+            if (rss_kb > peak_rss) peak_rss = rss_kb;
+        }
+    }
+
+    double elapsed = now_seconds() - start;
+    result->games_per_sec = games / elapsed;
+    result->turns_per_sec = total_turns / elapsed;
+    result->peak_rss_kb = peak_rss;
+
+    printf("%-28s %6ld games (%ld capped) %9ld turns %8.2fs %10.1f games/s %12.0f turns/s %8ld KB\n",
+           result->variant, games, capped, total_turns, elapsed,
+           result->games_per_sec, result->turns_per_sec, result->peak_rss_kb);
+    return 1;
+}
+
+// Keep the fastest of several passes so scheduler noise doesn't read as a regression
+static int measure_variant(const char *executable, const char *runner, const char *scratch_dir,
+                           const CorpusCase cases[], int num_cases, int max_turns, int repeats,
+                           Throughput *result) {
+    for (int r = 0; r < repeats; r++) {
+        Throughput pass = *result;
+        if (!measure_pass(executable, runner, scratch_dir, cases, num_cases, max_turns, &pass)) return 0;
+        if (r == 0 || pass.games_per_sec > result->games_per_sec) {
+            *result = pass;
+        }
+    }
+    return 1;
+}
+
+static int read_baseline(const char *filename, Throughput baselines[], int *num_baselines) {
+    *num_baselines = 0;
+    FILE *baseline_file = fopen(filename, "r");
+    if (!baseline_file) return 0;
+
+    char line_buffer[512];
+    while (fgets(line_buffer, sizeof(line_buffer), baseline_file) && *num_baselines < MAX_BASELINES) {
+        Throughput *b = &baselines[*num_baselines];
+        if (line_buffer[0] == '#') continue;
+        if (sscanf(line_buffer, "%127s %lf %lf %ld", b->variant, &b->games_per_sec,
+                   &b->turns_per_sec, &b->peak_rss_kb) == 4) {
+            (*num_baselines)++;
+        }
+    }
+    fclose(baseline_file);
+    return 1;
+}
+
+static int write_baseline(const char *filename, const Throughput baselines[], int num_baselines) {
+    FILE *baseline_file = fopen(filename, "w");
+    if (!baseline_file) {
+        fprintf(stderr, "Error: Could not write baseline %s\n", filename);
+        return 0;
+    }
+    fprintf(baseline_file, "# Macro benchmark baseline: <variant> <games/s> <turns/s> <peak RSS KB>\n");
+    fprintf(baseline_file, "# Regenerate with: ./bench_macro --update <executable>...\n");
+    for (int i = 0; i < num_baselines; i++) {
+        fprintf(baseline_file, "%s %.1f %.0f %ld\n", baselines[i].variant, baselines[i].games_per_sec,
+                baselines[i].turns_per_sec, baselines[i].peak_rss_kb);
+    }
+    fclose(baseline_file);
+    return 1;
+}
+
+static Throughput *find_baseline(Throughput baselines[], int num_baselines, const char *variant) {
+    for (int i = 0; i < num_baselines; i++) {
+        if (strcmp(baselines[i].variant, variant) == 0) return &baselines[i];
+    }
+    return NULL;
+}
+
+// Returns 1 if the measurement regressed past the threshold
+static int compare_with_baseline(const Throughput *measured, const Throughput *baseline, double threshold_pct) {
+    // A zero rate (a truncated or hand-edited line) gives nothing to compare against
+    if (baseline->games_per_sec <= 0.0 || baseline->turns_per_sec <= 0.0) {
+        printf("  baseline for %s has no throughput; not compared\n", measured->variant);
+        return 0;
+    }
+    double games_change = 100.0 * (measured->games_per_sec - baseline->games_per_sec) / baseline->games_per_sec;
+    double turns_change = 100.0 * (measured->turns_per_sec - baseline->turns_per_sec) / baseline->turns_per_sec;
+    double rss_change = baseline->peak_rss_kb > 0 ?
+                        100.0 * (double)(measured->peak_rss_kb - baseline->peak_rss_kb) / baseline->peak_rss_kb : 0.0;
+
+    int regressed = (games_change < -threshold_pct) || (turns_change < -threshold_pct) || (rss_change > threshold_pct);
+    printf("  vs baseline: games/s %+.1f%%, turns/s %+.1f%%, peak RSS %+.1f%% -> %s\n",
+           games_change, turns_change, rss_change, regressed ? "REGRESSION" : "ok");
+    return regressed;
+}
+
+int main(int argc, char *argv[]) {
+    const char *corpus_filename = "bench/corpus.txt";
+    const char *baseline_filename = "bench/baseline.txt";
+    const char *runner = NULL;
+    double threshold_pct = 10.0;
+    int max_turns = 5000;
+    int repeats = 3;
+    int update_baseline = 0;
+    const char *executables[MAX_VARIANTS];
+    int num_executables = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--corpus") == 0 && i + 1 < argc) corpus_filename = argv[++i];
+        else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) baseline_filename = argv[++i];
+        else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) threshold_pct = atof(argv[++i]);
+        else if (strcmp(argv[i], "--max-turns") == 0 && i + 1 < argc) max_turns = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) repeats = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--runner") == 0 && i + 1 < argc) runner = argv[++i];
+        else if (strcmp(argv[i], "--update") == 0) update_baseline = 1;
+        else if (num_executables < MAX_VARIANTS) executables[num_executables++] = argv[i];
+    }
+    if (num_executables == 0) {
+        fprintf(stderr, "Usage: %s [--corpus FILE] [--baseline FILE] [--threshold PCT] [--max-turns N] "
+                        "[--repeat N] [--runner CMD] [--update] <executable>...\n", argv[0]);
+        return 2;
+    }
+
+    static CorpusCase cases[MAX_CASES];
+    int num_cases;
+    if (!read_corpus(corpus_filename, cases, &num_cases)) return 2;
+
+    static Throughput baselines[MAX_BASELINES];
+    int num_baselines;
+    read_baseline(baseline_filename, baselines, &num_baselines);
+
+    char scratch_dir[] = "/tmp/maze_bench.XXXXXX";
+    if (!mkdtemp(scratch_dir)) {
+        fprintf(stderr, "Error: Could not create scratch directory\n");
+        return 2;
+    }
+
+    int regressions = 0, failures = 0;
+    for (int v = 0; v < num_executables; v++) {
+        char executable[PATH_MAX];
+        Throughput measured;
+        if (!realpath(executables[v], executable)) {
+            fprintf(stderr, "Error: %s not found\n", executables[v]);
+            failures++;
+            continue;
+        }
+        char name_buffer[PATH_MAX];
+        snprintf(name_buffer, sizeof(name_buffer), "%s", executables[v]);
+        snprintf(measured.variant, sizeof(measured.variant), "%s", basename(name_buffer));
+
+        if (repeats < 1) repeats = 1;
+        if (!measure_variant(executable, runner, scratch_dir, cases, num_cases, max_turns, repeats, &measured)) {
+            failures++;
+            continue;
+        }
+
+        Throughput *baseline = find_baseline(baselines, num_baselines, measured.variant);
+        if (update_baseline) {
+            if (baseline) {
+                *baseline = measured;
+            } else if (num_baselines < MAX_BASELINES) {
+                baselines[num_baselines++] = measured;
+            }
+        } else if (baseline) {
+            regressions += compare_with_baseline(&measured, baseline, threshold_pct);
+        } else {
+            printf("  no baseline for %s\n", measured.variant);
+        }
+    }
+
+    // Clean up the scratch directory
+    char path[PATH_MAX];
+    for (int i = 0; i < NUM_CONFIG_FILES; i++) {
+        snprintf(path, sizeof(path), "%s/%s", scratch_dir, config_file_names[i]);
+        unlink(path);
+    }
+    snprintf(path, sizeof(path), "%s/seed.txt", scratch_dir);
+    unlink(path);
+    rmdir(scratch_dir);
+
+    if (update_baseline && !write_baseline(baseline_filename, baselines, num_baselines)) return 2;
+    if (failures) return 2;
+    return regressions ? 1 : 0;
+}
@@ -0,0 +1,385 @@
+// bench_micro.c - Microbenchmarks for the engine's hot functions
+// Runs every benchmark with narration and prompts disabled, fixed seeds and
+// fixed configurations, and reports ns/op with the spread across samples.
+//
+// Build: gcc -O2 -o bench_micro bench_micro.c pathfind.c game.c turn.c -lm
+// Usage: ./bench_micro [samples] [name-filter]
+
+#include "game.h"
+#include "pathfind.h"
+#include <stdint.h>
+
+#define BENCH_SEED        20250914
+#define DEFAULT_SAMPLES   15
+#define MAX_CASES         (NUM_FLOORS * FLOOR_WIDTH * FLOOR_LENGTH * 4)
+
+// A complete game configuration the benchmarks operate on
+typedef struct {
+    const char *name;
+    MazeLayout layout;
+    Maze maze;
+    Stair stairs[MAX_STAIRS];
+    Pole poles[MAX_POLES];
+    Wall walls[MAX_WALLS];
+    int num_stairs, num_poles, num_walls;
+    int flag[3];
+    PathGraph graph;
+} BenchConfig;
+
+// One movement query: start cell, facing and number of steps
+typedef struct {
+    int floor, w, l;
+    int direction;
+    int steps;
+} MoveCase;
+
+static MoveCase move_cases[MAX_CASES];
+static int num_move_cases;
+
+// Keeps results alive so the compiler cannot drop the measured calls
+static volatile long bench_sink;
+
+// Worst case: every stair, pole and wall slot in use
+static const int worst_stairs[MAX_STAIRS][6] = {
+    {0, 0, 2, 1, 0, 3},   {0, 2, 4, 1, 2, 5},   {0, 4, 6, 1, 4, 6},
+    {0, 5, 10, 1, 5, 10}, {0, 1, 22, 1, 1, 22}, {1, 4, 12, 2, 4, 12},
+    {1, 3, 9, 2, 1, 9},   {1, 6, 15, 2, 8, 15}, {1, 5, 16, 2, 5, 16},
+    {0, 3, 18, 2, 3, 14}
+};
+static const int worst_poles[MAX_POLES][4] = {
+    {2, 0, 5, 24}, {2, 0, 0, 8},  {2, 1, 9, 16}, {2, 0, 2, 12}, {1, 0, 8, 1},
+    {1, 0, 0, 20}, {2, 1, 6, 10}, {1, 0, 9, 23}, {2, 0, 7, 11}, {1, 0, 3, 0}
+};
+static const int worst_walls[MAX_WALLS][5] = {
+    {0, 6, 20, 9, 20}, {0, 6, 20, 6, 24}, {1, 0, 2, 8, 2},  {0, 0, 5, 4, 5},
+    {0, 2, 0, 2, 4},   {0, 5, 1, 5, 6},   {0, 0, 18, 5, 18}, {0, 3, 19, 3, 24},
+    {0, 0, 8, 3, 8},   {0, 1, 9, 1, 15},  {1, 1, 0, 1, 6},   {1, 3, 9, 3, 15},
+    {1, 5, 5, 9, 5},   {1, 0, 19, 7, 19}, {1, 6, 20, 6, 24}, {2, 0, 10, 7, 10},
+    {2, 4, 8, 4, 13},  {2, 2, 14, 9, 14}, {2, 8, 9, 8, 16},  {0, 7, 2, 9, 2}
+};
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Build one of the fixed configurations; the flag is placed deterministically
+static void setup_config(BenchConfig *config, const char *name, int worst_case) {
+    config->name = name;
+    game_srand(BENCH_SEED);
+
+    if (!worst_case) {
+        initialize_stairs(config->stairs, &config->num_stairs);
+        initialize_poles(config->poles, &config->num_poles);
+        initialize_walls(config->walls, &config->num_walls);
+    } else {
+        config->num_stairs = MAX_STAIRS;
+        for (int i = 0; i < MAX_STAIRS; i++) {
+            config->stairs[i].start_floor = worst_stairs[i][0];
+            config->stairs[i].start_w = worst_stairs[i][1];
+            config->stairs[i].start_l = worst_stairs[i][2];
+            config->stairs[i].end_floor = worst_stairs[i][3];
+            config->stairs[i].end_w = worst_stairs[i][4];
+            config->stairs[i].end_l = worst_stairs[i][5];
+            config->stairs[i].direction_type = STAIR_BIDIRECTIONAL;
+        }
+        config->num_poles = MAX_POLES;
+        for (int i = 0; i < MAX_POLES; i++) {
+            config->poles[i].start_floor = worst_poles[i][0];
+            config->poles[i].end_floor = worst_poles[i][1];
+            config->poles[i].w = worst_poles[i][2];
+            config->poles[i].l = worst_poles[i][3];
+        }
+        config->num_walls = MAX_WALLS;
+        for (int i = 0; i < MAX_WALLS; i++) {
+            config->walls[i].floor = worst_walls[i][0];
+            config->walls[i].start_w = worst_walls[i][1];
+            config->walls[i].start_l = worst_walls[i][2];
+            config->walls[i].end_w = worst_walls[i][3];
+            config->walls[i].end_l = worst_walls[i][4];
+        }
+    }
+
+    maze_layout_build(&config->layout, config->stairs, config->num_stairs,
+                      config->poles, config->num_poles, config->walls, config->num_walls);
+    initialize_maze(&config->maze, &config->layout);
+    place_random_flag(config->flag, &config->layout);
+    path_graph_build(&config->graph, &config->layout, config->stairs, config->num_stairs,
+                     config->poles, config->num_poles, NULL);
+}
+
+// Every valid cell in every direction, with steps cycling through 1-6
+static void build_move_cases(BenchConfig *config) {
+    num_move_cases = 0;
+    for (int f = 0; f < NUM_FLOORS; f++) {
+        for (int w = 0; w < FLOOR_WIDTH; w++) {
+            for (int l = 0; l < FLOOR_LENGTH; l++) {
+                if (!is_valid_position(&config->layout, f, w, l)) continue;
+                for (int dir = 0; dir < 4; dir++) {
+                    MoveCase *mc = &move_cases[num_move_cases];
+                    mc->floor = f; mc->w = w; mc->l = l;
+                    mc->direction = dir;
+                    mc->steps = (num_move_cases % 6) + 1;
+                    num_move_cases++;
+                }
+            }
+        }
+    }
+}
+
+static void place_player(Player *player, const MoveCase *mc) {
+    player->pos[0] = mc->floor;
+    player->pos[1] = mc->w;
+    player->pos[2] = mc->l;
+    player->direction = mc->direction;
+    player->in_game = 1;
+    player->movement_points = 100;
+    player->bawana_effect = EFFECT_NONE;
+    player->bawana_turns_left = 0;
+}
+
+// Each benchmark runs `ops` operations and returns how many it performed
+typedef long (*BenchFn)(BenchConfig *config, long ops);
+
+static long bench_is_wall_blocking(BenchConfig *config, long ops) {
+    static const int dw[4] = {0, 1, 0, -1};
+    static const int dl[4] = {-1, 0, 1, 0};
+    long hits = 0;
+    for (long i = 0; i < ops; i++) {
+        const MoveCase *mc = &move_cases[i % num_move_cases];
+        hits += is_wall_blocking(mc->floor, mc->w, mc->l,
+                               mc->w + dw[mc->direction], mc->l + dl[mc->direction],
+                               config->walls, config->num_walls);
+    }
+    bench_sink = hits;
+    return ops;
+}
+
+static long bench_find_all_stairs_at(BenchConfig *config, long ops) {
+    int found[MAX_STAIRS];
+    long hits = 0;
+    for (long i = 0; i < ops; i++) {
+        const MoveCase *mc = &move_cases[i % num_move_cases];
+        hits += find_all_stairs_at(config->stairs, config->num_stairs, mc->floor, mc->w, mc->l, found);
+    }
+    bench_sink = hits;
+    return ops;
+}
+
+static long bench_check_path_validity(BenchConfig *config, long ops) {
+    Player player = {0};
+    int blocked_step, reason;
+    long hits = 0;
+    for (long i = 0; i < ops; i++) {
+        const MoveCase *mc = &move_cases[i % num_move_cases];
+        place_player(&player, mc);
+        hits += check_path_validity(&player, &config->maze, config->stairs, config->poles,
+                                    mc->steps, config->flag, &blocked_step, &reason);
+    }
+    bench_sink = hits;
+    return ops;
+}
+
+// Bonuses are consumed on the first pass over the cases, so steady state
+// measures movement through an already-visited maze
+static long bench_move_player_with_teleport(BenchConfig *config, long ops) {
+    Player player = {0};
+    int cost, steps_taken, reason;
+    long hits = 0;
+    for (long i = 0; i < ops; i++) {
+        const MoveCase *mc = &move_cases[i % num_move_cases];
+        place_player(&player, mc);
+        hits += move_player_with_teleport(&player, &config->maze, config->stairs, config->poles,
+                                          mc->steps, PLAYER_A, config->flag, &cost, &steps_taken, &reason);
+    }
+    bench_sink = hits;
+    return ops;
+}
+
+static long bench_is_flag_reachable(BenchConfig *config, long ops) {
+    long hits = 0;
+    for (long i = 0; i < ops; i++) {
+        hits += is_flag_reachable(&config->layout, config->stairs, config->poles, config->num_poles, NULL, 0,
+                                  config->flag);
+    }
+    bench_sink = hits;
+    return ops;
+}
+
+static long bench_path_graph_flag_reachable(BenchConfig *config, long ops) {
+    long hits = 0;
+    for (long i = 0; i < ops; i++) {
+        hits += path_graph_flag_reachable(&config->graph, &config->layout, NULL, 0, config->flag);
+    }
+    bench_sink = hits;
+    return ops;
+}
+
+// From every valid cell in turn to the flag
+static long bench_path_graph_distance(BenchConfig *config, long ops) {
+    long total = 0;
+    for (long i = 0; i < ops; i++) {
+        const MoveCase *mc = &move_cases[(i * 4) % num_move_cases];
+        int source[1][3] = { { mc->floor, mc->w, mc->l } };
+        total += path_graph_distance(&config->graph, source, 1, config->flag);
+    }
+    bench_sink = total;
+    return ops;
+}
+
+// One stair changes direction, then the graph catches up
+static long bench_path_graph_sync_stairs(BenchConfig *config, long ops) {
+    StairEpoch epoch;
+    stair_epoch_init(&epoch);
+    config->graph.stair_epoch = 0;
+    long synced = 0;
+    for (long i = 0; i < ops; i++) {
+        int stair = (int)(i % config->num_stairs);
+        config->stairs[stair].direction_type = (int)(i % 3);
+        stair_epoch_bump(&epoch, &stair, 1);
+        synced += path_graph_sync_stairs(&config->graph, config->stairs, &epoch);
+    }
+    bench_sink = synced;
+    return ops;
+}
+
+static long bench_path_graph_build(BenchConfig *config, long ops) {
+    static PathGraph scratch;
+    for (long i = 0; i < ops; i++) {
+        path_graph_build(&scratch, &config->layout, config->stairs, config->num_stairs,
+                         config->poles, config->num_poles, NULL);
+    }
+    bench_sink = scratch.clusters[0][0][0].num_nodes;
+    return ops;
+}
+
+static long bench_maze_layout_build(BenchConfig *config, long ops) {
+    static MazeLayout scratch;
+    for (long i = 0; i < ops; i++) {
+        maze_layout_build(&scratch, config->stairs, config->num_stairs,
+                          config->poles, config->num_poles, config->walls, config->num_walls);
+    }
+    bench_sink = scratch.num_value_slots;
+    return ops;
+}
+
+static long bench_initialize_maze(BenchConfig *config, long ops) {
+    static Maze scratch;
+    for (long i = 0; i < ops; i++) {
+        initialize_maze(&scratch, &config->layout);
+    }
+    bench_sink = scratch.overlay.cell_value[0];
+    return ops;
+}
+
+// Full turns of complete games; a finished game is restored from a snapshot
+// (the restore is rare and included in the measurement)
+static long bench_play_turn(BenchConfig *config, long ops) {
+    static Maze maze;
+    Player players[DEFAULT_NUM_PLAYERS];
+    Occupancy occupancy;
+    Stair stairs[MAX_STAIRS];
+    long games = 0;
+
+    maze = config->maze;
+    memcpy(stairs, config->stairs, sizeof(stairs));
+    initialize_players(players, DEFAULT_NUM_PLAYERS, NULL);
+    occupancy_clear(&occupancy, players, DEFAULT_NUM_PLAYERS);
+
+    int player_turn = 0;
+    for (long i = 0; i < ops; i++) {
+        if (play_turn(player_turn, players, &occupancy, &maze, stairs, config->num_stairs,
+                      config->poles, config->num_poles, config->walls, config->num_walls, config->flag)) {
+            maze = config->maze;
+            memcpy(stairs, config->stairs, sizeof(stairs));
+            initialize_players(players, DEFAULT_NUM_PLAYERS, NULL);
+            occupancy_clear(&occupancy, players, DEFAULT_NUM_PLAYERS);
+            player_turn = 0;
+            games++;
+            continue;
+        }
+        player_turn = (player_turn + 1) % DEFAULT_NUM_PLAYERS;
+    }
+    bench_sink = games;
+    return ops;
+}
+
+typedef struct {
+    const char *name;
+    BenchFn fn;
+    long ops_per_sample;
+} Benchmark;
+
+static const Benchmark benchmarks[] = {
+    {"is_wall_blocking",          bench_is_wall_blocking,          2000000},
+    {"find_all_stairs_at",        bench_find_all_stairs_at,        2000000},
+    {"check_path_validity",       bench_check_path_validity,        500000},
+    {"move_player_with_teleport", bench_move_player_with_teleport,  500000},
+    {"is_flag_reachable",         bench_is_flag_reachable,            5000},
+    {"path_graph_flag_reachable", bench_path_graph_flag_reachable,   20000},
+    {"path_graph_distance",       bench_path_graph_distance,         20000},
+    {"path_graph_sync_stairs",    bench_path_graph_sync_stairs,    2000000},
+    {"path_graph_build",          bench_path_graph_build,             2000},
+    {"maze_layout_build",         bench_maze_layout_build,            2000},
+    {"initialize_maze",           bench_initialize_maze,             20000},
+    {"play_turn",                 bench_play_turn,                  500000},
+};
+
+static void run_benchmark(const Benchmark *bench, BenchConfig *config, int samples) {
+    double per_op[64];
+    if (samples > 64) samples = 64;
+
+    // Warm-up pass (also consumes one-time bonuses so samples see a steady state)
+    game_srand(BENCH_SEED);
+    bench->fn(config, bench->ops_per_sample / 10 + 1);
+
+    for (int s = 0; s < samples; s++) {
+        game_srand(BENCH_SEED + s);
+        double start = now_ns();
+        long done = bench->fn(config, bench->ops_per_sample);
+        per_op[s] = (now_ns() - start) / (double)done;
+    }
+
+    double mean = 0.0, min = per_op[0];
+    for (int s = 0; s < samples; s++) {
+        mean += per_op[s];
+        if (per_op[s] < min) min = per_op[s];
+    }
+    mean /= samples;
+    double variance = 0.0;
+    for (int s = 0; s < samples; s++) {
+        variance += (per_op[s] - mean) * (per_op[s] - mean);
+    }
+    variance = (samples > 1) ? variance / (samples - 1) : 0.0;
+    double stddev = sqrt(variance);
+
+    printf("%-27s %-8s %12.1f %10.1f %8.1f%% %12.1f\n",
+           bench->name, config->name, mean, stddev, mean > 0.0 ? 100.0 * stddev / mean : 0.0, min);
+}
+
+int main(int argc, char *argv[]) {
+    int samples = (argc > 1) ? atoi(argv[1]) : DEFAULT_SAMPLES;
+    const char *filter = (argc > 2) ? argv[2] : NULL;
+    if (samples < 2) samples = 2;
+
+    game_print_enabled = 0;
+    game_prompt_enabled = 0;
+
+    static BenchConfig configs[2];
+    setup_config(&configs[0], "default", 0);
+    setup_config(&configs[1], "worst", 1);
+
+    printf("%-27s %-8s %12s %10s %9s %12s\n", "benchmark", "config", "ns/op", "stddev", "rel", "min ns/op");
+    for (size_t b = 0; b < sizeof(benchmarks) / sizeof(benchmarks[0]); b++) {
+        if (filter && !strstr(benchmarks[b].name, filter)) continue;
+        for (int c = 0; c < 2; c++) {
+            // Work on a fresh copy so one benchmark's consumed bonuses don't leak into the next
+            static BenchConfig working;
+            working = configs[c];
+            build_move_cases(&working);
+            run_benchmark(&benchmarks[b], &working, samples);
+        }
+    }
+    return 0;
+}
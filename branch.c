@@ -0,0 +1,208 @@
+// branch.c - Parallel what-if runs from a copied game state
+
+#include "branch.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define BRANCH_CLAIM 16   // Runs a thread takes from the shared counter at a time
+
+typedef struct {
+    const GameState *game;
+    const BranchSpec *branches;
+    int num_branches;
+    int runs;
+    int max_rounds;
+    unsigned int seed;
+    atomic_long next_item;      // Item i is run i / num_branches of branch i % num_branches
+} BranchJob;
+
+typedef struct {
+    BranchJob *job;
+    BranchOutcome *outcomes;    // num_branches, this thread's counts
+    int failed;
+} BranchWorker;
+
+static const char *stair_direction_names[] = {"up", "down", "both"};
+
+int branch_apply(GameState *game, const BranchSpec *branch) {
+    switch (branch->kind) {
+        case BRANCH_AS_IS:
+            return 1;
+        case BRANCH_MOVEMENT_ROLL:
+            if (branch->value < 1 || branch->value > 6) return 0;
+            game->turn.forced_movement_roll = branch->value;
+            return 1;
+        case BRANCH_DIRECTION_ROLL:
+            if (branch->value < 1 || branch->value > 6) return 0;
+            game->turn.forced_direction_roll = branch->value;
+            return 1;
+        case BRANCH_STAIR_DIRECTION:
+            // Lasts until the next re-roll at the start of a fifth round
+            if (branch->value < STAIR_UP_ONLY || branch->value > STAIR_BIDIRECTIONAL) return 0;
+            if (branch->stair < -1 || branch->stair >= game->num_stairs) return 0;
+            int changed[MAX_STAIRS], num_changed = 0;
+            for (int i = 0; i < game->num_stairs; i++) {
+                if ((branch->stair == -1 || branch->stair == i) && game->stairs[i].direction_type != branch->value) {
+                    game->stairs[i].direction_type = branch->value;
+                    changed[num_changed++] = i;
+                }
+            }
+            stair_epoch_bump(&game->stair_epoch, changed, num_changed);
+            return 1;
+    }
+    return 0;
+}
+
+int branch_parse(const char *text, BranchSpec *branch) {
+    char direction[8];
+    int stair, consumed = 0;
+    branch->stair = -1;
+    branch->value = 0;
+
+    if (strcmp(text, "as-is") == 0) {
+        branch->kind = BRANCH_AS_IS;
+        return 1;
+    }
+    if (sscanf(text, "roll=%d%n", &branch->value, &consumed) == 1 && text[consumed] == '\0') {
+        branch->kind = BRANCH_MOVEMENT_ROLL;
+        return branch->value >= 1 && branch->value <= 6;
+    }
+    if (sscanf(text, "direction=%d%n", &branch->value, &consumed) == 1 && text[consumed] == '\0') {
+        branch->kind = BRANCH_DIRECTION_ROLL;
+        return branch->value >= 1 && branch->value <= 6;
+    }
+    if (sscanf(text, "stair%d=%7s", &stair, direction) == 2 && stair >= 0) {
+        branch->stair = stair;
+    } else if (sscanf(text, "stair=%7s", direction) != 1) {
+        return 0;
+    }
+    branch->kind = BRANCH_STAIR_DIRECTION;
+    for (int i = 0; i < 3; i++) {
+        if (strcmp(direction, stair_direction_names[i]) == 0) {
+            branch->value = i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+const char* branch_describe(const BranchSpec *branch) {
+    static _Thread_local char text[32];
+    switch (branch->kind) {
+        case BRANCH_AS_IS:          snprintf(text, sizeof(text), "as-is"); break;
+        case BRANCH_MOVEMENT_ROLL:  snprintf(text, sizeof(text), "roll=%d", branch->value); break;
+        case BRANCH_DIRECTION_ROLL: snprintf(text, sizeof(text), "direction=%d", branch->value); break;
+        case BRANCH_STAIR_DIRECTION:
+            if (branch->stair < 0) snprintf(text, sizeof(text), "stair=%s", stair_direction_names[branch->value % 3]);
+            else snprintf(text, sizeof(text), "stair%d=%s", branch->stair, stair_direction_names[branch->value % 3]);
+            break;
+        default:                    snprintf(text, sizeof(text), "unknown"); break;
+    }
+    return text;
+}
+
+// Copy the game, apply the branch, reseed and play to a win or the round cap
+static void play_branch_run(BranchJob *job, GameState *copy, int branch_index, int run, BranchOutcome *outcome) {
+    TurnResult result;
+    game_state_copy(copy, job->game);
+    branch_apply(copy, &job->branches[branch_index]);
+    game_rng_seed(&copy->rng, job->seed + (unsigned int)run);
+    while (copy->winner < 0 && copy->round_number <= job->max_rounds) {
+        play_game_turn(copy, &result);
+    }
+
+    outcome->runs++;
+    if (copy->winner < 0) {
+        outcome->unfinished++;
+        return;
+    }
+    int slot = copy->winner < BRANCH_MAX_PLAYERS ? copy->winner : BRANCH_MAX_PLAYERS - 1;
+    int bucket = copy->round_number / 10;
+    outcome->wins[slot]++;
+    outcome->rounds_to_win += copy->round_number;
+    outcome->length[bucket < BRANCH_LENGTH_BUCKETS ? bucket : BRANCH_LENGTH_BUCKETS - 1]++;
+}
+
+static void *branch_worker_main(void *arg) {
+    BranchWorker *worker = arg;
+    BranchJob *job = worker->job;
+    long total = (long)job->runs * job->num_branches;
+
+    // One game state per thread, overwritten by every run it plays
+    GameState *copy = malloc(game_state_size(job->game->num_players));
+    if (!copy) {
+        worker->failed = 1;
+        return NULL;
+    }
+    while (1) {
+        long first = atomic_fetch_add(&job->next_item, BRANCH_CLAIM);
+        if (first >= total) break;
+        long last = first + BRANCH_CLAIM < total ? first + BRANCH_CLAIM : total;
+        for (long item = first; item < last; item++) {
+            int branch_index = (int)(item % job->num_branches);
+            play_branch_run(job, copy, branch_index, (int)(item / job->num_branches), &worker->outcomes[branch_index]);
+        }
+    }
+    free(copy);
+    return NULL;
+}
+
+int branch_explore(const GameState *game, const BranchSpec branches[], int num_branches,
+                   int runs, int max_rounds, int num_threads, unsigned int seed,
+                   BranchOutcome outcomes[]) {
+    if (num_branches < 1 || runs < 1) return 0;
+    if (num_threads < 1) num_threads = 1;
+
+    // Check every change against a scratch copy before any thread starts
+    GameState *scratch = game_state_fork(game);
+    if (!scratch) return 0;
+    for (int b = 0; b < num_branches; b++) {
+        if (!branch_apply(scratch, &branches[b])) {
+            free(scratch);
+            return 0;
+        }
+    }
+    free(scratch);
+
+    BranchJob job = { game, branches, num_branches, runs, max_rounds, seed, 0 };
+    BranchWorker *workers = calloc((size_t)num_threads, sizeof(BranchWorker));
+    pthread_t *threads = calloc((size_t)num_threads, sizeof(pthread_t));
+    BranchOutcome *counts = calloc((size_t)num_threads * num_branches, sizeof(BranchOutcome));
+    if (!workers || !threads || !counts) {
+        free(workers);
+        free(threads);
+        free(counts);
+        return 0;
+    }
+
+    int saved_print = game_print_enabled;
+    game_print_enabled = 0;
+    for (int t = 0; t < num_threads; t++) {
+        workers[t].job = &job;
+        workers[t].outcomes = &counts[(size_t)t * num_branches];
+        pthread_create(&threads[t], NULL, branch_worker_main, &workers[t]);
+    }
+
+    // Merge the per-thread counts; sums do not depend on which thread played a run
+    int ok = 1;
+    memset(outcomes, 0, (size_t)num_branches * sizeof(BranchOutcome));
+    for (int t = 0; t < num_threads; t++) {
+        pthread_join(threads[t], NULL);
+        if (workers[t].failed) ok = 0;
+        for (int b = 0; b < num_branches; b++) {
+            const BranchOutcome *part = &workers[t].outcomes[b];
+            BranchOutcome *sum = &outcomes[b];
+            sum->runs += part->runs;
+            sum->unfinished += part->unfinished;
+            sum->rounds_to_win += part->rounds_to_win;
+            for (int p = 0; p < BRANCH_MAX_PLAYERS; p++) sum->wins[p] += part->wins[p];
+            for (int i = 0; i < BRANCH_LENGTH_BUCKETS; i++) sum->length[i] += part->length[i];
+        }
+    }
+    game_print_enabled = saved_print;
+
+    free(workers);
+    free(threads);
+    free(counts);
+    return ok && outcomes[0].runs == runs;
+}
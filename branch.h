@@ -0,0 +1,51 @@
+// branch.h - What-if analysis from a live game
+// A branch is a copy of a game (game_state_copy()) with one change applied:
+// a die showing a chosen value, or a stair pointing another way. Each branch
+// is played to the end many times from the same position, with run r of every
+// branch drawing its dice from seed + r, so the branches differ only by the
+// change itself. Runs are spread over worker threads; outcomes are counted per
+// thread and merged at the end, and do not depend on the number of threads.
+// Branches are played with narration and prompts off.
+
+#ifndef BRANCH_H
+#define BRANCH_H
+
+#include "game.h"
+
+#define BRANCH_AS_IS            0   // No change: how the game goes on from here
+#define BRANCH_MOVEMENT_ROLL    1   // The next movement die shows `value`
+#define BRANCH_DIRECTION_ROLL   2   // The next direction die shows `value` (when the turn rolls one)
+#define BRANCH_STAIR_DIRECTION  3   // Stair `stair` (-1 = every stair) is set to STAIR_* `value`
+
+#define BRANCH_MAX_PLAYERS      16  // Per-player wins; higher player ids share the last slot
+#define BRANCH_LENGTH_BUCKETS   32  // Rounds until the win, in steps of 10 rounds
+
+typedef struct {
+    int kind;                   // BRANCH_*
+    int value;
+    int stair;
+} BranchSpec;
+
+typedef struct {
+    long runs;
+    long wins[BRANCH_MAX_PLAYERS];
+    long unfinished;                        // Runs still going at the round cap
+    long rounds_to_win;                     // Sum over won runs, for the mean
+    long length[BRANCH_LENGTH_BUCKETS];     // Won runs by rounds until the win
+} BranchOutcome;
+
+// Apply a branch's change to a game; returns 0 if the change does not fit it
+int branch_apply(GameState *game, const BranchSpec *branch);
+
+// Parse "as-is", "roll=N", "direction=N", "stair=up|down|both" (every stair) or
+// "stairI=up|down|both" (stair I); returns 0 if malformed
+int branch_parse(const char *text, BranchSpec *branch);
+const char* branch_describe(const BranchSpec *branch);
+
+// Play every branch `runs` times from `game` until a win or round `max_rounds`,
+// on `num_threads` threads. `game` is only read. Returns 0 on failure.
+int branch_explore(const GameState *game, const BranchSpec branches[], int num_branches,
+                   int runs, int max_rounds, int num_threads, unsigned int seed,
+                   BranchOutcome outcomes[]);
+
+#endif // BRANCH_H
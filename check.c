@@ -0,0 +1,459 @@
+// check.c - Static checks of one configuration directory (see check.h)
+
+#include "check.h"
+#include <stdarg.h>
+#include <unistd.h>
+
+static const char *const config_files[] = { "stairs.txt", "poles.txt", "walls.txt", "flag.txt", "players.txt" };
+
+// The walls maze_layout_build() draws round the Bawana anyway; listing them again is fine
+static const Wall bawana_walls[2] = { {0, 6, 20, 9, 20}, {0, 6, 20, 6, 24} };
+
+static void add_issue(ConfigCheck *check, const char *code, const char *file, int line, const char *format, ...) {
+    if (check->num_issues < CHECK_MAX_ISSUES) {
+        ConfigIssue *issue = &check->issues[check->num_issues];
+        va_list args;
+        issue->code = code;
+        issue->file = file;
+        issue->line = line;
+        va_start(args, format);
+        vsnprintf(issue->message, sizeof(issue->message), format, args);
+        va_end(args);
+    }
+    check->num_issues++;
+}
+
+static int in_maze(int floor, int w, int l) {
+    return floor >= 0 && floor < NUM_FLOORS && w >= 0 && w < FLOOR_WIDTH && l >= 0 && l < FLOOR_LENGTH;
+}
+
+static int in_bawana(int floor, int w, int l) {
+    return floor == 0 && w >= 6 && w <= 9 && l >= 20 && l <= 24;
+}
+
+// Why players cannot stand on a cell of the maze, or NULL if they can
+static const char *cell_problem(const MazeLayout *layout, int floor, int w, int l) {
+    const Cell *cell = &layout->cells[floor][w][l];
+    if (cell->is_starting_area) return "is in the starting area";
+    if (cell->is_blocked_by_stair) return "is blocked by a stair skipping its floor";
+    if (!cell->is_valid) return "is outside the floor plan";
+    if (in_bawana(floor, w, l) || cell->is_bawana_entrance) return "is in the Bawana";
+    return NULL;
+}
+
+static int is_blank(const char *line) {
+    for (; *line; line++) {
+        if (*line != ' ' && *line != '\t' && *line != '\r' && *line != '\n') return 0;
+    }
+    return 1;
+}
+
+static FILE *open_config_file(const char *dir, const char *name) {
+    char path[1024];
+    if (snprintf(path, sizeof(path), "%s/%s", dir, name) >= (int)sizeof(path)) return NULL;
+    return fopen(path, "r");
+}
+
+// ---- Reading, with the same line formats as read_*_from_file() ----
+
+static void read_stairs(ConfigCheck *check, const char *dir) {
+    FILE *file = open_config_file(dir, "stairs.txt");
+    if (!file) {
+        initialize_stairs(check->stairs, &check->num_stairs);
+        for (int i = 0; i < check->num_stairs; i++) check->stair_lines[i] = 0;
+        return;
+    }
+    char buffer[256];
+    int line = 0, parsed = 0;
+    while (fgets(buffer, sizeof(buffer), file)) {
+        line++;
+        if (is_blank(buffer)) continue;
+        Stair s;
+        if (sscanf(buffer, "[%d, %d, %d, %d, %d, %d]", &s.start_floor, &s.start_w, &s.start_l,
+                   &s.end_floor, &s.end_w, &s.end_l) != 6) {
+            add_issue(check, "parse_error", "stairs.txt", line, "not [start_floor, start_w, start_l, end_floor, end_w, end_l]");
+        } else if (parsed++ >= MAX_STAIRS) {
+            if (parsed == MAX_STAIRS + 1) add_issue(check, "too_many_entries", "stairs.txt", line, "only the first %d stairs are used", MAX_STAIRS);
+        } else if (!in_maze(s.start_floor, s.start_w, s.start_l) || !in_maze(s.end_floor, s.end_w, s.end_l)) {
+            add_issue(check, "out_of_bounds", "stairs.txt", line, "stair [%d,%d,%d] to [%d,%d,%d] leaves the maze",
+                      s.start_floor, s.start_w, s.start_l, s.end_floor, s.end_w, s.end_l);
+        } else {
+            s.direction_type = STAIR_BIDIRECTIONAL;
+            check->stair_lines[check->num_stairs] = line;
+            check->stairs[check->num_stairs++] = s;
+        }
+    }
+    fclose(file);
+}
+
+static void read_poles(ConfigCheck *check, const char *dir) {
+    FILE *file = open_config_file(dir, "poles.txt");
+    if (!file) {
+        initialize_poles(check->poles, &check->num_poles);
+        for (int i = 0; i < check->num_poles; i++) check->pole_lines[i] = 0;
+        return;
+    }
+    char buffer[256];
+    int line = 0, parsed = 0;
+    while (fgets(buffer, sizeof(buffer), file)) {
+        line++;
+        if (is_blank(buffer)) continue;
+        Pole p;
+        if (sscanf(buffer, "[%d, %d, %d, %d]", &p.start_floor, &p.end_floor, &p.w, &p.l) != 4) {
+            add_issue(check, "parse_error", "poles.txt", line, "not [start_floor, end_floor, w, l]");
+        } else if (parsed++ >= MAX_POLES) {
+            if (parsed == MAX_POLES + 1) add_issue(check, "too_many_entries", "poles.txt", line, "only the first %d poles are used", MAX_POLES);
+        } else if (!in_maze(p.start_floor, p.w, p.l) || !in_maze(p.end_floor, p.w, p.l)) {
+            add_issue(check, "out_of_bounds", "poles.txt", line, "pole from floor %d to %d at [%d,%d] leaves the maze",
+                      p.start_floor, p.end_floor, p.w, p.l);
+        } else {
+            check->pole_lines[check->num_poles] = line;
+            check->poles[check->num_poles++] = p;
+        }
+    }
+    fclose(file);
+}
+
+static void read_walls(ConfigCheck *check, const char *dir) {
+    FILE *file = open_config_file(dir, "walls.txt");
+    if (!file) {
+        initialize_walls(check->walls, &check->num_walls);
+        for (int i = 0; i < check->num_walls; i++) check->wall_lines[i] = 0;
+        return;
+    }
+    char buffer[256];
+    int line = 0, parsed = 0;
+    while (fgets(buffer, sizeof(buffer), file)) {
+        line++;
+        if (is_blank(buffer)) continue;
+        Wall wall;
+        if (sscanf(buffer, "[%d, %d, %d, %d, %d]", &wall.floor, &wall.start_w, &wall.start_l,
+                   &wall.end_w, &wall.end_l) != 5) {
+            add_issue(check, "parse_error", "walls.txt", line, "not [floor, start_w, start_l, end_w, end_l]");
+        } else if (parsed++ >= MAX_WALLS) {
+            if (parsed == MAX_WALLS + 1) add_issue(check, "too_many_entries", "walls.txt", line, "only the first %d walls are used", MAX_WALLS);
+        } else if (!in_maze(wall.floor, wall.start_w, wall.start_l) || !in_maze(wall.floor, wall.end_w, wall.end_l)) {
+            add_issue(check, "out_of_bounds", "walls.txt", line, "wall [%d,%d,%d] to [%d,%d,%d] leaves the maze",
+                      wall.floor, wall.start_w, wall.start_l, wall.floor, wall.end_w, wall.end_l);
+        } else {
+            check->wall_lines[check->num_walls] = line;
+            check->walls[check->num_walls++] = wall;
+        }
+    }
+    fclose(file);
+}
+
+static void use_default_spawns(ConfigCheck *check) {
+    Player players[DEFAULT_NUM_PLAYERS];
+    initialize_players(players, DEFAULT_NUM_PLAYERS, NULL);
+    check->num_spawns = DEFAULT_NUM_PLAYERS;
+    for (int i = 0; i < DEFAULT_NUM_PLAYERS; i++) {
+        memcpy(check->spawns[i].start_pos, players[i].pos, sizeof(players[i].pos));
+        memcpy(check->spawns[i].entry_pos, players[i].entry_pos, sizeof(players[i].entry_pos));
+        check->spawns[i].direction = players[i].direction;
+        check->spawn_lines[i] = 0;
+    }
+}
+
+static void read_players(ConfigCheck *check, const char *dir) {
+    FILE *file = open_config_file(dir, "players.txt");
+    if (!file) {
+        use_default_spawns(check);
+        return;
+    }
+    char buffer[256];
+    int line = 0, parsed = 0;
+    while (fgets(buffer, sizeof(buffer), file)) {
+        line++;
+        if (is_blank(buffer)) continue;
+        PlayerSpawn s;
+        if (sscanf(buffer, "[%d, %d, %d, %d, %d, %d, %d]", &s.start_pos[0], &s.start_pos[1], &s.start_pos[2],
+                   &s.entry_pos[0], &s.entry_pos[1], &s.entry_pos[2], &s.direction) != 7) {
+            add_issue(check, "parse_error", "players.txt", line,
+                      "not [start_floor, start_w, start_l, entry_floor, entry_w, entry_l, direction]");
+        } else if (parsed++ >= MAX_PLAYERS) {
+            if (parsed == MAX_PLAYERS + 1) add_issue(check, "too_many_entries", "players.txt", line, "only the first %d players are used", MAX_PLAYERS);
+        } else if (!in_maze(s.start_pos[0], s.start_pos[1], s.start_pos[2]) ||
+                   !in_maze(s.entry_pos[0], s.entry_pos[1], s.entry_pos[2])) {
+            add_issue(check, "out_of_bounds", "players.txt", line, "spawn [%d,%d,%d] entering at [%d,%d,%d] leaves the maze",
+                      s.start_pos[0], s.start_pos[1], s.start_pos[2], s.entry_pos[0], s.entry_pos[1], s.entry_pos[2]);
+        } else {
+            if (s.direction < DIR_NORTH || s.direction > DIR_WEST) {
+                add_issue(check, "spawn_bad_direction", "players.txt", line, "direction %d is not 0-3; North is used",
+                          s.direction);
+                s.direction = DIR_NORTH;
+            }
+            check->spawn_lines[check->num_spawns] = line;
+            check->spawns[check->num_spawns++] = s;
+        }
+    }
+    fclose(file);
+    if (check->num_spawns < MIN_PLAYERS) {
+        add_issue(check, "too_few_players", "players.txt", 0, "%d usable players, fewer than %d; the defaults are used",
+                  check->num_spawns, MIN_PLAYERS);
+        use_default_spawns(check);
+    }
+}
+
+static void read_flag(ConfigCheck *check, const char *dir) {
+    FILE *file = open_config_file(dir, "flag.txt");
+    check->flag_line = 0;
+    if (!file) return;
+    char buffer[256];
+    // Only the first line counts, as in read_flag_from_file()
+    if (!fgets(buffer, sizeof(buffer), file) ||
+        sscanf(buffer, "[%d, %d, %d]", &check->flag_position[0], &check->flag_position[1], &check->flag_position[2]) != 3) {
+        add_issue(check, "parse_error", "flag.txt", 1, "not [floor, w, l]; the flag is placed at random");
+    } else if (!in_maze(check->flag_position[0], check->flag_position[1], check->flag_position[2])) {
+        add_issue(check, "out_of_bounds", "flag.txt", 1, "flag [%d,%d,%d] is outside the maze",
+                  check->flag_position[0], check->flag_position[1], check->flag_position[2]);
+    } else {
+        check->flag_line = 1;
+    }
+    fclose(file);
+}
+
+// ---- Checks on the built layout ----
+
+static void check_stairs_and_poles(ConfigCheck *check) {
+    for (int i = 0; i < check->num_stairs; i++) {
+        const Stair *s = &check->stairs[i];
+        if (s->start_floor == s->end_floor) {
+            add_issue(check, "stair_same_floor", "stairs.txt", check->stair_lines[i], "stair [%d,%d,%d] to [%d,%d,%d] stays on one floor",
+                      s->start_floor, s->start_w, s->start_l, s->end_floor, s->end_w, s->end_l);
+            continue;
+        }
+        const int ends[2][3] = { { s->start_floor, s->start_w, s->start_l }, { s->end_floor, s->end_w, s->end_l } };
+        for (int e = 0; e < 2; e++) {
+            const char *problem = cell_problem(&check->layout, ends[e][0], ends[e][1], ends[e][2]);
+            if (problem) {
+                add_issue(check, "stair_invalid_cell", "stairs.txt", check->stair_lines[i], "%s [%d,%d,%d] %s",
+                          e ? "end" : "start", ends[e][0], ends[e][1], ends[e][2], problem);
+            }
+        }
+    }
+    for (int i = 0; i < check->num_poles; i++) {
+        const Pole *p = &check->poles[i];
+        if (p->start_floor <= p->end_floor) {
+            add_issue(check, "pole_not_downward", "poles.txt", check->pole_lines[i], "pole at [%d,%d] goes from floor %d to %d",
+                      p->w, p->l, p->start_floor, p->end_floor);
+            continue;
+        }
+        // A top players cannot step on only means the pole never fires (the built-in pole's
+        // top is off floor 2's plan); a bottom they cannot stand on strands whoever slides
+        const char *problem = cell_problem(&check->layout, p->end_floor, p->w, p->l);
+        if (problem) {
+            add_issue(check, "pole_invalid_cell", "poles.txt", check->pole_lines[i], "bottom [%d,%d,%d] %s",
+                      p->end_floor, p->w, p->l, problem);
+        }
+    }
+}
+
+static void check_spawns(ConfigCheck *check) {
+    for (int i = 0; i < check->num_spawns; i++) {
+        // Defaults are known to be good
+        if (check->spawn_lines[i] == 0) continue;
+        const PlayerSpawn *s = &check->spawns[i];
+        if (!is_in_starting_area(s->start_pos[0], s->start_pos[1], s->start_pos[2])) {
+            add_issue(check, "spawn_invalid_cell", "players.txt", check->spawn_lines[i], "start [%d,%d,%d] is not in the starting area",
+                      s->start_pos[0], s->start_pos[1], s->start_pos[2]);
+        }
+        const char *problem = cell_problem(&check->layout, s->entry_pos[0], s->entry_pos[1], s->entry_pos[2]);
+        if (problem) {
+            add_issue(check, "spawn_invalid_cell", "players.txt", check->spawn_lines[i], "entry [%d,%d,%d] %s",
+                      s->entry_pos[0], s->entry_pos[1], s->entry_pos[2], problem);
+        }
+    }
+}
+
+// Walls may not run along a spawn cell, the starting area or the Bawana
+static void check_walls(ConfigCheck *check) {
+    unsigned char spawn_cell[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH];
+    memset(spawn_cell, 0, sizeof(spawn_cell));
+    for (int i = 0; i < check->num_spawns; i++) {
+        const PlayerSpawn *s = &check->spawns[i];
+        spawn_cell[s->start_pos[0]][s->start_pos[1]][s->start_pos[2]] = 1;
+        spawn_cell[s->entry_pos[0]][s->entry_pos[1]][s->entry_pos[2]] = 1;
+    }
+
+    for (int i = 0; i < check->num_walls; i++) {
+        const Wall *wall = &check->walls[i];
+        int vertical = wall->start_w == wall->end_w, horizontal = wall->start_l == wall->end_l;
+        if (!vertical && !horizontal) {
+            add_issue(check, "wall_not_straight", "walls.txt", check->wall_lines[i],
+                      "wall [%d,%d,%d] to [%d,%d,%d] is diagonal and blocks nothing",
+                      wall->floor, wall->start_w, wall->start_l, wall->floor, wall->end_w, wall->end_l);
+            continue;
+        }
+        if (memcmp(wall, &bawana_walls[0], sizeof(Wall)) == 0 || memcmp(wall, &bawana_walls[1], sizeof(Wall)) == 0) continue;
+
+        // The wall separates cell (w, l) from the next one across it, as in is_wall_blocking()
+        int lo = vertical ? (wall->start_l < wall->end_l ? wall->start_l : wall->end_l)
+                          : (wall->start_w < wall->end_w ? wall->start_w : wall->end_w);
+        int hi = vertical ? (wall->start_l > wall->end_l ? wall->start_l : wall->end_l)
+                          : (wall->start_w > wall->end_w ? wall->start_w : wall->end_w);
+        const char *zone = NULL;
+        int at[3] = { wall->floor, 0, 0 };
+        for (int k = lo; k <= hi && !zone; k++) {
+            for (int side = 0; side < 2 && !zone; side++) {
+                int w = vertical ? wall->start_w + side : k;
+                int l = vertical ? k : wall->start_l + side;
+                if (!in_maze(wall->floor, w, l)) continue;
+                const Cell *cell = &check->layout.cells[wall->floor][w][l];
+                if (spawn_cell[wall->floor][w][l]) zone = "a spawn cell";
+                else if (cell->is_starting_area) zone = "the starting area";
+                else if (in_bawana(wall->floor, w, l) || cell->is_bawana_entrance) zone = "the Bawana";
+                at[1] = w;
+                at[2] = l;
+            }
+        }
+        if (zone) {
+            add_issue(check, "wall_on_protected_cell", "walls.txt", check->wall_lines[i], "wall runs along %s at [%d,%d,%d]",
+                      zone, at[0], at[1], at[2]);
+        }
+    }
+}
+
+static void check_flag(ConfigCheck *check) {
+    if (!check->flag_line) return;
+    const int *flag = check->flag_position;
+    if (!is_valid_flag_cell(&check->layout, flag[0], flag[1], flag[2])) {
+        add_issue(check, "flag_invalid_cell", "flag.txt", 1, "flag [%d,%d,%d] is not a playable cell; it is moved at random",
+                  flag[0], flag[1], flag[2]);
+    } else if (!is_flag_reachable(&check->layout, check->stairs, check->poles, check->num_poles, check->spawns,
+                                  check->num_spawns, flag)) {
+        add_issue(check, "flag_unreachable", "flag.txt", 1, "no player can reach flag [%d,%d,%d]; it is moved at random",
+                  flag[0], flag[1], flag[2]);
+    }
+}
+
+// ---- Teleport cycles ----
+// A node is a cell at the end of a stair or pole; an edge is one teleport.
+// Stairs go both ways (their directions are re-rolled), poles only down.
+
+#define MAX_TELEPORT_NODES (2 * (MAX_STAIRS + MAX_POLES))
+
+typedef struct {
+    int num_nodes, num_edges;
+    int cells[MAX_TELEPORT_NODES][3];
+    int from[2 * MAX_STAIRS + MAX_POLES], to[2 * MAX_STAIRS + MAX_POLES];
+    int object[2 * MAX_STAIRS + MAX_POLES];   // Stair i, or MAX_STAIRS + pole i
+} TeleportGraph;
+
+static int teleport_node(TeleportGraph *graph, int floor, int w, int l) {
+    for (int n = 0; n < graph->num_nodes; n++) {
+        if (graph->cells[n][0] == floor && graph->cells[n][1] == w && graph->cells[n][2] == l) return n;
+    }
+    graph->cells[graph->num_nodes][0] = floor;
+    graph->cells[graph->num_nodes][1] = w;
+    graph->cells[graph->num_nodes][2] = l;
+    return graph->num_nodes++;
+}
+
+static void teleport_edge(TeleportGraph *graph, int from, int to, int object) {
+    graph->from[graph->num_edges] = from;
+    graph->to[graph->num_edges] = to;
+    graph->object[graph->num_edges++] = object;
+}
+
+// Extend path[0..depth) from `node` back to `start`, through nodes numbered
+// above `start` only (every cycle is found from its lowest node). Going back
+// down the stair just taken is not a cycle. Returns the cycle length or 0.
+static int find_cycle(const TeleportGraph *graph, int start, int node, int path[], int depth, unsigned char on_path[]) {
+    for (int e = 0; e < graph->num_edges; e++) {
+        if (graph->from[e] != node) continue;
+        int next = graph->to[e];
+        path[depth] = e;
+        if (next == start) {
+            if (depth == 1 && graph->object[path[0]] == graph->object[e]) continue;
+            return depth + 1;
+        }
+        if (next < start || on_path[next]) continue;
+        on_path[next] = 1;
+        int length = find_cycle(graph, start, next, path, depth + 1, on_path);
+        on_path[next] = 0;
+        if (length) return length;
+    }
+    return 0;
+}
+
+static void check_teleport_cycles(ConfigCheck *check) {
+    TeleportGraph graph;
+    graph.num_nodes = graph.num_edges = 0;
+    for (int i = 0; i < check->num_stairs; i++) {
+        const Stair *s = &check->stairs[i];
+        if (s->start_floor == s->end_floor) continue;
+        int a = teleport_node(&graph, s->start_floor, s->start_w, s->start_l);
+        int b = teleport_node(&graph, s->end_floor, s->end_w, s->end_l);
+        teleport_edge(&graph, a, b, i);
+        teleport_edge(&graph, b, a, i);
+    }
+    for (int i = 0; i < check->num_poles; i++) {
+        const Pole *p = &check->poles[i];
+        if (p->start_floor <= p->end_floor) continue;
+        int a = teleport_node(&graph, p->start_floor, p->w, p->l);
+        int b = teleport_node(&graph, p->end_floor, p->w, p->l);
+        teleport_edge(&graph, a, b, MAX_STAIRS + i);
+    }
+
+    int path[MAX_TELEPORT_NODES];
+    unsigned char on_path[MAX_TELEPORT_NODES] = { 0 };
+    for (int start = 0; start < graph.num_nodes; start++) {
+        int length = find_cycle(&graph, start, start, path, 0, on_path);
+        if (!length) continue;
+
+        // Name the stairs and poles by their lines
+        char chain[80];
+        int used = 0;
+        for (int k = 0; k < length && used < (int)sizeof(chain); k++) {
+            int object = graph.object[path[k]];
+            used += snprintf(chain + used, sizeof(chain) - (size_t)used, "%s%s %d", k ? ", " : "",
+                             object < MAX_STAIRS ? "stair" : "pole",
+                             object < MAX_STAIRS ? check->stair_lines[object] : check->pole_lines[object - MAX_STAIRS]);
+        }
+        // Report it at the first stair or pole that came from a file
+        int first = graph.object[path[0]];
+        for (int k = 0; k < length; k++) {
+            int object = graph.object[path[k]];
+            if ((object < MAX_STAIRS ? check->stair_lines[object] : check->pole_lines[object - MAX_STAIRS]) > 0) {
+                first = object;
+                break;
+            }
+        }
+        add_issue(check, "teleport_cycle", first < MAX_STAIRS ? "stairs.txt" : "poles.txt",
+                  first < MAX_STAIRS ? check->stair_lines[first] : check->pole_lines[first - MAX_STAIRS],
+                  "[%d,%d,%d] leads back to itself by teleports alone (lines: %s)",
+                  graph.cells[start][0], graph.cells[start][1], graph.cells[start][2], chain);
+        return;
+    }
+}
+
+int config_check(ConfigCheck *check, const char *dir) {
+    check->num_issues = 0;
+    check->num_stairs = check->num_poles = check->num_walls = check->num_spawns = 0;
+    read_stairs(check, dir);
+    read_poles(check, dir);
+    read_walls(check, dir);
+    read_players(check, dir);
+    read_flag(check, dir);
+
+    // Only entries inside the maze get this far, so the layout is safe to build
+    maze_layout_build(&check->layout, check->stairs, check->num_stairs, check->poles, check->num_poles,
+                      check->walls, check->num_walls);
+    check_stairs_and_poles(check);
+    check_spawns(check);
+    check_walls(check);
+    check_flag(check);
+    check_teleport_cycles(check);
+    return check->num_issues;
+}
+
+int config_check_is_config_dir(const char *dir) {
+    char path[1024];
+    for (size_t i = 0; i < sizeof(config_files) / sizeof(config_files[0]); i++) {
+        if (snprintf(path, sizeof(path), "%s/%s", dir, config_files[i]) < (int)sizeof(path) && access(path, R_OK) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
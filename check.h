@@ -0,0 +1,58 @@
+// check.h - Static checks of one configuration directory
+// main() quietly repairs or ignores what it cannot use: unreadable lines are
+// skipped, an invalid or unreachable flag is moved, a short players.txt falls
+// back to the default players. config_check() reads the same files with the
+// same formats and reports each of these instead, with the file and line, plus
+// problems the engine never looks at:
+//  - coordinates outside the 3 x 10 x 25 maze (the entry is not checked further)
+//  - stairs within one floor, poles that do not go down
+//  - stair ends, pole bottoms and spawn entries players cannot stand on
+//    (invalid, starting area, blocked by a skipping stair, inside the Bawana)
+//  - diagonal walls, which never block anything
+//  - walls along a spawn cell, the starting area or the Bawana (the README's
+//    wall sanitisation rule); the two built-in Bawana walls are allowed
+//  - teleport cycles: stairs and poles whose ends chain back to where they
+//    started, so players can be carried round in circles
+//
+// A ConfigCheck is large scratch space; give each thread its own. Checking a
+// directory touches no global state, so threads can check different
+// directories at once. validate.c runs it over whole directory trees.
+
+#ifndef CHECK_H
+#define CHECK_H
+
+#include "game.h"
+
+#define CHECK_MAX_ISSUES  64    // Issues kept per directory; more are only counted
+
+typedef struct {
+    const char *code;           // Stable identifier, e.g. "flag_unreachable"
+    const char *file;           // Config file the issue is in
+    int line;                   // 1-based line in the file (0 = the file as a whole)
+    char message[112];
+} ConfigIssue;
+
+typedef struct {
+    // The directory as read, with the line every entry came from
+    Stair stairs[MAX_STAIRS];
+    Pole poles[MAX_POLES];
+    Wall walls[MAX_WALLS];
+    PlayerSpawn spawns[MAX_PLAYERS];
+    int stair_lines[MAX_STAIRS], pole_lines[MAX_POLES], wall_lines[MAX_WALLS], spawn_lines[MAX_PLAYERS];
+    int num_stairs, num_poles, num_walls, num_spawns;
+    int flag_position[3];
+    int flag_line;              // 0 = no flag.txt
+    MazeLayout layout;
+
+    int num_issues;             // Issues found, including those past CHECK_MAX_ISSUES
+    ConfigIssue issues[CHECK_MAX_ISSUES];
+} ConfigCheck;
+
+// Check the config files in `dir`; missing files mean the defaults, as in
+// main(). Returns the number of issues (0 = the directory is clean).
+int config_check(ConfigCheck *check, const char *dir);
+
+// Does `dir` hold any of the config files?
+int config_check_is_config_dir(const char *dir);
+
+#endif // CHECK_H
@@ -0,0 +1,290 @@
+// client.c - Stub client for the Maze of UCSC game server
+// Without --games it forwards stdin to the server line by line and prints each
+// reply, which is handy for poking at the protocol by hand. With --games it
+// plays that many games to completion over one or more connections, pipelining
+// requests in windows, checks every reply and reports the turn throughput.
+// Exits with 1 if the server sent an error or a malformed reply.
+//
+// Build: gcc -O2 -pthread -o client client.c
+// Usage: ./client [--socket PATH]                       (forward stdin)
+//        ./client [--socket PATH] --games N [--players P] [--seed S]
+//                 [--max-rounds R] [--connections C] [--window W]
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CLIENT_DEFAULT_SOCKET "/tmp/maze.sock"
+#define CLIENT_MAX_REPLY      1024
+
+typedef struct {
+    const char *socket_path;
+    int num_games;
+    int num_players;
+    unsigned int base_seed;
+    int max_rounds;
+    int window;                  // Requests in flight per connection
+} ClientConfig;
+
+typedef struct {
+    const ClientConfig *config;
+    int first_game;              // Games first_game .. first_game + num_games - 1 (for seeds)
+    int num_games;
+    long turns;
+    int games_won;
+    int errors;
+} ClientWorker;
+
+// Buffered reader for reply lines
+typedef struct {
+    int fd;
+    char buffer[65536];
+    size_t start, end;
+} ReplyReader;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int connect_to_server(const char *socket_path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    snprintf(address.sun_path, sizeof(address.sun_path), "%s", socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&address, sizeof(address)) < 0) {
+        perror(socket_path);
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int send_all(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        if (written <= 0) return 0;
+        data += written;
+        length -= (size_t)written;
+    }
+    return 1;
+}
+
+// Read one reply line (without the newline) into `line`; returns 0 on EOF
+static int read_reply(ReplyReader *reader, char *line, size_t line_size) {
+    size_t length = 0;
+    while (1) {
+        while (reader->start < reader->end) {
+            char c = reader->buffer[reader->start++];
+            if (c == '\n') {
+                line[length] = '\0';
+                return 1;
+            }
+            if (length + 1 < line_size) line[length++] = c;
+        }
+        ssize_t received = read(reader->fd, reader->buffer, sizeof(reader->buffer));
+        if (received <= 0) return 0;
+        reader->start = 0;
+        reader->end = (size_t)received;
+    }
+}
+
+// Integer value of `key=` in a reply, or `fallback` when the field is missing
+static int reply_field(const char *reply, const char *key, int fallback) {
+    char pattern[32];
+    snprintf(pattern, sizeof(pattern), " %s=", key);
+    const char *found = strstr(reply, pattern);
+    return found ? atoi(found + strlen(pattern)) : fallback;
+}
+
+// Forward stdin to the server, one request and one reply at a time
+static int run_interactive(const char *socket_path) {
+    int fd = connect_to_server(socket_path);
+    if (fd < 0) return 1;
+    ReplyReader *reader = calloc(1, sizeof(ReplyReader));
+    reader->fd = fd;
+
+    char request[CLIENT_MAX_REPLY], reply[CLIENT_MAX_REPLY];
+    int errors = 0;
+    while (fgets(request, sizeof(request), stdin)) {
+        if (strchr(request, '\n') == NULL) strcat(request, "\n");
+        if (!send_all(fd, request, strlen(request)) || !read_reply(reader, reply, sizeof(reply))) {
+            fprintf(stderr, "Error: Connection to server lost\n");
+            errors++;
+            break;
+        }
+        printf("%s\n", reply);
+        if (strncmp(reply, "ERR", 3) == 0) errors++;
+    }
+    close(fd);
+    free(reader);
+    return errors ? 1 : 0;
+}
+
+// Send one request per listed game in a single write, then read the replies in order
+static int exchange(int fd, ReplyReader *reader, const char *verb, const int games[], int count,
+                    char replies[][CLIENT_MAX_REPLY]) {
+    char *batch = malloc((size_t)count * 32);
+    size_t length = 0;
+    for (int i = 0; i < count; i++) {
+        length += (size_t)sprintf(batch + length, "%s %d\n", verb, games[i]);
+    }
+    int ok = send_all(fd, batch, length);
+    free(batch);
+    for (int i = 0; ok && i < count; i++) {
+        ok = read_reply(reader, replies[i], CLIENT_MAX_REPLY);
+    }
+    return ok;
+}
+
+// Play this worker's games to the end over its own connection
+static void *worker_main(void *arg) {
+    ClientWorker *worker = arg;
+    const ClientConfig *config = worker->config;
+    int fd = connect_to_server(config->socket_path);
+    if (fd < 0) {
+        worker->errors++;
+        return NULL;
+    }
+    ReplyReader *reader = calloc(1, sizeof(ReplyReader));
+    reader->fd = fd;
+    int *server_ids = malloc((size_t)worker->num_games * sizeof(int));
+    int *running = malloc((size_t)worker->num_games * sizeof(int));      // Local indices of unfinished games
+    long *turns_played = calloc((size_t)worker->num_games, sizeof(long));
+    int *batch = malloc((size_t)config->window * sizeof(int));
+    char (*replies)[CLIENT_MAX_REPLY] = malloc((size_t)config->window * CLIENT_MAX_REPLY);
+    char request[64];
+
+    // Create the games
+    for (int g = 0; g < worker->num_games; g++) {
+        snprintf(request, sizeof(request), "NEW %d %u\n", config->num_players,
+                 config->base_seed + (unsigned int)(worker->first_game + g));
+        if (!send_all(fd, request, strlen(request)) || !read_reply(reader, replies[0], CLIENT_MAX_REPLY) ||
+            strncmp(replies[0], "OK ", 3) != 0) {
+            fprintf(stderr, "Error: NEW failed: %s\n", replies[0]);
+            worker->errors++;
+            goto done;
+        }
+        server_ids[g] = reply_field(replies[0], "game", -1);
+        running[g] = g;
+    }
+
+    // Roll round-robin, one window of games at a time, dropping games as they finish.
+    // Every ROLL is one player's turn, so a game reaches the round cap after max_rounds * players rolls.
+    long turn_cap = (long)config->max_rounds * config->num_players;
+    int num_running = worker->num_games;
+    while (num_running > 0) {
+        int kept = 0;
+        for (int first = 0; first < num_running; first += config->window) {
+            int count = num_running - first < config->window ? num_running - first : config->window;
+            for (int i = 0; i < count; i++) {
+                batch[i] = server_ids[running[first + i]];
+            }
+            if (!exchange(fd, reader, "ROLL", batch, count, replies)) {
+                fprintf(stderr, "Error: Connection to server lost\n");
+                worker->errors++;
+                goto done;
+            }
+            for (int i = 0; i < count; i++) {
+                int g = running[first + i];
+                if (strncmp(replies[i], "TURN ", 5) != 0 || reply_field(replies[i], "game", -1) != batch[i]) {
+                    fprintf(stderr, "Error: Unexpected reply to ROLL %d: %s\n", batch[i], replies[i]);
+                    worker->errors++;
+                    continue;
+                }
+                worker->turns++;
+                if (reply_field(replies[i], "won", 0)) {
+                    worker->games_won++;
+                } else if (++turns_played[g] < turn_cap) {
+                    running[kept++] = g;
+                }
+            }
+        }
+        num_running = kept;
+    }
+
+    // Release the games
+    for (int first = 0; first < worker->num_games; first += config->window) {
+        int count = worker->num_games - first < config->window ? worker->num_games - first : config->window;
+        if (!exchange(fd, reader, "END", &server_ids[first], count, replies)) {
+            worker->errors++;
+            break;
+        }
+        for (int i = 0; i < count; i++) {
+            if (strncmp(replies[i], "OK ", 3) != 0) worker->errors++;
+        }
+    }
+
+done:
+    close(fd);
+    free(reader);
+    free(server_ids);
+    free(running);
+    free(turns_played);
+    free(batch);
+    free(replies);
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    ClientConfig config = { CLIENT_DEFAULT_SOCKET, 0, 3, 1, 1000, 256 };
+    int num_connections = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) config.socket_path = argv[++i];
+        else if (strcmp(argv[i], "--games") == 0 && i + 1 < argc) config.num_games = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--players") == 0 && i + 1 < argc) config.num_players = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) config.base_seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--max-rounds") == 0 && i + 1 < argc) config.max_rounds = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--connections") == 0 && i + 1 < argc) num_connections = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--window") == 0 && i + 1 < argc) config.window = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "Usage: %s [--socket PATH] [--games N] [--players P] [--seed S] [--max-rounds R] "
+                            "[--connections C] [--window W]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (config.num_games <= 0) return run_interactive(config.socket_path);
+    if (num_connections < 1) num_connections = 1;
+    if (num_connections > config.num_games) num_connections = config.num_games;
+    if (config.window < 1) config.window = 1;
+
+    ClientWorker *workers = calloc((size_t)num_connections, sizeof(ClientWorker));
+    pthread_t *threads = calloc((size_t)num_connections, sizeof(pthread_t));
+    double start = now_seconds();
+    int assigned = 0;
+    for (int c = 0; c < num_connections; c++) {
+        workers[c].config = &config;
+        workers[c].first_game = assigned;
+        workers[c].num_games = config.num_games / num_connections + (c < config.num_games % num_connections);
+        assigned += workers[c].num_games;
+        pthread_create(&threads[c], NULL, worker_main, &workers[c]);
+    }
+
+    long turns = 0;
+    int games_won = 0, errors = 0;
+    for (int c = 0; c < num_connections; c++) {
+        pthread_join(threads[c], NULL);
+        turns += workers[c].turns;
+        games_won += workers[c].games_won;
+        errors += workers[c].errors;
+    }
+    double elapsed = now_seconds() - start;
+
+    printf("Games: %d (%d won) over %d connection%s\n", config.num_games, games_won, num_connections,
+           num_connections == 1 ? "" : "s");
+    printf("Turns: %ld in %.3fs, %.0f turns/s\n", turns, elapsed, turns / elapsed);
+    if (errors) printf("Errors: %d\n", errors);
+
+    free(workers);
+    free(threads);
+    return errors ? 1 : 0;
+}
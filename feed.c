@@ -0,0 +1,156 @@
+// feed.c - Seqlock ring of game snapshots in /dev/shm (see feed.h)
+
+#include "feed.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static void feed_path(char *path, size_t size, const char *name) {
+    snprintf(path, size, "/%s", name);
+}
+
+static size_t feed_size(uint32_t num_slots) {
+    return sizeof(FeedHeader) + (size_t)num_slots * sizeof(FeedSlot);
+}
+
+int feed_create(LiveFeed *feed, const char *name, int num_slots) {
+    char path[256];
+    feed_path(path, sizeof(path), name);
+    memset(feed, 0, sizeof(*feed));
+    if (num_slots < 1) num_slots = FEED_SLOTS;
+
+    // A fresh file each time, so readers of an older feed keep their own mapping
+    shm_unlink(path);
+    int fd = shm_open(path, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) return 0;
+    size_t size = feed_size((uint32_t)num_slots);
+    if (ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        shm_unlink(path);
+        return 0;
+    }
+    void *base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        shm_unlink(path);
+        return 0;
+    }
+
+    // The file starts zeroed: every slot is even (readable) and holds no snapshot yet
+    feed->header = base;
+    feed->slots = (FeedSlot *)((char *)base + sizeof(FeedHeader));
+    feed->mapped_size = size;
+    feed->writable = 1;
+    feed->header->version = FEED_VERSION;
+    feed->header->num_slots = (uint32_t)num_slots;
+    feed->header->slot_size = sizeof(FeedSlot);
+    feed->header->max_players = FEED_MAX_PLAYERS;
+    atomic_store_explicit(&feed->header->published, 0, memory_order_relaxed);
+    // Readers check the magic last, once the rest of the header is in place
+    atomic_thread_fence(memory_order_release);
+    feed->header->magic = FEED_MAGIC;
+    return 1;
+}
+
+int feed_open(LiveFeed *feed, const char *name) {
+    char path[256];
+    struct stat st;
+    feed_path(path, sizeof(path), name);
+    memset(feed, 0, sizeof(*feed));
+
+    int fd = shm_open(path, O_RDONLY, 0);
+    if (fd < 0) return 0;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(FeedHeader)) {
+        close(fd);
+        return 0;
+    }
+    void *base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return 0;
+
+    FeedHeader *header = base;
+    atomic_thread_fence(memory_order_acquire);
+    if (header->magic != FEED_MAGIC || header->version != FEED_VERSION || header->slot_size != sizeof(FeedSlot) ||
+        (size_t)st.st_size < feed_size(header->num_slots)) {
+        munmap(base, (size_t)st.st_size);
+        return 0;
+    }
+    feed->header = header;
+    feed->slots = (FeedSlot *)((char *)base + sizeof(FeedHeader));
+    feed->mapped_size = (size_t)st.st_size;
+    return 1;
+}
+
+void feed_close(LiveFeed *feed) {
+    if (feed->header) munmap(feed->header, feed->mapped_size);
+    memset(feed, 0, sizeof(*feed));
+}
+
+void feed_unlink(const char *name) {
+    char path[256];
+    feed_path(path, sizeof(path), name);
+    shm_unlink(path);
+}
+
+void feed_publish(LiveFeed *feed, uint64_t game_id, int round_number, int winner,
+                  const Player players[], int num_players, const Stair stairs[], int num_stairs,
+                  const int flag_position[3]) {
+    if (!feed->writable) return;
+    uint64_t index = atomic_fetch_add_explicit(&feed->header->published, 1, memory_order_relaxed);
+    FeedSlot *slot = &feed->slots[index % feed->header->num_slots];
+
+    // Take the slot: even -> odd. A writer still in it means the ring wrapped under it; drop this one.
+    uint64_t seq = atomic_load_explicit(&slot->seq, memory_order_relaxed);
+    if ((seq & 1) || !atomic_compare_exchange_strong_explicit(&slot->seq, &seq, seq + 1,
+                                                              memory_order_acquire, memory_order_relaxed)) {
+        return;
+    }
+    atomic_thread_fence(memory_order_release);
+
+    FeedSnapshot *snapshot = &slot->snapshot;
+    snapshot->index = index;
+    snapshot->game_id = game_id;
+    snapshot->round_number = round_number;
+    snapshot->winner = winner;
+    snapshot->num_players = num_players;
+    snapshot->num_stairs = num_stairs;
+    memcpy(snapshot->flag_position, flag_position, sizeof(snapshot->flag_position));
+    for (int i = 0; i < num_stairs; i++) {
+        snapshot->stair_direction[i] = (int8_t)stairs[i].direction_type;
+    }
+    int listed = num_players < FEED_MAX_PLAYERS ? num_players : FEED_MAX_PLAYERS;
+    for (int p = 0; p < listed; p++) {
+        const Player *player = &players[p];
+        FeedPlayer *out = &snapshot->players[p];
+        memcpy(out->pos, player->pos, sizeof(out->pos));
+        out->in_game = player->in_game;
+        out->direction = player->direction;
+        out->movement_points = player->movement_points;
+        out->bawana_effect = player->bawana_effect;
+        out->bawana_turns_left = player->bawana_turns_left;
+    }
+
+    atomic_store_explicit(&slot->seq, seq + 2, memory_order_release);
+}
+
+// The round a game has just finished (round_number already points at the next one)
+void feed_publish_game(LiveFeed *feed, uint64_t game_id, const GameState *game) {
+    int round_number = game->winner >= 0 ? game->round_number : game->round_number - 1;
+    feed_publish(feed, game_id, round_number, game->winner, game->players, game->num_players,
+                 game->stairs, game->num_stairs, game->flag_position);
+}
+
+uint64_t feed_published(const LiveFeed *feed) {
+    return atomic_load_explicit(&feed->header->published, memory_order_acquire);
+}
+
+int feed_read(const LiveFeed *feed, uint64_t index, FeedSnapshot *snapshot) {
+    const FeedSlot *slot = &feed->slots[index % feed->header->num_slots];
+    uint64_t before = atomic_load_explicit(&((FeedSlot *)slot)->seq, memory_order_acquire);
+    if (before & 1) return 0;
+    memcpy(snapshot, &slot->snapshot, sizeof(*snapshot));
+    atomic_thread_fence(memory_order_acquire);
+    uint64_t after = atomic_load_explicit(&((FeedSlot *)slot)->seq, memory_order_relaxed);
+    return before == after && snapshot->index == index && before != 0;
+}
@@ -0,0 +1,96 @@
+// feed.h - Live game state feed in shared memory for spectators and dashboards
+// A writer publishes a snapshot of a game (player positions, MP, effects, stair
+// directions, flag) at the end of every round into a ring of fixed-size slots
+// in a file under /dev/shm. Any number of reader processes map the same file
+// read-only and poll it; they never take a lock or make a system call, so a
+// reader can never slow a game down or block it.
+//
+// Each slot is a seqlock: its sequence number is odd while the slot is being
+// written and moves on by two per snapshot. A reader copies the slot and keeps
+// the copy only if the sequence number was even and unchanged across the copy.
+// Several threads may publish into one feed; a writer that finds its slot still
+// being written by a slower writer a full ring behind drops its snapshot.
+//
+// Writers and readers both link feed.c; spectate.c is the reader tool.
+
+#ifndef FEED_H
+#define FEED_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include "game.h"
+
+#define FEED_MAGIC        0x44454546455a414dULL  // "MAZEFEED"
+#define FEED_VERSION      1
+#define FEED_MAX_PLAYERS  16      // Players beyond this are not published
+#define FEED_SLOTS        1024    // Default ring size
+
+typedef struct {
+    int32_t pos[3];
+    int32_t in_game;
+    int32_t direction;
+    int32_t movement_points;
+    int32_t bawana_effect;      // EFFECT_*
+    int32_t bawana_turns_left;
+} FeedPlayer;
+
+typedef struct {
+    uint64_t index;             // Position in the order snapshots were published
+    uint64_t game_id;           // Seed of the game (or its server id)
+    int32_t round_number;       // Last round played
+    int32_t winner;             // -1 while the game runs
+    int32_t num_players;        // Players in the game; the first FEED_MAX_PLAYERS are listed
+    int32_t num_stairs;
+    int32_t flag_position[3];
+    int8_t stair_direction[MAX_STAIRS];   // STAIR_* per stair
+    FeedPlayer players[FEED_MAX_PLAYERS];
+} FeedSnapshot;
+
+typedef struct {
+    _Atomic uint64_t seq;       // Odd while being written
+    uint64_t reserved[7];       // Keeps the snapshot off the sequence number's cache line
+    FeedSnapshot snapshot;
+} __attribute__((aligned(64))) FeedSlot;
+
+typedef struct {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t num_slots;
+    uint32_t slot_size;         // sizeof(FeedSlot), checked by readers
+    uint32_t max_players;
+    uint64_t reserved[5];
+    _Atomic uint64_t published; // Snapshots claimed so far; the newest is published - 1
+} __attribute__((aligned(64))) FeedHeader;
+
+typedef struct {
+    FeedHeader *header;
+    FeedSlot *slots;
+    size_t mapped_size;
+    int writable;
+} LiveFeed;
+
+// Create (or replace) the feed /dev/shm/<name> with `num_slots` slots; returns 0 on failure
+int feed_create(LiveFeed *feed, const char *name, int num_slots);
+
+// Map an existing feed read-only; returns 0 if it does not exist or is not a feed
+int feed_open(LiveFeed *feed, const char *name);
+
+void feed_close(LiveFeed *feed);
+
+// Remove /dev/shm/<name>; readers that have it mapped keep their view
+void feed_unlink(const char *name);
+
+// Publish one snapshot of a game (writers only, any thread)
+void feed_publish(LiveFeed *feed, uint64_t game_id, int round_number, int winner,
+                  const Player players[], int num_players, const Stair stairs[], int num_stairs,
+                  const int flag_position[3]);
+void feed_publish_game(LiveFeed *feed, uint64_t game_id, const GameState *game);
+
+// Number of snapshots published so far
+uint64_t feed_published(const LiveFeed *feed);
+
+// Copy snapshot `index` into `snapshot`; returns 0 if it is being written or has
+// already been overwritten by a newer one
+int feed_read(const LiveFeed *feed, uint64_t index, FeedSnapshot *snapshot);
+
+#endif // FEED_H
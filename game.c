@@ -1,8 +1,21 @@
 // game.c - Main game logic implementation
 
 #include "game.h"
+#include "profile.h"
+#include "trace.h"
+#include "stats.h"
+#include "metrics.h"
 #include <stdlib.h>
 
+// Narration and prompts are on by default for interactive play
+int game_print_enabled = 1;
+int game_prompt_enabled = 1;
+_Thread_local int game_fast_paths_enabled = 1;
+
+// Change in width and length for one step in each direction (DIR_*)
+static const int step_w[4] = {0, 1, 0, -1};
+static const int step_l[4] = {-1, 0, 1, 0};
+
 // Helper function to convert direction enum to readable string
 const char* get_direction_name(int direction) {
     switch(direction) {
@@ -16,11 +29,27 @@ const char* get_direction_name(int direction) {
 
 // Format position coordinates into a nice string like [floor,width,length]
 const char* format_position(int floor, int width_pos, int length_pos) {
-    static char position_buffer[20];
+    static _Thread_local char position_buffer[20];
     snprintf(position_buffer, sizeof(position_buffer), "[%d,%d,%d]", floor, width_pos, length_pos);
     return position_buffer;
 }
 
+// Player display name: A..Z for the first 26 players, then P27, P28, ...
+const char* get_player_name(int player_id) {
+    static const char letter_names[26][2] = {
+        "A", "B", "C", "D", "E", "F", "G", "H", "I", "J", "K", "L", "M",
+        "N", "O", "P", "Q", "R", "S", "T", "U", "V", "W", "X", "Y", "Z"
+    };
+    static _Thread_local char name_buffers[4][16]; // A few names may appear in one message
+    static _Thread_local int next_buffer;
+
+    if (player_id >= 0 && player_id < 26) return letter_names[player_id];
+    char *name_buffer = name_buffers[next_buffer];
+    next_buffer = (next_buffer + 1) % 4;
+    snprintf(name_buffer, sizeof(name_buffers[0]), "P%d", player_id + 1);
+    return name_buffer;
+}
+
 // Find a pole at a specific position (poles span multiple floors)
 int find_pole_at(Pole poles[], int num_poles, int floor, int width_pos, int length_pos) {
     for (int pole_idx = 0; pole_idx < num_poles; pole_idx++) {
@@ -42,11 +71,9 @@ int manhattan_distance(int floor1, int w1, int l1, int floor2, int w2, int l2) {
 
 // Comprehensive path validation - checks entire movement path before executing
 int check_path_validity(Player *player,
-                        Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH],
-                        Stair stairs[], int num_stairs,
-                        Pole poles[], int num_poles,
-                        Wall walls[], int num_walls,
-                        int steps, int player_id, const int flag_position[3],
+                        Maze *maze,
+                        Stair stairs[], Pole poles[],
+                        int steps, const int flag_position[3],
                         int *first_blocked_step, int *blocking_reason) {
     int current_width = player->pos[1];
     int current_length = player->pos[2];
@@ -57,6 +84,17 @@ int check_path_validity(Player *player,
     
     // Simulate each step of the movement
     for (int step_num = 0; step_num < steps; step_num++) {
+        // Plain cells ahead pass every check below, so skip over them at once
+        int run = game_fast_paths_enabled ?
+                  maze->layout->cells[current_floor][current_width][current_length].plain_run[player->direction] : 0;
+        if (run > 0) {
+            if (run > steps - step_num) run = steps - step_num;
+            current_width += run * step_w[player->direction];
+            current_length += run * step_l[player->direction];
+            step_num += run - 1;
+            continue;
+        }
+
         int next_width = current_width;
         int next_length = current_length;
 
@@ -69,19 +107,19 @@ int check_path_validity(Player *player,
         }
 
         // Walls between cells
-        if (is_wall_blocking(maze, current_floor, current_width, current_length, next_width, next_length, walls, num_walls)) {
+        if (maze_wall_blocks(maze->layout, current_floor, current_width, current_length, player->direction)) {
             *first_blocked_step = step_num;
             *blocking_reason = BLOCK_WALL;
             return 0;
         }
         // Valid destination
-        if (!is_valid_position(maze, current_floor, next_width, next_length)) {
+        if (!is_valid_position(maze->layout, current_floor, next_width, next_length)) {
             *first_blocked_step = step_num;
             *blocking_reason = BLOCK_INVALID_CELL;
             return 0;
         }
         // Bawana entrance restriction
-        if (!can_enter_bawana_entrance(player, maze, next_width, next_length)) {
+        if (!can_enter_bawana_entrance(player, maze->layout, next_width, next_length)) {
             *first_blocked_step = step_num;
             *blocking_reason = BLOCK_BAWANA_ENTRANCE;
             return 0;
@@ -93,7 +131,7 @@ int check_path_validity(Player *player,
 
         // If landing on stairs, simulate teleport using same tie-break as runtime
         int stair_indices_found[MAX_STAIRS];
-        int stairs_here = find_all_stairs_at(stairs, num_stairs, current_floor, current_width, current_length, stair_indices_found);
+        int stairs_here = maze_stairs_at(maze->layout, current_floor, current_width, current_length, stair_indices_found);
         if (stairs_here > 0) {
             int chosen_idx = -1;
             if (stairs_here == 1) {
@@ -131,21 +169,30 @@ int check_path_validity(Player *player,
         }
 
         // If landing on a pole start, simulate slide
-        for (int p = 0; p < num_poles; p++) {
-            if (poles[p].start_floor == current_floor && poles[p].w == current_width && poles[p].l == current_length) {
-                current_floor = poles[p].end_floor;
-                current_width = poles[p].w;
-                current_length = poles[p].l;
-                break;
-            }
+        int pole_here = maze->layout->cells[current_floor][current_width][current_length].pole_start;
+        if (pole_here != -1) {
+            current_floor = poles[pole_here].end_floor;
+            current_width = poles[pole_here].w;
+            current_length = poles[pole_here].l;
         }
     }
     
     return 1; // Entire path is clear
 }
 
+// Durations and recovery messages of the lasting effects, in one place for
+// apply_bawana_effect(), the countdowns in turn.c and the status line
+const BawanaEffectInfo bawana_effect_info[NUM_EFFECTS] = {
+    [EFFECT_NONE]           = {"None",           0, NULL},
+    [EFFECT_FOOD_POISONING] = {"Food Poisoning", 3, "%s has recovered from food poisoning and can resume normal play.\n"},
+    [EFFECT_DISORIENTED]    = {"Disoriented",    4, "%s has recovered from disorientation.\n"},
+    [EFFECT_TRIGGERED]      = {"Triggered",      4, "%s has recovered from being triggered.\n"},
+    [EFFECT_HAPPY]          = {"Happy",          0, NULL},
+    [EFFECT_RANDOM_MP]      = {"Random MP",      4, "%s's random movement point effect has expired.\n"},
+};
+
 // Apply special effects when player lands on a Bawana cell
-void apply_bawana_effect(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH], int player_id) {
+void apply_bawana_effect(Player *player, Maze *maze, int player_id) {
     int current_floor = player->pos[0];
     int current_width = player->pos[1];
     int current_length = player->pos[2];
@@ -156,16 +203,17 @@ void apply_bawana_effect(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOO
     // Don't apply effect if player already has one
     if (player->bawana_effect != EFFECT_NONE) return;
 
-    int cell_effect_type = maze[current_floor][current_width][current_length].bawana_cell_type;
-    char player_letter = 'A' + player_id;
+    int cell_effect_type = maze_bawana_type(maze, current_floor, current_width, current_length);
     
     // Required message: Announce what type of cell the player landed on
     const char* effect_names[] = {"food poisoning", "disoriented", "triggered", "happy", "random MP"};
     if (cell_effect_type >= 0 && cell_effect_type < 5) {
-        printf("%c is placed on a %s cell and effects take place.\n", player_letter, effect_names[cell_effect_type]);
+        GAME_PRINT("%s is placed on a %s cell and effects take place.\n", get_player_name(player_id), effect_names[cell_effect_type]);
     } else {
-        printf("%c is placed on a random cell and effects take place.\n", player_letter);
+        GAME_PRINT("%s is placed on a random cell and effects take place.\n", get_player_name(player_id));
     }
+    STATS_BAWANA(cell_effect_type);
+    METRICS_BAWANA(cell_effect_type);
 
     // Helper function to ensure MP awards are applied correctly
     // If player has negative MP, first normalize to 0, then add the bonus
@@ -180,55 +228,55 @@ void apply_bawana_effect(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOO
     switch (cell_effect_type) {
         case BA_FOOD_POISONING:
             player->bawana_effect = EFFECT_FOOD_POISONING;
-            player->bawana_turns_left = 3;
-            printf("%c eats from Bawana and have a bad case of food poisoning. Will need three rounds to recover.\n", player_letter);
+            player->bawana_turns_left = bawana_effect_info[EFFECT_FOOD_POISONING].duration;
+            GAME_PRINT("%s eats from Bawana and have a bad case of food poisoning. Will need three rounds to recover.\n", get_player_name(player_id));
             break;
             
         case BA_DISORIENTED:
             player->bawana_effect = EFFECT_DISORIENTED;
-            player->bawana_turns_left = 4;
+            player->bawana_turns_left = bawana_effect_info[EFFECT_DISORIENTED].duration;
             normalize_mp_then_add(50);
             // Move to Bawana entrance
             player->pos[1] = 9; 
             player->pos[2] = 19;
             player->direction = DIR_NORTH;
-            printf("%c eats from Bawana and is disoriented and is placed at the entrance of Bawana with 50 movement points.\n", player_letter);
+            GAME_PRINT("%s eats from Bawana and is disoriented and is placed at the entrance of Bawana with 50 movement points.\n", get_player_name(player_id));
             break;
             
         case BA_TRIGGERED:
             player->bawana_effect = EFFECT_TRIGGERED;
-            player->bawana_turns_left = 4; // Fixed duration
+            player->bawana_turns_left = bawana_effect_info[EFFECT_TRIGGERED].duration;
             normalize_mp_then_add(50);
             // Move to Bawana entrance
             player->pos[1] = 9; 
             player->pos[2] = 19;
             player->direction = DIR_NORTH;
-            printf("%c eats from Bawana and is triggered due to bad quality of food. %c is placed at the entrance of Bawana with 50 movement points.\n", player_letter, player_letter);
+            GAME_PRINT("%s eats from Bawana and is triggered due to bad quality of food. %s is placed at the entrance of Bawana with 50 movement points.\n", get_player_name(player_id), get_player_name(player_id));
             break;
             
         case BA_HAPPY:
             // Happy effect gives immediate boost with no lasting status
             player->bawana_effect = EFFECT_NONE;
-            player->bawana_turns_left = 0;
+            player->bawana_turns_left = bawana_effect_info[EFFECT_HAPPY].duration;
             normalize_mp_then_add(200);
             // Move to Bawana entrance
             player->pos[1] = 9; 
             player->pos[2] = 19;
             player->direction = DIR_NORTH;
-            printf("%c eats from Bawana and is happy. %c is placed at the entrance of Bawana with 200 movement points.\n", player_letter, player_letter);
+            GAME_PRINT("%s eats from Bawana and is happy. %s is placed at the entrance of Bawana with 200 movement points.\n", get_player_name(player_id), get_player_name(player_id));
             break;
             
         case BA_RANDOM_MP:
             player->bawana_effect = EFFECT_RANDOM_MP;
-            player->bawana_turns_left = 4;
-            player->bawana_random_mp = (rand() % 91) + 10; // Random 10-100
+            player->bawana_turns_left = bawana_effect_info[EFFECT_RANDOM_MP].duration;
+            player->bawana_random_mp = (game_rand() % 91) + 10; // Random 10-100
             normalize_mp_then_add(player->bawana_random_mp);
             // Move to Bawana entrance
             player->pos[1] = 9; 
             player->pos[2] = 19;
             player->direction = DIR_NORTH;
-            printf("%c eats from Bawana and earns %d movement points and is placed at the %s.\n", 
-                   player_letter, player->bawana_random_mp, format_position(player->pos[0], player->pos[1], player->pos[2]));
+            GAME_PRINT("%s eats from Bawana and earns %d movement points and is placed at the %s.\n", 
+                   get_player_name(player_id), player->bawana_random_mp, format_position(player->pos[0], player->pos[1], player->pos[2]));
             break;
     }
 }
@@ -242,8 +290,9 @@ int is_in_starting_area(int floor, int width_pos, int length_pos) {
 
 // Reset player to starting area when trapped in infinite loop
 void reset_to_starting_area(Player *player, int player_id) {
-    char player_letter = 'A' + player_id;
-    printf("Player %c trapped in Infinite Loop - resetting to Player A's starting area. Movement points preserved.\n", player_letter);
+    GAME_PRINT("Player %s trapped in Infinite Loop - resetting to Player A's starting area. Movement points preserved.\n", get_player_name(player_id));
+    STATS_LOOP_RESET();
+    METRICS_LOOP_RESET();
     
     // All players go to Player A's starting position when reset
     player->pos[0] = 0;
@@ -255,10 +304,8 @@ void reset_to_starting_area(Player *player, int player_id) {
 }
 
 // Main movement function with teleportation handling (stairs/poles)
-int move_player_with_teleport(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH],
-                               Stair stairs[], int num_stairs,
-                               Pole poles[], int num_poles,
-                               Wall walls[], int num_walls, int steps, int player_id, const int flag_position[3],
+int move_player_with_teleport(Player *player, Maze *maze,
+                               Stair stairs[], Pole poles[], int steps, int player_id, const int flag_position[3],
                                int *total_movement_cost, int *actual_steps_taken, int *blocking_reason) {
     
     int blocked_at_step;
@@ -270,18 +317,22 @@ int move_player_with_teleport(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH]
     if (blocking_reason) *blocking_reason = BLOCK_NONE;
     
     // Pre-validate the entire path
+    PROFILE_BEGIN(PROF_PATH_VALIDATION);
+    TRACE_BEGIN(trace_validate_start);
     int path_is_clear = check_path_validity(player, maze,
-                                           stairs, num_stairs,
-                                           poles, num_poles,
-                                           walls, num_walls,
-                                           steps, player_id, flag_position,
+                                           stairs, poles,
+                                           steps, flag_position,
                                            &blocked_at_step, &reason_for_blocking);
+    TRACE_END(trace_validate_start, TRACE_VALIDATE, player_id, player);
+    PROFILE_END(PROF_PATH_VALIDATION);
     
     if (blocking_reason) {
         *blocking_reason = reason_for_blocking;
     }
     
     if (!path_is_clear) {
+        STATS_BLOCKED(reason_for_blocking);
+        METRICS_BLOCKED(reason_for_blocking);
         if (total_movement_cost) *total_movement_cost = 2; // Standard cost for being blocked
         return 0; // Movement failed due to obstruction
     }
@@ -289,9 +340,33 @@ int move_player_with_teleport(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH]
     // Path is valid, execute the movement step by step
     int visited_positions[MAX_LOOP_HISTORY][3]; // Track positions to detect loops
     int visit_counter = 0;
-    char player_letter = 'A' + player_id;
+    int move_direction = player->direction;
+    int straight = 1; // No teleport or turn yet, so no cell of this move can repeat
 
     for (int current_step = 0; current_step < steps; current_step++) {
+        // Jump over plain cells while the move is still a straight line: only their
+        // cost counts, and the loop check cannot fire. Their positions are recorded
+        // only if later steps could need them for the loop check.
+        int run = straight && game_fast_paths_enabled ?
+                  maze_plain_run(maze, player->pos[0], player->pos[1], player->pos[2], move_direction) : 0;
+        if (run > 0) {
+            if (run > steps - current_step) run = steps - current_step;
+            if (total_movement_cost) {
+                *total_movement_cost += maze_ray_cost(maze, player->pos[0], player->pos[1], player->pos[2], move_direction, run);
+            }
+            for (int i = 0; i < run; i++) {
+                if (current_step + run < steps) {
+                    memcpy(visited_positions[visit_counter], player->pos, sizeof(player->pos));
+                    if (++visit_counter >= MAX_LOOP_HISTORY) visit_counter = 0;
+                }
+                player->pos[1] += step_w[move_direction];
+                player->pos[2] += step_l[move_direction];
+                STATS_VISIT(player->pos[0], player->pos[1], player->pos[2]);
+            }
+            current_step += run - 1;
+            continue;
+        }
+
         int old_floor = player->pos[0];
         int old_width = player->pos[1];
         int old_length = player->pos[2];
@@ -320,10 +395,11 @@ int move_player_with_teleport(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH]
         // Execute the basic movement
         player->pos[1] = new_width;
         player->pos[2] = new_length;
+        STATS_VISIT(old_floor, new_width, new_length);
 
         // Add consumable cost of this cell to total cost
         if (total_movement_cost) {
-            *total_movement_cost += maze[player->pos[0]][player->pos[1]][player->pos[2]].consumable_value;
+            *total_movement_cost += maze_consumable_value(maze, player->pos[0], player->pos[1], player->pos[2]);
         }
 
         // Check for infinite loop after basic movement
@@ -331,18 +407,19 @@ int move_player_with_teleport(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH]
             if (visited_positions[history_idx][0] == player->pos[0] &&
                 visited_positions[history_idx][1] == player->pos[1] &&
                 visited_positions[history_idx][2] == player->pos[2]) {
-                printf("Infinite loop detected at [%d,%d,%d]!\n", player->pos[0], player->pos[1], player->pos[2]);
+                GAME_PRINT("Infinite loop detected at [%d,%d,%d]!\n", player->pos[0], player->pos[1], player->pos[2]);
                 reset_to_starting_area(player, player_id);
                 return 1; // Movement completed (via loop reset)
             }
         }
 
         // Check for stairs at new position
+        PROFILE_BEGIN(PROF_STAIR_RESOLUTION);
         int stair_indices_found[MAX_STAIRS];
-        int num_stairs_found = find_all_stairs_at(stairs, num_stairs, old_floor, new_width, new_length, stair_indices_found);
+        int num_stairs_found = maze_stairs_at(maze->layout, old_floor, new_width, new_length, stair_indices_found);
 
         if (num_stairs_found > 0) {
-            printf("%c lands on %s which is a stair cell.\n", player_letter, format_position(old_floor, new_width, new_length));
+            GAME_PRINT("%s lands on %s which is a stair cell.\n", get_player_name(player_id), format_position(old_floor, new_width, new_length));
 
             int chosen_stair_idx = -1;
 
@@ -382,19 +459,21 @@ int move_player_with_teleport(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH]
                 }
 
                 if (num_tied > 1) {
-                    chosen_stair_idx = tied_stairs[rand() % num_tied];
-                    printf("Multiple stairs at same distance - randomly chose one.\n");
+                    chosen_stair_idx = tied_stairs[game_rand() % num_tied];
+                    GAME_PRINT("Multiple stairs at same distance - randomly chose one.\n");
                 } else {
                     chosen_stair_idx = best_stair_idx;
                 }
             }
 
             Stair *selected_stair = &stairs[chosen_stair_idx];
+            PROFILE_END(PROF_STAIR_RESOLUTION);
             // Check if stair allows movement in this direction
             if (selected_stair->direction_type == STAIR_BIDIRECTIONAL ||
                 (selected_stair->direction_type == STAIR_UP_ONLY && old_floor == selected_stair->start_floor) ||
                 (selected_stair->direction_type == STAIR_DOWN_ONLY && old_floor == selected_stair->end_floor)) {
 
+                TRACE_BEGIN(trace_stair_start);
                 int destination_floor, dest_width, dest_length;
                 if (old_floor == selected_stair->start_floor) {
                     destination_floor = selected_stair->end_floor; 
@@ -409,16 +488,18 @@ int move_player_with_teleport(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH]
                 player->pos[0] = destination_floor;
                 player->pos[1] = dest_width;
                 player->pos[2] = dest_length;
+                STATS_STAIR(old_floor, new_width, new_length);
 
-                printf("%c takes the stairs and now placed at %s in floor %d.\n",
-                       player_letter, format_position(player->pos[0], player->pos[1], player->pos[2]), player->pos[0]);
+                GAME_PRINT("%s takes the stairs and now placed at %s in floor %d.\n",
+                       get_player_name(player_id), format_position(player->pos[0], player->pos[1], player->pos[2]), player->pos[0]);
+                TRACE_END(trace_stair_start, TRACE_TELEPORT, player_id, player);
 
                 // Check for infinite loop after stair teleportation
                 for (int history_idx = 0; history_idx < visit_counter; history_idx++) {
                     if (visited_positions[history_idx][0] == player->pos[0] &&
                         visited_positions[history_idx][1] == player->pos[1] &&
                         visited_positions[history_idx][2] == player->pos[2]) {
-                        printf("Infinite loop detected after stair teleportation at [%d,%d,%d]!\n", 
+                        GAME_PRINT("Infinite loop detected after stair teleportation at [%d,%d,%d]!\n", 
                                player->pos[0], player->pos[1], player->pos[2]);
                         reset_to_starting_area(player, player_id);
                         return 1; // Movement completed (via loop reset)
@@ -427,33 +508,41 @@ int move_player_with_teleport(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH]
 
                 // Check if player fell back into starting area via stairs
                 if (is_in_starting_area(player->pos[0], player->pos[1], player->pos[2])) {
-                    printf("%c fell into starting area via stair - must roll 6 to re-enter.\n", player_letter);
+                    GAME_PRINT("%s fell into starting area via stair - must roll 6 to re-enter.\n", get_player_name(player_id));
                     player->in_game = 0;
                 }
 
+                straight = 0;
                 continue; // Skip to next step
             }
+        } else {
+            PROFILE_END(PROF_STAIR_RESOLUTION);
         }
 
         // Check for poles at new position
-        int pole_idx = find_pole_at(poles, num_poles, old_floor, new_width, new_length);
+        PROFILE_BEGIN(PROF_POLE_SLIDE);
+        int pole_idx = maze_pole_at(maze->layout, old_floor, new_width, new_length);
         if (pole_idx != -1) {
+            TRACE_BEGIN(trace_pole_start);
             Pole *current_pole = &poles[pole_idx];
-            printf("%c lands on %s which is a pole cell.\n", player_letter, format_position(old_floor, new_width, new_length));
+            GAME_PRINT("%s lands on %s which is a pole cell.\n", get_player_name(player_id), format_position(old_floor, new_width, new_length));
 
             player->pos[0] = current_pole->end_floor;
             player->pos[1] = current_pole->w;
             player->pos[2] = current_pole->l;
+            STATS_POLE(old_floor, new_width, new_length);
 
-            printf("%c slides down and now placed at %s in floor %d.\n",
-                   player_letter, format_position(player->pos[0], player->pos[1], player->pos[2]), player->pos[0]);
+            GAME_PRINT("%s slides down and now placed at %s in floor %d.\n",
+                   get_player_name(player_id), format_position(player->pos[0], player->pos[1], player->pos[2]), player->pos[0]);
+            TRACE_END(trace_pole_start, TRACE_TELEPORT, player_id, player);
+            PROFILE_END(PROF_POLE_SLIDE);
 
             // Check for infinite loop after pole teleportation
             for (int history_idx = 0; history_idx < visit_counter; history_idx++) {
                 if (visited_positions[history_idx][0] == player->pos[0] &&
                     visited_positions[history_idx][1] == player->pos[1] &&
                     visited_positions[history_idx][2] == player->pos[2]) {
-                    printf("Infinite loop detected after pole teleportation at [%d,%d,%d]!\n", 
+                    GAME_PRINT("Infinite loop detected after pole teleportation at [%d,%d,%d]!\n", 
                            player->pos[0], player->pos[1], player->pos[2]);
                     reset_to_starting_area(player, player_id);
                     return 1; // Movement completed (via loop reset)
@@ -462,20 +551,34 @@ int move_player_with_teleport(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH]
 
             // Check if player fell back into starting area via pole
             if (is_in_starting_area(player->pos[0], player->pos[1], player->pos[2])) {
-                printf("%c fell into starting area via pole - must roll 6 to re-enter.\n", player_letter);
+                GAME_PRINT("%s fell into starting area via pole - must roll 6 to re-enter.\n", get_player_name(player_id));
                 player->in_game = 0;
             }
 
+            straight = 0;
             continue; // Skip to next step
         }
+        PROFILE_END(PROF_POLE_SLIDE);
 
         // Apply Bawana effects if player landed in Bawana area
         if (old_floor == 0 && new_width >= 6 && new_width <= 9 && new_length >= 20 && new_length <= 24) {
+            PROFILE_BEGIN(PROF_BAWANA_EFFECT);
+            TRACE_BEGIN(trace_effect_start);
             apply_bawana_effect(player, maze, player_id);
+            TRACE_END(trace_effect_start, TRACE_EFFECTS, player_id, player);
+            PROFILE_END(PROF_BAWANA_EFFECT);
         }
         
         // Apply movement bonus if available at this cell
+        PROFILE_BEGIN(PROF_MOVEMENT_BONUS);
         apply_movement_bonus(player, maze, player_id);
+        PROFILE_END(PROF_MOVEMENT_BONUS);
+
+        // A Bawana effect may have moved or turned the player
+        if (player->pos[0] != old_floor || player->pos[1] != new_width || player->pos[2] != new_length ||
+            player->direction != move_direction) {
+            straight = 0;
+        }
     }
     
     // Set final return values for successful movement
@@ -484,10 +587,54 @@ int move_player_with_teleport(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH]
     return 1; // Movement completed successfully
 }
 
+// Block intermediate-floor cells under stairs that span more than one floor
+void block_skipping_stair_cells(MazeLayout *layout, Stair stairs[], int num_stairs) {
+    for (int stair_idx = 0; stair_idx < num_stairs; stair_idx++) {
+        int start_floor = stairs[stair_idx].start_floor;
+        int end_floor = stairs[stair_idx].end_floor;
+        int start_width = stairs[stair_idx].start_w;
+        int start_length = stairs[stair_idx].start_l;
+        
+        int min_floor = (start_floor < end_floor) ? start_floor : end_floor;
+        int max_floor = (start_floor > end_floor) ? start_floor : end_floor;
+        
+        // If stair spans more than 1 floor, block intermediate floors
+        if (max_floor - min_floor > 1) {
+            // Block intermediate floors using coordinates from the starting floor
+            for (int blocked_floor = min_floor + 1; blocked_floor < max_floor; blocked_floor++) {
+                layout->cells[blocked_floor][start_width][start_length].is_blocked_by_stair = 1;
+                GAME_PRINT("Blocked cell [%d,%d,%d] for skipping stair.\n", blocked_floor, start_width, start_length);
+            }
+        }
+    }
+}
+
+// Randomly place the flag if none was loaded, otherwise replace a loaded flag that is invalid or unreachable
+void resolve_flag_position(int flag_position[3], int loaded_from_file,
+                           const MazeLayout *layout,
+                           Stair stairs[], Pole poles[], int num_poles,
+                           const PlayerSpawn spawns[], int num_spawns) {
+    if (!loaded_from_file) {
+        place_random_flag(flag_position, layout);
+        GAME_PRINT("Flag randomly placed at [%d,%d,%d]\n", flag_position[0], flag_position[1], flag_position[2]);
+    } else {
+        if (!is_valid_flag_cell(layout, flag_position[0], flag_position[1], flag_position[2])) {
+            GAME_PRINT("Flag in flag.txt at %s is invalid. Replacing with a random valid location.\n", 
+                   format_position(flag_position[0], flag_position[1], flag_position[2]));
+            place_random_flag(flag_position, layout);
+        } else if (!is_flag_reachable(layout, stairs, poles, num_poles, spawns, num_spawns, flag_position)) {
+            GAME_PRINT("Flag in flag.txt at %s is unreachable. Replacing with a random valid reachable location.\n", 
+                   format_position(flag_position[0], flag_position[1], flag_position[2]));
+            place_random_flag(flag_position, layout);
+        }
+    }
+}
+
 // Randomly place the flag in a valid maze position
-void place_random_flag(int flag_position[3], Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH]) {
+void place_random_flag(int flag_position[3], const MazeLayout *layout) {
     int valid_flag_positions[1000][3]; // Store all valid positions
     int num_valid_positions = 0;
+    const Cell (*maze)[FLOOR_WIDTH][FLOOR_LENGTH] = layout->cells;
     
     for (int floor_num = 0; floor_num < NUM_FLOORS; floor_num++) {
         for (int w = 0; w < FLOOR_WIDTH; w++) {
@@ -514,11 +661,11 @@ void place_random_flag(int flag_position[3], Cell maze[NUM_FLOORS][FLOOR_WIDTH][
     }
     
     if (num_valid_positions == 0) { 
-        printf("Error: No valid positions for flag placement!\n");
+        fprintf(stderr, "Error: No valid positions for flag placement!\n");
         exit(1); 
     }
     
-    int random_choice = rand() % num_valid_positions;
+    int random_choice = game_rand() % num_valid_positions;
     flag_position[0] = valid_flag_positions[random_choice][0];
     flag_position[1] = valid_flag_positions[random_choice][1];
     flag_position[2] = valid_flag_positions[random_choice][2];
@@ -531,45 +678,101 @@ int check_flag_capture(Player *player, const int flag_position[3]) {
             player->pos[2] == flag_position[2]);
 }
 
+static int occupancy_index(const int pos[3]) {
+    return (pos[0] * FLOOR_WIDTH + pos[1]) * FLOOR_LENGTH + pos[2];
+}
+
+// Empty the grid, then list every player currently in the maze
+void occupancy_clear(Occupancy *occupancy, Player players[], int num_players) {
+    for (int cell = 0; cell < NUM_FLOORS * FLOOR_WIDTH * FLOOR_LENGTH; cell++) {
+        occupancy->head[cell] = -1;
+    }
+    for (int player_id = 0; player_id < num_players; player_id++) {
+        players[player_id].occupancy_cell = -1;
+        if (players[player_id].in_game) occupancy_add(occupancy, players, player_id);
+    }
+}
+
+// List a player under the cell it currently stands on
+void occupancy_add(Occupancy *occupancy, Player players[], int player_id) {
+    Player *player = &players[player_id];
+    int cell = occupancy_index(player->pos);
+    player->occupancy_cell = cell;
+    player->occupancy_prev = -1;
+    player->occupancy_next = occupancy->head[cell];
+    if (player->occupancy_next >= 0) players[player->occupancy_next].occupancy_prev = player_id;
+    occupancy->head[cell] = player_id;
+}
+
+// Unlink a player from whichever cell it was listed under (no-op if not listed)
+void occupancy_remove(Occupancy *occupancy, Player players[], int player_id) {
+    Player *player = &players[player_id];
+    if (player->occupancy_cell < 0) return;
+    if (player->occupancy_prev >= 0) {
+        players[player->occupancy_prev].occupancy_next = player->occupancy_next;
+    } else {
+        occupancy->head[player->occupancy_cell] = player->occupancy_next;
+    }
+    if (player->occupancy_next >= 0) players[player->occupancy_next].occupancy_prev = player->occupancy_prev;
+    player->occupancy_cell = -1;
+}
+
 // Check if current player has captured any other players at the same position
-void check_player_capture(Player players[3], int current_player_id) {
-    for (int other_player = 0; other_player < 3; other_player++) {
-        if (other_player == current_player_id || !players[other_player].in_game) continue;
-        
-        // Check if both players are at the same position
-        if (players[current_player_id].pos[0] == players[other_player].pos[0] &&
-            players[current_player_id].pos[1] == players[other_player].pos[1] &&
-            players[current_player_id].pos[2] == players[other_player].pos[2]) {
-            
-            printf("Player %c captures Player %c!\n", 'A' + current_player_id, 'A' + other_player);
-            
-            players[other_player].in_game = 0;
-            players[other_player].captured = 1;
-            
-            // All captured players go to Player A's starting position
-            players[other_player].pos[0] = 0; 
-            players[other_player].pos[1] = 6; 
-            players[other_player].pos[2] = 12;
-            players[other_player].direction = DIR_NORTH; // Same direction as Player A
-            
-            printf("Player %c sent back to Player A's starting area - must roll 6 to re-enter like Player A\n", 'A' + other_player);
-            return; // Only one capture per turn
-        }
+// Only the current player's cell is inspected, so the cost does not grow with
+// the number of players. The current player must not be listed in the grid.
+// Returns the captured player's id, or -1 if nobody was captured
+int check_player_capture(Player players[], Occupancy *occupancy, int current_player_id) {
+    Player *current_player = &players[current_player_id];
+    if (current_player->pos[0] < 0 || current_player->pos[0] >= NUM_FLOORS ||
+        current_player->pos[1] < 0 || current_player->pos[1] >= FLOOR_WIDTH ||
+        current_player->pos[2] < 0 || current_player->pos[2] >= FLOOR_LENGTH) return -1;
+
+    // Players can share a cell (entering the maze does not capture); the lowest id is caught
+    int other_player = -1;
+    for (int occupant = occupancy->head[occupancy_index(current_player->pos)]; occupant >= 0;
+         occupant = players[occupant].occupancy_next) {
+        if (other_player < 0 || occupant < other_player) other_player = occupant;
     }
+    if (other_player < 0) return -1;
+
+    GAME_PRINT("Player %s captures Player %s!\n", get_player_name(current_player_id), get_player_name(other_player));
+    STATS_CAPTURE(current_player_id);
+    METRICS_CAPTURE();
+
+    occupancy_remove(occupancy, players, other_player);
+    players[other_player].in_game = 0;
+    players[other_player].captured = 1;
+
+    // All captured players go to Player A's starting position
+    players[other_player].pos[0] = 0;
+    players[other_player].pos[1] = 6;
+    players[other_player].pos[2] = 12;
+    players[other_player].direction = DIR_NORTH; // Same direction as Player A
+
+    GAME_PRINT("Player %s sent back to Player A's starting area - must roll 6 to re-enter like Player A\n", get_player_name(other_player));
+    return other_player;
 }
 
 // Validate that a flag cell is on a playable tile (not starting area, wall, blocked, or Bawana)
-int is_valid_flag_cell(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH], int floor, int w, int l) {
+int is_valid_flag_cell(const MazeLayout *layout, int floor, int w, int l) {
     if (floor < 0 || floor >= NUM_FLOORS || w < 0 || w >= FLOOR_WIDTH || l < 0 || l >= FLOOR_LENGTH) return 0;
-    if (!maze[floor][w][l].is_valid) return 0;
-    if (maze[floor][w][l].is_starting_area) return 0;
-    if (maze[floor][w][l].has_wall) return 0;
-    if (maze[floor][w][l].is_blocked_by_stair) return 0;
-    if (maze[floor][w][l].is_bawana_entrance) return 0;
+    const Cell *cell = &layout->cells[floor][w][l];
+    if (!cell->is_valid) return 0;
+    if (cell->is_starting_area) return 0;
+    if (cell->has_wall) return 0;
+    if (cell->is_blocked_by_stair) return 0;
+    if (cell->is_bawana_entrance) return 0;
     if (floor == 0 && w >= 6 && w <= 9 && l >= 20 && l <= 24) return 0; // Bawana interior
     return 1;
 }
 
+// Default spawns of Players A, B and C; extra players reuse them in turn
+static const PlayerSpawn default_spawns[DEFAULT_NUM_PLAYERS] = {
+    {{0, 6, 12}, {0, 5, 12}, DIR_NORTH}, // Player A starts at [0,6,12] facing North
+    {{0, 9, 8},  {0, 9, 7},  DIR_WEST},  // Player B starts at [0,9,8] facing West
+    {{0, 9, 16}, {0, 9, 17}, DIR_EAST}   // Player C starts at [0,9,16] facing East
+};
+
 // Helper: enqueue for BFS if not visited
 static void enqueue_if_valid(int queue[][3], int *q_tail, int visited[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH], int f, int w, int l) {
     if (f < 0 || f >= NUM_FLOORS || w < 0 || w >= FLOOR_WIDTH || l < 0 || l >= FLOOR_LENGTH) return;
@@ -582,29 +785,25 @@ static void enqueue_if_valid(int queue[][3], int *q_tail, int visited[NUM_FLOORS
 }
 
 // Determine if flag is reachable from any player's entry cell considering walls, stairs, and poles
-int is_flag_reachable(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH],
-                      Stair stairs[], int num_stairs,
-                      Pole poles[], int num_poles,
-                      Wall walls[], int num_walls,
+int is_flag_reachable(const MazeLayout *layout,
+                      Stair stairs[], Pole poles[], int num_poles,
+                      const PlayerSpawn spawns[], int num_spawns,
                       const int flag_position[3]) {
     // Early reject if flag not on a valid cell per rules
-    if (!is_valid_flag_cell(maze, flag_position[0], flag_position[1], flag_position[2])) return 0;
+    if (!is_valid_flag_cell(layout, flag_position[0], flag_position[1], flag_position[2])) return 0;
 
     int visited[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH] = {0};
     int queue[NUM_FLOORS * FLOOR_WIDTH * FLOOR_LENGTH][3];
     int q_head = 0, q_tail = 0;
 
-    // Starting entry cells for A, B, C (after entering maze)
-    const int starts[3][3] = {
-        {0, 5, 12}, // A
-        {0, 9, 7},  // B
-        {0, 9, 17}  // C
-    };
-
-    // Seed BFS with valid starts
-    for (int s = 0; s < 3; s++) {
-        int sf = starts[s][0], sw = starts[s][1], sl = starts[s][2];
-        if (is_valid_position(maze, sf, sw, sl)) {
+    // Seed BFS with the players' valid entry cells (after entering maze)
+    if (!spawns) {
+        spawns = default_spawns;
+        num_spawns = DEFAULT_NUM_PLAYERS;
+    }
+    for (int s = 0; s < num_spawns; s++) {
+        int sf = spawns[s].entry_pos[0], sw = spawns[s].entry_pos[1], sl = spawns[s].entry_pos[2];
+        if (is_valid_position(layout, sf, sw, sl)) {
             enqueue_if_valid(queue, &q_tail, visited, sf, sw, sl);
         }
     }
@@ -625,15 +824,15 @@ int is_flag_reachable(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH],
             int nl = cl + dl[dir];
             if (nw < 0 || nw >= FLOOR_WIDTH || nl < 0 || nl >= FLOOR_LENGTH) continue;
             // Check cell validity first
-            if (!is_valid_position(maze, cf, nw, nl)) continue;
+            if (!is_valid_position(layout, cf, nw, nl)) continue;
             // Check walls between (cw,cl)->(nw,nl)
-            if (is_wall_blocking(maze, cf, cw, cl, nw, nl, walls, num_walls)) continue;
+            if (maze_wall_blocks(layout, cf, cw, cl, dir)) continue;
             enqueue_if_valid(queue, &q_tail, visited, cf, nw, nl);
         }
 
         // Stairs edges: from a stair endpoint, traverse to the other endpoint if allowed
         int stair_indices[MAX_STAIRS];
-        int stairs_here = find_all_stairs_at(stairs, num_stairs, cf, cw, cl, stair_indices);
+        int stairs_here = maze_stairs_at(layout, cf, cw, cl, stair_indices);
         for (int i = 0; i < stairs_here; i++) {
             Stair *st = &stairs[stair_indices[i]];
             int df, dw2, dl2;
@@ -641,25 +840,25 @@ int is_flag_reachable(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH],
                 // From start to end allowed if up-only or bidirectional
                 if (st->direction_type == STAIR_UP_ONLY || st->direction_type == STAIR_BIDIRECTIONAL) {
                     df = st->end_floor; dw2 = st->end_w; dl2 = st->end_l;
-                    if (is_valid_position(maze, df, dw2, dl2)) enqueue_if_valid(queue, &q_tail, visited, df, dw2, dl2);
+                    if (is_valid_position(layout, df, dw2, dl2)) enqueue_if_valid(queue, &q_tail, visited, df, dw2, dl2);
                 }
             }
             if (cf == st->end_floor && cw == st->end_w && cl == st->end_l) {
                 // From end to start allowed if down-only or bidirectional
                 if (st->direction_type == STAIR_DOWN_ONLY || st->direction_type == STAIR_BIDIRECTIONAL) {
                     df = st->start_floor; dw2 = st->start_w; dl2 = st->start_l;
-                    if (is_valid_position(maze, df, dw2, dl2)) enqueue_if_valid(queue, &q_tail, visited, df, dw2, dl2);
+                    if (is_valid_position(layout, df, dw2, dl2)) enqueue_if_valid(queue, &q_tail, visited, df, dw2, dl2);
                 }
             }
         }
 
         // Pole edge: if this cell has a pole start at this floor/coord, allow sliding to end
-        for (int p = 0; p < num_poles; p++) {
+        for (int p = layout->cells[cf][cw][cl].pole_start; p != -1 && p < num_poles; p++) {
             if (poles[p].start_floor == cf && poles[p].w == cw && poles[p].l == cl) {
                 int df = poles[p].end_floor;
                 int dw2 = poles[p].w;
                 int dl2 = poles[p].l;
-                if (is_valid_position(maze, df, dw2, dl2)) enqueue_if_valid(queue, &q_tail, visited, df, dw2, dl2);
+                if (is_valid_position(layout, df, dw2, dl2)) enqueue_if_valid(queue, &q_tail, visited, df, dw2, dl2);
             }
         }
     }
@@ -668,20 +867,50 @@ int is_flag_reachable(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH],
 }
 
 // Periodically update stair directions to add dynamic gameplay
-void update_stair_directions(Stair stairs[], int num_stairs) {
-    static int total_rounds = 0;
-    total_rounds++;
-    
-    if (total_rounds % 5 == 0) {
+// Called once at the start of every round; returns 1 if this round re-rolled the directions
+// `epoch` (may be NULL) is bumped only if a re-roll changed at least one direction
+int update_stair_directions(Stair stairs[], int num_stairs, int round_number, StairEpoch *epoch) {
+    if (round_number % STAIR_REROLL_ROUNDS == 0) {
+        int changed[MAX_STAIRS], num_changed = 0;
         for (int stair_idx = 0; stair_idx < num_stairs; stair_idx++) {
-            stairs[stair_idx].direction_type = rand() % 3; // Random between up, down, bidirectional
+            int direction_type = game_rand() % 3; // Random between up, down, bidirectional
+            if (stairs[stair_idx].direction_type != direction_type) changed[num_changed++] = stair_idx;
+            stairs[stair_idx].direction_type = direction_type;
         }
-        printf("Stair directions updated after 5 rounds.\n");
+        if (epoch) stair_epoch_bump(epoch, changed, num_changed);
+        GAME_PRINT("Stair directions updated after 5 rounds.\n");
+        return 1;
+    }
+    return 0;
+}
+
+void stair_epoch_init(StairEpoch *epoch) {
+    memset(epoch, 0, sizeof(*epoch));
+}
+
+// Start a new epoch in which `changed` stairs have new directions; nothing happens if none did
+void stair_epoch_bump(StairEpoch *epoch, const int changed[], int num_changed) {
+    if (num_changed == 0) return;
+    epoch->epoch++;
+    epoch->num_changed = num_changed;
+    for (int i = 0; i < num_changed; i++) {
+        epoch->changed[i] = changed[i];
+        epoch->changed_at[changed[i]] = epoch->epoch;
+    }
+}
+
+// List the stairs whose direction changed after epoch `since`; returns how many
+int stair_epoch_changed_since(const StairEpoch *epoch, int num_stairs, unsigned int since, int changed[]) {
+    int count = 0;
+    if (epoch->epoch == since) return 0;
+    for (int i = 0; i < num_stairs; i++) {
+        if (epoch->changed_at[i] > since) changed[count++] = i;
     }
+    return count;
 }
 
 // Apply movement bonuses when player lands on bonus cells
-void apply_movement_bonus(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH], int player_id) {
+void apply_movement_bonus(Player *player, Maze *maze, int player_id) {
     int current_floor = player->pos[0];
     int current_width = player->pos[1];
     int current_length = player->pos[2];
@@ -691,58 +920,56 @@ void apply_movement_bonus(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLO
         return;
     }
     
-    int bonus_type = maze[current_floor][current_width][current_length].movement_bonus_type;
+    int bonus_type = maze_bonus_type(maze, current_floor, current_width, current_length);
     if (bonus_type == BONUS_NONE) return; // No bonus at this cell
     
-    char player_letter = 'A' + player_id;
     int old_movement_points = player->movement_points;
     
     switch (bonus_type) {
         case BONUS_ADD_1:
             player->movement_points += 1;
-            printf("%c lands on a movement bonus cell and gains 1 movement point! (%d -> %d)\n", 
-                   player_letter, old_movement_points, player->movement_points);
+            GAME_PRINT("%s lands on a movement bonus cell and gains 1 movement point! (%d -> %d)\n", 
+                   get_player_name(player_id), old_movement_points, player->movement_points);
             break;
         case BONUS_ADD_2:
             player->movement_points += 2;
-            printf("%c lands on a movement bonus cell and gains 2 movement points! (%d -> %d)\n", 
-                   player_letter, old_movement_points, player->movement_points);
+            GAME_PRINT("%s lands on a movement bonus cell and gains 2 movement points! (%d -> %d)\n", 
+                   get_player_name(player_id), old_movement_points, player->movement_points);
             break;
         case BONUS_ADD_3:
             player->movement_points += 3;
-            printf("%c lands on a movement bonus cell and gains 3 movement points! (%d -> %d)\n", 
-                   player_letter, old_movement_points, player->movement_points);
+            GAME_PRINT("%s lands on a movement bonus cell and gains 3 movement points! (%d -> %d)\n", 
+                   get_player_name(player_id), old_movement_points, player->movement_points);
             break;
         case BONUS_ADD_4:
             player->movement_points += 4;
-            printf("%c lands on a movement bonus cell and gains 4 movement points! (%d -> %d)\n", 
-                   player_letter, old_movement_points, player->movement_points);
+            GAME_PRINT("%s lands on a movement bonus cell and gains 4 movement points! (%d -> %d)\n", 
+                   get_player_name(player_id), old_movement_points, player->movement_points);
             break;
         case BONUS_ADD_5:
             player->movement_points += 5;
-            printf("%c lands on a movement bonus cell and gains 5 movement points! (%d -> %d)\n", 
-                   player_letter, old_movement_points, player->movement_points);
+            GAME_PRINT("%s lands on a movement bonus cell and gains 5 movement points! (%d -> %d)\n", 
+                   get_player_name(player_id), old_movement_points, player->movement_points);
             break;
         case BONUS_MULTIPLY_2:
             player->movement_points *= 2;
-            printf("%c lands on a movement bonus cell and doubles movement points! (%d -> %d)\n", 
-                   player_letter, old_movement_points, player->movement_points);
+            GAME_PRINT("%s lands on a movement bonus cell and doubles movement points! (%d -> %d)\n", 
+                   get_player_name(player_id), old_movement_points, player->movement_points);
             break;
         case BONUS_MULTIPLY_3:
             player->movement_points *= 3;
-            printf("%c lands on a movement bonus cell and triples movement points! (%d -> %d)\n", 
-                   player_letter, old_movement_points, player->movement_points);
+            GAME_PRINT("%s lands on a movement bonus cell and triples movement points! (%d -> %d)\n", 
+                   get_player_name(player_id), old_movement_points, player->movement_points);
             break;
     }
     
     // Clear the bonus after use (one-time bonus per cell)
-    maze[current_floor][current_width][current_length].movement_bonus_type = BONUS_NONE;
+    maze_use_bonus(maze, current_floor, current_width, current_length);
 }
 
 // Transport player to Bawana when movement points are depleted
 void reset_to_bawana(Player *player, int player_id) {
-    char player_letter = 'A' + player_id;
-    printf("%c movement points are depleted and requires replenishment. Transporting to Bawana.\n", player_letter);
+    GAME_PRINT("%s movement points are depleted and requires replenishment. Transporting to Bawana.\n", get_player_name(player_id));
     
     // Place player randomly in one of the Bawana interior cells
     int bawana_interior_cells[12][2] = {
@@ -751,7 +978,7 @@ void reset_to_bawana(Player *player, int player_id) {
         {8,21}, {8,22}, {8,23}, {8,24}
     };
     
-    int random_cell_idx = rand() % 12;
+    int random_cell_idx = game_rand() % 12;
     player->pos[0] = 0;
     player->pos[1] = bawana_interior_cells[random_cell_idx][0];
     player->pos[2] = bawana_interior_cells[random_cell_idx][1];
@@ -777,24 +1004,48 @@ const char* get_blockage_reason_description(int blocking_reason) {
     }
 }
 
-// Initialize the entire 3D maze structure with default values
-void initialize_maze(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH]) {
-    // First pass: set all cells to invalid/empty state
-    for (int current_floor = 0; current_floor < NUM_FLOORS; current_floor++) {
-        for (int width_idx = 0; width_idx < FLOOR_WIDTH; width_idx++) {
-            for (int length_idx = 0; length_idx < FLOOR_LENGTH; length_idx++) {
-                // Start with everything disabled/empty
-                maze[current_floor][width_idx][length_idx].is_valid = 0;
-                maze[current_floor][width_idx][length_idx].is_starting_area = 0;
-                maze[current_floor][width_idx][length_idx].has_wall = 0;
-                maze[current_floor][width_idx][length_idx].bawana_cell_type = -1; // -1 means not a Bawana cell
-                maze[current_floor][width_idx][length_idx].is_blocked_by_stair = 0;
-                maze[current_floor][width_idx][length_idx].is_bawana_entrance = 0;
-                maze[current_floor][width_idx][length_idx].consumable_value = 0;
-                maze[current_floor][width_idx][length_idx].movement_bonus_type = BONUS_NONE;
-            }
-        }
+// Default stairs, poles and walls, used when no config files are given
+static const Stair default_stairs[DEFAULT_NUM_STAIRS] = {
+    {0, 5, 10, 1, 5, 10, STAIR_BIDIRECTIONAL},  // Connects floor 0 and 1 at position [5,10]
+    {1, 4, 12, 2, 4, 12, STAIR_BIDIRECTIONAL}   // Connects floor 1 and 2 at position [4,12]
+};
+
+static const Pole default_poles[DEFAULT_NUM_POLES] = {
+    {2, 0, 5, 24}                               // Floor 2 straight down to floor 0
+};
+
+static const Wall default_walls[DEFAULT_NUM_WALLS] = {
+    {0, 6, 20, 9, 20},                          // Wall around Bawana area - horizontal section
+    {0, 6, 20, 6, 24},                          // Wall around Bawana area - vertical section
+    {1, 0, 2, 8, 2}                             // Wall on floor 1
+};
+
+#ifndef GAME_LAYOUT_GENERATOR
+#include "layout_default.h"
+#endif
+
+// Build the part of the maze every game on one configuration shares: floor
+// shapes, the Bawana walls, cells blocked by skipping stairs, and per-cell
+// wall, stair and pole lookups. Cells whose consumable value or bonus is drawn
+// per game get a value slot, numbered in the order initialize_maze() draws them.
+void maze_layout_build(MazeLayout *layout, Stair stairs[], int num_stairs,
+                       Pole poles[], int num_poles, Wall walls[], int num_walls) {
+    Cell (*maze)[FLOOR_WIDTH][FLOOR_LENGTH] = layout->cells;
+
+#ifndef GAME_LAYOUT_GENERATOR
+    // The default stairs, poles and walls have their layout baked in at compile time
+    if (game_fast_paths_enabled &&
+        num_stairs == DEFAULT_NUM_STAIRS && num_poles == DEFAULT_NUM_POLES && num_walls == DEFAULT_NUM_WALLS &&
+        memcmp(stairs, default_stairs, sizeof(default_stairs)) == 0 &&
+        memcmp(poles, default_poles, sizeof(default_poles)) == 0 &&
+        memcmp(walls, default_walls, sizeof(default_walls)) == 0) {
+        *layout = default_maze_layout;
+        return;
     }
+#endif
+
+    // First pass: set all cells to invalid/empty state
+    memset(layout, 0, sizeof(*layout));
 
     // Floor 0 setup - ground level with starting area
     for (int w = 0; w < FLOOR_WIDTH; w++) {
@@ -843,16 +1094,12 @@ void initialize_maze(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH]) {
     for (int w = 6; w <= 9; w++) {
         for (int l = 20; l <= 24; l++) {
             maze[0][w][l].is_valid = 1;
-            maze[0][w][l].consumable_value = 0; // Bawana doesn't cost movement points
-            maze[0][w][l].movement_bonus_type = BONUS_NONE; // No bonuses in Bawana
         }
     }
 
     // Special entrance cell for Bawana
     maze[0][9][19].is_valid = 1;
     maze[0][9][19].is_bawana_entrance = 1;
-    maze[0][9][19].consumable_value = 0;
-    maze[0][9][19].movement_bonus_type = BONUS_NONE;
 
     // Build walls around Bawana area
     // Horizontal wall across the top
@@ -864,14 +1111,184 @@ void initialize_maze(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH]) {
         maze[0][6][l].has_wall = 1;
     }
 
+    // Rule 10: eligible cells (excluding starting area and Bawana) get a value slot;
+    // Bawana doesn't cost movement points and has no bonuses
+    for (int floor_num = 0; floor_num < NUM_FLOORS; floor_num++) {
+        for (int w = 0; w < FLOOR_WIDTH; w++) {
+            for (int l = 0; l < FLOOR_LENGTH; l++) {
+                maze[floor_num][w][l].value_slot = -1;
+                // Must be a valid maze cell
+                if (!maze[floor_num][w][l].is_valid) continue;
+                // Skip starting area
+                if (maze[floor_num][w][l].is_starting_area) continue;
+                // Skip Bawana area and entrance
+                if ((floor_num == 0 && w >= 6 && w <= 9 && l >= 20 && l <= 24) || 
+                    maze[floor_num][w][l].is_bawana_entrance) {
+                        continue;
+                    }
+                maze[floor_num][w][l].value_slot = layout->num_value_slots++;
+            }
+        }
+    }
+
+    block_skipping_stair_cells(layout, stairs, num_stairs);
+
+    // Index walls, stairs and poles by cell so a move never scans the lists. The fast
+    // path marks the cells along each wall and at each stair and pole instead of asking
+    // is_wall_blocking(), find_all_stairs_at() and find_pole_at() about every cell,
+    // which was most of the cost of a build (validate.c builds one per config checked).
+    if (game_fast_paths_enabled) {
+        for (int i = 0; i < num_walls; i++) {
+            const Wall *wall = &walls[i];
+            if (wall->floor < 0 || wall->floor >= NUM_FLOORS) continue;
+            if (wall->start_w == wall->end_w) {
+                // Blocks (w, l) <-> (w + 1, l) for l along the wall
+                int w = wall->start_w;
+                int lo = wall->start_l < wall->end_l ? wall->start_l : wall->end_l;
+                int hi = wall->start_l > wall->end_l ? wall->start_l : wall->end_l;
+                for (int l = lo < 0 ? 0 : lo; l <= hi && l < FLOOR_LENGTH; l++) {
+                    if (w >= 0 && w < FLOOR_WIDTH) maze[wall->floor][w][l].wall_mask |= 1 << DIR_EAST;
+                    if (w + 1 >= 0 && w + 1 < FLOOR_WIDTH) maze[wall->floor][w + 1][l].wall_mask |= 1 << DIR_WEST;
+                }
+            }
+            if (wall->start_l == wall->end_l) {
+                // Blocks (w, l) <-> (w, l + 1) for w along the wall
+                int l = wall->start_l;
+                int lo = wall->start_w < wall->end_w ? wall->start_w : wall->end_w;
+                int hi = wall->start_w > wall->end_w ? wall->start_w : wall->end_w;
+                for (int w = lo < 0 ? 0 : lo; w <= hi && w < FLOOR_WIDTH; w++) {
+                    if (l >= 0 && l < FLOOR_LENGTH) maze[wall->floor][w][l].wall_mask |= 1 << DIR_SOUTH;
+                    if (l + 1 >= 0 && l + 1 < FLOOR_LENGTH) maze[wall->floor][w][l + 1].wall_mask |= 1 << DIR_NORTH;
+                }
+            }
+        }
+        for (int i = 0; i < num_stairs; i++) {
+            const Stair *s = &stairs[i];
+            if (s->start_floor >= 0 && s->start_floor < NUM_FLOORS && s->start_w >= 0 && s->start_w < FLOOR_WIDTH &&
+                s->start_l >= 0 && s->start_l < FLOOR_LENGTH) {
+                maze[s->start_floor][s->start_w][s->start_l].stair_mask |= 1 << i;
+            }
+            if (s->end_floor >= 0 && s->end_floor < NUM_FLOORS && s->end_w >= 0 && s->end_w < FLOOR_WIDTH &&
+                s->end_l >= 0 && s->end_l < FLOOR_LENGTH) {
+                maze[s->end_floor][s->end_w][s->end_l].stair_mask |= 1 << i;
+            }
+        }
+        for (int floor_num = 0; floor_num < NUM_FLOORS; floor_num++) {
+            for (int w = 0; w < FLOOR_WIDTH; w++) {
+                for (int l = 0; l < FLOOR_LENGTH; l++) maze[floor_num][w][l].pole = maze[floor_num][w][l].pole_start = -1;
+            }
+        }
+        // Last pole first, so the lowest index wins a cell as in find_pole_at()
+        for (int p = num_poles - 1; p >= 0; p--) {
+            const Pole *pole = &poles[p];
+            if (pole->w < 0 || pole->w >= FLOOR_WIDTH || pole->l < 0 || pole->l >= FLOOR_LENGTH) continue;
+            int low = pole->start_floor < pole->end_floor ? pole->start_floor : pole->end_floor;
+            int high = pole->start_floor > pole->end_floor ? pole->start_floor : pole->end_floor;
+            for (int floor_num = low < 0 ? 0 : low; floor_num <= high && floor_num < NUM_FLOORS; floor_num++) {
+                maze[floor_num][pole->w][pole->l].pole = (signed char)p;
+            }
+            if (pole->start_floor >= 0 && pole->start_floor < NUM_FLOORS) {
+                maze[pole->start_floor][pole->w][pole->l].pole_start = (signed char)p;
+            }
+        }
+    } else {
+        for (int floor_num = 0; floor_num < NUM_FLOORS; floor_num++) {
+            for (int w = 0; w < FLOOR_WIDTH; w++) {
+                for (int l = 0; l < FLOOR_LENGTH; l++) {
+                    Cell *cell = &maze[floor_num][w][l];
+                    for (int dir = 0; dir < 4; dir++) {
+                        if (is_wall_blocking(floor_num, w, l, w + step_w[dir], l + step_l[dir], walls, num_walls)) {
+                            cell->wall_mask |= 1 << dir;
+                        }
+                    }
+                    int found[MAX_STAIRS];
+                    int stairs_here = find_all_stairs_at(stairs, num_stairs, floor_num, w, l, found);
+                    for (int i = 0; i < stairs_here; i++) {
+                        cell->stair_mask |= 1 << found[i];
+                    }
+                    cell->pole = find_pole_at(poles, num_poles, floor_num, w, l);
+                    cell->pole_start = -1;
+                    for (int p = num_poles - 1; p >= 0; p--) {
+                        if (poles[p].start_floor == floor_num && poles[p].w == w && poles[p].l == l) cell->pole_start = p;
+                    }
+                }
+            }
+        }
+    }
+
+    // Count the plain cells ahead of every cell in every direction. A step is plain when
+    // check_path_validity() lets it through unconditionally and the move does nothing on
+    // arrival but add the consumable cost. The entrance test reads floor 0 on every floor,
+    // like can_enter_bawana_entrance() does. The fast path counts each run once, from its
+    // far end back: a cell's run is one more than the run of the plain cell after it.
+    if (game_fast_paths_enabled) {
+        for (int floor_num = 0; floor_num < NUM_FLOORS; floor_num++) {
+            for (int dir = 0; dir < 4; dir++) {
+                // Visit cells so that the next cell in `dir` is always done first
+                int w_first = step_w[dir] > 0 ? FLOOR_WIDTH - 1 : 0, w_step = step_w[dir] > 0 ? -1 : 1;
+                int l_first = step_l[dir] > 0 ? FLOOR_LENGTH - 1 : 0, l_step = step_l[dir] > 0 ? -1 : 1;
+                for (int i = 0, w = w_first; i < FLOOR_WIDTH; i++, w += w_step) {
+                    for (int j = 0, l = l_first; j < FLOOR_LENGTH; j++, l += l_step) {
+                        int next_w = w + step_w[dir], next_l = l + step_l[dir];
+                        int run = 0;
+                        if (!(maze[floor_num][w][l].wall_mask >> dir & 1) &&
+                            is_valid_position(layout, floor_num, next_w, next_l)) {
+                            const Cell *next = &maze[floor_num][next_w][next_l];
+                            if (!(maze[0][next_w][next_l].is_bawana_entrance || next->stair_mask ||
+                                  next->pole != -1 || next->pole_start != -1 ||
+                                  (floor_num == 0 && next_w >= 6 && next_w <= 9 && next_l >= 20 && next_l <= 24))) {
+                                run = 1 + next->plain_run[dir];
+                            }
+                        }
+                        maze[floor_num][w][l].plain_run[dir] = (unsigned char)run;
+                    }
+                }
+            }
+        }
+        return;
+    }
+    for (int floor_num = 0; floor_num < NUM_FLOORS; floor_num++) {
+        for (int w = 0; w < FLOOR_WIDTH; w++) {
+            for (int l = 0; l < FLOOR_LENGTH; l++) {
+                for (int dir = 0; dir < 4; dir++) {
+                    int run = 0, cur_w = w, cur_l = l;
+                    while (!(maze[floor_num][cur_w][cur_l].wall_mask >> dir & 1)) {
+                        int next_w = cur_w + step_w[dir], next_l = cur_l + step_l[dir];
+                        if (!is_valid_position(layout, floor_num, next_w, next_l)) break;
+                        const Cell *next = &maze[floor_num][next_w][next_l];
+                        if (maze[0][next_w][next_l].is_bawana_entrance || next->stair_mask ||
+                            next->pole != -1 || next->pole_start != -1) break;
+                        if (floor_num == 0 && next_w >= 6 && next_w <= 9 && next_l >= 20 && next_l <= 24) break;
+                        run++;
+                        cur_w = next_w;
+                        cur_l = next_l;
+                    }
+                    maze[floor_num][w][l].plain_run[dir] = (unsigned char)run;
+                }
+            }
+        }
+    }
+}
+
+// Set up one game's maze on a shared layout: assign the Bawana effects and
+// draw the consumable values and movement bonuses into the game's overlay
+void initialize_maze(Maze *maze, const MazeLayout *layout) {
+    // Zero values, no bonuses used, -1 (not a Bawana cell) everywhere before the draws
+    static const MazeOverlay blank_overlay = {
+        .bawana_type = { {-1, -1, -1, -1, -1}, {-1, -1, -1, -1, -1}, {-1, -1, -1, -1, -1}, {-1, -1, -1, -1, -1} }
+    };
+    MazeOverlay *overlay = &maze->overlay;
+    maze->layout = layout;
+    *overlay = blank_overlay;
+
     // Randomly assign special effects to Bawana interior cells
-    int bawana_interior_positions[12][2] = {
+    static const int bawana_interior_positions[12][2] = {
         {6,21}, {6,22}, {6,23}, {6,24},
         {7,21}, {7,22}, {7,23}, {7,24},
         {8,21}, {8,22}, {8,23}, {8,24}
     };
 
-    int available_effects[] = {BA_FOOD_POISONING, BA_DISORIENTED, BA_TRIGGERED, BA_HAPPY};
+    static const int available_effects[] = {BA_FOOD_POISONING, BA_DISORIENTED, BA_TRIGGERED, BA_HAPPY};
     int cell_assignment_tracker[12] = {0}; // 0 = unassigned, 1 = assigned
 
     // Assign 2 cells to each of the 4 effect types
@@ -880,12 +1297,12 @@ void initialize_maze(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH]) {
             int random_cell_idx;
             // Find an unassigned cell
             do {
-                random_cell_idx = rand() % 12;
+                random_cell_idx = game_rand() % 12;
             } while (cell_assignment_tracker[random_cell_idx]);
             
             int cell_w = bawana_interior_positions[random_cell_idx][0];
             int cell_l = bawana_interior_positions[random_cell_idx][1];
-            maze[0][cell_w][cell_l].bawana_cell_type = available_effects[effect_type];
+            overlay->bawana_type[cell_w - 6][cell_l - 20] = available_effects[effect_type];
             cell_assignment_tracker[random_cell_idx] = 1;
         }
     }
@@ -895,224 +1312,210 @@ void initialize_maze(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH]) {
         if (!cell_assignment_tracker[i]) {
             int cell_w = bawana_interior_positions[i][0];
             int cell_l = bawana_interior_positions[i][1];
-            maze[0][cell_w][cell_l].bawana_cell_type = BA_RANDOM_MP;
+            overlay->bawana_type[cell_w - 6][cell_l - 20] = BA_RANDOM_MP;
         }
     }
 
     // Rule 10: Distribute consumable values and movement bonuses across valid cells
-    // This creates variety in the maze - some cells cost MP, others give bonuses
-    
-    // Collect all eligible cells (excluding starting area and Bawana)
-    int eligible_cells[1000][3]; // Store [floor, w, l] for each valid cell
-    int total_eligible = 0;
-    
-    for (int floor_num = 0; floor_num < NUM_FLOORS; floor_num++) {
-        for (int w = 0; w < FLOOR_WIDTH; w++) {
-            for (int l = 0; l < FLOOR_LENGTH; l++) {
-                // Must be a valid maze cell
-                if (!maze[floor_num][w][l].is_valid) continue;
-                // Skip starting area
-                if (maze[floor_num][w][l].is_starting_area) continue;
-                // Skip Bawana area and entrance
-                if ((floor_num == 0 && w >= 6 && w <= 9 && l >= 20 && l <= 24) || 
-                    maze[floor_num][w][l].is_bawana_entrance) {
-                        continue;
-                    }
-                
-                eligible_cells[total_eligible][0] = floor_num;
-                eligible_cells[total_eligible][1] = w;
-                eligible_cells[total_eligible][2] = l;
-                total_eligible++;
-            }
-        }
-    }
-    
-    
-    // Now distribute according to the specified percentages
-    int cell_counter = 0;
+    // This creates variety in the maze - some cells cost MP, others give bonuses.
+    // Slots are numbered in floor, width, length order, so slot i is the i-th eligible cell.
+    int total_eligible = layout->num_value_slots;
     
     // 25% get zero consumable value (no cost to move through)
     int zero_value_count = (total_eligible * 25) / 100;
-    for (int i = 0; i < zero_value_count && cell_counter < total_eligible; i++) {
-        int floor_num = eligible_cells[cell_counter][0];
-        int w = eligible_cells[cell_counter][1];
-        int l = eligible_cells[cell_counter][2];
-        maze[floor_num][w][l].consumable_value = 0;
-        maze[floor_num][w][l].movement_bonus_type = BONUS_NONE;
-        cell_counter++;
-    }
+    int cell_counter = zero_value_count;
     
     // 35% get consumable value 1-4 (costs MP to move through)
     int consumable_count = (total_eligible * 35) / 100;
     for (int i = 0; i < consumable_count && cell_counter < total_eligible; i++) {
-        int floor_num = eligible_cells[cell_counter][0];
-        int w = eligible_cells[cell_counter][1];
-        int l = eligible_cells[cell_counter][2];
-        maze[floor_num][w][l].consumable_value = (rand() % 4) + 1; // Random 1-4
-        maze[floor_num][w][l].movement_bonus_type = BONUS_NONE;
+        overlay->cell_value[cell_counter] = (game_rand() % 4) + 1; // Random 1-4
         cell_counter++;
     }
     
     // 25% get small movement bonuses (add 1-2 MP)
     int small_bonus_count = (total_eligible * 25) / 100;
     for (int i = 0; i < small_bonus_count && cell_counter < total_eligible; i++) {
-        int floor_num = eligible_cells[cell_counter][0];
-        int w = eligible_cells[cell_counter][1];
-        int l = eligible_cells[cell_counter][2];
-        maze[floor_num][w][l].consumable_value = 0;
-        maze[floor_num][w][l].movement_bonus_type = (rand() % 2) + 1; // BONUS_ADD_1 or BONUS_ADD_2
+        overlay->cell_value[cell_counter] = ((game_rand() % 2) + 1) << 4; // BONUS_ADD_1 or BONUS_ADD_2
         cell_counter++;
     }
     
     // 10% get medium movement bonuses (add 3-5 MP)
     int medium_bonus_count = (total_eligible * 10) / 100;
     for (int i = 0; i < medium_bonus_count && cell_counter < total_eligible; i++) {
-        int floor_num = eligible_cells[cell_counter][0];
-        int w = eligible_cells[cell_counter][1];
-        int l = eligible_cells[cell_counter][2];
-        maze[floor_num][w][l].consumable_value = 0;
-        maze[floor_num][w][l].movement_bonus_type = (rand() % 3) + 3; // BONUS_ADD_3, 4, or 5
+        overlay->cell_value[cell_counter] = ((game_rand() % 3) + 3) << 4; // BONUS_ADD_3, 4, or 5
         cell_counter++;
     }
     
     // 5% get multiplier bonuses (multiply by 2-3)
     int multiplier_count = (total_eligible * 5) / 100;
     for (int i = 0; i < multiplier_count && cell_counter < total_eligible; i++) {
-        int floor_num = eligible_cells[cell_counter][0];
-        int w = eligible_cells[cell_counter][1];
-        int l = eligible_cells[cell_counter][2];
-        maze[floor_num][w][l].consumable_value = 0;
-        maze[floor_num][w][l].movement_bonus_type = (rand() % 2) + 6; // BONUS_MULTIPLY_2 or 3
+        overlay->cell_value[cell_counter] = ((game_rand() % 2) + 6) << 4; // BONUS_MULTIPLY_2 or 3
         cell_counter++;
     }
     
-    // Any remaining cells get zero value (due to rounding in percentages)
-    while (cell_counter < total_eligible) {
-        int floor_num = eligible_cells[cell_counter][0];
-        int w = eligible_cells[cell_counter][1];
-        int l = eligible_cells[cell_counter][2];
-        maze[floor_num][w][l].consumable_value = 0;
-        maze[floor_num][w][l].movement_bonus_type = BONUS_NONE;
-        cell_counter++;
+    // Any remaining cells keep zero value (due to rounding in percentages)
+
+    // Row and column indexes of the values just drawn (blank_overlay left them zero)
+    for (int floor_num = 0; floor_num < NUM_FLOORS; floor_num++) {
+        for (int w = 0; w < FLOOR_WIDTH; w++) {
+            for (int l = 0; l < FLOOR_LENGTH; l++) {
+                int slot = layout->cells[floor_num][w][l].value_slot;
+                int value = slot < 0 ? 0 : overlay->cell_value[slot];
+                overlay->cost_along_l[floor_num][w][l + 1] = overlay->cost_along_l[floor_num][w][l] + (value & 0x0F);
+                overlay->cost_along_w[floor_num][l][w + 1] = overlay->cost_along_w[floor_num][l][w] + (value & 0x0F);
+                if (value >> 4) {
+                    overlay->bonus_along_l[floor_num][w] |= 1u << l;
+                    overlay->bonus_along_w[floor_num][l] |= 1u << w;
+                }
+            }
+        }
+    }
+}
+
+// Does a wall stop a step from this cell in `direction`?
+int maze_wall_blocks(const MazeLayout *layout, int floor, int width_pos, int length_pos, int direction) {
+    return layout->cells[floor][width_pos][length_pos].wall_mask >> direction & 1;
+}
+
+// Same result as find_all_stairs_at() for the stairs the layout was built with
+int maze_stairs_at(const MazeLayout *layout, int floor, int width_pos, int length_pos, int found_stair_indices[]) {
+    int stairs_found = 0;
+    for (unsigned mask = layout->cells[floor][width_pos][length_pos].stair_mask; mask; mask &= mask - 1) {
+        found_stair_indices[stairs_found++] = __builtin_ctz(mask);
+    }
+    return stairs_found;
+}
+
+// Same result as find_pole_at() for the poles the layout was built with
+int maze_pole_at(const MazeLayout *layout, int floor, int width_pos, int length_pos) {
+    return layout->cells[floor][width_pos][length_pos].pole;
+}
+
+int maze_consumable_value(const Maze *maze, int floor, int width_pos, int length_pos) {
+    int slot = maze->layout->cells[floor][width_pos][length_pos].value_slot;
+    return slot < 0 ? 0 : maze->overlay.cell_value[slot] & 0x0F;
+}
+
+// The bonus still waiting on a cell (BONUS_NONE once collected)
+int maze_bonus_type(const Maze *maze, int floor, int width_pos, int length_pos) {
+    int slot = maze->layout->cells[floor][width_pos][length_pos].value_slot;
+    if (slot < 0 || (maze->overlay.bonus_used[slot >> 6] >> (slot & 63) & 1)) return BONUS_NONE;
+    return maze->overlay.cell_value[slot] >> 4;
+}
+
+void maze_use_bonus(Maze *maze, int floor, int width_pos, int length_pos) {
+    int slot = maze->layout->cells[floor][width_pos][length_pos].value_slot;
+    if (slot < 0) return;
+    maze->overlay.bonus_used[slot >> 6] |= 1ULL << (slot & 63);
+    maze->overlay.bonus_along_l[floor][width_pos] &= ~(1u << length_pos);
+    maze->overlay.bonus_along_w[floor][length_pos] &= (uint16_t)~(1u << width_pos);
+}
+
+// Bawana effect of a cell, -1 outside the Bawana interior
+int maze_bawana_type(const Maze *maze, int floor, int width_pos, int length_pos) {
+    if (floor != 0 || width_pos < 6 || width_pos > 9 || length_pos < 20 || length_pos > 24) return -1;
+    return maze->overlay.bawana_type[width_pos - 6][length_pos - 20];
+}
+
+// Steps a move can take from this cell before anything but consumable cost happens:
+// the layout's plain run, cut short before the next cell whose bonus is still waiting
+int maze_plain_run(const Maze *maze, int floor, int width_pos, int length_pos, int direction) {
+    int run = maze->layout->cells[floor][width_pos][length_pos].plain_run[direction];
+    if (run == 0) return 0;
+    int bonus_distance;
+    switch (direction) {
+        case DIR_NORTH: {
+            uint32_t ahead = maze->overlay.bonus_along_l[floor][width_pos] & ((1u << length_pos) - 1);
+            bonus_distance = ahead ? length_pos - (31 - __builtin_clz(ahead)) : FLOOR_LENGTH;
+            break;
+        }
+        case DIR_SOUTH: {
+            uint32_t ahead = maze->overlay.bonus_along_l[floor][width_pos] >> (length_pos + 1);
+            bonus_distance = ahead ? __builtin_ctz(ahead) + 1 : FLOOR_LENGTH;
+            break;
+        }
+        case DIR_WEST: {
+            uint32_t ahead = maze->overlay.bonus_along_w[floor][length_pos] & ((1u << width_pos) - 1);
+            bonus_distance = ahead ? width_pos - (31 - __builtin_clz(ahead)) : FLOOR_WIDTH;
+            break;
+        }
+        default: {
+            uint32_t ahead = (uint32_t)maze->overlay.bonus_along_w[floor][length_pos] >> (width_pos + 1);
+            bonus_distance = ahead ? __builtin_ctz(ahead) + 1 : FLOOR_WIDTH;
+            break;
+        }
+    }
+    return run < bonus_distance - 1 ? run : bonus_distance - 1;
+}
+
+// Total consumable value of the `steps` cells after this one in `direction`
+int maze_ray_cost(const Maze *maze, int floor, int width_pos, int length_pos, int direction, int steps) {
+    switch (direction) {
+        case DIR_NORTH: return maze->overlay.cost_along_l[floor][width_pos][length_pos] -
+                               maze->overlay.cost_along_l[floor][width_pos][length_pos - steps];
+        case DIR_SOUTH: return maze->overlay.cost_along_l[floor][width_pos][length_pos + steps + 1] -
+                               maze->overlay.cost_along_l[floor][width_pos][length_pos + 1];
+        case DIR_WEST:  return maze->overlay.cost_along_w[floor][length_pos][width_pos] -
+                               maze->overlay.cost_along_w[floor][length_pos][width_pos - steps];
+        default:        return maze->overlay.cost_along_w[floor][length_pos][width_pos + steps + 1] -
+                               maze->overlay.cost_along_w[floor][length_pos][width_pos + 1];
     }
 }
 
 // Set up initial player positions and states
-void initialize_players(Player players[3]) {
-    // Player A starts at position [0,6,12] facing North
-    players[PLAYER_A].pos[0] = 0; 
-    players[PLAYER_A].pos[1] = 6; 
-    players[PLAYER_A].pos[2] = 12;
-    players[PLAYER_A].in_game = 0; // Starts outside maze
-    players[PLAYER_A].direction = DIR_NORTH;
-    players[PLAYER_A].movement_points = 100;
-    players[PLAYER_A].roll_count = 0;
-    players[PLAYER_A].captured = 0;
-    players[PLAYER_A].bawana_effect = EFFECT_NONE;
-    players[PLAYER_A].bawana_turns_left = 0;
-    players[PLAYER_A].bawana_random_mp = 0;
-    players[PLAYER_A].just_entered = 0;
-
-    // Player B starts at position [0,9,8] facing West
-    players[PLAYER_B].pos[0] = 0; 
-    players[PLAYER_B].pos[1] = 9; 
-    players[PLAYER_B].pos[2] = 8;
-    players[PLAYER_B].in_game = 0;
-    players[PLAYER_B].direction = DIR_WEST;
-    players[PLAYER_B].movement_points = 100;
-    players[PLAYER_B].roll_count = 0;
-    players[PLAYER_B].captured = 0;
-    players[PLAYER_B].bawana_effect = EFFECT_NONE;
-    players[PLAYER_B].bawana_turns_left = 0;
-    players[PLAYER_B].bawana_random_mp = 0;
-    players[PLAYER_B].just_entered = 0;
-
-    // Player C starts at position [0,9,16] facing East
-    players[PLAYER_C].pos[0] = 0; 
-    players[PLAYER_C].pos[1] = 9; 
-    players[PLAYER_C].pos[2] = 16;
-    players[PLAYER_C].in_game = 0;
-    players[PLAYER_C].direction = DIR_EAST;
-    players[PLAYER_C].movement_points = 100;
-    players[PLAYER_C].roll_count = 0;
-    players[PLAYER_C].captured = 0;
-    players[PLAYER_C].bawana_effect = EFFECT_NONE;
-    players[PLAYER_C].bawana_turns_left = 0;
-    players[PLAYER_C].bawana_random_mp = 0;
-    players[PLAYER_C].just_entered = 0;
+// `spawns` may be NULL to use the default starting areas
+void initialize_players(Player players[], int num_players, const PlayerSpawn spawns[]) {
+    for (int player_id = 0; player_id < num_players; player_id++) {
+        const PlayerSpawn *spawn = spawns ? &spawns[player_id] : &default_spawns[player_id % DEFAULT_NUM_PLAYERS];
+        Player *player = &players[player_id];
+
+        memcpy(player->pos, spawn->start_pos, sizeof(player->pos));
+        memcpy(player->entry_pos, spawn->entry_pos, sizeof(player->entry_pos));
+        player->in_game = 0; // Starts outside maze
+        player->direction = spawn->direction;
+        player->movement_points = 100;
+        player->roll_count = 0;
+        player->captured = 0;
+        player->bawana_effect = EFFECT_NONE;
+        player->bawana_turns_left = 0;
+        player->bawana_random_mp = 0;
+        player->just_entered = 0;
+        player->occupancy_cell = -1;
+        player->occupancy_prev = -1;
+        player->occupancy_next = -1;
+        player->start_wait = -1;
+    }
 }
 
 // Set up default stair connections between floors
 void initialize_stairs(Stair stairs[], int *num_stairs) {
-    *num_stairs = 2;
-    
-    // First stair: connects floor 0 and 1 at position [5,10]
-    stairs[0].start_floor = 0; 
-    stairs[0].start_w = 5; 
-    stairs[0].start_l = 10;
-    stairs[0].end_floor = 1; 
-    stairs[0].end_w = 5; 
-    stairs[0].end_l = 10;
-    stairs[0].direction_type = STAIR_BIDIRECTIONAL;
-
-    // Second stair: connects floor 1 and 2 at position [4,12]
-    stairs[1].start_floor = 1; 
-    stairs[1].start_w = 4; 
-    stairs[1].start_l = 12;
-    stairs[1].end_floor = 2; 
-    stairs[1].end_w = 4; 
-    stairs[1].end_l = 12;
-    stairs[1].direction_type = STAIR_BIDIRECTIONAL;
+    *num_stairs = DEFAULT_NUM_STAIRS;
+    memcpy(stairs, default_stairs, sizeof(default_stairs));
 }
 
 // Set up default poles for quick descent between floors
 void initialize_poles(Pole poles[], int *num_poles) {
-    *num_poles = 1;
-    
-    // One pole that goes from floor 2 straight down to floor 0
-    poles[0].start_floor = 2;
-    poles[0].end_floor = 0;
-    poles[0].w = 5;
-    poles[0].l = 24;
+    *num_poles = DEFAULT_NUM_POLES;
+    memcpy(poles, default_poles, sizeof(default_poles));
 }
 
 // Set up default wall barriers in the maze
 void initialize_walls(Wall walls[], int *num_walls) {
-    *num_walls = 3;
-    
-    // Wall around Bawana area - horizontal section
-    walls[0].floor = 0; 
-    walls[0].start_w = 6; 
-    walls[0].start_l = 20; 
-    walls[0].end_w = 9; 
-    walls[0].end_l = 20;
-    
-    // Wall around Bawana area - vertical section
-    walls[1].floor = 0; 
-    walls[1].start_w = 6; 
-    walls[1].start_l = 20; 
-    walls[1].end_w = 6; 
-    walls[1].end_l = 24;
-    
-    // Wall on floor 1
-    walls[2].floor = 1; 
-    walls[2].start_w = 0; 
-    walls[2].start_l = 2; 
-    walls[2].end_w = 8; 
-    walls[2].end_l = 2;
+    *num_walls = DEFAULT_NUM_WALLS;
+    memcpy(walls, default_walls, sizeof(default_walls));
 }
 
 // Try to read random seed from file, fallback to current time
 int read_seed_from_file(const char *filename) {
     FILE *seed_file = fopen(filename, "r");
     if (!seed_file) {
-        printf("Warning: Could not open %s. Using default seed.\n", filename);
+        GAME_PRINT("Warning: Could not open %s. Using default seed.\n", filename);
         return time(NULL); // Use current time as seed
     }
     
     int seed_value;
     if (fscanf(seed_file, "%d", &seed_value) != 1) {
-        printf("Warning: Could not read seed from %s. Using default seed.\n", filename);
+        GAME_PRINT("Warning: Could not read seed from %s. Using default seed.\n", filename);
         fclose(seed_file);
         return time(NULL);
     }
@@ -1121,6 +1524,39 @@ int read_seed_from_file(const char *filename) {
     return seed_value;
 }
 
+// Load player spawns from external file; the number of lines sets the player count
+int read_players_from_file(const char *filename, PlayerSpawn spawns[], int *num_players) {
+    FILE *player_file = fopen(filename, "r");
+    if (!player_file) return 0;
+
+    *num_players = 0;
+    char line_buffer[256];
+
+    while (fgets(line_buffer, sizeof(line_buffer), player_file) && *num_players < MAX_PLAYERS) {
+        // Expected format: [start_floor, start_w, start_l, entry_floor, entry_w, entry_l, direction]
+        // Direction: 0 = North, 1 = East, 2 = South, 3 = West
+        PlayerSpawn *spawn = &spawns[*num_players];
+        if (sscanf(line_buffer, "[%d, %d, %d, %d, %d, %d, %d]",
+                   &spawn->start_pos[0], &spawn->start_pos[1], &spawn->start_pos[2],
+                   &spawn->entry_pos[0], &spawn->entry_pos[1], &spawn->entry_pos[2],
+                   &spawn->direction) == 7) {
+            if (spawn->direction < DIR_NORTH || spawn->direction > DIR_WEST) {
+                GAME_PRINT("Warning: Invalid direction %d in %s. Using North.\n", spawn->direction, filename);
+                spawn->direction = DIR_NORTH;
+            }
+            (*num_players)++;
+        }
+    }
+
+    fclose(player_file);
+    if (*num_players < MIN_PLAYERS) {
+        GAME_PRINT("Warning: %s lists fewer than %d players. Using default players.\n", filename, MIN_PLAYERS);
+        return 0;
+    }
+    GAME_PRINT("Loaded %d players from %s\n", *num_players, filename);
+    return 1;
+}
+
 // Load stair configurations from external file
 int read_stairs_from_file(const char *filename, Stair stairs[], int *num_stairs) {
     FILE *stair_file = fopen(filename, "r");
@@ -1144,7 +1580,7 @@ int read_stairs_from_file(const char *filename, Stair stairs[], int *num_stairs)
     }
     
     fclose(stair_file);
-    printf("Loaded %d stairs from %s\n", *num_stairs, filename);
+    GAME_PRINT("Loaded %d stairs from %s\n", *num_stairs, filename);
     return 1;
 }
 
@@ -1168,7 +1604,7 @@ int read_poles_from_file(const char *filename, Pole poles[], int *num_poles) {
     }
     
     fclose(pole_file);
-    printf("Loaded %d poles from %s\n", *num_poles, filename);
+    GAME_PRINT("Loaded %d poles from %s\n", *num_poles, filename);
     return 1;
 }
 
@@ -1193,7 +1629,7 @@ int read_walls_from_file(const char *filename, Wall walls[], int *num_walls) {
     }
     
     fclose(wall_file);
-    printf("Loaded %d walls from %s\n", *num_walls, filename);
+    GAME_PRINT("Loaded %d walls from %s\n", *num_walls, filename);
     return 1;
 }
 
@@ -1206,7 +1642,7 @@ int read_flag_from_file(const char *filename, int flag_position[3]) {
     if (fgets(line_buffer, sizeof(line_buffer), flag_file)) {
         if (sscanf(line_buffer, "[%d, %d, %d]", &flag_position[0], &flag_position[1], &flag_position[2]) == 3) {
             fclose(flag_file);
-            printf("Loaded flag position [%d,%d,%d] from %s\n", flag_position[0], flag_position[1], flag_position[2], filename);
+            GAME_PRINT("Loaded flag position [%d,%d,%d] from %s\n", flag_position[0], flag_position[1], flag_position[2], filename);
             return 1;
         }
     }
@@ -1215,29 +1651,70 @@ int read_flag_from_file(const char *filename, int flag_position[3]) {
     return 0;
 }
 
+// Seed a generator exactly like glibc's srand(): LCG warm-up, then 310 discarded outputs
+void game_rng_seed(GameRng *rng, unsigned int seed) {
+    int r[GAME_RNG_DEGREE];
+    r[0] = (int)(seed == 0 ? 1 : seed);
+    for (int i = 1; i < 31; i++) {
+        long long next = (16807LL * r[i - 1]) % 2147483647;
+        if (next < 0) next += 2147483647;
+        r[i] = (int)next;
+    }
+    for (int i = 31; i < GAME_RNG_DEGREE; i++) {
+        r[i] = r[i - 31];
+    }
+    for (int i = 0; i < GAME_RNG_DEGREE; i++) {
+        rng->state[i] = (unsigned int)r[i];
+    }
+    rng->index = 0;
+    for (int i = 0; i < 310; i++) {
+        game_rng_next(rng);
+    }
+}
+
+// r[i] = r[i-31] + r[i-3]; the low bit is dropped like glibc does
+int game_rng_next(GameRng *rng) {
+    int i = rng->index;
+    unsigned int next = rng->state[(i + GAME_RNG_DEGREE - 31) % GAME_RNG_DEGREE] +
+                        rng->state[(i + GAME_RNG_DEGREE - 3) % GAME_RNG_DEGREE];
+    rng->state[i] = next;
+    rng->index = (i + 1) % GAME_RNG_DEGREE;
+    return (int)(next >> 1);
+}
+
+// Per-thread generator; seeded with 1 like rand() when nobody calls game_srand()
+static _Thread_local GameRng thread_rng;
+static _Thread_local int thread_rng_seeded;
+static _Thread_local GameRng *bound_rng; // A game's own generator while one of its turns runs
+
+void game_srand(unsigned int seed) {
+    game_rng_seed(&thread_rng, seed);
+    thread_rng_seeded = 1;
+}
+
+int game_rand(void) {
+    if (bound_rng) return game_rng_next(bound_rng);
+    if (!thread_rng_seeded) game_srand(1);
+    return game_rng_next(&thread_rng);
+}
+
+void game_rng_bind(GameRng *rng) {
+    bound_rng = rng;
+}
+
 // Roll a 6-sided die for movement
 int roll_movement_dice(void) {
-    return (rand() % 6) + 1;
+    return (game_rand() % 6) + 1;
 }
 
 // Roll a 6-sided die for direction changes
 int roll_direction_dice(void) {
-    return (rand() % 6) + 1;
+    return (game_rand() % 6) + 1;
 }
 
 // Move player from starting area into the maze
-void enter_maze(Player *player, int player_id) {
-    switch (player_id) {
-        case PLAYER_A:
-            player->pos[0] = 0; player->pos[1] = 5; player->pos[2] = 12;
-            break;
-        case PLAYER_B:
-            player->pos[0] = 0; player->pos[1] = 9; player->pos[2] = 7;
-            break;
-        case PLAYER_C:
-            player->pos[0] = 0; player->pos[1] = 9; player->pos[2] = 17;
-            break;
-    }
+void enter_maze(Player *player) {
+    memcpy(player->pos, player->entry_pos, sizeof(player->pos));
     player->in_game = 1;
     player->just_entered = 1;
 }
@@ -1253,21 +1730,21 @@ void enter_maze_like_player_a(Player *player) {
 }
 
 // Check if a position is valid for player movement
-int is_valid_position(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH], int floor, int width_pos, int length_pos) {
+int is_valid_position(const MazeLayout *layout, int floor, int width_pos, int length_pos) {
     // Boundary checks first
     if (floor < 0 || floor >= NUM_FLOORS || width_pos < 0 || width_pos >= FLOOR_WIDTH || length_pos < 0 || length_pos >= FLOOR_LENGTH) {
         return 0;
     }
     
     // Check if cell is blocked by stairs
-    if (maze[floor][width_pos][length_pos].is_blocked_by_stair) return 0;
+    if (layout->cells[floor][width_pos][length_pos].is_blocked_by_stair) return 0;
     
-    return maze[floor][width_pos][length_pos].is_valid;
+    return layout->cells[floor][width_pos][length_pos].is_valid;
 }
 
 // Special rule: Can only enter Bawana entrance with 0 movement points
-int can_enter_bawana_entrance(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH], int new_w, int new_l) {
-    if (maze[0][new_w][new_l].is_bawana_entrance) {
+int can_enter_bawana_entrance(Player *player, const MazeLayout *layout, int new_w, int new_l) {
+    if (layout->cells[0][new_w][new_l].is_bawana_entrance) {
         if (player->movement_points > 0) {
             return 0; // Can't enter with positive MP
         }
@@ -1276,7 +1753,7 @@ int can_enter_bawana_entrance(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH]
 }
 
 // Check if there's a wall blocking movement between two adjacent cells
-int is_wall_blocking(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH], int floor, int from_w, int from_l, int to_w, int to_l, Wall walls[], int num_walls) {
+int is_wall_blocking(int floor, int from_w, int from_l, int to_w, int to_l, Wall walls[], int num_walls) {
     for (int wall_idx = 0; wall_idx < num_walls; wall_idx++) {
         if (walls[wall_idx].floor != floor) continue;
         
@@ -1320,4 +1797,89 @@ int find_all_stairs_at(Stair stairs[], int num_stairs, int floor, int width_pos,
         }
     }
     return stairs_found;
-}
\ No newline at end of file
+}
+
+// Load the config files from `dir`, or the built-in defaults when dir is NULL
+// Missing files fall back to the defaults, the same way main() does
+void game_config_load(GameConfig *config, const char *dir, int num_players) {
+    char path[512];
+
+    snprintf(path, sizeof(path), "%s/stairs.txt", dir ? dir : ".");
+    if (!dir || !read_stairs_from_file(path, config->stairs, &config->num_stairs)) {
+        initialize_stairs(config->stairs, &config->num_stairs);
+    }
+    snprintf(path, sizeof(path), "%s/poles.txt", dir ? dir : ".");
+    if (!dir || !read_poles_from_file(path, config->poles, &config->num_poles)) {
+        initialize_poles(config->poles, &config->num_poles);
+    }
+    snprintf(path, sizeof(path), "%s/walls.txt", dir ? dir : ".");
+    if (!dir || !read_walls_from_file(path, config->walls, &config->num_walls)) {
+        initialize_walls(config->walls, &config->num_walls);
+    }
+    snprintf(path, sizeof(path), "%s/players.txt", dir ? dir : ".");
+    config->spawns_loaded = dir ? read_players_from_file(path, config->spawns, &config->num_players) : 0;
+    if (!config->spawns_loaded) config->num_players = num_players;
+    snprintf(path, sizeof(path), "%s/flag.txt", dir ? dir : ".");
+    config->flag_loaded = dir ? read_flag_from_file(path, config->flag_position) : 0;
+    maze_layout_build(&config->layout, config->stairs, config->num_stairs,
+                      config->poles, config->num_poles, config->walls, config->num_walls);
+}
+
+size_t game_state_size(int num_players) {
+    return sizeof(GameState) + (size_t)num_players * sizeof(Player);
+}
+
+// Allocate and set up a new game; returns NULL if out of memory
+GameState* game_state_create(const GameConfig *config, int num_players, unsigned int seed) {
+    GameState *game = malloc(game_state_size(num_players));
+    if (!game) return NULL;
+    game_state_init(game, config, num_players, seed);
+    return game;
+}
+
+// Set up a game in the same order as main(), so a seed replays the same game interactively
+// Spawns from players.txt are used when the game has no more players than the file lists
+void game_state_init(GameState *game, const GameConfig *config, int num_players, unsigned int seed) {
+    game->config = config;
+    game->num_players = num_players;
+    game->round_number = 1;
+    game->next_player = 0;
+    game->winner = -1;
+    game->fast_start = 0;
+    game->turn.stage = TURN_DONE;
+    game->turn.forced_direction_roll = 0;
+    game->turn.forced_movement_roll = 0;
+
+    game_rng_seed(&game->rng, seed);
+    game_rng_bind(&game->rng);
+    initialize_maze(&game->maze, &config->layout);
+    const PlayerSpawn *spawns = (config->spawns_loaded && num_players <= config->num_players) ? config->spawns : NULL;
+    initialize_players(game->players, num_players, spawns);
+    memcpy(game->stairs, config->stairs, sizeof(game->stairs));
+    game->num_stairs = config->num_stairs;
+    stair_epoch_init(&game->stair_epoch);
+    memcpy(game->flag_position, config->flag_position, sizeof(game->flag_position));
+    resolve_flag_position(game->flag_position, config->flag_loaded, &config->layout, game->stairs,
+                          (Pole *)config->poles, config->num_poles, spawns, num_players);
+    occupancy_clear(&game->occupancy, game->players, num_players);
+    game_rng_bind(NULL);
+}
+
+// Copy a game, paused turn and generator included, into `copy` (game_state_size() bytes
+// for game->num_players). The copy shares the configuration and maze layout and plays on
+// independently; every other part of the state is plain data indexed by player id.
+void game_state_copy(GameState *copy, const GameState *game) {
+    memcpy(copy, game, game_state_size(game->num_players));
+}
+
+// Allocate a copy of a game for what-if play; returns NULL if out of memory
+GameState* game_state_fork(const GameState *game) {
+    GameState *copy = malloc(game_state_size(game->num_players));
+    if (!copy) return NULL;
+    game_state_copy(copy, game);
+    return copy;
+}
+
+void game_state_destroy(GameState *game) {
+    free(game);
+}
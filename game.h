@@ -10,6 +10,7 @@
 #include <string.h>
 #include <time.h>
 #include <math.h>
+#include <stdint.h>
 
 // Basic maze dimensions - these define the 3D structure
 #define NUM_FLOORS      3
@@ -27,6 +28,11 @@
 #define PLAYER_B 1
 #define PLAYER_C 2
 
+// Player count limits (the default game has 3 players, A, B and C)
+#define DEFAULT_NUM_PLAYERS 3
+#define MIN_PLAYERS         2
+#define MAX_PLAYERS         4096
+
 // Movement directions (North decreases length, East increases width)
 #define DIR_NORTH 0
 #define DIR_EAST  1
@@ -52,6 +58,19 @@
 #define EFFECT_TRIGGERED        3
 #define EFFECT_HAPPY            4  // Actually not used as lasting effect
 #define EFFECT_RANDOM_MP        5
+#define NUM_EFFECTS             6
+
+// How each effect is shown, how many of the player's own turns it lasts once set
+// (0 = not lasting), and what is printed with the player's name when it wears off
+typedef struct {
+    const char *name;
+    int duration;
+    const char *recovery;
+} BawanaEffectInfo;
+
+extern const BawanaEffectInfo bawana_effect_info[NUM_EFFECTS];  // Indexed by EFFECT_*
+
+#define STAIR_REROLL_ROUNDS     5  // Stair directions are re-rolled at the start of every fifth round
 
 // Movement bonus types for special cells
 #define BONUS_NONE              0
@@ -73,6 +92,11 @@
 #define MAX_STAIRS  10
 #define MAX_POLES   10
 #define MAX_WALLS   20
+
+// Size of the built-in configuration (initialize_stairs/poles/walls)
+#define DEFAULT_NUM_STAIRS  2
+#define DEFAULT_NUM_POLES   1
+#define DEFAULT_NUM_WALLS   3
 #define MAX_LOOP_HISTORY 100  // For infinite loop detection
 
 // Data structure for stairs connecting different floors
@@ -82,6 +106,18 @@ typedef struct {
     int direction_type;                 // Movement restriction type
 } Stair;
 
+// Version of a game's stair directions, for data derived from them
+// epoch moves only when some direction actually changes, so anything built at
+// epoch E is current while the epoch is still E. changed_at[] holds the epoch
+// each stair last changed at: a cache built at E rebuilds just the stairs with
+// changed_at > E (stair_epoch_changed_since), however many epochs behind it is.
+typedef struct {
+    unsigned int epoch;
+    int num_changed;                    // Stairs that changed in the latest bump
+    int changed[MAX_STAIRS];
+    unsigned int changed_at[MAX_STAIRS];
+} StairEpoch;
+
 // Data structure for poles (slide down from higher to lower floor)
 typedef struct {
     int start_floor;  // Where pole starts (higher floor)
@@ -96,18 +132,52 @@ typedef struct {
     int end_w, end_l;            // Other end of the wall
 } Wall;
 
-// Data structure for individual maze cells
+// Data structure for individual maze cells (the part every game shares, see MazeLayout)
 typedef struct {
-    int is_valid;                // Can players move through this cell?
-    int is_starting_area;        // Is this part of the starting area?
-    int has_wall;               // Does this cell have a wall structure?
-    int bawana_cell_type;       // What Bawana effect does this cell have? (-1 = not Bawana)
-    int is_blocked_by_stair;    // Is movement blocked due to stair skipping?
-    int is_bawana_entrance;     // Special entrance cell for Bawana area
-    int consumable_value;       // How much MP does it cost to move through? (0-4)
-    int movement_bonus_type;    // What movement bonus does this cell provide?
+    unsigned char is_valid;             // Can players move through this cell?
+    unsigned char is_starting_area;     // Is this part of the starting area?
+    unsigned char has_wall;             // Does this cell have a wall structure?
+    unsigned char is_blocked_by_stair;  // Is movement blocked due to stair skipping?
+    unsigned char is_bawana_entrance;   // Special entrance cell for Bawana area
+    unsigned char wall_mask;            // Bit (1 << DIR_*) per direction a wall blocks stepping out of this cell
+    signed char pole;                   // Pole through this cell as find_pole_at() picks it (-1 = none)
+    signed char pole_start;             // First pole starting on this cell (-1 = none)
+    unsigned short stair_mask;          // Bit per stair with an end on this cell
+    short value_slot;                   // Where a game keeps this cell's consumable value and bonus (-1 = none)
+    unsigned char plain_run[4];         // Steps per direction (DIR_*) through plain cells: no wall, invalid cell,
+                                        // Bawana entrance or interior, stair or pole on the way
 } Cell;
 
+#define MAZE_MAX_VALUE_SLOTS  512   // Cells with a per-game consumable value or bonus (479 in this layout)
+
+// The maze as every game on one configuration sees it: floor shapes, walls,
+// stair blocking and where the stairs and poles are. Built once and shared
+// read-only by any number of games.
+typedef struct {
+    Cell cells[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH];
+    int num_value_slots;
+} MazeLayout;
+
+// What one game changes on top of the shared layout: 2480 bytes, 1875 of them the
+// row and column indexes at the end (a 3-player GameState is about 6.4 KB)
+typedef struct {
+    unsigned char cell_value[MAZE_MAX_VALUE_SLOTS];  // Consumable value (low 4 bits) and bonus type (high 4 bits) per slot
+    uint64_t bonus_used[MAZE_MAX_VALUE_SLOTS / 64];  // Bonuses already collected (one-time per cell), bit per slot
+    signed char bawana_type[4][5];                   // BA_* type of Bawana area cell [w - 6][l - 20] (-1 = none)
+    // Along each row and column: prefix sums of consumable values, and a bit per cell whose
+    // bonus is still waiting, so a move over plain cells is costed without visiting them
+    unsigned char cost_along_l[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH + 1];  // Sum over cells [f][w][0..l-1]
+    unsigned char cost_along_w[NUM_FLOORS][FLOOR_LENGTH][FLOOR_WIDTH + 1];  // Sum over cells [f][0..w-1][l]
+    uint32_t bonus_along_l[NUM_FLOORS][FLOOR_WIDTH];                        // Bit l: bonus waiting on [f][w][l]
+    uint16_t bonus_along_w[NUM_FLOORS][FLOOR_LENGTH];                       // Bit w: bonus waiting on [f][w][l]
+} MazeOverlay;
+
+// One game's maze: the shared layout plus the game's own overlay
+typedef struct {
+    const MazeLayout *layout;
+    MazeOverlay overlay;
+} Maze;
+
 // Data structure for player state and position
 typedef struct {
     int pos[3];                 // Current position [floor, width, length]
@@ -121,13 +191,122 @@ typedef struct {
     int bawana_turns_left;      // How many turns until effect wears off
     int bawana_random_mp;       // Random MP value for random MP effect
     int just_entered;           // Flag for players who just entered maze
+    int entry_pos[3];           // Maze cell the player enters on after rolling a 6
+    int occupancy_cell;         // Cell index this player is listed under in the occupancy grid (-1 = none)
+    int occupancy_prev;         // Neighbours in that cell's occupant list (-1 = none)
+    int occupancy_next;
+    int start_wait;             // Fast start: rolls left that miss the 6 (-1 = not drawn yet)
 } Player;
 
+// Where a player starts and enters the maze (one line of players.txt)
+typedef struct {
+    int start_pos[3];           // Cell in the starting area
+    int entry_pos[3];           // First maze cell after rolling a 6
+    int direction;              // Initial facing direction
+} PlayerSpawn;
+
+// Per-cell occupancy map of players who are in the maze, for O(1) capture checks
+// Each cell heads a doubly linked list threaded through the Player structs
+typedef struct {
+    int head[NUM_FLOORS * FLOOR_WIDTH * FLOOR_LENGTH]; // First occupant's id (-1 = empty)
+} Occupancy;
+
+// Random number generator state (additive feedback generator, same sequence as glibc rand())
+// Each thread draws from its own state, so simulations on several threads never share a lock
+#define GAME_RNG_DEGREE 34
+typedef struct {
+    unsigned int state[GAME_RNG_DEGREE];
+    int index;
+} GameRng;
+
+// Configuration every game of a simulation or server starts from (read-only once loaded)
+typedef struct {
+    Stair stairs[MAX_STAIRS];
+    Pole poles[MAX_POLES];
+    Wall walls[MAX_WALLS];
+    PlayerSpawn spawns[MAX_PLAYERS];
+    int num_stairs, num_poles, num_walls;
+    int num_players;            // Default player count for new games
+    int spawns_loaded;          // spawns[] came from players.txt
+    int flag_position[3];
+    int flag_loaded;            // flag_position came from flag.txt
+    MazeLayout layout;          // Shared by every game on this configuration
+} GameConfig;
+
+// Outcome of one turn as data, for callers that do not read the narration
+typedef struct {
+    int player_id;
+    int round_number;
+    int stairs_changed;         // Stair directions were re-rolled before this turn
+    int direction_roll;         // 0 when no direction die was rolled
+    int movement_roll;          // 0 when the turn was skipped (food poisoning, or a fast start miss)
+    int start_pos[3];
+    int end_pos[3];
+    int in_game;
+    int direction;
+    int movement_points;
+    int steps_taken;
+    int movement_cost;
+    int blocked_reason;         // BLOCK_* reason if the move was blocked
+    int captured_player;        // Player sent back to the start (-1 = none)
+    int bawana_effect;          // EFFECT_* after the turn
+    int won;
+} TurnResult;
+
+// Where a turn is paused (turn.c); a turn waits for the player before each die roll
+#define TURN_DONE                  0  // No turn in progress
+#define TURN_AWAIT_DIRECTION_ROLL  1
+#define TURN_AWAIT_MOVEMENT_ROLL   2
+
+typedef struct {
+    int stage;                  // TURN_* stage the turn is paused in
+    int should_roll_direction;  // This turn rolls the direction die first
+    const char *rolled_direction_name;
+    int won;
+    TurnResult result;          // Filled in as the turn runs
+    int forced_direction_roll;  // What-if overrides for the next roll of each die (0 = none)
+    int forced_movement_roll;
+} TurnState;
+
+// Complete state of one game, so many games can live in one process
+// Allocated with game_state_size() bytes; players[] holds num_players entries
+typedef struct {
+    Maze maze;                  // Overlay on the configuration's layout
+    Stair stairs[MAX_STAIRS];   // Per game because directions are re-rolled
+    int num_stairs;
+    StairEpoch stair_epoch;     // Bumped whenever a stair direction changes
+    const GameConfig *config;   // Poles and walls are shared
+    int flag_position[3];
+    int round_number;           // Current round (starts at 1)
+    int next_player;            // Whose turn is next
+    int winner;                 // Player who captured the flag (-1 while running)
+    int fast_start;             // Headless only: draw a waiting player's misses at once (see turn.c)
+    GameRng rng;                // Each game draws from its own generator
+    TurnState turn;             // Turn in progress, if it is paused for a die roll
+    Occupancy occupancy;
+    int num_players;
+    Player players[];
+} GameState;
+
+// Output switches for headless runs (benchmarks, simulations)
+// game_print_enabled = 0 silences all game narration; arguments are not even evaluated
+// game_prompt_enabled = 0 rolls the dice without waiting for Enter
+extern int game_print_enabled;
+extern int game_prompt_enabled;
+
+// game_fast_paths_enabled = 0 makes the calling thread walk every move cell by cell and
+// build every layout from scratch: the reference engine golden.c checks the fast paths against
+extern _Thread_local int game_fast_paths_enabled;
+
+#define GAME_PRINT(...) do { if (game_print_enabled) printf(__VA_ARGS__); } while (0)
+
 // Function prototypes - organized by category
 
 // Initialization functions
-void initialize_maze(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH]);
-void initialize_players(Player players[3]);
+void maze_layout_build(MazeLayout *layout, Stair stairs[], int num_stairs,
+                       Pole poles[], int num_poles, Wall walls[], int num_walls);
+void initialize_maze(Maze *maze, const MazeLayout *layout);
+void initialize_players(Player players[], int num_players, const PlayerSpawn spawns[]);
 void initialize_stairs(Stair stairs[], int *num_stairs);
 void initialize_poles(Pole poles[], int *num_poles);
 void initialize_walls(Wall walls[], int *num_walls);
@@ -138,61 +317,106 @@ int read_poles_from_file(const char *filename, Pole poles[], int *num_poles);
 int read_walls_from_file(const char *filename, Wall walls[], int *num_walls);
 int read_flag_from_file(const char *filename, int flag_position[3]);
 int read_seed_from_file(const char *filename);
+int read_players_from_file(const char *filename, PlayerSpawn spawns[], int *num_players);
 
 // Dice and random functions
+void game_rng_seed(GameRng *rng, unsigned int seed);
+int game_rng_next(GameRng *rng);
+void game_srand(unsigned int seed);   // Seed the calling thread's generator
+int game_rand(void);                  // Next value (0..RAND_MAX) from the calling thread's generator
+void game_rng_bind(GameRng *rng);     // Make game_rand() draw from `rng` on this thread (NULL = thread's own)
 int roll_movement_dice(void);
 int roll_direction_dice(void);
 
 // Player movement and entry functions
-void enter_maze(Player *player, int player_id);
+void enter_maze(Player *player);
 void enter_maze_like_player_a(Player *player);
-int move_player_with_teleport(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH],
-                               Stair stairs[], int num_stairs,
-                               Pole poles[], int num_poles,
-                               Wall walls[], int num_walls, int steps, int player_id, const int flag_position[3],
+int move_player_with_teleport(Player *player, Maze *maze,
+                               Stair stairs[], Pole poles[], int steps, int player_id, const int flag_position[3],
                                int *total_movement_cost, int *actual_steps_taken, int *blocking_reason);
 
 // Movement validation and obstacle detection
-int is_valid_position(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH], int floor, int width_pos, int length_pos);
-int is_wall_blocking(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH], int floor, int from_w, int from_l, int to_w, int to_l, Wall walls[], int num_walls);
+int is_valid_position(const MazeLayout *layout, int floor, int width_pos, int length_pos);
+int is_wall_blocking(int floor, int from_w, int from_l, int to_w, int to_l, Wall walls[], int num_walls);
 int find_all_stairs_at(Stair stairs[], int num_stairs, int floor, int width_pos, int length_pos, int found_indices[]);
 int find_pole_at(Pole poles[], int num_poles, int floor, int width_pos, int length_pos);
 
+// Maze lookups: walls, stairs and poles come from the shared layout, values and bonuses from the game
+int maze_wall_blocks(const MazeLayout *layout, int floor, int width_pos, int length_pos, int direction);
+int maze_stairs_at(const MazeLayout *layout, int floor, int width_pos, int length_pos, int found_indices[]);
+int maze_pole_at(const MazeLayout *layout, int floor, int width_pos, int length_pos);
+int maze_consumable_value(const Maze *maze, int floor, int width_pos, int length_pos);
+int maze_bonus_type(const Maze *maze, int floor, int width_pos, int length_pos);
+void maze_use_bonus(Maze *maze, int floor, int width_pos, int length_pos);
+int maze_bawana_type(const Maze *maze, int floor, int width_pos, int length_pos);
+int maze_plain_run(const Maze *maze, int floor, int width_pos, int length_pos, int direction);
+int maze_ray_cost(const Maze *maze, int floor, int width_pos, int length_pos, int direction, int steps);
+
 // Game objective and win condition functions
-void place_random_flag(int flag_position[3], Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH]);
+void place_random_flag(int flag_position[3], const MazeLayout *layout);
+void resolve_flag_position(int flag_position[3], int loaded_from_file,
+                           const MazeLayout *layout,
+                           Stair stairs[], Pole poles[], int num_poles,
+                           const PlayerSpawn spawns[], int num_spawns);
 int check_flag_capture(Player *player, const int flag_position[3]);
-void check_player_capture(Player players[3], int current_player_id);
+int check_player_capture(Player players[], Occupancy *occupancy, int current_player_id);
+
+// Occupancy grid maintenance (only players with in_game set are listed)
+void occupancy_clear(Occupancy *occupancy, Player players[], int num_players);
+void occupancy_add(Occupancy *occupancy, Player players[], int player_id);
+void occupancy_remove(Occupancy *occupancy, Player players[], int player_id);
 
 // Dynamic game mechanics
-void update_stair_directions(Stair stairs[], int num_stairs);
+void block_skipping_stair_cells(MazeLayout *layout, Stair stairs[], int num_stairs);
+int update_stair_directions(Stair stairs[], int num_stairs, int round_number, StairEpoch *epoch);
+void stair_epoch_init(StairEpoch *epoch);
+void stair_epoch_bump(StairEpoch *epoch, const int changed[], int num_changed);
+int stair_epoch_changed_since(const StairEpoch *epoch, int num_stairs, unsigned int since, int changed[]);
 
 // Special area functions (Bawana effects and movement bonuses)
 void reset_to_bawana(Player *player, int player_id);
-void apply_bawana_effect(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH], int player_id);
-void apply_movement_bonus(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH], int player_id);
+void apply_bawana_effect(Player *player, Maze *maze, int player_id);
+void apply_movement_bonus(Player *player, Maze *maze, int player_id);
 
 // Helper and utility functions
+const char* get_player_name(int player_id);
 int is_in_starting_area(int floor, int width_pos, int length_pos);
 void reset_to_starting_area(Player *player, int player_id);
 int manhattan_distance(int floor1, int w1, int l1, int floor2, int w2, int l2);
 const char* get_direction_name(int direction);
 const char* format_position(int floor, int width_pos, int length_pos);
-int can_enter_bawana_entrance(Player *player, Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH], int new_w, int new_l);
+int can_enter_bawana_entrance(Player *player, const MazeLayout *layout, int new_w, int new_l);
 int check_path_validity(Player *player,
-                        Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH],
-                        Stair stairs[], int num_stairs,
-                        Pole poles[], int num_poles,
-                        Wall walls[], int num_walls,
-                        int steps, int player_id, const int flag_position[3],
+                        Maze *maze,
+                        Stair stairs[], Pole poles[],
+                        int steps, const int flag_position[3],
                         int *first_blocked_step, int *blocking_reason);
 const char* get_blockage_reason_description(int blocking_reason);
 
 // Flag validation and reachability helpers
-int is_valid_flag_cell(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH], int floor, int w, int l);
-int is_flag_reachable(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH],
-                      Stair stairs[], int num_stairs,
-                      Pole poles[], int num_poles,
-                      Wall walls[], int num_walls,
+int is_valid_flag_cell(const MazeLayout *layout, int floor, int w, int l);
+// `spawns` NULL means the default Players A, B and C
+int is_flag_reachable(const MazeLayout *layout,
+                      Stair stairs[], Pole poles[], int num_poles,
+                      const PlayerSpawn spawns[], int num_spawns,
                       const int flag_position[3]);
 
+// Game sessions: shared configuration and self-contained game state
+void game_config_load(GameConfig *config, const char *dir, int num_players);
+size_t game_state_size(int num_players);
+GameState* game_state_create(const GameConfig *config, int num_players, unsigned int seed);
+void game_state_init(GameState *game, const GameConfig *config, int num_players, unsigned int seed);
+void game_state_copy(GameState *copy, const GameState *game);
+GameState* game_state_fork(const GameState *game);
+void game_state_destroy(GameState *game);
+
+// Turn flow (turn.c)
+int play_turn(int player_id, Player players[], Occupancy *occupancy,
+              Maze *maze,
+              Stair stairs[], int num_stairs, Pole poles[], int num_poles,
+              Wall walls[], int num_walls, int flag_location[3]);
+int game_turn_resume(GameState *game, TurnResult *result);
+int play_game_turn(GameState *game, TurnResult *result);
+void print_game_status(Player players[], int num_players, int flag_location[3]);
+
 #endif // GAME_H
\ No newline at end of file
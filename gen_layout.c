@@ -0,0 +1,47 @@
+// gen_layout.c - Writes layout_default.h, the default maze layout as a constant table
+// game.c copies the table instead of building the layout whenever a configuration
+// uses the built-in stairs, poles and walls. Regenerate it after changing the floor
+// shapes, the Bawana or the defaults; `./gen_layout | cmp - layout_default.h` checks it.
+//
+// Build: gcc -O2 -DGAME_LAYOUT_GENERATOR -o gen_layout gen_layout.c game.c turn.c -lm
+// Usage: ./gen_layout > layout_default.h
+
+#include "game.h"
+
+int main(void) {
+    static MazeLayout layout;
+    Stair stairs[MAX_STAIRS];
+    Pole poles[MAX_POLES];
+    Wall walls[MAX_WALLS];
+    int num_stairs, num_poles, num_walls;
+
+    initialize_stairs(stairs, &num_stairs);
+    initialize_poles(poles, &num_poles);
+    initialize_walls(walls, &num_walls);
+    maze_layout_build(&layout, stairs, num_stairs, poles, num_poles, walls, num_walls);
+
+    printf("// layout_default.h - Generated by gen_layout.c; do not edit\n");
+    printf("// The maze layout of the default stairs, poles and walls, included by game.c.\n");
+    printf("// Each cell: is_valid, is_starting_area, has_wall, is_blocked_by_stair,\n");
+    printf("// is_bawana_entrance, wall_mask, pole, pole_start, stair_mask, value_slot, plain_run\n\n");
+    printf("#ifndef LAYOUT_DEFAULT_H\n#define LAYOUT_DEFAULT_H\n\n");
+    printf("static const MazeLayout default_maze_layout = {\n    {\n");
+    for (int f = 0; f < NUM_FLOORS; f++) {
+        printf("        { // Floor %d\n", f);
+        for (int w = 0; w < FLOOR_WIDTH; w++) {
+            printf("            {");
+            for (int l = 0; l < FLOOR_LENGTH; l++) {
+                const Cell *cell = &layout.cells[f][w][l];
+                printf("%s{%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,{%d,%d,%d,%d}}", l ? "," : "",
+                       cell->is_valid, cell->is_starting_area, cell->has_wall, cell->is_blocked_by_stair,
+                       cell->is_bawana_entrance, cell->wall_mask, cell->pole, cell->pole_start,
+                       cell->stair_mask, cell->value_slot, cell->plain_run[0], cell->plain_run[1],
+                       cell->plain_run[2], cell->plain_run[3]);
+            }
+            printf("}%s // w=%d\n", w < FLOOR_WIDTH - 1 ? "," : "", w);
+        }
+        printf("        }%s\n", f < NUM_FLOORS - 1 ? "," : "");
+    }
+    printf("    },\n    %d\n};\n\n#endif // LAYOUT_DEFAULT_H\n", layout.num_value_slots);
+    return 0;
+}
@@ -0,0 +1,673 @@
+// golden.c - Differential harness: the reference engine against the optimised ones
+// The reference engine is the console game's own loop: play_turn() on plain
+// arrays, with every move walked cell by cell and the layout built from scratch
+// (game_fast_paths_enabled = 0). Each optimised engine plays the same game from
+// the same seed, so every engine draws the same dice from its own generator,
+// and after every turn the whole state is compared with the reference: round,
+// next player, winner, every player field, stair directions and their epoch,
+// the flag, the game's maze overlay (cell values, collected bonuses and the
+// cached row and column sums) and the generator itself.
+//
+// Engines:
+//   game    play_game_turn() on a GameState, fast paths on
+//   step    game_turn_resume() one die at a time, continuing from a copy of the
+//           game at every pause (the server's STEP and the scheduler)
+//   wide    a lane of a wide batch (wide.h)
+//   mutant  play_game_turn() with a deliberate bug, to check the harness itself
+//
+// The corpus is every config in a corpus file (bench/corpus.txt by default)
+// times its seeds times each player count. At the first turn where an engine
+// differs, the case is minimised: stairs, poles and walls are dropped one at a
+// time and the player count lowered while the engines still differ, and the
+// smallest case is written out as a config directory with its seed.txt, ready
+// for ./golden --config DIR or for the console game itself.
+//
+// --record FILE writes one digest of the reference's turn-by-turn states per
+// game; --check FILE compares against it, to catch a change of the reference
+// engine itself between versions.
+//
+// Build: gcc -O2 -march=native -o golden golden.c wide.c game.c turn.c -lm
+// Usage: ./golden [--corpus FILE | --config DIR [--seed S] [--seeds N]] [--players LIST]
+//                 [--max-rounds R] [--engines LIST] [--repro DIR] [--record FILE | --check FILE]
+
+#include "game.h"
+#include "wide.h"
+#include <sys/stat.h>
+
+#define GOLDEN_MAX_CONFIGS  64
+#define GOLDEN_MAX_COUNTS   16
+
+enum { ENGINE_GAME, ENGINE_STEP, ENGINE_WIDE, ENGINE_MUTANT, NUM_ENGINES };
+static const char *const engine_names[NUM_ENGINES] = { "game", "step", "wide", "mutant" };
+
+// The state an engine exposes after a turn
+typedef struct {
+    int round_number, next_player, winner;
+    const Player *players;
+    int num_players;
+    const Stair *stairs;
+    int num_stairs;
+    const StairEpoch *stair_epoch;
+    const int *flag_position;
+    const MazeOverlay *overlay;
+    const GameRng *rng;
+} EngineView;
+
+// The console game's state, kept the way main() keeps it
+typedef struct {
+    MazeLayout layout;
+    Maze maze;
+    Player players[MAX_PLAYERS];
+    Occupancy occupancy;
+    Stair stairs[MAX_STAIRS];
+    StairEpoch stair_epoch;
+    Pole poles[MAX_POLES];
+    Wall walls[MAX_WALLS];
+    int num_stairs, num_poles, num_walls, num_players;
+    int flag_position[3];
+    GameRng rng;
+    int round_number, next_player, winner;
+} ReferenceGame;
+
+typedef struct {
+    int kind;
+    GameState *game;            // game, step, mutant
+    GameState *spare;           // step: the copy the game continues from at each pause
+    WideBatch *batch;           // wide
+} Engine;
+
+typedef struct {
+    char name[64];
+    char dir[512];              // Empty for the built-in default configuration
+    unsigned int first_seed;
+    int num_seeds;
+} CorpusEntry;
+
+typedef struct {
+    int engine;
+    int turn;                   // Turns played when the states first differed (1 = after the first turn)
+    int round_number, player_id;
+    char detail[256];
+} Divergence;
+
+// ---- Reference engine ----
+
+static void reference_init(ReferenceGame *ref, const GameConfig *config, int num_players, unsigned int seed) {
+    game_fast_paths_enabled = 0;
+    memcpy(ref->stairs, config->stairs, sizeof(ref->stairs));
+    memcpy(ref->poles, config->poles, sizeof(ref->poles));
+    memcpy(ref->walls, config->walls, sizeof(ref->walls));
+    ref->num_stairs = config->num_stairs;
+    ref->num_poles = config->num_poles;
+    ref->num_walls = config->num_walls;
+    ref->num_players = num_players;
+    stair_epoch_init(&ref->stair_epoch);
+    maze_layout_build(&ref->layout, ref->stairs, ref->num_stairs, ref->poles, ref->num_poles,
+                      ref->walls, ref->num_walls);
+
+    // The same order as game_state_init() and main()
+    game_rng_seed(&ref->rng, seed);
+    game_rng_bind(&ref->rng);
+    initialize_maze(&ref->maze, &ref->layout);
+    const PlayerSpawn *spawns = (config->spawns_loaded && num_players <= config->num_players) ? config->spawns : NULL;
+    initialize_players(ref->players, num_players, spawns);
+    memcpy(ref->flag_position, config->flag_position, sizeof(ref->flag_position));
+    resolve_flag_position(ref->flag_position, config->flag_loaded, &ref->layout, ref->stairs,
+                          ref->poles, ref->num_poles, spawns, num_players);
+    occupancy_clear(&ref->occupancy, ref->players, num_players);
+    game_rng_bind(NULL);
+    game_fast_paths_enabled = 1;
+
+    ref->round_number = 1;
+    ref->next_player = 0;
+    ref->winner = -1;
+}
+
+// One player's turn, as main()'s round loop plays it
+static void reference_turn(ReferenceGame *ref) {
+    game_fast_paths_enabled = 0;
+    game_rng_bind(&ref->rng);
+    if (ref->next_player == 0) update_stair_directions(ref->stairs, ref->num_stairs, ref->round_number, &ref->stair_epoch);
+    int won = play_turn(ref->next_player, ref->players, &ref->occupancy, &ref->maze, ref->stairs, ref->num_stairs,
+                        ref->poles, ref->num_poles, ref->walls, ref->num_walls, ref->flag_position);
+    game_rng_bind(NULL);
+    game_fast_paths_enabled = 1;
+
+    if (won) {
+        ref->winner = ref->next_player;
+    } else if (++ref->next_player == ref->num_players) {
+        ref->next_player = 0;
+        ref->round_number++;
+    }
+}
+
+static EngineView reference_view(const ReferenceGame *ref) {
+    EngineView view = { ref->round_number, ref->next_player, ref->winner, ref->players, ref->num_players,
+                        ref->stairs, ref->num_stairs, &ref->stair_epoch, ref->flag_position, &ref->maze.overlay, &ref->rng };
+    return view;
+}
+
+// ---- Optimised engines ----
+
+static int engine_start(Engine *engine, int kind, const GameConfig *config, int num_players, unsigned int seed) {
+    memset(engine, 0, sizeof(*engine));
+    engine->kind = kind;
+    if (kind == ENGINE_WIDE) {
+        if (num_players > WIDE_MAX_PLAYERS) return 1;   // Not playable wide; nothing to compare
+        engine->batch = wide_batch_create(config, num_players);
+        if (!engine->batch) return 0;
+        wide_batch_start(engine->batch, 0, seed);
+        return 1;
+    }
+    engine->game = game_state_create(config, num_players, seed);
+    if (kind == ENGINE_STEP) engine->spare = malloc(game_state_size(num_players));
+    return engine->game && (kind != ENGINE_STEP || engine->spare);
+}
+
+static void engine_stop(Engine *engine) {
+    if (engine->batch) wide_batch_destroy(engine->batch);
+    if (engine->game) game_state_destroy(engine->game);
+    free(engine->spare);
+    memset(engine, 0, sizeof(*engine));
+}
+
+static int engine_active(const Engine *engine) {
+    return engine->game || engine->batch;
+}
+
+static void engine_turn(Engine *engine) {
+    TurnResult result;
+    switch (engine->kind) {
+        case ENGINE_GAME:
+            play_game_turn(engine->game, &result);
+            break;
+        case ENGINE_STEP:
+            while (game_turn_resume(engine->game, &result) != TURN_DONE) {
+                game_state_copy(engine->spare, engine->game);
+                GameState *swap = engine->game;
+                engine->game = engine->spare;
+                engine->spare = swap;
+            }
+            break;
+        case ENGINE_WIDE: {
+            TurnResult results[WIDE_LANES];
+            wide_batch_step(engine->batch, results);
+            break;
+        }
+        case ENGINE_MUTANT:
+            play_game_turn(engine->game, &result);
+            // The bug: a full six in the maze costs one MP too many
+            if (result.movement_roll == 6 && result.in_game && result.steps_taken == 6) {
+                engine->game->players[result.player_id].movement_points--;
+            }
+            break;
+    }
+}
+
+static EngineView engine_view(Engine *engine) {
+    const GameState *game = engine->kind == ENGINE_WIDE ? wide_batch_game(engine->batch, 0) : engine->game;
+    EngineView view = { game->round_number, game->next_player, game->winner, game->players, game->num_players,
+                        game->stairs, game->num_stairs, &game->stair_epoch, game->flag_position, &game->maze.overlay, &game->rng };
+    return view;
+}
+
+// ---- Comparison ----
+
+// Describe the first difference between two views in `detail`; returns 0 when they match
+static int compare_views(const EngineView *ref, const EngineView *other, const char *engine_name,
+                         char *detail, size_t size) {
+#define GOLDEN_FIELD(label, a, b) \
+    do { \
+        if ((a) != (b)) { \
+            snprintf(detail, size, "%s: reference %d, %s %d", label, (a), engine_name, (b)); \
+            return 1; \
+        } \
+    } while (0)
+    GOLDEN_FIELD("round", ref->round_number, other->round_number);
+    GOLDEN_FIELD("next player", ref->next_player, other->next_player);
+    GOLDEN_FIELD("winner", ref->winner, other->winner);
+    GOLDEN_FIELD("players", ref->num_players, other->num_players);
+    for (int p = 0; p < ref->num_players; p++) {
+        const Player *a = &ref->players[p], *b = &other->players[p];
+        char label[64];
+#define GOLDEN_PLAYER(field) \
+        do { snprintf(label, sizeof(label), "player %s " #field, get_player_name(p)); \
+             GOLDEN_FIELD(label, a->field, b->field); } while (0)
+        GOLDEN_PLAYER(pos[0]);
+        GOLDEN_PLAYER(pos[1]);
+        GOLDEN_PLAYER(pos[2]);
+        GOLDEN_PLAYER(in_game);
+        GOLDEN_PLAYER(direction);
+        GOLDEN_PLAYER(movement_points);
+        GOLDEN_PLAYER(roll_count);
+        GOLDEN_PLAYER(captured);
+        GOLDEN_PLAYER(bawana_effect);
+        GOLDEN_PLAYER(bawana_turns_left);
+        GOLDEN_PLAYER(bawana_random_mp);
+        GOLDEN_PLAYER(just_entered);
+#undef GOLDEN_PLAYER
+    }
+    GOLDEN_FIELD("stairs", ref->num_stairs, other->num_stairs);
+    for (int i = 0; i < ref->num_stairs; i++) {
+        char label[64];
+        snprintf(label, sizeof(label), "stair %d direction", i);
+        GOLDEN_FIELD(label, ref->stairs[i].direction_type, other->stairs[i].direction_type);
+        snprintf(label, sizeof(label), "stair %d changed at epoch", i);
+        GOLDEN_FIELD(label, (int)ref->stair_epoch->changed_at[i], (int)other->stair_epoch->changed_at[i]);
+    }
+    GOLDEN_FIELD("stair epoch", (int)ref->stair_epoch->epoch, (int)other->stair_epoch->epoch);
+    for (int i = 0; i < 3; i++) GOLDEN_FIELD("flag position", ref->flag_position[i], other->flag_position[i]);
+#undef GOLDEN_FIELD
+
+    const MazeOverlay *a = ref->overlay, *b = other->overlay;
+    if (memcmp(a->cell_value, b->cell_value, sizeof(a->cell_value)) != 0) {
+        snprintf(detail, size, "cell values differ");
+        return 1;
+    }
+    if (memcmp(a->bonus_used, b->bonus_used, sizeof(a->bonus_used)) != 0) {
+        snprintf(detail, size, "collected bonuses differ");
+        return 1;
+    }
+    if (memcmp(a->bawana_type, b->bawana_type, sizeof(a->bawana_type)) != 0) {
+        snprintf(detail, size, "Bawana cells differ");
+        return 1;
+    }
+    if (memcmp(a->cost_along_l, b->cost_along_l, sizeof(a->cost_along_l)) != 0 ||
+        memcmp(a->cost_along_w, b->cost_along_w, sizeof(a->cost_along_w)) != 0 ||
+        memcmp(a->bonus_along_l, b->bonus_along_l, sizeof(a->bonus_along_l)) != 0 ||
+        memcmp(a->bonus_along_w, b->bonus_along_w, sizeof(a->bonus_along_w)) != 0) {
+        snprintf(detail, size, "cached row and column sums differ from the cells");
+        return 1;
+    }
+    if (memcmp(ref->rng, other->rng, sizeof(*ref->rng)) != 0) {
+        snprintf(detail, size, "generator state differs (a different number of dice drawn)");
+        return 1;
+    }
+    return 0;
+}
+
+static unsigned long long mix(unsigned long long digest, const void *data, size_t size) {
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < size; i++) digest = (digest ^ bytes[i]) * 1099511628211ULL;
+    return digest;
+}
+
+static unsigned long long mix_view(unsigned long long digest, const EngineView *view) {
+    int header[] = { view->round_number, view->next_player, view->winner };
+    digest = mix(digest, header, sizeof(header));
+    for (int p = 0; p < view->num_players; p++) {
+        const Player *player = &view->players[p];
+        int fields[] = { player->pos[0], player->pos[1], player->pos[2], player->in_game, player->direction,
+                         player->movement_points, player->roll_count, player->captured, player->bawana_effect,
+                         player->bawana_turns_left, player->bawana_random_mp, player->just_entered };
+        digest = mix(digest, fields, sizeof(fields));
+    }
+    for (int i = 0; i < view->num_stairs; i++) {
+        digest = mix(digest, &view->stairs[i].direction_type, sizeof(int));
+    }
+    digest = mix(digest, view->overlay->bonus_used, sizeof(view->overlay->bonus_used));
+    return mix(digest, view->rng, sizeof(*view->rng));
+}
+
+// ---- Cases ----
+
+// Play one case on the reference and every engine in `engines` (bit per ENGINE_*) in lockstep.
+// Returns 1 if they agree to the end, 0 with `divergence` filled in if not, -1 if out of memory.
+static int run_case(const GameConfig *config, int num_players, unsigned int seed, int max_rounds, int engines,
+                    Divergence *divergence, unsigned long long *digest, int *turns_played) {
+    static ReferenceGame ref;
+    Engine engine[NUM_ENGINES];
+    int ok = 1;
+
+    reference_init(&ref, config, num_players, seed);
+    for (int e = 0; e < NUM_ENGINES; e++) {
+        memset(&engine[e], 0, sizeof(engine[e]));
+        if ((engines >> e & 1) && !engine_start(&engine[e], e, config, num_players, seed)) ok = -1;
+    }
+    if (memcmp(&ref.layout, &config->layout, sizeof(ref.layout)) != 0) {
+        divergence->engine = -1;
+        divergence->turn = 0;
+        divergence->round_number = 0;
+        divergence->player_id = -1;
+        snprintf(divergence->detail, sizeof(divergence->detail),
+                 "the configuration's layout differs from one built from scratch");
+        ok = 0;
+    }
+
+    unsigned long long hash = 14695981039346656037ULL;
+    int turn = 0;
+    while (ok == 1 && ref.winner < 0 && ref.round_number <= max_rounds) {
+        int round_number = ref.round_number, player_id = ref.next_player;
+        reference_turn(&ref);
+        turn++;
+        EngineView expected = reference_view(&ref);
+        hash = mix_view(hash, &expected);
+        for (int e = 0; e < NUM_ENGINES && ok == 1; e++) {
+            if (!engine_active(&engine[e])) continue;
+            engine_turn(&engine[e]);
+            EngineView actual = engine_view(&engine[e]);
+            if (compare_views(&expected, &actual, engine_names[e], divergence->detail, sizeof(divergence->detail))) {
+                divergence->engine = e;
+                divergence->turn = turn;
+                divergence->round_number = round_number;
+                divergence->player_id = player_id;
+                ok = 0;
+            }
+        }
+    }
+
+    for (int e = 0; e < NUM_ENGINES; e++) engine_stop(&engine[e]);
+    if (digest) *digest = hash;
+    if (turns_played) *turns_played = turn;
+    return ok;
+}
+
+// ---- Minimising ----
+
+// Rebuild the layout after an edit; stairs that no longer match the defaults load
+// from stairs.txt, which makes them bidirectional, so they are made so here as well
+static void config_rebuild(GameConfig *config) {
+    Stair defaults[MAX_STAIRS];
+    int num_defaults;
+    initialize_stairs(defaults, &num_defaults);
+    if (config->num_stairs != num_defaults ||
+        memcmp(config->stairs, defaults, sizeof(Stair) * (size_t)num_defaults) != 0) {
+        for (int i = 0; i < config->num_stairs; i++) config->stairs[i].direction_type = STAIR_BIDIRECTIONAL;
+    }
+    maze_layout_build(&config->layout, config->stairs, config->num_stairs, config->poles, config->num_poles,
+                      config->walls, config->num_walls);
+}
+
+static void remove_item(void *items, int *count, size_t item_size, int index) {
+    char *base = items;
+    memmove(base + (size_t)index * item_size, base + (size_t)(index + 1) * item_size,
+            (size_t)(*count - index - 1) * item_size);
+    (*count)--;
+}
+
+// Does the case still diverge on `engine`, at any turn within `max_rounds`?
+static int still_diverges(const GameConfig *config, int num_players, unsigned int seed, int max_rounds, int engine,
+                          Divergence *divergence) {
+    return run_case(config, num_players, seed, max_rounds, 1 << engine, divergence, NULL, NULL) == 0;
+}
+
+// Drop stairs, poles and walls one at a time and lower the player count while
+// the engine still differs; `config` and `num_players` are left at the smallest case
+static void minimise(GameConfig *config, int *num_players, unsigned int seed, int max_rounds, int engine,
+                     Divergence *divergence) {
+    static GameConfig candidate;
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (int kind = 0; kind < 3; kind++) {
+            int *count = kind == 0 ? &config->num_walls : kind == 1 ? &config->num_poles : &config->num_stairs;
+            for (int i = *count - 1; i >= 0; i--) {
+                candidate = *config;
+                if (kind == 0) remove_item(candidate.walls, &candidate.num_walls, sizeof(Wall), i);
+                else if (kind == 1) remove_item(candidate.poles, &candidate.num_poles, sizeof(Pole), i);
+                else remove_item(candidate.stairs, &candidate.num_stairs, sizeof(Stair), i);
+                config_rebuild(&candidate);
+                if (still_diverges(&candidate, *num_players, seed, max_rounds, engine, divergence)) {
+                    *config = candidate;
+                    changed = 1;
+                }
+            }
+        }
+    }
+    for (int players = MIN_PLAYERS; players < *num_players; players++) {
+        if (still_diverges(config, players, seed, max_rounds, engine, divergence)) {
+            *num_players = players;
+            break;
+        }
+    }
+    // Leave `divergence` describing the smallest case
+    still_diverges(config, *num_players, seed, max_rounds, engine, divergence);
+}
+
+// Write the case as a config directory the game and this harness both load
+static int write_reproducer(const char *dir, const GameConfig *config, int num_players, unsigned int seed) {
+    char path[600];
+    FILE *file;
+    mkdir(dir, 0755);
+
+    snprintf(path, sizeof(path), "%s/stairs.txt", dir);
+    if (!(file = fopen(path, "w"))) return 0;
+    for (int i = 0; i < config->num_stairs; i++) {
+        const Stair *stair = &config->stairs[i];
+        fprintf(file, "[%d, %d, %d, %d, %d, %d]\n", stair->start_floor, stair->start_w, stair->start_l,
+                stair->end_floor, stair->end_w, stair->end_l);
+    }
+    fclose(file);
+    snprintf(path, sizeof(path), "%s/poles.txt", dir);
+    if (!(file = fopen(path, "w"))) return 0;
+    for (int i = 0; i < config->num_poles; i++) {
+        const Pole *pole = &config->poles[i];
+        fprintf(file, "[%d, %d, %d, %d]\n", pole->start_floor, pole->end_floor, pole->w, pole->l);
+    }
+    fclose(file);
+    snprintf(path, sizeof(path), "%s/walls.txt", dir);
+    if (!(file = fopen(path, "w"))) return 0;
+    for (int i = 0; i < config->num_walls; i++) {
+        const Wall *wall = &config->walls[i];
+        fprintf(file, "[%d, %d, %d, %d, %d]\n", wall->floor, wall->start_w, wall->start_l, wall->end_w, wall->end_l);
+    }
+    fclose(file);
+    if (config->flag_loaded) {
+        snprintf(path, sizeof(path), "%s/flag.txt", dir);
+        if (!(file = fopen(path, "w"))) return 0;
+        fprintf(file, "[%d, %d, %d]\n", config->flag_position[0], config->flag_position[1], config->flag_position[2]);
+        fclose(file);
+    }
+    if (config->spawns_loaded && num_players <= config->num_players) {
+        snprintf(path, sizeof(path), "%s/players.txt", dir);
+        if (!(file = fopen(path, "w"))) return 0;
+        for (int p = 0; p < num_players; p++) {
+            const PlayerSpawn *spawn = &config->spawns[p];
+            fprintf(file, "[%d, %d, %d, %d, %d, %d, %d]\n", spawn->start_pos[0], spawn->start_pos[1],
+                    spawn->start_pos[2], spawn->entry_pos[0], spawn->entry_pos[1], spawn->entry_pos[2],
+                    spawn->direction);
+        }
+        fclose(file);
+    }
+    snprintf(path, sizeof(path), "%s/seed.txt", dir);
+    if (!(file = fopen(path, "w"))) return 0;
+    fprintf(file, "%u\n", seed);
+    fclose(file);
+    return 1;
+}
+
+// ---- Driver ----
+
+static int read_corpus(const char *filename, CorpusEntry entries[], int max_entries) {
+    FILE *file = fopen(filename, "r");
+    if (!file) return -1;
+    // Config dirs are relative to the corpus file
+    char base[512];
+    snprintf(base, sizeof(base), "%s", filename);
+    char *slash = strrchr(base, '/');
+    if (slash) slash[1] = '\0';
+    else base[0] = '\0';
+
+    char line[512], dir[256];
+    int count = 0;
+    while (fgets(line, sizeof(line), file) && count < max_entries) {
+        CorpusEntry *entry = &entries[count];
+        if (line[0] == '#') continue;
+        if (sscanf(line, "%63s %255s %u %d", entry->name, dir, &entry->first_seed, &entry->num_seeds) != 4) continue;
+        if (strcmp(dir, "-") == 0) entry->dir[0] = '\0';
+        else snprintf(entry->dir, sizeof(entry->dir), "%s%s", base, dir);
+        count++;
+    }
+    fclose(file);
+    return count;
+}
+
+static int parse_list(const char *text, int values[], int max_values) {
+    int count = 0;
+    while (*text && count < max_values) {
+        char *end;
+        long value = strtol(text, &end, 10);
+        if (end == text) return -1;
+        values[count++] = (int)value;
+        text = *end == ',' ? end + 1 : end;
+    }
+    return count;
+}
+
+static int parse_engines(const char *text) {
+    int engines = 0;
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), "%s", text);
+    for (char *name = strtok(buffer, ","); name; name = strtok(NULL, ",")) {
+        int e;
+        for (e = 0; e < NUM_ENGINES && strcmp(name, engine_names[e]) != 0; e++) {
+        }
+        if (e == NUM_ENGINES) return -1;
+        engines |= 1 << e;
+    }
+    return engines;
+}
+
+int main(int argc, char *argv[]) {
+    static CorpusEntry corpus[GOLDEN_MAX_CONFIGS];
+    static GameConfig config;
+    const char *corpus_file = "bench/corpus.txt";
+    const char *config_dir = NULL;
+    const char *repro_dir = "golden_repro";
+    const char *record_file = NULL, *check_file = NULL;
+    unsigned int seed = 1;
+    int num_seeds = 100, max_rounds = 300;
+    int player_counts[GOLDEN_MAX_COUNTS] = { 2, 3, 4 }, num_counts = 3;
+    int engines = (1 << ENGINE_GAME) | (1 << ENGINE_STEP) | (1 << ENGINE_WIDE);
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--corpus") == 0 && i + 1 < argc) corpus_file = argv[++i];
+        else if (strcmp(argv[i], "--config") == 0 && i + 1 < argc) config_dir = argv[++i];
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--seeds") == 0 && i + 1 < argc) num_seeds = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--players") == 0 && i + 1 < argc) num_counts = parse_list(argv[++i], player_counts, GOLDEN_MAX_COUNTS);
+        else if (strcmp(argv[i], "--max-rounds") == 0 && i + 1 < argc) max_rounds = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--engines") == 0 && i + 1 < argc) engines = parse_engines(argv[++i]);
+        else if (strcmp(argv[i], "--repro") == 0 && i + 1 < argc) repro_dir = argv[++i];
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) record_file = argv[++i];
+        else if (strcmp(argv[i], "--check") == 0 && i + 1 < argc) check_file = argv[++i];
+        else {
+            fprintf(stderr, "Usage: %s [--corpus FILE | --config DIR [--seed S] [--seeds N]] [--players LIST] "
+                            "[--max-rounds R] [--engines game,step,wide,mutant] [--repro DIR] "
+                            "[--record FILE | --check FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (engines < 0) {
+        fprintf(stderr, "Error: engines are game, step, wide and mutant\n");
+        return 2;
+    }
+    if (num_counts <= 0) {
+        fprintf(stderr, "Error: --players takes a list like 2,3,4\n");
+        return 2;
+    }
+    for (int c = 0; c < num_counts; c++) {
+        if (player_counts[c] < MIN_PLAYERS || player_counts[c] > MAX_PLAYERS) {
+            fprintf(stderr, "Error: player counts must be between %d and %d\n", MIN_PLAYERS, MAX_PLAYERS);
+            return 2;
+        }
+    }
+
+    int num_configs;
+    if (config_dir) {
+        snprintf(corpus[0].name, sizeof(corpus[0].name), "%s", config_dir);
+        snprintf(corpus[0].dir, sizeof(corpus[0].dir), "%s", config_dir);
+        corpus[0].first_seed = seed;
+        corpus[0].num_seeds = num_seeds;
+        num_configs = 1;
+    } else if ((num_configs = read_corpus(corpus_file, corpus, GOLDEN_MAX_CONFIGS)) < 0) {
+        fprintf(stderr, "Error: Could not read corpus %s\n", corpus_file);
+        return 1;
+    }
+
+    FILE *record = NULL, *check = NULL;
+    if (record_file && !(record = fopen(record_file, "w"))) {
+        fprintf(stderr, "Error: Could not write %s\n", record_file);
+        return 1;
+    }
+    if (check_file && !(check = fopen(check_file, "r"))) {
+        fprintf(stderr, "Error: Could not read %s\n", check_file);
+        return 1;
+    }
+
+    game_print_enabled = 0;
+    game_prompt_enabled = 0;
+    long cases = 0, turns = 0, golden_mismatches = 0;
+    for (int c = 0; c < num_configs; c++) {
+        const CorpusEntry *entry = &corpus[c];
+        for (int n = 0; n < num_counts; n++) {
+            int num_players = player_counts[n];
+            game_config_load(&config, entry->dir[0] ? entry->dir : NULL, num_players);
+            for (int s = 0; s < entry->num_seeds; s++) {
+                unsigned int case_seed = entry->first_seed + (unsigned int)s;
+                Divergence divergence;
+                unsigned long long digest;
+                int case_turns;
+                int result = run_case(&config, num_players, case_seed, max_rounds, engines, &divergence, &digest,
+                                      &case_turns);
+                if (result < 0) {
+                    fprintf(stderr, "Error: Out of memory\n");
+                    return 1;
+                }
+                cases++;
+                turns += case_turns;
+
+                if (result == 0) {
+                    printf("✗ %s, seed %u, %d players: %s differs at turn %d (round %d, player %s): %s\n",
+                           entry->name, case_seed, num_players,
+                           divergence.engine >= 0 ? engine_names[divergence.engine] : "layout",
+                           divergence.turn, divergence.round_number, get_player_name(divergence.player_id),
+                           divergence.detail);
+                    if (divergence.engine < 0) return 1;
+                    int engine = divergence.engine;
+                    minimise(&config, &num_players, case_seed, divergence.round_number, engine, &divergence);
+                    printf("  Smallest case: %d stairs, %d poles, %d walls, %d players, differs at turn %d "
+                           "(round %d, player %s): %s\n", config.num_stairs, config.num_poles, config.num_walls,
+                           num_players, divergence.turn, divergence.round_number,
+                           get_player_name(divergence.player_id), divergence.detail);
+                    if (write_reproducer(repro_dir, &config, num_players, case_seed)) {
+                        printf("  Reproduce: %s --config %s --seed %u --seeds 1 --players %d --max-rounds %d "
+                               "--engines %s\n", argv[0], repro_dir, case_seed, num_players, divergence.round_number,
+                               engine_names[engine]);
+                    }
+                    return 1;
+                }
+
+                if (record) {
+                    fprintf(record, "%s %u %d %d %016llx\n", entry->name, case_seed, num_players, case_turns, digest);
+                }
+                if (check) {
+                    char line[256], name[64];
+                    unsigned int golden_seed;
+                    int golden_players, golden_turns;
+                    unsigned long long golden_digest;
+                    if (!fgets(line, sizeof(line), check) ||
+                        sscanf(line, "%63s %u %d %d %llx", name, &golden_seed, &golden_players, &golden_turns,
+                               &golden_digest) != 5 ||
+                        strcmp(name, entry->name) != 0 || golden_seed != case_seed || golden_players != num_players) {
+                        fprintf(stderr, "Error: %s was recorded with a different corpus or options\n", check_file);
+                        return 1;
+                    }
+                    if (golden_turns != case_turns || golden_digest != digest) {
+                        printf("✗ %s, seed %u, %d players: the reference engine no longer matches %s "
+                               "(%d turns, recorded %d)\n", entry->name, case_seed, num_players, check_file,
+                               case_turns, golden_turns);
+                        golden_mismatches++;
+                    }
+                }
+            }
+        }
+    }
+    if (record) fclose(record);
+    if (check) fclose(check);
+
+    if (golden_mismatches) return 1;
+    printf("✓ %ld games, %ld turns: every engine matched the reference after every turn%s.\n", cases, turns,
+           check ? ", and the reference matched the recorded traces" : "");
+    return 0;
+}
@@ -0,0 +1,51 @@
+// layout_default.h - Generated by gen_layout.c; do not edit
+// The maze layout of the default stairs, poles and walls, included by game.c.
+// Each cell: is_valid, is_starting_area, has_wall, is_blocked_by_stair,
+// is_bawana_entrance, wall_mask, pole, pole_start, stair_mask, value_slot, plain_run
+
+#ifndef LAYOUT_DEFAULT_H
+#define LAYOUT_DEFAULT_H
+
+static const MazeLayout default_maze_layout = {
+    {
+        { // Floor 0
+            {{1,0,0,0,0,0,-1,-1,0,0,{0,9,24,0}},{1,0,0,0,0,0,-1,-1,0,1,{1,9,23,0}},{1,0,0,0,0,0,-1,-1,0,2,{2,9,22,0}},{1,0,0,0,0,0,-1,-1,0,3,{3,9,21,0}},{1,0,0,0,0,0,-1,-1,0,4,{4,9,20,0}},{1,0,0,0,0,0,-1,-1,0,5,{5,9,19,0}},{1,0,0,0,0,0,-1,-1,0,6,{6,9,18,0}},{1,0,0,0,0,0,-1,-1,0,7,{7,9,17,0}},{1,0,0,0,0,0,-1,-1,0,8,{8,5,16,0}},{1,0,0,0,0,0,-1,-1,0,9,{9,5,15,0}},{1,0,0,0,0,0,-1,-1,0,10,{10,4,14,0}},{1,0,0,0,0,0,-1,-1,0,11,{11,5,13,0}},{1,0,0,0,0,0,-1,-1,0,12,{12,5,12,0}},{1,0,0,0,0,0,-1,-1,0,13,{13,5,11,0}},{1,0,0,0,0,0,-1,-1,0,14,{14,5,10,0}},{1,0,0,0,0,0,-1,-1,0,15,{15,5,9,0}},{1,0,0,0,0,0,-1,-1,0,16,{16,5,8,0}},{1,0,0,0,0,0,-1,-1,0,17,{17,9,7,0}},{1,0,0,0,0,0,-1,-1,0,18,{18,9,6,0}},{1,0,0,0,0,0,-1,-1,0,19,{19,8,5,0}},{1,0,0,0,0,0,-1,-1,0,20,{20,5,4,0}},{1,0,0,0,0,0,-1,-1,0,21,{21,5,3,0}},{1,0,0,0,0,0,-1,-1,0,22,{22,5,2,0}},{1,0,0,0,0,0,-1,-1,0,23,{23,5,1,0}},{1,0,0,0,0,0,-1,-1,0,24,{24,4,0,0}}}, // w=0
+            {{1,0,0,0,0,0,-1,-1,0,25,{0,8,24,1}},{1,0,0,0,0,0,-1,-1,0,26,{1,8,23,1}},{1,0,0,0,0,0,-1,-1,0,27,{2,8,22,1}},{1,0,0,0,0,0,-1,-1,0,28,{3,8,21,1}},{1,0,0,0,0,0,-1,-1,0,29,{4,8,20,1}},{1,0,0,0,0,0,-1,-1,0,30,{5,8,19,1}},{1,0,0,0,0,0,-1,-1,0,31,{6,8,18,1}},{1,0,0,0,0,0,-1,-1,0,32,{7,8,17,1}},{1,0,0,0,0,0,-1,-1,0,33,{8,4,16,1}},{1,0,0,0,0,0,-1,-1,0,34,{9,4,15,1}},{1,0,0,0,0,0,-1,-1,0,35,{10,3,14,1}},{1,0,0,0,0,0,-1,-1,0,36,{11,4,13,1}},{1,0,0,0,0,0,-1,-1,0,37,{12,4,12,1}},{1,0,0,0,0,0,-1,-1,0,38,{13,4,11,1}},{1,0,0,0,0,0,-1,-1,0,39,{14,4,10,1}},{1,0,0,0,0,0,-1,-1,0,40,{15,4,9,1}},{1,0,0,0,0,0,-1,-1,0,41,{16,4,8,1}},{1,0,0,0,0,0,-1,-1,0,42,{17,8,7,1}},{1,0,0,0,0,0,-1,-1,0,43,{18,8,6,1}},{1,0,0,0,0,0,-1,-1,0,44,{19,7,5,1}},{1,0,0,0,0,0,-1,-1,0,45,{20,4,4,1}},{1,0,0,0,0,0,-1,-1,0,46,{21,4,3,1}},{1,0,0,0,0,0,-1,-1,0,47,{22,4,2,1}},{1,0,0,0,0,0,-1,-1,0,48,{23,4,1,1}},{1,0,0,0,0,0,-1,-1,0,49,{24,3,0,1}}}, // w=1
+            {{1,0,0,0,0,0,-1,-1,0,50,{0,7,24,2}},{1,0,0,0,0,0,-1,-1,0,51,{1,7,23,2}},{1,0,0,0,0,0,-1,-1,0,52,{2,7,22,2}},{1,0,0,0,0,0,-1,-1,0,53,{3,7,21,2}},{1,0,0,0,0,0,-1,-1,0,54,{4,7,20,2}},{1,0,0,0,0,0,-1,-1,0,55,{5,7,19,2}},{1,0,0,0,0,0,-1,-1,0,56,{6,7,18,2}},{1,0,0,0,0,0,-1,-1,0,57,{7,7,17,2}},{1,0,0,0,0,0,-1,-1,0,58,{8,3,16,2}},{1,0,0,0,0,0,-1,-1,0,59,{9,3,15,2}},{1,0,0,0,0,0,-1,-1,0,60,{10,2,14,2}},{1,0,0,0,0,0,-1,-1,0,61,{11,3,13,2}},{1,0,0,0,0,0,-1,-1,0,62,{12,3,12,2}},{1,0,0,0,0,0,-1,-1,0,63,{13,3,11,2}},{1,0,0,0,0,0,-1,-1,0,64,{14,3,10,2}},{1,0,0,0,0,0,-1,-1,0,65,{15,3,9,2}},{1,0,0,0,0,0,-1,-1,0,66,{16,3,8,2}},{1,0,0,0,0,0,-1,-1,0,67,{17,7,7,2}},{1,0,0,0,0,0,-1,-1,0,68,{18,7,6,2}},{1,0,0,0,0,0,-1,-1,0,69,{19,6,5,2}},{1,0,0,0,0,0,-1,-1,0,70,{20,3,4,2}},{1,0,0,0,0,0,-1,-1,0,71,{21,3,3,2}},{1,0,0,0,0,0,-1,-1,0,72,{22,3,2,2}},{1,0,0,0,0,0,-1,-1,0,73,{23,3,1,2}},{1,0,0,0,0,0,-1,-1,0,74,{24,2,0,2}}}, // w=2
+            {{1,0,0,0,0,0,-1,-1,0,75,{0,6,24,3}},{1,0,0,0,0,0,-1,-1,0,76,{1,6,23,3}},{1,0,0,0,0,0,-1,-1,0,77,{2,6,22,3}},{1,0,0,0,0,0,-1,-1,0,78,{3,6,21,3}},{1,0,0,0,0,0,-1,-1,0,79,{4,6,20,3}},{1,0,0,0,0,0,-1,-1,0,80,{5,6,19,3}},{1,0,0,0,0,0,-1,-1,0,81,{6,6,18,3}},{1,0,0,0,0,0,-1,-1,0,82,{7,6,17,3}},{1,0,0,0,0,0,-1,-1,0,83,{8,2,16,3}},{1,0,0,0,0,0,-1,-1,0,84,{9,2,15,3}},{1,0,0,0,0,0,-1,-1,0,85,{10,1,14,3}},{1,0,0,0,0,0,-1,-1,0,86,{11,2,13,3}},{1,0,0,0,0,0,-1,-1,0,87,{12,2,12,3}},{1,0,0,0,0,0,-1,-1,0,88,{13,2,11,3}},{1,0,0,0,0,0,-1,-1,0,89,{14,2,10,3}},{1,0,0,0,0,0,-1,-1,0,90,{15,2,9,3}},{1,0,0,0,0,0,-1,-1,0,91,{16,2,8,3}},{1,0,0,0,0,0,-1,-1,0,92,{17,6,7,3}},{1,0,0,0,0,0,-1,-1,0,93,{18,6,6,3}},{1,0,0,0,0,0,-1,-1,0,94,{19,5,5,3}},{1,0,0,0,0,0,-1,-1,0,95,{20,2,4,3}},{1,0,0,0,0,0,-1,-1,0,96,{21,2,3,3}},{1,0,0,0,0,0,-1,-1,0,97,{22,2,2,3}},{1,0,0,0,0,0,-1,-1,0,98,{23,2,1,3}},{1,0,0,0,0,0,-1,-1,0,99,{24,1,0,3}}}, // w=3
+            {{1,0,0,0,0,0,-1,-1,0,100,{0,5,24,4}},{1,0,0,0,0,0,-1,-1,0,101,{1,5,23,4}},{1,0,0,0,0,0,-1,-1,0,102,{2,5,22,4}},{1,0,0,0,0,0,-1,-1,0,103,{3,5,21,4}},{1,0,0,0,0,0,-1,-1,0,104,{4,5,20,4}},{1,0,0,0,0,0,-1,-1,0,105,{5,5,19,4}},{1,0,0,0,0,0,-1,-1,0,106,{6,5,18,4}},{1,0,0,0,0,0,-1,-1,0,107,{7,5,17,4}},{1,0,0,0,0,0,-1,-1,0,108,{8,1,16,4}},{1,0,0,0,0,0,-1,-1,0,109,{9,1,15,4}},{1,0,0,0,0,0,-1,-1,0,110,{10,0,14,4}},{1,0,0,0,0,0,-1,-1,0,111,{11,1,13,4}},{1,0,0,0,0,0,-1,-1,0,112,{12,1,12,4}},{1,0,0,0,0,0,-1,-1,0,113,{13,1,11,4}},{1,0,0,0,0,0,-1,-1,0,114,{14,1,10,4}},{1,0,0,0,0,0,-1,-1,0,115,{15,1,9,4}},{1,0,0,0,0,0,-1,-1,0,116,{16,1,8,4}},{1,0,0,0,0,0,-1,-1,0,117,{17,5,7,4}},{1,0,0,0,0,0,-1,-1,0,118,{18,5,6,4}},{1,0,0,0,0,0,-1,-1,0,119,{19,4,5,4}},{1,0,0,0,0,0,-1,-1,0,120,{20,1,4,4}},{1,0,0,0,0,0,-1,-1,0,121,{21,1,3,4}},{1,0,0,0,0,0,-1,-1,0,122,{22,1,2,4}},{1,0,0,0,0,0,-1,-1,0,123,{23,1,1,4}},{1,0,0,0,0,0,-1,-1,0,124,{24,0,0,4}}}, // w=4
+            {{1,0,0,0,0,0,-1,-1,0,125,{0,4,9,5}},{1,0,0,0,0,0,-1,-1,0,126,{1,4,8,5}},{1,0,0,0,0,0,-1,-1,0,127,{2,4,7,5}},{1,0,0,0,0,0,-1,-1,0,128,{3,4,6,5}},{1,0,0,0,0,0,-1,-1,0,129,{4,4,5,5}},{1,0,0,0,0,0,-1,-1,0,130,{5,4,4,5}},{1,0,0,0,0,0,-1,-1,0,131,{6,4,3,5}},{1,0,0,0,0,0,-1,-1,0,132,{7,4,2,5}},{1,0,0,0,0,0,-1,-1,0,133,{8,0,1,5}},{1,0,0,0,0,0,-1,-1,0,134,{9,0,0,5}},{1,0,0,0,0,0,-1,-1,1,135,{10,0,13,5}},{1,0,0,0,0,0,-1,-1,0,136,{0,0,12,5}},{1,0,0,0,0,0,-1,-1,0,137,{1,0,11,5}},{1,0,0,0,0,0,-1,-1,0,138,{2,0,10,5}},{1,0,0,0,0,0,-1,-1,0,139,{3,0,9,5}},{1,0,0,0,0,0,-1,-1,0,140,{4,0,8,5}},{1,0,0,0,0,0,-1,-1,0,141,{5,0,7,5}},{1,0,0,0,0,0,-1,-1,0,142,{6,4,6,5}},{1,0,0,0,0,0,-1,-1,0,143,{7,4,5,5}},{1,0,0,0,0,0,-1,-1,0,144,{8,3,4,5}},{1,0,0,0,0,0,-1,-1,0,145,{9,0,3,5}},{1,0,0,0,0,0,-1,-1,0,146,{10,0,2,5}},{1,0,0,0,0,0,-1,-1,0,147,{11,0,1,5}},{1,0,0,0,0,0,-1,-1,0,148,{12,0,0,5}},{1,0,0,0,0,0,0,-1,0,149,{13,0,0,5}}}, // w=5
+            {{1,0,0,0,0,0,-1,-1,0,150,{0,3,7,6}},{1,0,0,0,0,0,-1,-1,0,151,{1,3,6,6}},{1,0,0,0,0,0,-1,-1,0,152,{2,3,5,6}},{1,0,0,0,0,0,-1,-1,0,153,{3,3,4,6}},{1,0,0,0,0,0,-1,-1,0,154,{4,3,3,6}},{1,0,0,0,0,0,-1,-1,0,155,{5,3,2,6}},{1,0,0,0,0,0,-1,-1,0,156,{6,3,1,6}},{1,0,0,0,0,0,-1,-1,0,157,{7,3,0,6}},{0,1,0,0,0,0,-1,-1,0,-1,{8,0,0,6}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,6}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,6}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,6}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,6}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,6}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,6}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,3,6}},{1,0,0,0,0,0,-1,-1,0,158,{0,3,2,6}},{1,0,0,0,0,0,-1,-1,0,159,{1,3,1,6}},{1,0,0,0,0,0,-1,-1,0,160,{2,2,0,6}},{1,0,1,0,0,6,-1,-1,0,-1,{3,0,0,6}},{1,0,1,0,0,3,-1,-1,0,-1,{0,0,0,6}},{1,0,1,0,0,2,-1,-1,0,-1,{0,0,0,6}},{1,0,1,0,0,2,-1,-1,0,-1,{0,0,0,6}},{1,0,1,0,0,2,-1,-1,0,-1,{0,0,0,0}}}, // w=6
+            {{1,0,0,0,0,0,-1,-1,0,161,{0,2,7,7}},{1,0,0,0,0,0,-1,-1,0,162,{1,2,6,7}},{1,0,0,0,0,0,-1,-1,0,163,{2,2,5,7}},{1,0,0,0,0,0,-1,-1,0,164,{3,2,4,7}},{1,0,0,0,0,0,-1,-1,0,165,{4,2,3,7}},{1,0,0,0,0,0,-1,-1,0,166,{5,2,2,7}},{1,0,0,0,0,0,-1,-1,0,167,{6,2,1,7}},{1,0,0,0,0,0,-1,-1,0,168,{7,2,0,7}},{0,1,0,0,0,0,-1,-1,0,-1,{8,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,3,0}},{1,0,0,0,0,0,-1,-1,0,169,{0,2,2,7}},{1,0,0,0,0,0,-1,-1,0,170,{1,2,1,7}},{1,0,0,0,0,0,-1,-1,0,171,{2,1,0,7}},{1,0,1,0,0,12,-1,-1,0,-1,{3,0,0,0}},{1,0,0,0,0,9,-1,-1,0,-1,{0,0,0,0}},{1,0,0,0,0,8,-1,-1,0,-1,{0,0,0,0}},{1,0,0,0,0,8,-1,-1,0,-1,{0,0,0,0}},{1,0,0,0,0,8,-1,-1,0,-1,{0,0,0,0}}}, // w=7
+            {{1,0,0,0,0,0,-1,-1,0,172,{0,1,7,8}},{1,0,0,0,0,0,-1,-1,0,173,{1,1,6,8}},{1,0,0,0,0,0,-1,-1,0,174,{2,1,5,8}},{1,0,0,0,0,0,-1,-1,0,175,{3,1,4,8}},{1,0,0,0,0,0,-1,-1,0,176,{4,1,3,8}},{1,0,0,0,0,0,-1,-1,0,177,{5,1,2,8}},{1,0,0,0,0,0,-1,-1,0,178,{6,1,1,8}},{1,0,0,0,0,0,-1,-1,0,179,{7,1,0,8}},{0,1,0,0,0,0,-1,-1,0,-1,{8,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,3,0}},{1,0,0,0,0,0,-1,-1,0,180,{0,1,2,8}},{1,0,0,0,0,0,-1,-1,0,181,{1,1,1,8}},{1,0,0,0,0,0,-1,-1,0,182,{2,0,0,8}},{1,0,1,0,0,4,-1,-1,0,-1,{3,0,0,0}},{1,0,0,0,0,1,-1,-1,0,-1,{0,0,0,0}},{1,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{1,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{1,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}}}, // w=8
+            {{1,0,0,0,0,0,-1,-1,0,183,{0,0,7,9}},{1,0,0,0,0,0,-1,-1,0,184,{1,0,6,9}},{1,0,0,0,0,0,-1,-1,0,185,{2,0,5,9}},{1,0,0,0,0,0,-1,-1,0,186,{3,0,4,9}},{1,0,0,0,0,0,-1,-1,0,187,{4,0,3,9}},{1,0,0,0,0,0,-1,-1,0,188,{5,0,2,9}},{1,0,0,0,0,0,-1,-1,0,189,{6,0,1,9}},{1,0,0,0,0,0,-1,-1,0,190,{7,0,0,9}},{0,1,0,0,0,0,-1,-1,0,-1,{8,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,1,0,0,0,0,-1,-1,0,-1,{0,0,2,0}},{1,0,0,0,0,0,-1,-1,0,191,{0,0,1,9}},{1,0,0,0,0,0,-1,-1,0,192,{1,0,0,9}},{1,0,0,0,1,0,-1,-1,0,-1,{2,0,0,9}},{1,0,1,0,0,4,-1,-1,0,-1,{0,0,0,0}},{1,0,0,0,0,1,-1,-1,0,-1,{0,0,0,0}},{1,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{1,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{1,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}}} // w=9
+        },
+        { // Floor 1
+            {{1,0,0,0,0,0,-1,-1,0,193,{0,9,2,0}},{1,0,0,0,0,0,-1,-1,0,194,{1,9,1,0}},{1,0,0,0,0,4,-1,-1,0,195,{2,9,0,0}},{1,0,0,0,0,1,-1,-1,0,196,{0,9,4,0}},{1,0,0,0,0,0,-1,-1,0,197,{1,9,3,0}},{1,0,0,0,0,0,-1,-1,0,198,{2,9,2,0}},{1,0,0,0,0,0,-1,-1,0,199,{3,9,1,0}},{1,0,0,0,0,0,-1,-1,0,200,{4,9,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{5,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,8,0}},{1,0,0,0,0,0,-1,-1,0,201,{0,9,7,0}},{1,0,0,0,0,0,-1,-1,0,202,{1,9,6,0}},{1,0,0,0,0,0,-1,-1,0,203,{2,8,5,0}},{1,0,0,0,0,0,-1,-1,0,204,{3,9,4,0}},{1,0,0,0,0,0,-1,-1,0,205,{4,9,3,0}},{1,0,0,0,0,0,-1,-1,0,206,{5,9,2,0}},{1,0,0,0,0,0,-1,-1,0,207,{6,9,1,0}},{1,0,0,0,0,0,-1,-1,0,208,{7,4,0,0}}}, // w=0
+            {{1,0,0,0,0,0,-1,-1,0,209,{0,8,2,1}},{1,0,0,0,0,0,-1,-1,0,210,{1,8,1,1}},{1,0,0,0,0,4,-1,-1,0,211,{2,8,0,1}},{1,0,0,0,0,1,-1,-1,0,212,{0,8,4,1}},{1,0,0,0,0,0,-1,-1,0,213,{1,8,3,1}},{1,0,0,0,0,0,-1,-1,0,214,{2,8,2,1}},{1,0,0,0,0,0,-1,-1,0,215,{3,8,1,1}},{1,0,0,0,0,0,-1,-1,0,216,{4,8,0,1}},{0,0,0,0,0,0,-1,-1,0,-1,{5,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,8,0}},{1,0,0,0,0,0,-1,-1,0,217,{0,8,7,1}},{1,0,0,0,0,0,-1,-1,0,218,{1,8,6,1}},{1,0,0,0,0,0,-1,-1,0,219,{2,7,5,1}},{1,0,0,0,0,0,-1,-1,0,220,{3,8,4,1}},{1,0,0,0,0,0,-1,-1,0,221,{4,8,3,1}},{1,0,0,0,0,0,-1,-1,0,222,{5,8,2,1}},{1,0,0,0,0,0,-1,-1,0,223,{6,8,1,1}},{1,0,0,0,0,0,-1,-1,0,224,{7,3,0,1}}}, // w=1
+            {{1,0,0,0,0,0,-1,-1,0,225,{0,7,2,2}},{1,0,0,0,0,0,-1,-1,0,226,{1,7,1,2}},{1,0,0,0,0,4,-1,-1,0,227,{2,7,0,2}},{1,0,0,0,0,1,-1,-1,0,228,{0,7,4,2}},{1,0,0,0,0,0,-1,-1,0,229,{1,7,3,2}},{1,0,0,0,0,0,-1,-1,0,230,{2,7,2,2}},{1,0,0,0,0,0,-1,-1,0,231,{3,7,1,2}},{1,0,0,0,0,0,-1,-1,0,232,{4,7,0,2}},{0,0,0,0,0,0,-1,-1,0,-1,{5,4,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,4,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,2,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,4,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,1,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,4,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,4,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,4,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,4,8,0}},{1,0,0,0,0,0,-1,-1,0,233,{0,7,7,2}},{1,0,0,0,0,0,-1,-1,0,234,{1,7,6,2}},{1,0,0,0,0,0,-1,-1,0,235,{2,6,5,2}},{1,0,0,0,0,0,-1,-1,0,236,{3,7,4,2}},{1,0,0,0,0,0,-1,-1,0,237,{4,7,3,2}},{1,0,0,0,0,0,-1,-1,0,238,{5,7,2,2}},{1,0,0,0,0,0,-1,-1,0,239,{6,7,1,2}},{1,0,0,0,0,0,-1,-1,0,240,{7,2,0,2}}}, // w=2
+            {{1,0,0,0,0,0,-1,-1,0,241,{0,6,2,3}},{1,0,0,0,0,0,-1,-1,0,242,{1,6,1,3}},{1,0,0,0,0,4,-1,-1,0,243,{2,6,0,3}},{1,0,0,0,0,1,-1,-1,0,244,{0,6,21,3}},{1,0,0,0,0,0,-1,-1,0,245,{1,6,20,3}},{1,0,0,0,0,0,-1,-1,0,246,{2,6,19,3}},{1,0,0,0,0,0,-1,-1,0,247,{3,6,18,3}},{1,0,0,0,0,0,-1,-1,0,248,{4,6,17,3}},{1,0,0,0,0,0,-1,-1,0,249,{5,3,16,0}},{1,0,0,0,0,0,-1,-1,0,250,{6,3,15,0}},{1,0,0,0,0,0,-1,-1,0,251,{7,1,14,0}},{1,0,0,0,0,0,-1,-1,0,252,{8,3,13,0}},{1,0,0,0,0,0,-1,-1,0,253,{9,0,12,0}},{1,0,0,0,0,0,-1,-1,0,254,{10,3,11,0}},{1,0,0,0,0,0,-1,-1,0,255,{11,3,10,0}},{1,0,0,0,0,0,-1,-1,0,256,{12,3,9,0}},{1,0,0,0,0,0,-1,-1,0,257,{13,3,8,0}},{1,0,0,0,0,0,-1,-1,0,258,{14,6,7,3}},{1,0,0,0,0,0,-1,-1,0,259,{15,6,6,3}},{1,0,0,0,0,0,-1,-1,0,260,{16,5,5,3}},{1,0,0,0,0,0,-1,-1,0,261,{17,6,4,3}},{1,0,0,0,0,0,-1,-1,0,262,{18,6,3,3}},{1,0,0,0,0,0,-1,-1,0,263,{19,6,2,3}},{1,0,0,0,0,0,-1,-1,0,264,{20,6,1,3}},{1,0,0,0,0,0,-1,-1,0,265,{21,1,0,3}}}, // w=3
+            {{1,0,0,0,0,0,-1,-1,0,266,{0,5,2,4}},{1,0,0,0,0,0,-1,-1,0,267,{1,5,1,4}},{1,0,0,0,0,4,-1,-1,0,268,{2,5,0,4}},{1,0,0,0,0,1,-1,-1,0,269,{0,5,8,4}},{1,0,0,0,0,0,-1,-1,0,270,{1,5,7,4}},{1,0,0,0,0,0,-1,-1,0,271,{2,5,6,4}},{1,0,0,0,0,0,-1,-1,0,272,{3,5,5,4}},{1,0,0,0,0,0,-1,-1,0,273,{4,5,4,4}},{1,0,0,0,0,0,-1,-1,0,274,{5,2,3,1}},{1,0,0,0,0,0,-1,-1,0,275,{6,2,2,1}},{1,0,0,0,0,0,-1,-1,0,276,{7,0,1,1}},{1,0,0,0,0,0,-1,-1,0,277,{8,2,0,1}},{1,0,0,0,0,0,-1,-1,2,278,{9,2,12,1}},{1,0,0,0,0,0,-1,-1,0,279,{0,2,11,1}},{1,0,0,0,0,0,-1,-1,0,280,{1,2,10,1}},{1,0,0,0,0,0,-1,-1,0,281,{2,2,9,1}},{1,0,0,0,0,0,-1,-1,0,282,{3,2,8,1}},{1,0,0,0,0,0,-1,-1,0,283,{4,5,7,4}},{1,0,0,0,0,0,-1,-1,0,284,{5,5,6,4}},{1,0,0,0,0,0,-1,-1,0,285,{6,4,5,4}},{1,0,0,0,0,0,-1,-1,0,286,{7,5,4,4}},{1,0,0,0,0,0,-1,-1,0,287,{8,5,3,4}},{1,0,0,0,0,0,-1,-1,0,288,{9,5,2,4}},{1,0,0,0,0,0,-1,-1,0,289,{10,5,1,4}},{1,0,0,0,0,0,-1,-1,0,290,{11,0,0,4}}}, // w=4
+            {{1,0,0,0,0,0,-1,-1,0,291,{0,4,2,5}},{1,0,0,0,0,0,-1,-1,0,292,{1,4,1,5}},{1,0,0,0,0,4,-1,-1,0,293,{2,4,0,5}},{1,0,0,0,0,1,-1,-1,0,294,{0,4,6,5}},{1,0,0,0,0,0,-1,-1,0,295,{1,4,5,5}},{1,0,0,0,0,0,-1,-1,0,296,{2,4,4,5}},{1,0,0,0,0,0,-1,-1,0,297,{3,4,3,5}},{1,0,0,0,0,0,-1,-1,0,298,{4,4,2,5}},{1,0,0,0,0,0,-1,-1,0,299,{5,1,1,2}},{1,0,0,0,0,0,-1,-1,0,300,{6,1,0,2}},{1,0,0,0,0,0,-1,-1,1,301,{7,1,13,2}},{1,0,0,0,0,0,-1,-1,0,302,{0,1,12,2}},{1,0,0,0,0,0,-1,-1,0,303,{1,1,11,0}},{1,0,0,0,0,0,-1,-1,0,304,{2,1,10,2}},{1,0,0,0,0,0,-1,-1,0,305,{3,1,9,2}},{1,0,0,0,0,0,-1,-1,0,306,{4,1,8,2}},{1,0,0,0,0,0,-1,-1,0,307,{5,1,7,2}},{1,0,0,0,0,0,-1,-1,0,308,{6,4,6,5}},{1,0,0,0,0,0,-1,-1,0,309,{7,4,5,5}},{1,0,0,0,0,0,-1,-1,0,310,{8,3,4,5}},{1,0,0,0,0,0,-1,-1,0,311,{9,4,3,5}},{1,0,0,0,0,0,-1,-1,0,312,{10,4,2,5}},{1,0,0,0,0,0,-1,-1,0,313,{11,4,1,5}},{1,0,0,0,0,0,-1,-1,0,314,{12,4,0,5}},{1,0,0,0,0,0,0,-1,0,315,{13,4,0,5}}}, // w=5
+            {{1,0,0,0,0,0,-1,-1,0,316,{0,3,2,6}},{1,0,0,0,0,0,-1,-1,0,317,{1,3,1,6}},{1,0,0,0,0,4,-1,-1,0,318,{2,3,0,6}},{1,0,0,0,0,1,-1,-1,0,319,{0,3,21,6}},{1,0,0,0,0,0,-1,-1,0,320,{1,3,20,6}},{1,0,0,0,0,0,-1,-1,0,321,{2,3,19,6}},{1,0,0,0,0,0,-1,-1,0,322,{3,3,18,6}},{1,0,0,0,0,0,-1,-1,0,323,{4,3,17,6}},{1,0,0,0,0,0,-1,-1,0,324,{5,0,16,3}},{1,0,0,0,0,0,-1,-1,0,325,{6,0,15,3}},{1,0,0,0,0,0,-1,-1,0,326,{7,0,14,0}},{1,0,0,0,0,0,-1,-1,0,327,{8,0,13,3}},{1,0,0,0,0,0,-1,-1,0,328,{9,0,12,1}},{1,0,0,0,0,0,-1,-1,0,329,{10,0,11,3}},{1,0,0,0,0,0,-1,-1,0,330,{11,0,10,3}},{1,0,0,0,0,0,-1,-1,0,331,{12,0,9,3}},{1,0,0,0,0,0,-1,-1,0,332,{13,0,8,3}},{1,0,0,0,0,0,-1,-1,0,333,{14,3,7,6}},{1,0,0,0,0,0,-1,-1,0,334,{15,3,6,6}},{1,0,0,0,0,0,-1,-1,0,335,{16,2,5,6}},{1,0,0,0,0,0,-1,-1,0,336,{17,3,4,6}},{1,0,0,0,0,0,-1,-1,0,337,{18,3,3,6}},{1,0,0,0,0,0,-1,-1,0,338,{19,3,2,6}},{1,0,0,0,0,0,-1,-1,0,339,{20,3,1,6}},{1,0,0,0,0,0,-1,-1,0,340,{21,3,0,0}}}, // w=6
+            {{1,0,0,0,0,0,-1,-1,0,341,{0,2,2,7}},{1,0,0,0,0,0,-1,-1,0,342,{1,2,1,7}},{1,0,0,0,0,4,-1,-1,0,343,{2,2,0,7}},{1,0,0,0,0,1,-1,-1,0,344,{0,2,4,7}},{1,0,0,0,0,0,-1,-1,0,345,{1,2,3,7}},{1,0,0,0,0,0,-1,-1,0,346,{2,2,2,7}},{1,0,0,0,0,0,-1,-1,0,347,{3,2,1,7}},{1,0,0,0,0,0,-1,-1,0,348,{4,2,0,7}},{0,0,0,0,0,0,-1,-1,0,-1,{5,0,0,4}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,4}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,1}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,4}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,2}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,4}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,4}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,4}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,8,4}},{1,0,0,0,0,0,-1,-1,0,349,{0,2,7,7}},{1,0,0,0,0,0,-1,-1,0,350,{1,2,6,7}},{1,0,0,0,0,0,-1,-1,0,351,{2,1,5,7}},{1,0,0,0,0,0,-1,-1,0,352,{3,2,4,7}},{1,0,0,0,0,0,-1,-1,0,353,{4,2,3,7}},{1,0,0,0,0,0,-1,-1,0,354,{5,2,2,7}},{1,0,0,0,0,0,-1,-1,0,355,{6,2,1,7}},{1,0,0,0,0,0,-1,-1,0,356,{7,2,0,1}}}, // w=7
+            {{1,0,0,0,0,0,-1,-1,0,357,{0,1,2,8}},{1,0,0,0,0,0,-1,-1,0,358,{1,1,1,8}},{1,0,0,0,0,4,-1,-1,0,359,{2,1,0,8}},{1,0,0,0,0,1,-1,-1,0,360,{0,1,4,8}},{1,0,0,0,0,0,-1,-1,0,361,{1,1,3,8}},{1,0,0,0,0,0,-1,-1,0,362,{2,1,2,8}},{1,0,0,0,0,0,-1,-1,0,363,{3,1,1,8}},{1,0,0,0,0,0,-1,-1,0,364,{4,1,0,8}},{0,0,0,0,0,0,-1,-1,0,-1,{5,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,8,0}},{1,0,0,0,0,0,-1,-1,0,365,{0,1,7,8}},{1,0,0,0,0,0,-1,-1,0,366,{1,1,6,8}},{1,0,0,0,0,0,-1,-1,0,367,{2,0,5,8}},{1,0,0,0,0,0,-1,-1,0,368,{3,1,4,8}},{1,0,0,0,0,0,-1,-1,0,369,{4,1,3,8}},{1,0,0,0,0,0,-1,-1,0,370,{5,1,2,8}},{1,0,0,0,0,0,-1,-1,0,371,{6,1,1,8}},{1,0,0,0,0,0,-1,-1,0,372,{7,1,0,2}}}, // w=8
+            {{1,0,0,0,0,0,-1,-1,0,373,{0,0,7,9}},{1,0,0,0,0,0,-1,-1,0,374,{1,0,6,9}},{1,0,0,0,0,0,-1,-1,0,375,{2,0,5,9}},{1,0,0,0,0,0,-1,-1,0,376,{3,0,4,9}},{1,0,0,0,0,0,-1,-1,0,377,{4,0,3,9}},{1,0,0,0,0,0,-1,-1,0,378,{5,0,2,9}},{1,0,0,0,0,0,-1,-1,0,379,{6,0,1,9}},{1,0,0,0,0,0,-1,-1,0,380,{7,0,0,9}},{0,0,0,0,0,0,-1,-1,0,-1,{8,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,2,0}},{1,0,0,0,0,0,-1,-1,0,381,{0,0,1,9}},{1,0,0,0,0,0,-1,-1,0,382,{1,0,0,9}},{1,0,0,0,0,0,-1,-1,0,383,{2,0,5,9}},{1,0,0,0,0,0,-1,-1,0,384,{0,0,4,9}},{1,0,0,0,0,0,-1,-1,0,385,{1,0,3,9}},{1,0,0,0,0,0,-1,-1,0,386,{2,0,2,9}},{1,0,0,0,0,0,-1,-1,0,387,{3,0,1,9}},{1,0,0,0,0,0,-1,-1,0,388,{4,0,0,3}}} // w=9
+        },
+        { // Floor 2
+            {{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,9,0}},{1,0,0,0,0,0,-1,-1,0,389,{0,9,8,0}},{1,0,0,0,0,0,-1,-1,0,390,{1,9,7,0}},{1,0,0,0,0,0,-1,-1,0,391,{2,9,6,0}},{1,0,0,0,0,0,-1,-1,0,392,{3,9,5,0}},{1,0,0,0,0,0,-1,-1,0,393,{4,3,4,0}},{1,0,0,0,0,0,-1,-1,0,394,{5,9,3,0}},{1,0,0,0,0,0,-1,-1,0,395,{6,9,2,0}},{1,0,0,0,0,0,-1,-1,0,396,{7,9,1,0}},{1,0,0,0,0,0,-1,-1,0,397,{8,9,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{9,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}}}, // w=0
+            {{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,9,0}},{1,0,0,0,0,0,-1,-1,0,398,{0,8,8,1}},{1,0,0,0,0,0,-1,-1,0,399,{1,8,7,1}},{1,0,0,0,0,0,-1,-1,0,400,{2,8,6,1}},{1,0,0,0,0,0,-1,-1,0,401,{3,8,5,1}},{1,0,0,0,0,0,-1,-1,0,402,{4,2,4,1}},{1,0,0,0,0,0,-1,-1,0,403,{5,8,3,1}},{1,0,0,0,0,0,-1,-1,0,404,{6,8,2,1}},{1,0,0,0,0,0,-1,-1,0,405,{7,8,1,1}},{1,0,0,0,0,0,-1,-1,0,406,{8,8,0,1}},{0,0,0,0,0,0,-1,-1,0,-1,{9,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}}}, // w=1
+            {{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,9,0}},{1,0,0,0,0,0,-1,-1,0,407,{0,7,8,2}},{1,0,0,0,0,0,-1,-1,0,408,{1,7,7,2}},{1,0,0,0,0,0,-1,-1,0,409,{2,7,6,2}},{1,0,0,0,0,0,-1,-1,0,410,{3,7,5,2}},{1,0,0,0,0,0,-1,-1,0,411,{4,1,4,2}},{1,0,0,0,0,0,-1,-1,0,412,{5,7,3,2}},{1,0,0,0,0,0,-1,-1,0,413,{6,7,2,2}},{1,0,0,0,0,0,-1,-1,0,414,{7,7,1,2}},{1,0,0,0,0,0,-1,-1,0,415,{8,7,0,2}},{0,0,0,0,0,0,-1,-1,0,-1,{9,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}}}, // w=2
+            {{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,9,0}},{1,0,0,0,0,0,-1,-1,0,416,{0,6,8,3}},{1,0,0,0,0,0,-1,-1,0,417,{1,6,7,3}},{1,0,0,0,0,0,-1,-1,0,418,{2,6,6,3}},{1,0,0,0,0,0,-1,-1,0,419,{3,6,5,3}},{1,0,0,0,0,0,-1,-1,0,420,{4,0,4,3}},{1,0,0,0,0,0,-1,-1,0,421,{5,6,3,3}},{1,0,0,0,0,0,-1,-1,0,422,{6,6,2,3}},{1,0,0,0,0,0,-1,-1,0,423,{7,6,1,3}},{1,0,0,0,0,0,-1,-1,0,424,{8,6,0,3}},{0,0,0,0,0,0,-1,-1,0,-1,{9,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}}}, // w=3
+            {{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,4,0}},{1,0,0,0,0,0,-1,-1,0,425,{0,5,3,4}},{1,0,0,0,0,0,-1,-1,0,426,{1,5,2,4}},{1,0,0,0,0,0,-1,-1,0,427,{2,5,1,4}},{1,0,0,0,0,0,-1,-1,0,428,{3,5,0,4}},{1,0,0,0,0,0,-1,-1,2,429,{4,5,4,4}},{1,0,0,0,0,0,-1,-1,0,430,{0,5,3,4}},{1,0,0,0,0,0,-1,-1,0,431,{1,5,2,4}},{1,0,0,0,0,0,-1,-1,0,432,{2,5,1,4}},{1,0,0,0,0,0,-1,-1,0,433,{3,5,0,4}},{0,0,0,0,0,0,-1,-1,0,-1,{4,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}}}, // w=4
+            {{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,9,0}},{1,0,0,0,0,0,-1,-1,0,434,{0,4,8,5}},{1,0,0,0,0,0,-1,-1,0,435,{1,4,7,5}},{1,0,0,0,0,0,-1,-1,0,436,{2,4,6,5}},{1,0,0,0,0,0,-1,-1,0,437,{3,4,5,5}},{1,0,0,0,0,0,-1,-1,0,438,{4,4,4,0}},{1,0,0,0,0,0,-1,-1,0,439,{5,4,3,5}},{1,0,0,0,0,0,-1,-1,0,440,{6,4,2,5}},{1,0,0,0,0,0,-1,-1,0,441,{7,4,1,5}},{1,0,0,0,0,0,-1,-1,0,442,{8,4,0,5}},{0,0,0,0,0,0,-1,-1,0,-1,{9,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,0,0,0,-1,{0,0,0,0}}}, // w=5
+            {{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,9,0}},{1,0,0,0,0,0,-1,-1,0,443,{0,3,8,6}},{1,0,0,0,0,0,-1,-1,0,444,{1,3,7,6}},{1,0,0,0,0,0,-1,-1,0,445,{2,3,6,6}},{1,0,0,0,0,0,-1,-1,0,446,{3,3,5,6}},{1,0,0,0,0,0,-1,-1,0,447,{4,3,4,1}},{1,0,0,0,0,0,-1,-1,0,448,{5,3,3,6}},{1,0,0,0,0,0,-1,-1,0,449,{6,3,2,6}},{1,0,0,0,0,0,-1,-1,0,450,{7,3,1,6}},{1,0,0,0,0,0,-1,-1,0,451,{8,3,0,6}},{0,0,0,0,0,0,-1,-1,0,-1,{9,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}}}, // w=6
+            {{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,9,0}},{1,0,0,0,0,0,-1,-1,0,452,{0,2,8,7}},{1,0,0,0,0,0,-1,-1,0,453,{1,2,7,7}},{1,0,0,0,0,0,-1,-1,0,454,{2,2,6,7}},{1,0,0,0,0,0,-1,-1,0,455,{3,2,5,7}},{1,0,0,0,0,0,-1,-1,0,456,{4,2,4,2}},{1,0,0,0,0,0,-1,-1,0,457,{5,2,3,7}},{1,0,0,0,0,0,-1,-1,0,458,{6,2,2,7}},{1,0,0,0,0,0,-1,-1,0,459,{7,2,1,7}},{1,0,0,0,0,0,-1,-1,0,460,{8,2,0,7}},{0,0,0,0,0,0,-1,-1,0,-1,{9,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}}}, // w=7
+            {{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,9,0}},{1,0,0,0,0,0,-1,-1,0,461,{0,1,8,8}},{1,0,0,0,0,0,-1,-1,0,462,{1,1,7,8}},{1,0,0,0,0,0,-1,-1,0,463,{2,1,6,8}},{1,0,0,0,0,0,-1,-1,0,464,{3,1,5,8}},{1,0,0,0,0,0,-1,-1,0,465,{4,1,4,3}},{1,0,0,0,0,0,-1,-1,0,466,{5,1,3,8}},{1,0,0,0,0,0,-1,-1,0,467,{6,1,2,8}},{1,0,0,0,0,0,-1,-1,0,468,{7,1,1,8}},{1,0,0,0,0,0,-1,-1,0,469,{8,1,0,8}},{0,0,0,0,0,0,-1,-1,0,-1,{9,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}}}, // w=8
+            {{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,9,0}},{1,0,0,0,0,0,-1,-1,0,470,{0,0,8,9}},{1,0,0,0,0,0,-1,-1,0,471,{1,0,7,9}},{1,0,0,0,0,0,-1,-1,0,472,{2,0,6,9}},{1,0,0,0,0,0,-1,-1,0,473,{3,0,5,9}},{1,0,0,0,0,0,-1,-1,0,474,{4,0,4,4}},{1,0,0,0,0,0,-1,-1,0,475,{5,0,3,9}},{1,0,0,0,0,0,-1,-1,0,476,{6,0,2,9}},{1,0,0,0,0,0,-1,-1,0,477,{7,0,1,9}},{1,0,0,0,0,0,-1,-1,0,478,{8,0,0,9}},{0,0,0,0,0,0,-1,-1,0,-1,{9,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}},{0,0,0,0,0,0,-1,-1,0,-1,{0,0,0,0}}} // w=9
+        }
+    },
+    479
+};
+
+#endif // LAYOUT_DEFAULT_H
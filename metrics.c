@@ -0,0 +1,316 @@
+// metrics.c - Sharded counters and their Prometheus exporters (see metrics.h)
+
+#include "metrics.h"
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+_Thread_local MetricsShard *metrics_thread;
+
+static MetricsShard metrics_shards[METRICS_MAX_SHARDS];
+static atomic_int metrics_shards_claimed;
+
+// Exporter threads
+typedef struct {
+    uint64_t turns;             // Turns at the previous collection, for turns per second
+    double time;
+} MetricsRate;
+
+static pthread_mutex_t exporter_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t exporter_cond = PTHREAD_COND_INITIALIZER;
+static int exporter_stopping;
+static pthread_t socket_thread, file_thread;
+static int socket_running, file_running;
+static int socket_fd = -1;
+static char socket_path[108];
+static char *file_path;
+static int file_interval_ms;
+static double start_time;
+
+static const char *const block_labels[METRICS_NUM_BLOCKS] = { "none", "wall", "invalid_cell", "bawana_entrance" };
+static const char *const bawana_labels[METRICS_NUM_BAWANA] = {
+    "food_poisoning", "disoriented", "triggered", "happy", "random_mp"
+};
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+MetricsShard *metrics_claim_shard(void) {
+    int index = atomic_fetch_add_explicit(&metrics_shards_claimed, 1, memory_order_relaxed);
+    if (index >= METRICS_MAX_SHARDS) index = METRICS_MAX_SHARDS - 1;
+    metrics_thread = &metrics_shards[index];
+    return metrics_thread;
+}
+
+// Sum every shard in use; game threads keep counting while this runs
+static void metrics_collect(MetricsShard *total) {
+    memset(total, 0, sizeof(*total));
+    int claimed = atomic_load_explicit(&metrics_shards_claimed, memory_order_relaxed);
+    if (claimed > METRICS_MAX_SHARDS) claimed = METRICS_MAX_SHARDS;
+#define METRICS_SUM(field) \
+    atomic_store_explicit(&total->field, atomic_load_explicit(&total->field, memory_order_relaxed) + \
+                          atomic_load_explicit(&shard->field, memory_order_relaxed), memory_order_relaxed)
+    for (int s = 0; s < claimed; s++) {
+        const MetricsShard *shard = &metrics_shards[s];
+        METRICS_SUM(games_started);
+        METRICS_SUM(games_finished);
+        METRICS_SUM(games_won);
+        METRICS_SUM(turns);
+        METRICS_SUM(captures);
+        METRICS_SUM(loop_resets);
+        METRICS_SUM(mp_sum);
+        for (int i = 0; i < METRICS_NUM_BLOCKS; i++) METRICS_SUM(blocked_moves[i]);
+        for (int i = 0; i < METRICS_NUM_BAWANA; i++) METRICS_SUM(bawana_effects[i]);
+        for (int i = 0; i < METRICS_MP_BUCKETS; i++) METRICS_SUM(mp_histogram[i]);
+    }
+#undef METRICS_SUM
+}
+
+// MP below which a `quantile` share of turns ended, interpolated inside its histogram bucket
+static double mp_quantile(const MetricsShard *total, uint64_t count, double quantile) {
+    if (count == 0) return 0.0;
+    double target = quantile * (double)count;
+    uint64_t below = 0;
+    for (int b = 0; b < METRICS_MP_BUCKETS; b++) {
+        uint64_t in_bucket = atomic_load_explicit(&total->mp_histogram[b], memory_order_relaxed);
+        if (in_bucket > 0 && (double)(below + in_bucket) >= target) {
+            if (b == 0) return 0.0;
+            double lower = 10.0 * (b - 1);
+            if (b == METRICS_MP_BUCKETS - 1) return lower;  // Open-ended: its lower bound
+            return lower + 10.0 * (target - (double)below) / (double)in_bucket;
+        }
+        below += in_bucket;
+    }
+    return 10.0 * (METRICS_MP_BUCKETS - 2);
+}
+
+static void metrics_format(FILE *out, MetricsRate *rate) {
+    static MetricsShard total;  // Only touched with exporter_lock held
+    metrics_collect(&total);
+    double now = now_seconds();
+    uint64_t turns = atomic_load_explicit(&total.turns, memory_order_relaxed);
+    double turns_per_second = now > rate->time ? (double)(turns - rate->turns) / (now - rate->time) : 0.0;
+    rate->turns = turns;
+    rate->time = now;
+
+#define METRICS_COUNTER(name, help, field) \
+    fprintf(out, "# HELP " name " " help "\n# TYPE " name " counter\n" name " %llu\n", \
+            (unsigned long long)atomic_load_explicit(&total.field, memory_order_relaxed))
+    METRICS_COUNTER("maze_games_started_total", "Games set up.", games_started);
+    METRICS_COUNTER("maze_games_finished_total", "Games ended, won or not.", games_finished);
+    METRICS_COUNTER("maze_games_won_total", "Games ended by a flag capture.", games_won);
+    METRICS_COUNTER("maze_turns_total", "Turns played.", turns);
+    METRICS_COUNTER("maze_captures_total", "Players sent back to the start by another player.", captures);
+    METRICS_COUNTER("maze_loop_resets_total", "Players reset after an infinite loop.", loop_resets);
+#undef METRICS_COUNTER
+
+    fprintf(out, "# HELP maze_turns_per_second Turns per second since the previous collection.\n"
+                 "# TYPE maze_turns_per_second gauge\nmaze_turns_per_second %.1f\n", turns_per_second);
+
+    fprintf(out, "# HELP maze_blocked_moves_total Moves stopped, by reason.\n# TYPE maze_blocked_moves_total counter\n");
+    for (int i = 1; i < METRICS_NUM_BLOCKS; i++) {
+        fprintf(out, "maze_blocked_moves_total{reason=\"%s\"} %llu\n", block_labels[i],
+                (unsigned long long)atomic_load_explicit(&total.blocked_moves[i], memory_order_relaxed));
+    }
+    fprintf(out, "# HELP maze_bawana_effects_total Bawana effects given, by effect.\n"
+                 "# TYPE maze_bawana_effects_total counter\n");
+    for (int i = 0; i < METRICS_NUM_BAWANA; i++) {
+        fprintf(out, "maze_bawana_effects_total{effect=\"%s\"} %llu\n", bawana_labels[i],
+                (unsigned long long)atomic_load_explicit(&total.bawana_effects[i], memory_order_relaxed));
+    }
+
+    static const double quantiles[] = { 0.5, 0.9, 0.99 };
+    fprintf(out, "# HELP maze_movement_points MP of the player after each turn.\n"
+                 "# TYPE maze_movement_points summary\n");
+    for (size_t q = 0; q < sizeof(quantiles) / sizeof(quantiles[0]); q++) {
+        fprintf(out, "maze_movement_points{quantile=\"%g\"} %.1f\n", quantiles[q],
+                mp_quantile(&total, turns, quantiles[q]));
+    }
+    fprintf(out, "maze_movement_points_sum %lld\nmaze_movement_points_count %llu\n",
+            (long long)atomic_load_explicit(&total.mp_sum, memory_order_relaxed), (unsigned long long)turns);
+}
+
+void metrics_write(FILE *out) {
+    MetricsRate rate = { 0, start_time };
+    pthread_mutex_lock(&exporter_lock);
+    metrics_format(out, &rate);
+    pthread_mutex_unlock(&exporter_lock);
+}
+
+// Format into a heap buffer; returns NULL when out of memory
+static char *metrics_render(MetricsRate *rate, size_t *length) {
+    char *text = NULL;
+    FILE *out = open_memstream(&text, length);
+    if (!out) return NULL;
+    pthread_mutex_lock(&exporter_lock);
+    metrics_format(out, rate);
+    pthread_mutex_unlock(&exporter_lock);
+    fclose(out);
+    return text;
+}
+
+static void write_all(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return;
+        data += written;
+        length -= (size_t)written;
+    }
+}
+
+// One client at a time: read what it sent (an HTTP request or nothing), answer, close
+static void *socket_main(void *arg) {
+    (void)arg;
+    MetricsRate rate = { 0, start_time };
+    struct pollfd listener = { socket_fd, POLLIN, 0 };
+    while (1) {
+        pthread_mutex_lock(&exporter_lock);
+        int stopping = exporter_stopping;
+        pthread_mutex_unlock(&exporter_lock);
+        if (stopping) break;
+        if (poll(&listener, 1, 200) <= 0) continue;
+
+        int client = accept(socket_fd, NULL, NULL);
+        if (client < 0) continue;
+        char request[1024];
+        struct pollfd peer = { client, POLLIN, 0 };
+        if (poll(&peer, 1, 100) > 0) {
+            ssize_t received = read(client, request, sizeof(request));
+            (void)received;
+        }
+        size_t length = 0;
+        char *body = metrics_render(&rate, &length);
+        if (body) {
+            char header[128];
+            int header_length = snprintf(header, sizeof(header),
+                                         "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n"
+                                         "Content-Length: %zu\r\n\r\n", length);
+            write_all(client, header, (size_t)header_length);
+            write_all(client, body, length);
+            free(body);
+        }
+        close(client);
+    }
+    return NULL;
+}
+
+int metrics_serve_socket(const char *path) {
+    struct sockaddr_un address;
+    if (socket_running || strlen(path) >= sizeof(address.sun_path)) return 0;
+    if (start_time == 0.0) start_time = now_seconds();
+
+    socket_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socket_fd < 0) return 0;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+    unlink(path);
+    if (bind(socket_fd, (struct sockaddr *)&address, sizeof(address)) != 0 || listen(socket_fd, 16) != 0) {
+        close(socket_fd);
+        socket_fd = -1;
+        return 0;
+    }
+    strcpy(socket_path, path);
+    if (pthread_create(&socket_thread, NULL, socket_main, NULL) != 0) {
+        close(socket_fd);
+        unlink(path);
+        return 0;
+    }
+    socket_running = 1;
+    return 1;
+}
+
+// Write to a temporary file next to `file_path` and rename it over, so readers never see half a file
+static void write_metrics_file(MetricsRate *rate) {
+    size_t length = 0;
+    char *body = metrics_render(rate, &length);
+    if (!body) return;
+    size_t path_length = strlen(file_path);
+    char *temporary = malloc(path_length + 5);
+    if (temporary) {
+        memcpy(temporary, file_path, path_length);
+        memcpy(temporary + path_length, ".tmp", 5);
+        FILE *out = fopen(temporary, "w");
+        if (out) {
+            int ok = fwrite(body, 1, length, out) == length;
+            if (fclose(out) == 0 && ok) rename(temporary, file_path);
+            else unlink(temporary);
+        }
+        free(temporary);
+    }
+    free(body);
+}
+
+static void *file_main(void *arg) {
+    MetricsRate *rate = arg;
+    pthread_mutex_lock(&exporter_lock);
+    while (!exporter_stopping) {
+        pthread_mutex_unlock(&exporter_lock);
+        write_metrics_file(rate);
+        pthread_mutex_lock(&exporter_lock);
+
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += file_interval_ms / 1000;
+        deadline.tv_nsec += (long)(file_interval_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        while (!exporter_stopping && pthread_cond_timedwait(&exporter_cond, &exporter_lock, &deadline) != ETIMEDOUT) {
+        }
+    }
+    pthread_mutex_unlock(&exporter_lock);
+    return NULL;
+}
+
+int metrics_write_file_every(const char *path, int interval_ms) {
+    static MetricsRate file_rate;
+    if (file_running) return 0;
+    if (start_time == 0.0) start_time = now_seconds();
+    file_path = strdup(path);
+    if (!file_path) return 0;
+    file_interval_ms = interval_ms > 0 ? interval_ms : 1000;
+    file_rate.turns = 0;
+    file_rate.time = start_time;
+    if (pthread_create(&file_thread, NULL, file_main, &file_rate) != 0) {
+        free(file_path);
+        file_path = NULL;
+        return 0;
+    }
+    file_running = 1;
+    return 1;
+}
+
+void metrics_stop(void) {
+    pthread_mutex_lock(&exporter_lock);
+    exporter_stopping = 1;
+    pthread_cond_broadcast(&exporter_cond);
+    pthread_mutex_unlock(&exporter_lock);
+
+    if (socket_running) {
+        pthread_join(socket_thread, NULL);
+        close(socket_fd);
+        unlink(socket_path);
+        socket_running = 0;
+    }
+    if (file_running) {
+        pthread_join(file_thread, NULL);
+        // The final counts, so a batch run leaves its totals behind
+        MetricsRate rate = { 0, start_time };
+        write_metrics_file(&rate);
+        free(file_path);
+        file_path = NULL;
+        file_running = 0;
+    }
+}
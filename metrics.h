@@ -0,0 +1,87 @@
+// metrics.h - Prometheus metrics for long-running hosts (server, simulate)
+// Games started and finished, turns, captures, loop resets, blocked moves by
+// reason, Bawana effects and the MP after each turn are counted by the
+// METRICS_* hooks. Each thread counts into its own cache-line-aligned shard
+// with relaxed atomic adds, so the hot path never shares a cache line with
+// another game thread. An exporter thread sums the shards whenever it is
+// asked, which never blocks or slows the game threads, and serves the result
+// in Prometheus text format on a UNIX socket (as an HTTP response, so
+// `curl --unix-socket` and a Prometheus proxy both work) or rewrites a file
+// atomically at an interval (for node_exporter's textfile collector).
+// Compile with -DGAME_METRICS (and link metrics.c) to build the hooks in;
+// without the flag every METRICS_* macro expands to nothing.
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define METRICS_MAX_SHARDS  64   // Threads beyond this share the last shard (still exact, just contended)
+#define METRICS_MP_BUCKETS  32   // Same buckets as stats.h: <=0, 1-10, 11-20, ... and open-ended
+#define METRICS_NUM_BAWANA  5    // BA_FOOD_POISONING .. BA_RANDOM_MP
+#define METRICS_NUM_BLOCKS  4    // BLOCK_NONE .. BLOCK_BAWANA_ENTRANCE
+
+typedef struct {
+    _Atomic uint64_t games_started;
+    _Atomic uint64_t games_finished;
+    _Atomic uint64_t games_won;
+    _Atomic uint64_t turns;
+    _Atomic uint64_t captures;
+    _Atomic uint64_t loop_resets;
+    _Atomic uint64_t blocked_moves[METRICS_NUM_BLOCKS];
+    _Atomic uint64_t bawana_effects[METRICS_NUM_BAWANA];
+    _Atomic uint64_t mp_histogram[METRICS_MP_BUCKETS];
+    _Atomic int64_t mp_sum;
+} __attribute__((aligned(64))) MetricsShard;
+
+// The calling thread's shard (NULL until its first count)
+extern _Thread_local MetricsShard *metrics_thread;
+
+MetricsShard *metrics_claim_shard(void);
+
+// Write all counters in Prometheus text format
+void metrics_write(FILE *out);
+
+// Serve the metrics to every client that connects to the UNIX socket at `path`; returns 0 on failure
+int metrics_serve_socket(const char *path);
+
+// Rewrite `path` (through a temporary file and rename) every `interval_ms`; returns 0 on failure
+int metrics_write_file_every(const char *path, int interval_ms);
+
+// Write the file once more and stop the exporter threads (at exit)
+void metrics_stop(void);
+
+#ifdef GAME_METRICS
+#define METRICS_SHARD() (metrics_thread ? metrics_thread : metrics_claim_shard())
+#define METRICS_ADD(field, amount) atomic_fetch_add_explicit(&METRICS_SHARD()->field, (amount), memory_order_relaxed)
+#define METRICS_GAME_START()       ((void)METRICS_ADD(games_started, 1))
+#define METRICS_GAME_END(won) \
+    do { METRICS_ADD(games_finished, 1); if (won) METRICS_ADD(games_won, 1); } while (0)
+#define METRICS_TURN(movement_points) \
+    do { \
+        MetricsShard *metrics_shard = METRICS_SHARD(); \
+        int metrics_mp = (movement_points); \
+        int metrics_bucket = metrics_mp <= 0 ? 0 : (metrics_mp - 1) / 10 + 1; \
+        if (metrics_bucket >= METRICS_MP_BUCKETS) metrics_bucket = METRICS_MP_BUCKETS - 1; \
+        atomic_fetch_add_explicit(&metrics_shard->turns, 1, memory_order_relaxed); \
+        atomic_fetch_add_explicit(&metrics_shard->mp_histogram[metrics_bucket], 1, memory_order_relaxed); \
+        atomic_fetch_add_explicit(&metrics_shard->mp_sum, metrics_mp, memory_order_relaxed); \
+    } while (0)
+#define METRICS_CAPTURE()          ((void)METRICS_ADD(captures, 1))
+#define METRICS_LOOP_RESET()       ((void)METRICS_ADD(loop_resets, 1))
+#define METRICS_BLOCKED(reason)    ((void)METRICS_ADD(blocked_moves[reason], 1))
+#define METRICS_BAWANA(type) \
+    do { if ((type) >= 0 && (type) < METRICS_NUM_BAWANA) METRICS_ADD(bawana_effects[type], 1); } while (0)
+#else
+#define METRICS_GAME_START()       ((void)0)
+#define METRICS_GAME_END(won)      ((void)0)
+#define METRICS_TURN(movement_points) ((void)0)
+#define METRICS_CAPTURE()          ((void)0)
+#define METRICS_LOOP_RESET()       ((void)0)
+#define METRICS_BLOCKED(reason)    ((void)0)
+#define METRICS_BAWANA(type)       ((void)0)
+#endif
+
+#endif // METRICS_H
@@ -0,0 +1,343 @@
+// pathfind.c - Cluster graph for reachability and distance queries (see pathfind.h)
+
+#include "pathfind.h"
+#include <limits.h>
+
+static const int step_w[4] = {0, 1, 0, -1};
+static const int step_l[4] = {-1, 0, 1, 0};
+
+#define CELL_INDEX(f, w, l) (((f) * FLOOR_WIDTH + (w)) * FLOOR_LENGTH + (l))
+
+static int cell_floor(int cell) { return cell / (FLOOR_WIDTH * FLOOR_LENGTH); }
+static int cell_w(int cell) { return cell / FLOOR_LENGTH % FLOOR_WIDTH; }
+static int cell_l(int cell) { return cell % FLOOR_LENGTH; }
+
+// Can a player step from (f, w, l) in `direction`? (the walking edges of is_flag_reachable())
+static int can_step(const PathGraph *graph, int f, int w, int l, int direction) {
+    int nw = w + step_w[direction], nl = l + step_l[direction];
+    if (nw < 0 || nw >= FLOOR_WIDTH || nl < 0 || nl >= FLOOR_LENGTH) return 0;
+    if (!(graph->open[f][nw][nl] & PATH_OPEN)) return 0;
+    return !(graph->open[f][w][l] >> direction & 1);
+}
+
+static int same_cluster(int w, int l, int nw, int nl) {
+    return w / PATH_CLUSTER_W == nw / PATH_CLUSTER_W && l / PATH_CLUSTER_L == nl / PATH_CLUSTER_L;
+}
+
+// Walking distances from (f, w, l) to every cell of its cluster without leaving it, into
+// local[] (PATH_UNREACHABLE where there is no such path); `reverse` gives distances to the cell
+static void cluster_bfs(const PathGraph *graph, int f, int w, int l, int reverse,
+                        unsigned short local[PATH_CLUSTER_CELLS]) {
+    int w0 = w / PATH_CLUSTER_W * PATH_CLUSTER_W, l0 = l / PATH_CLUSTER_L * PATH_CLUSTER_L;
+    int queue[PATH_CLUSTER_CELLS], head = 0, tail = 0;
+    for (int i = 0; i < PATH_CLUSTER_CELLS; i++) local[i] = PATH_UNREACHABLE;
+
+    local[(w - w0) * PATH_CLUSTER_L + (l - l0)] = 0;
+    queue[tail++] = (w - w0) * PATH_CLUSTER_L + (l - l0);
+    while (head < tail) {
+        int here = queue[head++];
+        int cw = w0 + here / PATH_CLUSTER_L, cl = l0 + here % PATH_CLUSTER_L;
+        for (int dir = 0; dir < 4; dir++) {
+            int nw = cw + step_w[dir], nl = cl + step_l[dir];
+            if (nw < w0 || nw >= w0 + PATH_CLUSTER_W || nl < l0 || nl >= l0 + PATH_CLUSTER_L) continue;
+            if (nw >= FLOOR_WIDTH || nl >= FLOOR_LENGTH) continue;
+            // Walking backwards: the step must lead from the neighbour to this cell
+            if (reverse ? !(graph->open[f][cw][cl] & PATH_OPEN) || (graph->open[f][nw][nl] >> ((dir + 2) % 4) & 1) ||
+                          !(graph->open[f][nw][nl] & PATH_OPEN)
+                        : !can_step(graph, f, cw, cl, dir)) {
+                continue;
+            }
+            int next = (nw - w0) * PATH_CLUSTER_L + (nl - l0);
+            if (local[next] != PATH_UNREACHABLE) continue;
+            local[next] = local[here] + 1;
+            queue[tail++] = next;
+        }
+    }
+}
+
+static int is_portal(const PathGraph *graph, int f, int w, int l) {
+    if (graph->stair_mask[f][w][l]) return 1;
+    for (int p = 0; p < graph->num_poles; p++) {
+        const Pole *pole = &graph->poles[p];
+        if (pole->w == w && pole->l == l && (pole->start_floor == f || pole->end_floor == f)) return 1;
+    }
+    return 0;
+}
+
+// Find the nodes of one cluster and the distances between them
+static void build_cluster(PathGraph *graph, int f, int cw, int cl) {
+    PathCluster *cluster = &graph->clusters[f][cw][cl];
+    int w0 = cw * PATH_CLUSTER_W, l0 = cl * PATH_CLUSTER_L;
+    int w1 = w0 + PATH_CLUSTER_W < FLOOR_WIDTH ? w0 + PATH_CLUSTER_W : FLOOR_WIDTH;
+    int l1 = l0 + PATH_CLUSTER_L < FLOOR_LENGTH ? l0 + PATH_CLUSTER_L : FLOOR_LENGTH;
+
+    cluster->num_nodes = 0;
+    for (int w = w0; w < w1; w++) {
+        for (int l = l0; l < l1; l++) {
+            graph->node_of_cell[f][w][l] = -1;
+            if (!(graph->open[f][w][l] & PATH_OPEN)) continue;
+            int node = is_portal(graph, f, w, l);
+            for (int dir = 0; dir < 4 && !node; dir++) {
+                int nw = w + step_w[dir], nl = l + step_l[dir];
+                if (nw < 0 || nw >= FLOOR_WIDTH || nl < 0 || nl >= FLOOR_LENGTH || same_cluster(w, l, nw, nl)) continue;
+                node = can_step(graph, f, w, l, dir) || can_step(graph, f, nw, nl, (dir + 2) % 4);
+            }
+            if (node) {
+                graph->node_of_cell[f][w][l] = (signed char)cluster->num_nodes;
+                cluster->node_cell[cluster->num_nodes++] = (short)CELL_INDEX(f, w, l);
+            }
+        }
+    }
+
+    unsigned short local[PATH_CLUSTER_CELLS];
+    for (int a = 0; a < cluster->num_nodes; a++) {
+        int cell = cluster->node_cell[a];
+        cluster_bfs(graph, f, cell_w(cell), cell_l(cell), 0, local);
+        for (int b = 0; b < cluster->num_nodes; b++) {
+            int other = cluster->node_cell[b];
+            cluster->distance[a][b] = local[(cell_w(other) - w0) * PATH_CLUSTER_L + (cell_l(other) - l0)];
+        }
+    }
+    graph->clusters_rebuilt++;
+}
+
+static void snapshot_layout(const MazeLayout *layout,
+                            unsigned char open[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH]) {
+    for (int f = 0; f < NUM_FLOORS; f++) {
+        for (int w = 0; w < FLOOR_WIDTH; w++) {
+            for (int l = 0; l < FLOOR_LENGTH; l++) {
+                open[f][w][l] = (unsigned char)((is_valid_position(layout, f, w, l) ? PATH_OPEN : 0) |
+                                                (layout->cells[f][w][l].wall_mask & 0x0F));
+            }
+        }
+    }
+}
+
+void path_graph_build(PathGraph *graph, const MazeLayout *layout, const Stair stairs[], int num_stairs,
+                      const Pole poles[], int num_poles, const StairEpoch *epoch) {
+    memcpy(graph->stairs, stairs, sizeof(Stair) * (size_t)num_stairs);
+    graph->num_stairs = num_stairs;
+    graph->stair_epoch = epoch ? epoch->epoch : 0;
+    memcpy(graph->poles, poles, sizeof(Pole) * (size_t)num_poles);
+    graph->num_poles = num_poles;
+    graph->clusters_rebuilt = 0;
+
+    memset(graph->stair_mask, 0, sizeof(graph->stair_mask));
+    for (int i = 0; i < num_stairs; i++) {
+        graph->stair_mask[stairs[i].start_floor][stairs[i].start_w][stairs[i].start_l] |= (unsigned short)(1u << i);
+        graph->stair_mask[stairs[i].end_floor][stairs[i].end_w][stairs[i].end_l] |= (unsigned short)(1u << i);
+    }
+    snapshot_layout(layout, graph->open);
+    for (int f = 0; f < NUM_FLOORS; f++) {
+        for (int cw = 0; cw < PATH_CLUSTERS_W; cw++) {
+            for (int cl = 0; cl < PATH_CLUSTERS_L; cl++) build_cluster(graph, f, cw, cl);
+        }
+    }
+}
+
+int path_graph_sync_stairs(PathGraph *graph, const Stair stairs[], const StairEpoch *epoch) {
+    if (epoch->epoch == graph->stair_epoch) return 0;
+    int changed[MAX_STAIRS], num_changed;
+    if (epoch->epoch > graph->stair_epoch) {
+        num_changed = stair_epoch_changed_since(epoch, graph->num_stairs, graph->stair_epoch, changed);
+    } else {
+        // An older epoch than the graph's: not a later state of the same game, so take every stair
+        for (num_changed = 0; num_changed < graph->num_stairs; num_changed++) changed[num_changed] = num_changed;
+    }
+    for (int i = 0; i < num_changed; i++) {
+        graph->stairs[changed[i]].direction_type = stairs[changed[i]].direction_type;
+    }
+    graph->stair_epoch = epoch->epoch;
+    return num_changed;
+}
+
+int path_graph_update_layout(PathGraph *graph, const MazeLayout *layout) {
+    static _Thread_local unsigned char open[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH];
+    unsigned char dirty[NUM_FLOORS][PATH_CLUSTERS_W][PATH_CLUSTERS_L] = {{{0}}};
+    snapshot_layout(layout, open);
+
+    for (int f = 0; f < NUM_FLOORS; f++) {
+        for (int w = 0; w < FLOOR_WIDTH; w++) {
+            for (int l = 0; l < FLOOR_LENGTH; l++) {
+                if (open[f][w][l] == graph->open[f][w][l]) continue;
+                // The cell's own cluster, and those whose border nodes step to or from it
+                dirty[f][w / PATH_CLUSTER_W][l / PATH_CLUSTER_L] = 1;
+                for (int dir = 0; dir < 4; dir++) {
+                    int nw = w + step_w[dir], nl = l + step_l[dir];
+                    if (nw < 0 || nw >= FLOOR_WIDTH || nl < 0 || nl >= FLOOR_LENGTH) continue;
+                    dirty[f][nw / PATH_CLUSTER_W][nl / PATH_CLUSTER_L] = 1;
+                }
+            }
+        }
+    }
+    memcpy(graph->open, open, sizeof(open));
+
+    int rebuilt = 0;
+    for (int f = 0; f < NUM_FLOORS; f++) {
+        for (int cw = 0; cw < PATH_CLUSTERS_W; cw++) {
+            for (int cl = 0; cl < PATH_CLUSTERS_L; cl++) {
+                if (!dirty[f][cw][cl]) continue;
+                build_cluster(graph, f, cw, cl);
+                rebuilt++;
+            }
+        }
+    }
+    return rebuilt;
+}
+
+// ---- Queries ----
+
+// Search state, reused by every query on a thread. Moves cost at most
+// PATH_CLUSTER_CELLS - 1, so a ring of PATH_QUEUE_BUCKETS buckets indexed by
+// distance is a priority queue with O(1) push and pop (Dial's algorithm).
+// Distances are valid only where stamp[] holds the query's number, which saves
+// clearing them before every query.
+#define PATH_QUEUE_BUCKETS  PATH_CLUSTER_CELLS
+#define PATH_QUEUE_ENTRIES  (PATH_NUM_CELLS * (PATH_CLUSTER_CELLS + 8))
+
+typedef struct {
+    int distance[PATH_NUM_CELLS];
+    unsigned int stamp[PATH_NUM_CELLS];
+    unsigned int query;
+    int head[PATH_QUEUE_BUCKETS];       // Last entry pushed at each distance modulo the ring (-1 = empty)
+    int entry_cell[PATH_QUEUE_ENTRIES];
+    int entry_next[PATH_QUEUE_ENTRIES];
+    int num_entries, queued;
+} PathSearch;
+
+static int search_distance(const PathSearch *search, int cell) {
+    return search->stamp[cell] == search->query ? search->distance[cell] : INT_MAX;
+}
+
+// Queue `cell` at `d` unless it is already queued or settled at `d` or less
+static void search_offer(PathSearch *search, int cell, int d) {
+    if (d >= search_distance(search, cell) || search->num_entries == PATH_QUEUE_ENTRIES) return;
+    search->distance[cell] = d;
+    search->stamp[cell] = search->query;
+    int entry = search->num_entries++;
+    search->entry_cell[entry] = cell;
+    search->entry_next[entry] = search->head[d % PATH_QUEUE_BUCKETS];
+    search->head[d % PATH_QUEUE_BUCKETS] = entry;
+    search->queued++;
+}
+
+// Next cell in order of distance from `*d` on (-1 = none left); stale entries are skipped
+static int search_pop(PathSearch *search, int *d) {
+    while (search->queued > 0) {
+        int bucket = *d % PATH_QUEUE_BUCKETS;
+        int entry = search->head[bucket];
+        if (entry < 0) {
+            (*d)++;
+            continue;
+        }
+        search->head[bucket] = search->entry_next[entry];
+        search->queued--;
+        int cell = search->entry_cell[entry];
+        if (search->distance[cell] == *d) return cell;
+    }
+    return -1;
+}
+
+int path_graph_distance(const PathGraph *graph, const int sources[][3], int num_sources, const int target[3]) {
+    int tf = target[0], tw = target[1], tl = target[2];
+    if (tf < 0 || tf >= NUM_FLOORS || tw < 0 || tw >= FLOOR_WIDTH || tl < 0 || tl >= FLOOR_LENGTH ||
+        !(graph->open[tf][tw][tl] & PATH_OPEN)) {
+        return -1;
+    }
+    static _Thread_local PathSearch search;
+    if (++search.query == 0) {
+        memset(search.stamp, 0, sizeof(search.stamp));
+        search.query = 1;
+    }
+    memset(search.head, 0xFF, sizeof(search.head));
+    search.num_entries = 0;
+    search.queued = 0;
+
+    // Walking distances to the target from inside its own cluster
+    unsigned short to_target[PATH_CLUSTER_CELLS], local[PATH_CLUSTER_CELLS];
+    int tw0 = tw / PATH_CLUSTER_W * PATH_CLUSTER_W, tl0 = tl / PATH_CLUSTER_L * PATH_CLUSTER_L;
+    cluster_bfs(graph, tf, tw, tl, 1, to_target);
+
+    int best = INT_MAX;
+    for (int s = 0; s < num_sources; s++) {
+        int sf = sources[s][0], sw = sources[s][1], sl = sources[s][2];
+        if (sf < 0 || sf >= NUM_FLOORS || sw < 0 || sw >= FLOOR_WIDTH || sl < 0 || sl >= FLOOR_LENGTH ||
+            !(graph->open[sf][sw][sl] & PATH_OPEN)) {
+            continue;
+        }
+        // Into the graph through the source cluster's nodes (or straight to the target beside it)
+        if (sf == tf && same_cluster(sw, sl, tw, tl)) {
+            int d = to_target[(sw - tw0) * PATH_CLUSTER_L + (sl - tl0)];
+            if (d != PATH_UNREACHABLE && d < best) best = d;
+        }
+        cluster_bfs(graph, sf, sw, sl, 0, local);
+        const PathCluster *cluster = &graph->clusters[sf][sw / PATH_CLUSTER_W][sl / PATH_CLUSTER_L];
+        int sw0 = sw / PATH_CLUSTER_W * PATH_CLUSTER_W, sl0 = sl / PATH_CLUSTER_L * PATH_CLUSTER_L;
+        for (int n = 0; n < cluster->num_nodes; n++) {
+            int cell = cluster->node_cell[n];
+            int d = local[(cell_w(cell) - sw0) * PATH_CLUSTER_L + (cell_l(cell) - sl0)];
+            if (d != PATH_UNREACHABLE) search_offer(&search, cell, d);
+        }
+    }
+
+    int d = 0, cell;
+    while ((cell = search_pop(&search, &d)) >= 0) {
+        if (d >= best) break;
+        int f = cell_floor(cell), w = cell_w(cell), l = cell_l(cell);
+
+        // Out of the graph to the target, inside the target's cluster
+        if (f == tf && same_cluster(w, l, tw, tl)) {
+            int rest = to_target[(w - tw0) * PATH_CLUSTER_L + (l - tl0)];
+            if (rest != PATH_UNREACHABLE && d + rest < best) best = d + rest;
+        }
+        // Other nodes of this cluster
+        const PathCluster *cluster = &graph->clusters[f][w / PATH_CLUSTER_W][l / PATH_CLUSTER_L];
+        int slot = graph->node_of_cell[f][w][l];
+        for (int n = 0; n < cluster->num_nodes; n++) {
+            if (cluster->distance[slot][n] != PATH_UNREACHABLE) {
+                search_offer(&search, cluster->node_cell[n], d + cluster->distance[slot][n]);
+            }
+        }
+        // Across a cluster border
+        for (int dir = 0; dir < 4; dir++) {
+            int nw = w + step_w[dir], nl = l + step_l[dir];
+            if (can_step(graph, f, w, l, dir) && !same_cluster(w, l, nw, nl)) {
+                search_offer(&search, CELL_INDEX(f, nw, nl), d + 1);
+            }
+        }
+        // Along a stair the way it points now
+        for (unsigned mask = graph->stair_mask[f][w][l]; mask; mask &= mask - 1) {
+            const Stair *stair = &graph->stairs[__builtin_ctz(mask)];
+            if (f == stair->start_floor && w == stair->start_w && l == stair->start_l &&
+                stair->direction_type != STAIR_DOWN_ONLY &&
+                (graph->open[stair->end_floor][stair->end_w][stair->end_l] & PATH_OPEN)) {
+                search_offer(&search, CELL_INDEX(stair->end_floor, stair->end_w, stair->end_l), d + 1);
+            }
+            if (f == stair->end_floor && w == stair->end_w && l == stair->end_l &&
+                stair->direction_type != STAIR_UP_ONLY &&
+                (graph->open[stair->start_floor][stair->start_w][stair->start_l] & PATH_OPEN)) {
+                search_offer(&search, CELL_INDEX(stair->start_floor, stair->start_w, stair->start_l), d + 1);
+            }
+        }
+        // Down a pole from its top
+        for (int p = 0; p < graph->num_poles; p++) {
+            const Pole *pole = &graph->poles[p];
+            if (pole->start_floor == f && pole->w == w && pole->l == l &&
+                (graph->open[pole->end_floor][w][l] & PATH_OPEN)) {
+                search_offer(&search, CELL_INDEX(pole->end_floor, w, l), d + 1);
+            }
+        }
+    }
+    return best == INT_MAX ? -1 : best;
+}
+
+int path_graph_flag_reachable(const PathGraph *graph, const MazeLayout *layout, const PlayerSpawn spawns[],
+                              int num_spawns, const int flag_position[3]) {
+    // Without spawns, the entry cells of the default Players A, B and C
+    static const int default_starts[DEFAULT_NUM_PLAYERS][3] = { {0, 5, 12}, {0, 9, 7}, {0, 9, 17} };
+    static _Thread_local int starts[MAX_PLAYERS][3];
+    if (!is_valid_flag_cell(layout, flag_position[0], flag_position[1], flag_position[2])) return 0;
+    if (!spawns) return path_graph_distance(graph, default_starts, DEFAULT_NUM_PLAYERS, flag_position) >= 0;
+    for (int s = 0; s < num_spawns; s++) memcpy(starts[s], spawns[s].entry_pos, sizeof(starts[s]));
+    return path_graph_distance(graph, (const int (*)[3])starts, num_spawns, flag_position) >= 0;
+}
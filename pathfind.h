@@ -0,0 +1,78 @@
+// pathfind.h - Hierarchical reachability and distance queries on the maze
+// Each floor is cut into clusters of PATH_CLUSTER_W x PATH_CLUSTER_L cells.
+// Inside a cluster only the nodes matter: cells with a step into or out of a
+// neighbouring cluster, and portal cells (stair ends, pole tops and bottoms).
+// For every cluster the walking distance between each pair of its nodes is
+// precomputed without leaving the cluster. A query walks the source's and
+// target's own clusters cell by cell and otherwise searches only the abstract
+// graph: node to node inside a cluster, one step across a cluster border, one
+// move along a stair or pole. Every path between clusters passes through
+// nodes, so the distances are exact, the same as a full BFS of the maze
+// (is_flag_reachable() counts a stair or pole as one move, and so does this).
+//
+// The graph is updated in place when the maze changes:
+//  - stair directions (path_graph_sync_stairs) only open and close stair
+//    moves between nodes, so no cluster is rebuilt; the graph copies just the
+//    stairs the game's StairEpoch lists as changed since it last synced, and
+//    does nothing when the epoch has not moved
+//  - a new layout (path_graph_update_layout, e.g. walls reloaded) rebuilds
+//    only the clusters with a cell whose walls or validity changed, and their
+//    neighbours across the borders of those cells
+//
+// The cluster size trades preprocessing for query time; all sizes follow the
+// maze dimensions in game.h.
+
+#ifndef PATHFIND_H
+#define PATHFIND_H
+
+#include "game.h"
+
+#define PATH_CLUSTER_W      5
+#define PATH_CLUSTER_L      5
+#define PATH_CLUSTER_CELLS  (PATH_CLUSTER_W * PATH_CLUSTER_L)
+#define PATH_CLUSTERS_W     ((FLOOR_WIDTH + PATH_CLUSTER_W - 1) / PATH_CLUSTER_W)
+#define PATH_CLUSTERS_L     ((FLOOR_LENGTH + PATH_CLUSTER_L - 1) / PATH_CLUSTER_L)
+#define PATH_NUM_CELLS      (NUM_FLOORS * FLOOR_WIDTH * FLOOR_LENGTH)
+#define PATH_UNREACHABLE    0xFFFF
+
+typedef struct {
+    int num_nodes;
+    short node_cell[PATH_CLUSTER_CELLS];                            // Cell index of each node
+    unsigned short distance[PATH_CLUSTER_CELLS][PATH_CLUSTER_CELLS]; // Node to node within the cluster
+} PathCluster;
+
+typedef struct {
+    PathCluster clusters[NUM_FLOORS][PATH_CLUSTERS_W][PATH_CLUSTERS_L];
+    signed char node_of_cell[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH];  // Node slot in the cell's cluster (-1 = none)
+    unsigned char open[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH];        // Layout as built: PATH_OPEN | wall_mask
+    unsigned short stair_mask[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH]; // Bit per stair with an end on the cell
+    Stair stairs[MAX_STAIRS];                                         // Directions as of stair_epoch
+    int num_stairs;
+    unsigned int stair_epoch;
+    Pole poles[MAX_POLES];
+    int num_poles;
+    unsigned long clusters_rebuilt;                                   // Since path_graph_build()
+} PathGraph;
+
+#define PATH_OPEN  0x80   // The cell can be stood on (is_valid_position())
+
+// Build the whole graph; `epoch` (may be NULL) is the StairEpoch the stair directions are from
+void path_graph_build(PathGraph *graph, const MazeLayout *layout, const Stair stairs[], int num_stairs,
+                      const Pole poles[], int num_poles, const StairEpoch *epoch);
+
+// Take over the stair directions that changed since the graph last synced; returns how many
+// The epoch must belong to the game the graph follows
+int path_graph_sync_stairs(PathGraph *graph, const Stair stairs[], const StairEpoch *epoch);
+
+// Rebuild the clusters a new layout changes (same stairs and poles); returns how many
+int path_graph_update_layout(PathGraph *graph, const MazeLayout *layout);
+
+// Fewest moves from any of `sources` to `target` (-1 = unreachable)
+int path_graph_distance(const PathGraph *graph, const int sources[][3], int num_sources, const int target[3]);
+
+// Same result as is_flag_reachable() for the layout, stairs and poles the graph follows
+// and the same spawns (NULL = the default Players A, B and C)
+int path_graph_flag_reachable(const PathGraph *graph, const MazeLayout *layout, const PlayerSpawn spawns[],
+                              int num_spawns, const int flag_position[3]);
+
+#endif // PATHFIND_H
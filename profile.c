@@ -0,0 +1,111 @@
+// profile.c - Per-thread phase counters merged into a profile table at exit
+
+#include "profile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILE_USE_TSC 1
+#endif
+
+// Counters owned by one thread; never freed so they outlive the thread
+typedef struct ProfileBlock {
+    uint64_t calls[PROF_NUM_PHASES];
+    uint64_t ticks[PROF_NUM_PHASES];
+    struct ProfileBlock *next;
+} ProfileBlock;
+
+static const char *phase_names[PROF_NUM_PHASES] = {
+    "turn", "direction roll", "movement roll", "move", "path validation",
+    "stair resolution", "pole slide", "bawana effect", "movement bonus",
+    "capture check", "flag check"
+};
+
+static _Thread_local ProfileBlock *thread_block;
+static ProfileBlock *all_blocks;
+static pthread_mutex_t blocks_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Reference points for converting TSC ticks into nanoseconds at dump time
+static uint64_t calibration_ticks;
+static struct timespec calibration_time;
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t profile_ticks(void) {
+#ifdef PROFILE_USE_TSC
+    return __rdtsc();
+#else
+    return monotonic_ns();
+#endif
+}
+
+// First record on a thread: allocate its block and link it into the global list
+static ProfileBlock *register_thread(void) {
+    ProfileBlock *block = calloc(1, sizeof(ProfileBlock));
+    if (!block) {
+        fprintf(stderr, "Error: Could not allocate profile counters\n");
+        exit(1);
+    }
+
+    pthread_mutex_lock(&blocks_lock);
+    if (!all_blocks) {
+        calibration_ticks = profile_ticks();
+        clock_gettime(CLOCK_MONOTONIC, &calibration_time);
+        atexit(profile_dump);
+    }
+    block->next = all_blocks;
+    all_blocks = block;
+    pthread_mutex_unlock(&blocks_lock);
+
+    thread_block = block;
+    return block;
+}
+
+void profile_record(ProfilePhase phase, uint64_t ticks) {
+    ProfileBlock *block = thread_block ? thread_block : register_thread();
+    block->calls[phase]++;
+    block->ticks[phase] += ticks;
+}
+
+void profile_dump(void) {
+    uint64_t calls[PROF_NUM_PHASES] = {0};
+    uint64_t ticks[PROF_NUM_PHASES] = {0};
+    int threads = 0;
+
+    pthread_mutex_lock(&blocks_lock);
+    for (ProfileBlock *block = all_blocks; block; block = block->next) {
+        for (int p = 0; p < PROF_NUM_PHASES; p++) {
+            calls[p] += block->calls[p];
+            ticks[p] += block->ticks[p];
+        }
+        threads++;
+    }
+    pthread_mutex_unlock(&blocks_lock);
+    if (threads == 0) return;
+
+    // Ticks per nanosecond over the whole run (1.0 when ticks already are ns)
+    double ticks_per_ns = 1.0;
+#ifdef PROFILE_USE_TSC
+    uint64_t elapsed_ns = monotonic_ns() - ((uint64_t)calibration_time.tv_sec * 1000000000ull +
+                                            (uint64_t)calibration_time.tv_nsec);
+    if (elapsed_ns > 0) {
+        ticks_per_ns = (double)(profile_ticks() - calibration_ticks) / (double)elapsed_ns;
+    }
+#endif
+
+    fprintf(stderr, "\n--- Profile (%d thread%s) ---\n", threads, threads == 1 ? "" : "s");
+    fprintf(stderr, "%-18s %12s %14s %12s\n", "phase", "calls", "total ms", "ns/call");
+    for (int p = 0; p < PROF_NUM_PHASES; p++) {
+        double total_ns = (double)ticks[p] / ticks_per_ns;
+        fprintf(stderr, "%-18s %12llu %14.3f %12.1f\n", phase_names[p], (unsigned long long)calls[p],
+                total_ns / 1e6, calls[p] ? total_ns / (double)calls[p] : 0.0);
+    }
+    fprintf(stderr, "-----------------------------\n");
+}
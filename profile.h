@@ -0,0 +1,44 @@
+// profile.h - Hot-path instrumentation counters for Maze of UCSC
+// Counts calls and accumulates time for the main phases of a turn.
+// Compile with -DGAME_PROFILE (and link profile.c) to enable; otherwise
+// every PROFILE_* macro expands to nothing and costs nothing.
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+
+// Instrumented phases of play_turn() and move_player_with_teleport()
+typedef enum {
+    PROF_TURN,              // Whole play_turn() call
+    PROF_DIRECTION_ROLL,    // Direction die roll and mapping
+    PROF_MOVEMENT_ROLL,     // Movement die roll
+    PROF_MOVE,              // Whole move_player_with_teleport() call
+    PROF_PATH_VALIDATION,   // check_path_validity() pre-check
+    PROF_STAIR_RESOLUTION,  // Stair lookup and tie-break selection
+    PROF_POLE_SLIDE,        // Pole lookup and slide
+    PROF_BAWANA_EFFECT,     // apply_bawana_effect()
+    PROF_MOVEMENT_BONUS,    // apply_movement_bonus()
+    PROF_CAPTURE_CHECK,     // check_player_capture()
+    PROF_FLAG_CHECK,        // check_flag_capture()
+    PROF_NUM_PHASES
+} ProfilePhase;
+
+// Read the phase timer: rdtsc on x86, CLOCK_MONOTONIC elsewhere
+uint64_t profile_ticks(void);
+
+// Add one call of `phase` taking `ticks` to the calling thread's counters
+void profile_record(ProfilePhase phase, uint64_t ticks);
+
+// Merge every thread's counters and print the table to stderr (runs at exit)
+void profile_dump(void);
+
+#ifdef GAME_PROFILE
+#define PROFILE_BEGIN(phase) uint64_t profile_start_##phase = profile_ticks()
+#define PROFILE_END(phase)   profile_record(phase, profile_ticks() - profile_start_##phase)
+#else
+#define PROFILE_BEGIN(phase) ((void)0)
+#define PROFILE_END(phase)   ((void)0)
+#endif
+
+#endif // PROFILE_H
@@ -0,0 +1,278 @@
+// render.c - Diff-based ANSI view of the maze (see render.h)
+
+#include "render.h"
+#include <stdarg.h>
+
+// Where things go on the screen
+#define FLOOR_TOP(f)    (1 + (f) * (FLOOR_WIDTH + 1))   // Floor header row; cells start one row below
+#define CELL_COL(l)     (4 + 2 * (l))                   // Cell glyph; the gap after it is CELL_COL(l) + 1
+#define PANEL_COL       56
+#define PANEL_PLAYERS   ((RENDER_ROWS - 4) / 2)         // Two rows per player
+#define MESSAGE_ROW     (RENDER_ROWS - 2)
+#define LEGEND_ROW      (RENDER_ROWS - 1)
+
+// SGR parameters per style (after a reset)
+static const char *const style_codes[RENDER_NUM_STYLES] = {
+    "", "2", "1", "32", "2;31", "36", "35", "1;32", "1;33", "1;37;41", "1;7", "1"
+};
+
+static void output_flush(Renderer *renderer) {
+    if (renderer->output_used == 0) return;
+    fwrite(renderer->output, 1, renderer->output_used, renderer->out);
+    renderer->bytes_written += renderer->output_used;
+    renderer->output_used = 0;
+}
+
+static void output_bytes(Renderer *renderer, const char *bytes, size_t length) {
+    if (renderer->output_used + length > sizeof(renderer->output)) output_flush(renderer);
+    memcpy(renderer->output + renderer->output_used, bytes, length);
+    renderer->output_used += length;
+}
+
+static void output_cursor(Renderer *renderer, int row, int col) {
+    char sequence[16];
+    int length = snprintf(sequence, sizeof(sequence), "\x1b[%d;%dH", row + 1, col + 1);
+    output_bytes(renderer, sequence, (size_t)length);
+    renderer->cursor_row = row;
+    renderer->cursor_col = col;
+}
+
+static void output_style(Renderer *renderer, int style) {
+    char sequence[24];
+    const char *code = style_codes[style & ~RENDER_UNDERLINE];
+    int length = snprintf(sequence, sizeof(sequence), "\x1b[0%s%s%s", *code ? ";" : "", code,
+                          (style & RENDER_UNDERLINE) ? ";4m" : "m");
+    output_bytes(renderer, sequence, (size_t)length);
+    renderer->style = style;
+}
+
+// A blank looks the same in any style without underline or a background
+static int style_shows_blank(int style) {
+    return !(style & RENDER_UNDERLINE) && style != RENDER_FLAG && style != RENDER_PLAYER;
+}
+
+// Write the back cell under the cursor and step the cursor past it
+static void output_cell(Renderer *renderer, int row, int col) {
+    RenderCell cell = renderer->back[row][col];
+    int blank = cell.glyph == ' ' && style_shows_blank(cell.style) && style_shows_blank(renderer->style);
+    if (cell.style != renderer->style && !blank) output_style(renderer, cell.style);
+    output_bytes(renderer, &cell.glyph, 1);
+    renderer->front[row][col] = cell;
+    // After the last column the cursor waits to wrap; do not count on where it is
+    if (++renderer->cursor_col == RENDER_COLS) renderer->cursor_row = -1;
+}
+
+static void put_text(Renderer *renderer, int row, int col, int style, const char *format, ...) {
+    char text[RENDER_COLS + 1];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    for (int i = 0; text[i] && col + i < RENDER_COLS; i++) {
+        renderer->back[row][col + i] = (RenderCell){ text[i], (unsigned char)style };
+    }
+}
+
+// Glyph of a stair end: where it leads, and whether it can be taken from here this round
+static RenderCell stair_glyph(unsigned stair_mask, const Stair stairs[], int floor, int width_pos, int length_pos) {
+    RenderCell glyph = { '?', RENDER_STAIR_CLOSED };
+    for (; stair_mask; stair_mask &= stair_mask - 1) {
+        const Stair *stair = &stairs[__builtin_ctz(stair_mask)];
+        int at_start = stair->start_floor == floor && stair->start_w == width_pos && stair->start_l == length_pos;
+        int other_floor = at_start ? stair->end_floor : stair->start_floor;
+        int usable = stair->direction_type != (at_start ? STAIR_DOWN_ONLY : STAIR_UP_ONLY);
+        glyph.glyph = other_floor > floor ? '^' : 'v';
+        if (usable) {
+            glyph.style = RENDER_STAIR;
+            break;
+        }
+    }
+    return glyph;
+}
+
+static RenderCell maze_glyph(const Maze *maze, const Stair stairs[], int floor, int width_pos, int length_pos) {
+    const Cell *cell = &maze->layout->cells[floor][width_pos][length_pos];
+    int bawana_type, bonus_type;
+    if (cell->is_starting_area) return (RenderCell){ ':', RENDER_DIM };
+    if (!cell->is_valid) return (RenderCell){ ' ', RENDER_PLAIN };
+    if (cell->has_wall) return (RenderCell){ '#', RENDER_WALL };
+    if (cell->is_bawana_entrance) return (RenderCell){ '=', RENDER_BAWANA };
+    if ((bawana_type = maze_bawana_type(maze, floor, width_pos, length_pos)) >= 0) {
+        return (RenderCell){ "fdthr"[bawana_type], RENDER_BAWANA };
+    }
+    if (cell->stair_mask) return stair_glyph(cell->stair_mask, stairs, floor, width_pos, length_pos);
+    if (cell->pole != -1 || cell->pole_start != -1) return (RenderCell){ '|', RENDER_POLE };
+    if (cell->is_blocked_by_stair) return (RenderCell){ 'x', RENDER_DIM };
+    bonus_type = maze_bonus_type(maze, floor, width_pos, length_pos);
+    if (bonus_type >= BONUS_MULTIPLY_2) return (RenderCell){ '*', RENDER_MULTIPLY };
+    if (bonus_type != BONUS_NONE) return (RenderCell){ '+', RENDER_BONUS };
+    return (RenderCell){ '.', RENDER_PLAIN };
+}
+
+static void draw_floor(Renderer *renderer, const Maze *maze, const Stair stairs[], int floor) {
+    int top = FLOOR_TOP(floor);
+    put_text(renderer, top, 0, RENDER_TITLE, "F%d", floor);
+    for (int l = 0; l < FLOOR_LENGTH; l++) {
+        renderer->back[top][CELL_COL(l)] = (RenderCell){ (char)('0' + l % 10), RENDER_DIM };
+    }
+    for (int w = 0; w < FLOOR_WIDTH; w++) {
+        RenderCell *row = renderer->back[top + 1 + w];
+        put_text(renderer, top + 1 + w, 0, RENDER_DIM, "%2d", w);
+        for (int l = 0; l < FLOOR_LENGTH; l++) {
+            const Cell *cell = &maze->layout->cells[floor][w][l];
+            RenderCell *glyph = &row[CELL_COL(l)], *gap = glyph + 1;
+            *glyph = maze_glyph(maze, stairs, floor, w, l);
+            if (cell->wall_mask >> DIR_SOUTH & 1) *gap = (RenderCell){ '|', RENDER_WALL };
+            // Underline both cells of a wall between rows, and the gap when the wall goes on
+            if (cell->wall_mask >> DIR_EAST & 1) {
+                glyph->style |= RENDER_UNDERLINE;
+                if (l + 1 < FLOOR_LENGTH && (maze->layout->cells[floor][w][l + 1].wall_mask >> DIR_EAST & 1)) {
+                    gap->style |= RENDER_UNDERLINE;
+                }
+            }
+        }
+    }
+}
+
+static void draw_player_panel(Renderer *renderer, const Player players[], int num_players) {
+    int listed = num_players <= PANEL_PLAYERS ? num_players : PANEL_PLAYERS - 1;
+    put_text(renderer, 1, PANEL_COL, RENDER_TITLE, "Players");
+    for (int p = 0; p < listed; p++) {
+        const Player *player = &players[p];
+        int row = 2 + 2 * p;
+        put_text(renderer, row, PANEL_COL, RENDER_PLAYER, "%s", get_player_name(p));
+        put_text(renderer, row, PANEL_COL + 4, RENDER_PLAIN, "[%d,%d,%d] %s", player->pos[0], player->pos[1],
+                 player->pos[2], player->in_game ? get_direction_name(player->direction) : "waiting");
+        if (player->bawana_effect > EFFECT_NONE && player->bawana_effect < NUM_EFFECTS) {
+            put_text(renderer, row + 1, PANEL_COL + 4, RENDER_BAWANA, "MP %-4d %s %d", player->movement_points,
+                     bawana_effect_info[player->bawana_effect].name, player->bawana_turns_left);
+        } else {
+            put_text(renderer, row + 1, PANEL_COL + 4, RENDER_PLAIN, "MP %d", player->movement_points);
+        }
+    }
+    if (listed < num_players) {
+        put_text(renderer, 2 + 2 * listed, PANEL_COL, RENDER_DIM, "+%d more players", num_players - listed);
+    }
+}
+
+// Mark each player on the map; a cell holding several shows '&'
+static void draw_players(Renderer *renderer, const Player players[], int num_players) {
+    for (int p = 0; p < num_players; p++) {
+        const int *pos = players[p].pos;
+        if (pos[0] < 0 || pos[0] >= NUM_FLOORS || pos[1] < 0 || pos[1] >= FLOOR_WIDTH ||
+            pos[2] < 0 || pos[2] >= FLOOR_LENGTH) {
+            continue;
+        }
+        RenderCell *cell = &renderer->back[FLOOR_TOP(pos[0]) + 1 + pos[1]][CELL_COL(pos[2])];
+        int underline = cell->style & RENDER_UNDERLINE;
+        int occupied = (cell->style & ~RENDER_UNDERLINE) == RENDER_PLAYER;
+        cell->glyph = occupied ? '&' : (p < 26 ? (char)('A' + p) : '@');
+        cell->style = (unsigned char)(RENDER_PLAYER | underline);
+    }
+}
+
+// Write every changed cell: a cursor move starts each run, unless reprinting the
+// few unchanged cells since the last write is shorter
+static void write_changes(Renderer *renderer) {
+    for (int row = 0; row < RENDER_ROWS; row++) {
+        if (memcmp(renderer->front[row], renderer->back[row], sizeof(renderer->front[row])) == 0) continue;
+        for (int col = 0; col < RENDER_COLS; col++) {
+            RenderCell *shown = &renderer->front[row][col], *wanted = &renderer->back[row][col];
+            if (shown->glyph == wanted->glyph && shown->style == wanted->style) continue;
+            if (renderer->cursor_row == row && renderer->cursor_col <= col && col - renderer->cursor_col <= 4) {
+                while (renderer->cursor_col < col) output_cell(renderer, row, renderer->cursor_col);
+            } else {
+                output_cursor(renderer, row, col);
+            }
+            output_cell(renderer, row, col);
+        }
+    }
+}
+
+void render_init(Renderer *renderer, FILE *out) {
+    memset(renderer, 0, sizeof(*renderer));
+    renderer->out = out;
+    for (int row = 0; row < RENDER_ROWS; row++) {
+        for (int col = 0; col < RENDER_COLS; col++) {
+            renderer->front[row][col] = (RenderCell){ ' ', RENDER_PLAIN };
+        }
+    }
+    renderer->cursor_row = renderer->cursor_col = -1;
+    renderer->style = RENDER_PLAIN;
+    // Reset colours, clear the screen, hide the cursor
+    static const char start[] = "\x1b[0m\x1b[2J\x1b[?25l";
+    output_bytes(renderer, start, sizeof(start) - 1);
+}
+
+void render_frame(Renderer *renderer, const Maze *maze, const Stair stairs[],
+                  const Player players[], int num_players, const int flag_position[3],
+                  int round_number, const char *message) {
+    for (int row = 0; row < RENDER_ROWS; row++) {
+        for (int col = 0; col < RENDER_COLS; col++) {
+            renderer->back[row][col] = (RenderCell){ ' ', RENDER_PLAIN };
+        }
+    }
+
+    put_text(renderer, 0, 0, RENDER_TITLE, "Maze of UCSC   Round %d   Flag [%d,%d,%d]", round_number,
+             flag_position[0], flag_position[1], flag_position[2]);
+    for (int f = 0; f < NUM_FLOORS; f++) draw_floor(renderer, maze, stairs, f);
+    RenderCell *flag = &renderer->back[FLOOR_TOP(flag_position[0]) + 1 + flag_position[1]][CELL_COL(flag_position[2])];
+    flag->glyph = '!';
+    flag->style = (unsigned char)(RENDER_FLAG | (flag->style & RENDER_UNDERLINE));
+    draw_players(renderer, players, num_players);
+    draw_player_panel(renderer, players, num_players);
+    put_text(renderer, MESSAGE_ROW, 0, RENDER_PLAIN, "%s", message ? message : "");
+    put_text(renderer, LEGEND_ROW, 0, RENDER_DIM,
+             "^v stair  | pole  + * bonus  x blocked  # wall  = fdthr Bawana  ! flag  : start");
+
+    write_changes(renderer);
+    // Park the cursor below the view, where a key echoed by the terminal does no harm
+    if (renderer->output_used) {
+        output_cursor(renderer, RENDER_ROWS, 0);
+        renderer->cursor_row = -1;
+    }
+    output_flush(renderer);
+    fflush(renderer->out);
+    renderer->frames++;
+}
+
+static void describe_turn(char *message, size_t size, const TurnResult *last) {
+    static const char *const block_names[] = { "", "wall", "invalid cell", "Bawana entrance" };
+    const char *name = get_player_name(last->player_id);
+    if (last->won) {
+        snprintf(message, size, "Player %s captured the flag!", name);
+    } else if (last->movement_roll == 0) {
+        snprintf(message, size, "Player %s misses the turn", name);
+    } else if (!last->in_game) {
+        snprintf(message, size, "Player %s rolled %d and waits for a 6", name, last->movement_roll);
+    } else {
+        int length = snprintf(message, size, "Player %s rolled %d, %s: %d step%s to [%d,%d,%d], cost %d, MP %d",
+                              name, last->movement_roll, get_direction_name(last->direction), last->steps_taken,
+                              last->steps_taken == 1 ? "" : "s", last->end_pos[0], last->end_pos[1],
+                              last->end_pos[2], last->movement_cost, last->movement_points);
+        if (last->blocked_reason > BLOCK_NONE && last->blocked_reason <= BLOCK_BAWANA_ENTRANCE &&
+            length > 0 && (size_t)length < size) {
+            length += snprintf(message + length, size - (size_t)length, ", blocked by %s",
+                               block_names[last->blocked_reason]);
+        }
+        if (last->captured_player >= 0 && length > 0 && (size_t)length < size) {
+            snprintf(message + length, size - (size_t)length, ", sent %s back",
+                     get_player_name(last->captured_player));
+        }
+    }
+}
+
+void render_game(Renderer *renderer, const GameState *game, const TurnResult *last) {
+    char message[RENDER_COLS + 1] = "";
+    if (last) describe_turn(message, sizeof(message), last);
+    render_frame(renderer, &game->maze, game->stairs, game->players, game->num_players, game->flag_position,
+                 last ? last->round_number : game->round_number, message);
+}
+
+void render_finish(Renderer *renderer) {
+    output_cursor(renderer, RENDER_ROWS, 0);
+    static const char end[] = "\x1b[0m\x1b[?25h";
+    output_bytes(renderer, end, sizeof(end) - 1);
+    output_flush(renderer);
+    fflush(renderer->out);
+}
@@ -0,0 +1,68 @@
+// render.h - Full-screen ANSI view of the three floors, redrawn by diff
+// The renderer draws each frame from the engine's state into an off-screen
+// grid of character cells, compares it with the grid the terminal already
+// shows and writes only the cells that changed, with a cursor move in front of
+// each changed run and a colour change only where the colour differs. A turn
+// usually changes a handful of cells, so a frame costs tens of bytes instead of
+// a few kilobytes, which keeps the view smooth over slow SSH links and when a
+// replay runs thousands of turns per second.
+//
+// Floors are drawn one above the other, width (w) down and length (l) across,
+// with the players on the right. A wall between two cells of a row is a '|'
+// in the gap between them; a wall between rows underlines the cell above it.
+
+#ifndef RENDER_H
+#define RENDER_H
+
+#include "game.h"
+
+#define RENDER_ROWS  36
+#define RENDER_COLS  80
+
+// Styles of a screen cell; RENDER_UNDERLINE may be added to any of them
+#define RENDER_PLAIN         0
+#define RENDER_DIM           1   // Starting area, blocked stair cells
+#define RENDER_WALL          2
+#define RENDER_STAIR         3   // Stair that can be taken from this end
+#define RENDER_STAIR_CLOSED  4   // Stair that only arrives at this end this round
+#define RENDER_POLE          5
+#define RENDER_BAWANA        6
+#define RENDER_BONUS         7   // Bonus that adds MP
+#define RENDER_MULTIPLY      8   // Bonus that multiplies MP
+#define RENDER_FLAG          9
+#define RENDER_PLAYER        10
+#define RENDER_TITLE         11
+#define RENDER_NUM_STYLES    12
+#define RENDER_UNDERLINE     0x80
+
+typedef struct {
+    char glyph;
+    unsigned char style;
+} RenderCell;
+
+typedef struct {
+    FILE *out;
+    RenderCell front[RENDER_ROWS][RENDER_COLS];  // What the terminal shows
+    RenderCell back[RENDER_ROWS][RENDER_COLS];   // Frame being drawn
+    int cursor_row, cursor_col;                   // Where the terminal cursor is (-1 = unknown)
+    int style;                                    // Style the terminal is drawing in (-1 = unknown)
+    char output[16384];                           // Escape sequences, written once per frame
+    size_t output_used;
+    unsigned long long frames, bytes_written;
+} Renderer;
+
+// Clear the screen and take it over; `out` must be a terminal (or a file to replay with cat)
+void render_init(Renderer *renderer, FILE *out);
+
+// Draw one frame and write what changed since the last one
+void render_frame(Renderer *renderer, const Maze *maze, const Stair stairs[],
+                  const Player players[], int num_players, const int flag_position[3],
+                  int round_number, const char *message);
+
+// Draw a game, describing `last` (the turn just played, or NULL) in the message line
+void render_game(Renderer *renderer, const GameState *game, const TurnResult *last);
+
+// Give the terminal back: default colours, cursor shown below the view
+void render_finish(Renderer *renderer);
+
+#endif // RENDER_H
@@ -0,0 +1,223 @@
+// scan.c - Filter and summarise a store of per-game outcomes (store.h)
+// Each --where keeps the games whose column is within MIN:MAX (either end may
+// be left out; a single value keeps just that value). A block whose min/max
+// rule a filter out is skipped without reading its data, and a filter the
+// whole block is inside of is not decoded either. Only the columns filtered on
+// or reported are decoded.
+//
+// Prints the number of games that match, and the count, min, max, mean and sum
+// of each column in --columns (all of them by default) over those games. With
+// --rows the matching games are printed as CSV instead.
+//
+// Build: gcc -O2 -pthread -o scan scan.c store.c
+// Usage: ./scan FILE [--where COLUMN=MIN:MAX]... [--columns A,B,...] [--rows]
+// e.g.   ./scan outcomes.bin --where winner=0 --where rounds=:50 --columns rounds,mp_A
+
+#include "store.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SCAN_MAX_FILTERS 16
+
+typedef struct {
+    int column;
+    int64_t lo, hi;
+} ScanFilter;
+
+typedef struct {
+    uint64_t count;
+    int64_t min, max;
+    double sum;
+} ColumnSummary;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// COLUMN=MIN:MAX, COLUMN=MIN:, COLUMN=:MAX or COLUMN=VALUE
+static int parse_filter(ScanFilter *filter, const char *text) {
+    char name[64];
+    const char *equals = strchr(text, '=');
+    if (!equals || (size_t)(equals - text) >= sizeof(name)) return 0;
+    memcpy(name, text, (size_t)(equals - text));
+    name[equals - text] = '\0';
+    filter->column = store_column_find(name);
+    if (filter->column < 0) return 0;
+
+    const char *range = equals + 1;
+    const char *colon = strchr(range, ':');
+    char *end;
+    filter->lo = INT64_MIN;
+    filter->hi = INT64_MAX;
+    if (!colon) {
+        filter->lo = filter->hi = strtoll(range, &end, 10);
+        return end != range && *end == '\0';
+    }
+    if (colon != range) {
+        filter->lo = strtoll(range, &end, 10);
+        if (end != colon) return 0;
+    }
+    if (colon[1] != '\0') {
+        filter->hi = strtoll(colon + 1, &end, 10);
+        if (*end != '\0') return 0;
+    }
+    return 1;
+}
+
+static int parse_columns(int selected[STORE_NUM_COLUMNS], int *num_selected, const char *list) {
+    char copy[1024];
+    snprintf(copy, sizeof(copy), "%s", list);
+    *num_selected = 0;
+    for (char *name = strtok(copy, ","); name; name = strtok(NULL, ",")) {
+        int column = store_column_find(name);
+        if (column < 0 || *num_selected == STORE_NUM_COLUMNS) return 0;
+        selected[(*num_selected)++] = column;
+    }
+    return *num_selected > 0;
+}
+
+int main(int argc, char *argv[]) {
+    ScanFilter filters[SCAN_MAX_FILTERS];
+    int num_filters = 0;
+    int selected[STORE_NUM_COLUMNS], num_selected = STORE_NUM_COLUMNS;
+    int print_rows = 0;
+    const char *path = NULL;
+    for (int c = 0; c < STORE_NUM_COLUMNS; c++) selected[c] = c;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--where") == 0 && i + 1 < argc) {
+            if (num_filters == SCAN_MAX_FILTERS || !parse_filter(&filters[num_filters++], argv[++i])) {
+                fprintf(stderr, "Error: Bad filter %s (COLUMN=MIN:MAX, at most %d)\n", argv[i], SCAN_MAX_FILTERS);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--columns") == 0 && i + 1 < argc) {
+            if (!parse_columns(selected, &num_selected, argv[++i])) {
+                fprintf(stderr, "Error: Bad column list %s\n", argv[i]);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--rows") == 0) {
+            print_rows = 1;
+        } else if (argv[i][0] != '-' && !path) {
+            path = argv[i];
+        } else {
+            fprintf(stderr, "Usage: %s FILE [--where COLUMN=MIN:MAX]... [--columns A,B,...] [--rows]\n", argv[0]);
+            fprintf(stderr, "Columns:");
+            for (int c = 0; c < STORE_NUM_COLUMNS; c++) fprintf(stderr, " %s", store_column_names[c]);
+            fprintf(stderr, "\n");
+            return 2;
+        }
+    }
+    if (!path) {
+        fprintf(stderr, "Error: No store file given\n");
+        return 2;
+    }
+
+    StoreReader reader;
+    if (!store_reader_open(&reader, path)) {
+        fprintf(stderr, "Error: %s is not an outcome store\n", path);
+        return 1;
+    }
+
+    static int64_t values[STORE_NUM_COLUMNS][STORE_BLOCK_ROWS];
+    static unsigned char match[STORE_BLOCK_ROWS];
+    ColumnSummary summary[STORE_NUM_COLUMNS];
+    for (int s = 0; s < num_selected; s++) summary[s] = (ColumnSummary){ 0, INT64_MAX, INT64_MIN, 0.0 };
+    uint64_t rows_total = 0, rows_matched = 0, bytes_decoded = 0;
+    int blocks_skipped = 0;
+
+    if (print_rows) {
+        for (int s = 0; s < num_selected; s++) printf("%s%s", s ? "," : "", store_column_names[selected[s]]);
+        printf("\n");
+    }
+
+    double start = now_seconds();
+    for (int b = 0; b < reader.num_blocks; b++) {
+        const StoreBlockHeader *block = reader.blocks[b];
+        int num_rows = (int)block->num_rows;
+        rows_total += (uint64_t)num_rows;
+
+        // The block's min and max decide most filters without the data
+        int skip = 0, partial[SCAN_MAX_FILTERS], num_partial = 0;
+        for (int f = 0; f < num_filters; f++) {
+            const StoreColumn *column = &block->columns[filters[f].column];
+            if (column->max < filters[f].lo || column->min > filters[f].hi) {
+                skip = 1;
+                break;
+            }
+            if (column->min < filters[f].lo || column->max > filters[f].hi) partial[num_partial++] = f;
+        }
+        if (skip) {
+            blocks_skipped++;
+            continue;
+        }
+
+        int decoded[STORE_NUM_COLUMNS] = { 0 };
+        memset(match, 1, (size_t)num_rows);
+        int matched = num_rows;
+        for (int p = 0; p < num_partial; p++) {
+            const ScanFilter *filter = &filters[partial[p]];
+            if (!decoded[filter->column]) {
+                store_column_decode(block, filter->column, values[filter->column]);
+                bytes_decoded += block->columns[filter->column].bytes;
+                decoded[filter->column] = 1;
+            }
+            const int64_t *v = values[filter->column];
+            for (int i = 0; i < num_rows; i++) match[i] &= v[i] >= filter->lo && v[i] <= filter->hi;
+        }
+        if (num_partial) {
+            matched = 0;
+            for (int i = 0; i < num_rows; i++) matched += match[i];
+        }
+        rows_matched += (uint64_t)matched;
+        if (matched == 0) continue;
+
+        for (int s = 0; s < num_selected; s++) {
+            int c = selected[s];
+            if (!decoded[c]) {
+                store_column_decode(block, c, values[c]);
+                bytes_decoded += block->columns[c].bytes;
+                decoded[c] = 1;
+            }
+            ColumnSummary *sum = &summary[s];
+            for (int i = 0; i < num_rows; i++) {
+                if (!match[i]) continue;
+                int64_t v = values[c][i];
+                sum->count++;
+                sum->sum += (double)v;
+                if (v < sum->min) sum->min = v;
+                if (v > sum->max) sum->max = v;
+            }
+        }
+        if (print_rows) {
+            for (int i = 0; i < num_rows; i++) {
+                if (!match[i]) continue;
+                for (int s = 0; s < num_selected; s++) {
+                    printf("%s%lld", s ? "," : "", (long long)values[selected[s]][i]);
+                }
+                printf("\n");
+            }
+        }
+    }
+    double elapsed = now_seconds() - start;
+
+    // With --rows stdout is the CSV, so the summary goes to stderr
+    FILE *report = print_rows ? stderr : stdout;
+    fprintf(report, "Games: %llu of %llu match; %d of %d blocks skipped, %.1f MB decoded in %.3fs\n",
+            (unsigned long long)rows_matched, (unsigned long long)rows_total, blocks_skipped, reader.num_blocks,
+            bytes_decoded / 1e6, elapsed);
+    if (!print_rows && rows_matched > 0) {
+        printf("%-22s %12s %12s %12s %14s %16s\n", "column", "count", "min", "max", "mean", "sum");
+        for (int s = 0; s < num_selected; s++) {
+            const ColumnSummary *sum = &summary[s];
+            printf("%-22s %12llu %12lld %12lld %14.4f %16.0f\n", store_column_names[selected[s]],
+                   (unsigned long long)sum->count, (long long)sum->min, (long long)sum->max,
+                   sum->sum / (double)sum->count, sum->sum);
+        }
+    }
+    store_reader_close(&reader);
+    return 0;
+}
@@ -0,0 +1,123 @@
+// scheduler.c - Thread pool that resumes paused games from a shared run queue
+
+#include "scheduler.h"
+#include <pthread.h>
+
+struct GameScheduler {
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;       // Signalled when a game is queued or on shutdown
+    pthread_cond_t idle;             // Signalled when the queue empties and no game runs
+    GameState **queue;               // Ring buffer of games to resume
+    int capacity;
+    int head;
+    int count;
+    int running;                     // Games being resumed right now
+    int stopping;
+
+    SchedulerCallback callback;
+    void *user_data;
+    int num_threads;
+    pthread_t *threads;
+};
+
+// Resume one game until it pauses for input or the callback parks it
+static void run_game(GameScheduler *scheduler, GameState *game) {
+    TurnResult result;
+    int stage = game_turn_resume(game, &result);
+    while (stage == TURN_DONE) {
+        if (!scheduler->callback(game, TURN_DONE, &result, scheduler->user_data)) return;
+        stage = game_turn_resume(game, &result);
+    }
+    scheduler->callback(game, stage, NULL, scheduler->user_data);
+}
+
+static void *scheduler_thread(void *arg) {
+    GameScheduler *scheduler = arg;
+
+    pthread_mutex_lock(&scheduler->lock);
+    while (1) {
+        while (scheduler->count == 0 && !scheduler->stopping) {
+            pthread_cond_wait(&scheduler->work_ready, &scheduler->lock);
+        }
+        if (scheduler->count == 0) break; // Stopping and nothing left to do
+
+        GameState *game = scheduler->queue[scheduler->head];
+        scheduler->head = (scheduler->head + 1) % scheduler->capacity;
+        scheduler->count--;
+        scheduler->running++;
+        pthread_mutex_unlock(&scheduler->lock);
+
+        run_game(scheduler, game);
+
+        pthread_mutex_lock(&scheduler->lock);
+        scheduler->running--;
+        if (scheduler->count == 0 && scheduler->running == 0) {
+            pthread_cond_broadcast(&scheduler->idle);
+        }
+    }
+    pthread_mutex_unlock(&scheduler->lock);
+    return NULL;
+}
+
+GameScheduler* scheduler_create(int num_threads, int capacity, SchedulerCallback callback, void *user_data) {
+    GameScheduler *scheduler = calloc(1, sizeof(GameScheduler));
+    if (!scheduler) return NULL;
+    scheduler->queue = malloc((size_t)capacity * sizeof(GameState *));
+    scheduler->threads = calloc((size_t)num_threads, sizeof(pthread_t));
+    if (!scheduler->queue || !scheduler->threads) {
+        free(scheduler->queue);
+        free(scheduler->threads);
+        free(scheduler);
+        return NULL;
+    }
+    scheduler->capacity = capacity;
+    scheduler->callback = callback;
+    scheduler->user_data = user_data;
+    scheduler->num_threads = num_threads;
+    pthread_mutex_init(&scheduler->lock, NULL);
+    pthread_cond_init(&scheduler->work_ready, NULL);
+    pthread_cond_init(&scheduler->idle, NULL);
+
+    for (int t = 0; t < num_threads; t++) {
+        pthread_create(&scheduler->threads[t], NULL, scheduler_thread, scheduler);
+    }
+    return scheduler;
+}
+
+int scheduler_submit(GameScheduler *scheduler, GameState *game) {
+    pthread_mutex_lock(&scheduler->lock);
+    if (scheduler->count == scheduler->capacity) {
+        pthread_mutex_unlock(&scheduler->lock);
+        return 0;
+    }
+    scheduler->queue[(scheduler->head + scheduler->count) % scheduler->capacity] = game;
+    scheduler->count++;
+    pthread_cond_signal(&scheduler->work_ready);
+    pthread_mutex_unlock(&scheduler->lock);
+    return 1;
+}
+
+void scheduler_drain(GameScheduler *scheduler) {
+    pthread_mutex_lock(&scheduler->lock);
+    while (scheduler->count > 0 || scheduler->running > 0) {
+        pthread_cond_wait(&scheduler->idle, &scheduler->lock);
+    }
+    pthread_mutex_unlock(&scheduler->lock);
+}
+
+void scheduler_destroy(GameScheduler *scheduler) {
+    pthread_mutex_lock(&scheduler->lock);
+    scheduler->stopping = 1;
+    pthread_cond_broadcast(&scheduler->work_ready);
+    pthread_mutex_unlock(&scheduler->lock);
+    for (int t = 0; t < scheduler->num_threads; t++) {
+        pthread_join(scheduler->threads[t], NULL);
+    }
+
+    pthread_mutex_destroy(&scheduler->lock);
+    pthread_cond_destroy(&scheduler->work_ready);
+    pthread_cond_destroy(&scheduler->idle);
+    free(scheduler->queue);
+    free(scheduler->threads);
+    free(scheduler);
+}
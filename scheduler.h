@@ -0,0 +1,38 @@
+// scheduler.h - Runs many games that pause for player input on a few threads
+// A game only occupies a thread while it is actually computing. When its turn
+// pauses for a die roll (game_turn_resume() returns a TURN_AWAIT_* stage) the
+// thread moves on to other games; once the player's input arrives the game is
+// submitted again and the next free thread resumes it where it stopped.
+// A game is queued at most once at a time, so its state is never touched by
+// two threads at once and needs no locking.
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "game.h"
+
+typedef struct GameScheduler GameScheduler;
+
+// Called on a scheduler thread:
+//   stage == TURN_DONE        - a turn finished; `result` describes it. Return nonzero
+//                               to start the game's next turn now, 0 to park the game
+//                               (it must return 0 once the game is won)
+//   stage == TURN_AWAIT_*     - the game paused for a roll; `result` is NULL and the
+//                               return value is ignored. Submit the game again when
+//                               the player rolls.
+typedef int (*SchedulerCallback)(GameState *game, int stage, const TurnResult *result, void *user_data);
+
+// `capacity` bounds how many games can be queued at once; returns NULL on failure
+GameScheduler* scheduler_create(int num_threads, int capacity, SchedulerCallback callback, void *user_data);
+
+// Wake a game: a pending roll is made, then the game runs until it pauses again or is
+// parked. A new or parked game starts its next turn. Returns 0 if the queue is full.
+int scheduler_submit(GameScheduler *scheduler, GameState *game);
+
+// Wait until no game is queued or running
+void scheduler_drain(GameScheduler *scheduler);
+
+// Finish the queued work, then stop the threads and free the scheduler
+void scheduler_destroy(GameScheduler *scheduler);
+
+#endif // SCHEDULER_H
@@ -0,0 +1,632 @@
+// server.c - Multi-session game server for Maze of UCSC
+// Hosts many independent games in one process. Clients connect over a UNIX
+// domain socket and speak a line protocol; one epoll thread does all socket
+// I/O and hands complete request lines to a fixed pool of worker threads.
+// Games belong to the connection that created them and go back to a shared
+// pool (arena.h) when they end or the connection closes, so a busy server
+// reuses game states instead of allocating one per game. A connection is
+// served by at most one worker at a time, so replies come back in request
+// order and a game is never touched by two threads.
+// Narration and prompts are off: every turn is answered with a TurnResult
+// rendered as key=value fields.
+//
+// Built with -DGAME_METRICS (and metrics.c), --metrics-socket and --metrics-file
+// export games, turns, captures, blocked moves, Bawana effects and MP
+// percentiles in Prometheus text format (metrics.h).
+//
+// Built with -DGAME_TRACE (and trace.c), --trace writes a Chrome trace of every
+// turn and turn phase (trace.h). Each game gets its own track, numbered from 1 in
+// the order games are created across all connections. With --trace-sample N only
+// every Nth game is traced (default: all of them).
+//
+// Build: gcc -O2 -pthread -o server server.c arena.c game.c turn.c -lm
+// Usage: ./server [--socket PATH] [--workers N] [--max-games N] [--config DIR]
+//                 [--metrics-socket PATH] [--metrics-file PATH] [--metrics-interval MS] [--trace FILE]
+//                 [--trace-sample N]
+//
+// Protocol (one request per line, exactly one reply line per request):
+//   NEW [players] [seed]  -> OK game=<id> players=<n> seed=<s> flag=<f,w,l>
+//   ROLL <id>             -> TURN game=<id> round=<r> player=<name> ... won=<0|1>
+//   STEP <id>             -> AWAIT game=<id> round=<r> player=<name> die=<direction|movement>
+//                            until the turn's last die is rolled, then the TURN line
+//   STATE <id>            -> STATE game=<id> round=<r> next=<name> winner=<name|-> ...
+//   PLAYER <id> <player>  -> PLAYER game=<id> player=<name> pos=<f,w,l> ...
+//   END <id>              -> OK game=<id>
+//   PING                  -> PONG
+// Any failure is answered with ERR <reason>. The id of an ended game is given
+// to the connection's next NEW. A line longer than SERVER_MAX_LINE - 1 bytes
+// is answered with ERR line too long, after the lines before it, and the
+// connection is closed.
+
+#define _GNU_SOURCE // accept4()
+#include "game.h"
+#include "arena.h"
+#include "metrics.h"
+#include "trace.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define SERVER_DEFAULT_SOCKET  "/tmp/maze.sock"
+#define SERVER_MAX_LINE        256   // Longest accepted request line
+#define SERVER_MAX_EVENTS      256
+#define SERVER_REPLY_SIZE      512
+
+// A queued request line
+typedef struct RequestLine {
+    struct RequestLine *next;
+    int too_long;                    // Stands for a line cut off at SERVER_MAX_LINE; text is empty
+    char text[];
+} RequestLine;
+
+typedef struct Connection {
+    int fd;
+    char input[SERVER_MAX_LINE];     // Bytes of an incomplete line (epoll thread only)
+    size_t input_length;
+
+    pthread_mutex_t lock;            // Guards the fields below
+    RequestLine *queue_head;
+    RequestLine *queue_tail;
+    int busy;                        // Queued on, or being served by, a worker
+    int closed;                      // Peer stopped sending; the last one out frees the connection
+
+    // Owned by whichever worker is serving the connection
+    GameState **games;               // Indexed by game id; NULL once ended
+    int *trace_ids;                  // Server-wide number of each game, its track in a trace
+    int *free_ids;                   // Ids of ended games, reused before num_games grows
+    int num_games;                   // Ids handed out so far
+    int num_free_ids;
+    int games_capacity;
+    struct Connection *next_ready;   // Worker queue link
+} Connection;
+
+typedef struct {
+    GameConfig config;
+    int max_games;
+    atomic_int active_games;
+    atomic_int games_created;        // Numbers the games for tracing
+
+    pthread_mutex_t pool_lock;       // Guards the pool; games are taken and returned on any thread
+    GamePool pool;
+
+    pthread_mutex_t ready_lock;      // Connections with requests waiting for a worker
+    pthread_cond_t ready_cond;
+    Connection *ready_head;
+    Connection *ready_tail;
+    int stopping;
+} Server;
+
+static volatile sig_atomic_t server_running = 1;
+
+static void handle_stop_signal(int signal_number) {
+    (void)signal_number;
+    server_running = 0;
+}
+
+static void release_game(Server *server, GameState *game) {
+    if (game->winner < 0) METRICS_GAME_END(0);  // Won games were counted at the winning turn
+    pthread_mutex_lock(&server->pool_lock);
+    game_pool_put(&server->pool, game);
+    pthread_mutex_unlock(&server->pool_lock);
+    atomic_fetch_sub(&server->active_games, 1);
+}
+
+static void connection_free(Server *server, Connection *connection) {
+    for (int id = 0; id < connection->num_games; id++) {
+        if (connection->games[id]) release_game(server, connection->games[id]);
+    }
+    while (connection->queue_head) {
+        RequestLine *line = connection->queue_head;
+        connection->queue_head = line->next;
+        free(line);
+    }
+    close(connection->fd);
+    pthread_mutex_destroy(&connection->lock);
+    free(connection->games);
+    free(connection->trace_ids);
+    free(connection->free_ids);
+    free(connection);
+}
+
+static void ready_push(Server *server, Connection *connection) {
+    pthread_mutex_lock(&server->ready_lock);
+    connection->next_ready = NULL;
+    if (server->ready_tail) server->ready_tail->next_ready = connection;
+    else server->ready_head = connection;
+    server->ready_tail = connection;
+    pthread_cond_signal(&server->ready_cond);
+    pthread_mutex_unlock(&server->ready_lock);
+}
+
+// Blocks until a connection has work; returns NULL when the server stops
+static Connection *ready_pop(Server *server) {
+    pthread_mutex_lock(&server->ready_lock);
+    while (!server->ready_head && !server->stopping) {
+        pthread_cond_wait(&server->ready_cond, &server->ready_lock);
+    }
+    Connection *connection = server->ready_head;
+    if (connection) {
+        server->ready_head = connection->next_ready;
+        if (!server->ready_head) server->ready_tail = NULL;
+    }
+    pthread_mutex_unlock(&server->ready_lock);
+    return connection;
+}
+
+// Write the whole reply; the socket is non-blocking, so wait for room when it is full
+static int send_reply(int fd, const char *reply, size_t length) {
+    while (length > 0) {
+        ssize_t written = send(fd, reply, length, MSG_NOSIGNAL);
+        if (written > 0) {
+            reply += written;
+            length -= (size_t)written;
+        } else if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            struct pollfd pending = { .fd = fd, .events = POLLOUT };
+            if (poll(&pending, 1, 5000) <= 0) return 0; // Client stopped reading
+        } else if (written < 0 && errno == EINTR) {
+            continue;
+        } else {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static const char *blocked_names[] = { "none", "wall", "invalid_cell", "bawana_entrance" };
+static const char *effect_names[] = { "none", "food_poisoning", "disoriented", "triggered", "happy", "random_mp" };
+
+static GameState *find_game(Connection *connection, const char *id_text, int *game_id) {
+    char *end;
+    long id = strtol(id_text ? id_text : "", &end, 10);
+    if (!id_text || *end != '\0' || id < 0 || id >= connection->num_games) return NULL;
+    *game_id = (int)id;
+    return connection->games[id];
+}
+
+static void command_new(Server *server, Connection *connection, char *players_text, char *seed_text,
+                        char *reply, size_t reply_size) {
+    int num_players = players_text ? atoi(players_text) : server->config.num_players;
+    unsigned int seed = seed_text ? (unsigned int)strtoul(seed_text, NULL, 10) : (unsigned int)time(NULL);
+
+    if (num_players < MIN_PLAYERS || num_players > MAX_PLAYERS) {
+        snprintf(reply, reply_size, "ERR players must be between %d and %d\n", MIN_PLAYERS, MAX_PLAYERS);
+        return;
+    }
+    if (atomic_fetch_add(&server->active_games, 1) >= server->max_games) {
+        atomic_fetch_sub(&server->active_games, 1);
+        snprintf(reply, reply_size, "ERR server is full (%d games)\n", server->max_games);
+        return;
+    }
+    if (connection->num_free_ids == 0 && connection->num_games == connection->games_capacity) {
+        int capacity = connection->games_capacity ? connection->games_capacity * 2 : 16;
+        GameState **games = realloc(connection->games, (size_t)capacity * sizeof(GameState *));
+        if (games) connection->games = games;
+        int *trace_ids = games ? realloc(connection->trace_ids, (size_t)capacity * sizeof(int)) : NULL;
+        if (trace_ids) connection->trace_ids = trace_ids;
+        int *free_ids = trace_ids ? realloc(connection->free_ids, (size_t)capacity * sizeof(int)) : NULL;
+        if (!free_ids) {
+            atomic_fetch_sub(&server->active_games, 1);
+            snprintf(reply, reply_size, "ERR out of memory\n");
+            return;
+        }
+        connection->free_ids = free_ids;
+        connection->games_capacity = capacity;
+    }
+
+    pthread_mutex_lock(&server->pool_lock);
+    GameState *game = game_pool_get(&server->pool, num_players);
+    pthread_mutex_unlock(&server->pool_lock);
+    if (!game) {
+        atomic_fetch_sub(&server->active_games, 1);
+        snprintf(reply, reply_size, "ERR out of memory\n");
+        return;
+    }
+    game_state_init(game, &server->config, num_players, seed);
+    METRICS_GAME_START();
+    int game_id = connection->num_free_ids ? connection->free_ids[--connection->num_free_ids] : connection->num_games++;
+    connection->games[game_id] = game;
+    connection->trace_ids[game_id] = atomic_fetch_add(&server->games_created, 1) + 1;
+    snprintf(reply, reply_size, "OK game=%d players=%d seed=%u flag=%d,%d,%d\n", game_id, num_players, seed,
+             game->flag_position[0], game->flag_position[1], game->flag_position[2]);
+}
+
+static void format_turn(int game_id, const TurnResult *result, char *reply, size_t reply_size) {
+    int length = snprintf(reply, reply_size,
+                          "TURN game=%d round=%d player=%s stairs_changed=%d dir_roll=%d move_roll=%d "
+                          "from=%d,%d,%d to=%d,%d,%d in_maze=%d facing=%s mp=%d steps=%d cost=%d blocked=%s ",
+                          game_id, result->round_number, get_player_name(result->player_id), result->stairs_changed,
+                          result->direction_roll, result->movement_roll,
+                          result->start_pos[0], result->start_pos[1], result->start_pos[2],
+                          result->end_pos[0], result->end_pos[1], result->end_pos[2],
+                          result->in_game, get_direction_name(result->direction), result->movement_points,
+                          result->steps_taken, result->movement_cost, blocked_names[result->blocked_reason]);
+    snprintf(reply + length, reply_size - (size_t)length, "captured=%s effect=%s won=%d\n",
+             result->captured_player >= 0 ? get_player_name(result->captured_player) : "-",
+             effect_names[result->bawana_effect], result->won);
+}
+
+// ROLL plays the rest of the turn at once; STEP stops wherever the player would press Enter
+static void command_roll(Connection *connection, char *id_text, int single_step, char *reply, size_t reply_size) {
+    int game_id;
+    GameState *game = find_game(connection, id_text, &game_id);
+    if (!game) {
+        snprintf(reply, reply_size, "ERR unknown game\n");
+        return;
+    }
+    if (game->winner >= 0) {
+        snprintf(reply, reply_size, "ERR game over, player %s won\n", get_player_name(game->winner));
+        return;
+    }
+
+    // A worker serves many games, so tag its events with this one each time
+    TRACE_GAME(connection->trace_ids[game_id]);
+    TurnResult result;
+    if (!single_step) {
+        play_game_turn(game, &result);
+    } else {
+        int stage = game_turn_resume(game, &result);
+        if (stage != TURN_DONE) {
+            snprintf(reply, reply_size, "AWAIT game=%d round=%d player=%s die=%s\n", game_id, game->round_number,
+                     get_player_name(game->next_player),
+                     stage == TURN_AWAIT_DIRECTION_ROLL ? "direction" : "movement");
+            return;
+        }
+    }
+    METRICS_TURN(result.movement_points);
+    if (result.won) METRICS_GAME_END(1);
+    format_turn(game_id, &result, reply, reply_size);
+}
+
+static void command_state(Connection *connection, char *id_text, char *reply, size_t reply_size) {
+    int game_id;
+    GameState *game = find_game(connection, id_text, &game_id);
+    if (!game) {
+        snprintf(reply, reply_size, "ERR unknown game\n");
+        return;
+    }
+    int in_maze = 0;
+    for (int player_id = 0; player_id < game->num_players; player_id++) {
+        in_maze += game->players[player_id].in_game;
+    }
+    snprintf(reply, reply_size, "STATE game=%d round=%d next=%s winner=%s players=%d in_maze=%d flag=%d,%d,%d\n",
+             game_id, game->round_number, get_player_name(game->next_player),
+             game->winner >= 0 ? get_player_name(game->winner) : "-", game->num_players, in_maze,
+             game->flag_position[0], game->flag_position[1], game->flag_position[2]);
+}
+
+static void command_player(Connection *connection, char *id_text, char *player_text, char *reply, size_t reply_size) {
+    int game_id;
+    GameState *game = find_game(connection, id_text, &game_id);
+    if (!game) {
+        snprintf(reply, reply_size, "ERR unknown game\n");
+        return;
+    }
+    int player_id = player_text ? atoi(player_text) : -1;
+    if (player_id < 0 || player_id >= game->num_players) {
+        snprintf(reply, reply_size, "ERR unknown player\n");
+        return;
+    }
+    Player *player = &game->players[player_id];
+    snprintf(reply, reply_size, "PLAYER game=%d player=%s pos=%d,%d,%d in_maze=%d facing=%s mp=%d effect=%s turns_left=%d\n",
+             game_id, get_player_name(player_id), player->pos[0], player->pos[1], player->pos[2], player->in_game,
+             get_direction_name(player->direction), player->movement_points, effect_names[player->bawana_effect],
+             player->bawana_turns_left);
+}
+
+static void command_end(Server *server, Connection *connection, char *id_text, char *reply, size_t reply_size) {
+    int game_id;
+    GameState *game = find_game(connection, id_text, &game_id);
+    if (!game) {
+        snprintf(reply, reply_size, "ERR unknown game\n");
+        return;
+    }
+    connection->games[game_id] = NULL;
+    connection->free_ids[connection->num_free_ids++] = game_id;
+    release_game(server, game);
+    snprintf(reply, reply_size, "OK game=%d\n", game_id);
+}
+
+static void handle_request(Server *server, Connection *connection, char *line, char *reply, size_t reply_size) {
+    char *save = NULL;
+    char *command = strtok_r(line, " \t\r", &save);
+    char *first = command ? strtok_r(NULL, " \t\r", &save) : NULL;
+    char *second = first ? strtok_r(NULL, " \t\r", &save) : NULL;
+
+    if (!command) snprintf(reply, reply_size, "ERR empty request\n");
+    else if (strcmp(command, "NEW") == 0) command_new(server, connection, first, second, reply, reply_size);
+    else if (strcmp(command, "ROLL") == 0) command_roll(connection, first, 0, reply, reply_size);
+    else if (strcmp(command, "STEP") == 0) command_roll(connection, first, 1, reply, reply_size);
+    else if (strcmp(command, "STATE") == 0) command_state(connection, first, reply, reply_size);
+    else if (strcmp(command, "PLAYER") == 0) command_player(connection, first, second, reply, reply_size);
+    else if (strcmp(command, "END") == 0) command_end(server, connection, first, reply, reply_size);
+    else if (strcmp(command, "PING") == 0) snprintf(reply, reply_size, "PONG\n");
+    else snprintf(reply, reply_size, "ERR unknown command %s\n", command);
+}
+
+// Serve every queued line of a connection, then hand it back to the epoll thread
+static void *worker_main(void *arg) {
+    Server *server = arg;
+    char reply[SERVER_REPLY_SIZE];
+
+    Connection *connection;
+    while ((connection = ready_pop(server)) != NULL) {
+        int write_failed = 0;
+        while (1) {
+            pthread_mutex_lock(&connection->lock);
+            RequestLine *line = connection->queue_head;
+            if (line) {
+                connection->queue_head = line->next;
+                if (!connection->queue_head) connection->queue_tail = NULL;
+            } else {
+                connection->busy = 0;
+            }
+            int closed = connection->closed;
+            pthread_mutex_unlock(&connection->lock);
+
+            if (!line) {
+                if (closed) connection_free(server, connection);
+                break;
+            }
+            if (!write_failed) { // Lines sent before a half-close are still answered
+                if (line->too_long) snprintf(reply, sizeof(reply), "ERR line too long\n");
+                else handle_request(server, connection, line->text, reply, sizeof(reply));
+                if (!send_reply(connection->fd, reply, strlen(reply))) {
+                    write_failed = 1;
+                    shutdown(connection->fd, SHUT_RDWR); // The epoll thread sees the hang-up and closes
+                }
+            }
+            free(line);
+        }
+    }
+    return NULL;
+}
+
+static void connection_close(Server *server, int epoll_fd, Connection *connection) {
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, connection->fd, NULL);
+    pthread_mutex_lock(&connection->lock);
+    connection->closed = 1;
+    int busy = connection->busy;
+    pthread_mutex_unlock(&connection->lock);
+    if (!busy) connection_free(server, connection);
+}
+
+// Split freshly read bytes into request lines and queue them; returns 0 on a line that is too long
+// (queued as a too_long line, so the client gets an ERR after the lines before it)
+static int connection_queue_input(Server *server, Connection *connection, const char *data, size_t length) {
+    RequestLine *first = NULL, *last = NULL;
+    int ok = 1;
+
+    for (size_t i = 0; ok && i < length; i++) {
+        int too_long = 0;
+        if (data[i] != '\n') {
+            if (connection->input_length < SERVER_MAX_LINE - 1) {
+                connection->input[connection->input_length++] = data[i];
+                continue;
+            }
+            too_long = 1;
+            ok = 0;
+        }
+        size_t text_length = too_long ? 0 : connection->input_length;
+        RequestLine *line = malloc(sizeof(RequestLine) + text_length + 1);
+        if (!line) return 0;
+        memcpy(line->text, connection->input, text_length);
+        line->text[text_length] = '\0';
+        line->too_long = too_long;
+        line->next = NULL;
+        connection->input_length = 0;
+        if (last) last->next = line;
+        else first = line;
+        last = line;
+    }
+    if (!first) return ok;
+
+    pthread_mutex_lock(&connection->lock);
+    if (connection->queue_tail) connection->queue_tail->next = first;
+    else connection->queue_head = first;
+    connection->queue_tail = last;
+    int wake = !connection->busy;
+    connection->busy = 1;
+    pthread_mutex_unlock(&connection->lock);
+
+    if (wake) ready_push(server, connection);
+    return ok;
+}
+
+static int open_listen_socket(const char *socket_path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Error: Socket path too long: %s\n", socket_path);
+        return -1;
+    }
+    strcpy(address.sun_path, socket_path);
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0) {
+        perror("socket");
+        return -1;
+    }
+    unlink(socket_path);
+    if (bind(listen_fd, (struct sockaddr *)&address, sizeof(address)) < 0 || listen(listen_fd, SOMAXCONN) < 0) {
+        perror(socket_path);
+        close(listen_fd);
+        return -1;
+    }
+    return listen_fd;
+}
+
+static void accept_connections(int listen_fd, int epoll_fd) {
+    while (1) {
+        int fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return; // EAGAIN: no more pending connections
+
+        Connection *connection = calloc(1, sizeof(Connection));
+        if (!connection) {
+            close(fd);
+            continue;
+        }
+        connection->fd = fd;
+        pthread_mutex_init(&connection->lock, NULL);
+
+        struct epoll_event event = { .events = EPOLLIN | EPOLLRDHUP, .data.ptr = connection };
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            close(fd);
+            pthread_mutex_destroy(&connection->lock);
+            free(connection);
+        }
+    }
+}
+
+static void read_connection(Server *server, int epoll_fd, Connection *connection, uint32_t events) {
+    char buffer[4096];
+    while (1) {
+        ssize_t received = read(connection->fd, buffer, sizeof(buffer));
+        if (received > 0) {
+            if (!connection_queue_input(server, connection, buffer, (size_t)received)) break;
+            continue;
+        }
+        if (received < 0 && errno == EINTR) continue;
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && !(events & (EPOLLHUP | EPOLLERR))) {
+            return; // Drained; wait for more
+        }
+        break; // EOF, error or hang-up
+    }
+    connection_close(server, epoll_fd, connection);
+}
+
+int main(int argc, char *argv[]) {
+    static Server server;
+    const char *socket_path = SERVER_DEFAULT_SOCKET;
+    const char *config_dir = NULL;
+    const char *metrics_socket = NULL, *metrics_file = NULL;
+    const char *trace_file = NULL;
+    int trace_sample = 1;
+    int metrics_interval = 1000;
+    int num_workers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    server.max_games = 100000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) socket_path = argv[++i];
+        else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) num_workers = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--max-games") == 0 && i + 1 < argc) server.max_games = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--config") == 0 && i + 1 < argc) config_dir = argv[++i];
+        else if (strcmp(argv[i], "--metrics-socket") == 0 && i + 1 < argc) metrics_socket = argv[++i];
+        else if (strcmp(argv[i], "--metrics-file") == 0 && i + 1 < argc) metrics_file = argv[++i];
+        else if (strcmp(argv[i], "--metrics-interval") == 0 && i + 1 < argc) metrics_interval = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) trace_file = argv[++i];
+        else if (strcmp(argv[i], "--trace-sample") == 0 && i + 1 < argc) trace_sample = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "Usage: %s [--socket PATH] [--workers N] [--max-games N] [--config DIR] "
+                            "[--metrics-socket PATH] [--metrics-file PATH] [--metrics-interval MS] [--trace FILE] "
+                            "[--trace-sample N]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if (num_workers < 1) num_workers = 1;
+#ifdef GAME_METRICS
+    if (metrics_socket && !metrics_serve_socket(metrics_socket)) {
+        fprintf(stderr, "Error: Could not serve metrics on %s\n", metrics_socket);
+        return 1;
+    }
+    if (metrics_file && !metrics_write_file_every(metrics_file, metrics_interval)) {
+        fprintf(stderr, "Error: Could not start writing metrics to %s\n", metrics_file);
+        return 1;
+    }
+#else
+    if (metrics_socket || metrics_file) {
+        fprintf(stderr, "Error: Metrics need a build with -DGAME_METRICS and metrics.c\n");
+        return 2;
+    }
+    (void)metrics_interval;
+#endif
+    // Opened before any worker starts, so every thread sees the trace on, and
+    // closed once the workers are joined
+#ifdef GAME_TRACE
+    trace_set_sample(trace_sample);
+    if (trace_file && !trace_open(trace_file)) return 1;
+#else
+    if (trace_file) {
+        fprintf(stderr, "Error: Tracing needs a build with -DGAME_TRACE and trace.c\n");
+        return 2;
+    }
+    (void)trace_sample;
+#endif
+
+    game_print_enabled = 0;
+    game_prompt_enabled = 0;
+    game_config_load(&server.config, config_dir, DEFAULT_NUM_PLAYERS);
+    pthread_mutex_init(&server.ready_lock, NULL);
+    pthread_cond_init(&server.ready_cond, NULL);
+    pthread_mutex_init(&server.pool_lock, NULL);
+    game_pool_init(&server.pool, 0);
+
+    struct sigaction stop_action;
+    memset(&stop_action, 0, sizeof(stop_action));
+    stop_action.sa_handler = handle_stop_signal; // No SA_RESTART, so epoll_wait returns on a signal
+    sigaction(SIGINT, &stop_action, NULL);
+    sigaction(SIGTERM, &stop_action, NULL);
+
+    int listen_fd = open_listen_socket(socket_path);
+    if (listen_fd < 0) return 1;
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event listen_event = { .events = EPOLLIN, .data.ptr = NULL };
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &listen_event);
+
+    pthread_t *workers = calloc((size_t)num_workers, sizeof(pthread_t));
+    if (!workers) {
+        fprintf(stderr, "Error: Could not allocate %d workers\n", num_workers);
+        return 1;
+    }
+    for (int w = 0; w < num_workers; w++) {
+        pthread_create(&workers[w], NULL, worker_main, &server);
+    }
+    printf("Listening on %s with %d worker%s\n", socket_path, num_workers, num_workers == 1 ? "" : "s");
+    fflush(stdout);
+
+    struct epoll_event events[SERVER_MAX_EVENTS];
+    while (server_running) {
+        int ready = epoll_wait(epoll_fd, events, SERVER_MAX_EVENTS, -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            perror("epoll_wait");
+            break;
+        }
+        for (int e = 0; e < ready; e++) {
+            if (!events[e].data.ptr) accept_connections(listen_fd, epoll_fd);
+            else read_connection(&server, epoll_fd, events[e].data.ptr, events[e].events);
+        }
+    }
+
+    // Let the workers finish what is queued, then exit; remaining games are released with the process
+    pthread_mutex_lock(&server.ready_lock);
+    server.stopping = 1;
+    pthread_cond_broadcast(&server.ready_cond);
+    pthread_mutex_unlock(&server.ready_lock);
+    for (int w = 0; w < num_workers; w++) {
+        pthread_join(workers[w], NULL);
+    }
+
+#ifdef GAME_METRICS
+    metrics_stop();
+#endif
+#ifdef GAME_TRACE
+    trace_close();
+#endif
+    printf("Stopped with %d active game%s\n", atomic_load(&server.active_games),
+           atomic_load(&server.active_games) == 1 ? "" : "s");
+    close(listen_fd);
+    close(epoll_fd);
+    unlink(socket_path);
+    free(workers);
+    game_pool_destroy(&server.pool);
+    return 0;
+}
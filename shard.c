@@ -0,0 +1,375 @@
+// shard.c - Runs a simulation sweep as many simulate processes and merges the results
+// A job is a corpus file (bench/corpus.txt format: name, config dir, first seed
+// and number of games per line). Each entry is cut into shards of --shard-games
+// games, and a shard is one simulate run (--config DIR --seed FIRST --games N)
+// that writes its raw counters to stdout (--stats-out -). Up to --workers
+// shards run at once. A finished shard is written to the checkpoint directory
+// under a temporary name and renamed once its exit status, format and game
+// count check out; a failed shard is retried up to --retries times. Shards
+// already in the directory are not run again, so a stopped job resumes where it
+// was.
+//
+// Game i of an entry is always seeded first_seed + i and draws from its own
+// generator, so it plays the same whatever shard, process or thread runs it.
+// The counters only add up, so the merged statistics are exactly those of one
+// simulate run over the same games, however the job was cut.
+//
+// Workers are started with execvp(); --launcher "ssh host" puts a command in
+// front of each. The protocol is just the command line in and the counters on
+// stdout, so it runs unchanged over SSH given the same paths on the other host.
+//
+// Build: gcc -O2 -o shard shard.c stats.c
+// Usage: ./shard --job FILE --dir CHECKPOINTS [--simulate PATH] [--workers W] [--threads T]
+//                [--shard-games N] [--players P] [--max-rounds R] [--retries N] [--launcher CMD]
+//                [--wide] [--json FILE] [--csv FILE]
+
+#include "game.h"
+#include "stats.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define SHARD_MAX_ENTRIES   256
+#define SHARD_MAX_ARGS      64
+
+typedef struct {
+    char name[64];
+    char dir[512];              // Empty for the built-in default configuration
+    unsigned int first_seed;
+    long num_games;
+} JobEntry;
+
+#define SHARD_PENDING  0
+#define SHARD_RUNNING  1
+#define SHARD_DONE     2
+#define SHARD_FAILED   3
+
+typedef struct {
+    int entry;
+    unsigned int first_seed;
+    long num_games;
+    int state;                  // SHARD_*
+    int attempts;
+    pid_t pid;
+    char path[600];             // Checkpoint file
+} Shard;
+
+typedef struct {
+    const char *simulate;
+    const char *launcher;
+    const char *dir;
+    int threads, players, max_rounds, wide;
+} ShardOptions;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int read_job(const char *filename, JobEntry entries[], int max_entries) {
+    FILE *file = fopen(filename, "r");
+    if (!file) return -1;
+    // Config dirs are relative to the job file
+    char base[512];
+    snprintf(base, sizeof(base), "%s", filename);
+    char *slash = strrchr(base, '/');
+    if (slash) slash[1] = '\0';
+    else base[0] = '\0';
+
+    char line[512], dir[256];
+    int count = 0;
+    while (fgets(line, sizeof(line), file) && count < max_entries) {
+        JobEntry *entry = &entries[count];
+        if (line[0] == '#') continue;
+        if (sscanf(line, "%63s %255s %u %ld", entry->name, dir, &entry->first_seed, &entry->num_games) != 4) continue;
+        if (strcmp(dir, "-") == 0) entry->dir[0] = '\0';
+        else snprintf(entry->dir, sizeof(entry->dir), "%s%s", base, dir);
+        count++;
+    }
+    fclose(file);
+    return count;
+}
+
+// Load a shard's counters; 0 if the file is missing, damaged or not the expected number of games
+static int load_shard(const char *path, long num_games, GameStats *stats) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return 0;
+    int ok = stats_read_binary(file, stats) && (long)stats->games == num_games;
+    fclose(file);
+    return ok;
+}
+
+// The checkpoint directory remembers the options its shards were played with
+static int check_job_options(const ShardOptions *options) {
+    char path[600], expected[128], found[128] = "";
+    snprintf(path, sizeof(path), "%s/job.txt", options->dir);
+    snprintf(expected, sizeof(expected), "players %d max_rounds %d\n", options->players, options->max_rounds);
+    FILE *file = fopen(path, "r");
+    if (file) {
+        if (!fgets(found, sizeof(found), file)) found[0] = '\0';
+        fclose(file);
+        if (strcmp(found, expected) != 0) {
+            fprintf(stderr, "Error: %s holds shards played with %.*s, not %.*s\n", options->dir,
+                    (int)strcspn(found, "\n"), found, (int)strcspn(expected, "\n"), expected);
+            return 0;
+        }
+        return 1;
+    }
+    if (!(file = fopen(path, "w"))) return 0;
+    fputs(expected, file);
+    fclose(file);
+    return 1;
+}
+
+// Start simulate for one shard with stdout going to the shard's temporary file
+static pid_t launch_shard(const Shard *shard, const JobEntry *entry, const ShardOptions *options) {
+    char tmp_path[620], log_path[620];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", shard->path);
+    snprintf(log_path, sizeof(log_path), "%.*s.log", (int)(strlen(shard->path) - strlen(".stats")), shard->path);
+
+    char seed[16], games[24], threads[16], players[16], rounds[16], launcher[512];
+    snprintf(seed, sizeof(seed), "%u", shard->first_seed);
+    snprintf(games, sizeof(games), "%ld", shard->num_games);
+    snprintf(threads, sizeof(threads), "%d", options->threads);
+    snprintf(players, sizeof(players), "%d", options->players);
+    snprintf(rounds, sizeof(rounds), "%d", options->max_rounds);
+
+    char *args[SHARD_MAX_ARGS];
+    int n = 0;
+    if (options->launcher) {
+        snprintf(launcher, sizeof(launcher), "%s", options->launcher);
+        for (char *word = strtok(launcher, " "); word && n < SHARD_MAX_ARGS - 24; word = strtok(NULL, " ")) {
+            args[n++] = word;
+        }
+    }
+    args[n++] = (char *)options->simulate;
+    if (entry->dir[0]) {
+        args[n++] = "--config";
+        args[n++] = (char *)entry->dir;
+    }
+    args[n++] = "--seed";       args[n++] = seed;
+    args[n++] = "--games";      args[n++] = games;
+    args[n++] = "--players";    args[n++] = players;
+    args[n++] = "--max-rounds"; args[n++] = rounds;
+    if (options->threads > 0) {
+        args[n++] = "--threads";
+        args[n++] = threads;
+    }
+    if (options->wide) args[n++] = "--wide";
+    args[n++] = "--stats-out";
+    args[n++] = "-";
+    args[n] = NULL;
+
+    int out = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    int log = open(log_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out < 0 || log < 0) {
+        if (out >= 0) close(out);
+        if (log >= 0) close(log);
+        return -1;
+    }
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        int null = open("/dev/null", O_RDONLY);
+        if (null >= 0) dup2(null, STDIN_FILENO);
+        dup2(out, STDOUT_FILENO);
+        dup2(log, STDERR_FILENO);
+        execvp(args[0], args);
+        fprintf(stderr, "Error: Could not start %s: %s\n", args[0], strerror(errno));
+        _exit(127);
+    }
+    close(out);
+    close(log);
+    return pid;
+}
+
+// Keep the shard if it exited cleanly with every game counted; returns 1 if kept
+static int finish_shard(Shard *shard, int status) {
+    char tmp_path[620];
+    GameStats stats;
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", shard->path);
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0 && load_shard(tmp_path, shard->num_games, &stats) &&
+        rename(tmp_path, shard->path) == 0) {
+        return 1;
+    }
+    unlink(tmp_path);
+    return 0;
+}
+
+static void print_summary(const char *label, const GameStats *stats, int num_players) {
+    int slots = num_players < STATS_MAX_PLAYERS ? num_players : STATS_MAX_PLAYERS;
+    printf("%-16s %10llu games, %10llu won, %12llu turns, wins", label, (unsigned long long)stats->games,
+           (unsigned long long)stats->games_won, (unsigned long long)stats->turns);
+    for (int p = 0; p < slots; p++) printf("%s %c %llu", p ? "," : "", 'A' + p, (unsigned long long)stats->wins[p]);
+    printf("\n");
+}
+
+int main(int argc, char *argv[]) {
+    static JobEntry entries[SHARD_MAX_ENTRIES];
+    ShardOptions options = { "./simulate", NULL, NULL, 1, DEFAULT_NUM_PLAYERS, 1000, 0 };
+    const char *job_file = NULL, *json_filename = NULL, *csv_filename = NULL;
+    long shard_games = 10000;
+    int workers = (int)sysconf(_SC_NPROCESSORS_ONLN), retries = 2;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--job") == 0 && i + 1 < argc) job_file = argv[++i];
+        else if (strcmp(argv[i], "--dir") == 0 && i + 1 < argc) options.dir = argv[++i];
+        else if (strcmp(argv[i], "--simulate") == 0 && i + 1 < argc) options.simulate = argv[++i];
+        else if (strcmp(argv[i], "--launcher") == 0 && i + 1 < argc) options.launcher = argv[++i];
+        else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) workers = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) options.threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--shard-games") == 0 && i + 1 < argc) shard_games = atol(argv[++i]);
+        else if (strcmp(argv[i], "--players") == 0 && i + 1 < argc) options.players = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--max-rounds") == 0 && i + 1 < argc) options.max_rounds = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--retries") == 0 && i + 1 < argc) retries = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--wide") == 0) options.wide = 1;
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) json_filename = argv[++i];
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) csv_filename = argv[++i];
+        else {
+            fprintf(stderr, "Usage: %s --job FILE --dir CHECKPOINTS [--simulate PATH] [--workers W] [--threads T] "
+                            "[--shard-games N] [--players P] [--max-rounds R] [--retries N] [--launcher CMD] "
+                            "[--wide] [--json FILE] [--csv FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (!job_file || !options.dir) {
+        fprintf(stderr, "Error: --job and --dir are required\n");
+        return 2;
+    }
+    if (options.players < MIN_PLAYERS || options.players > MAX_PLAYERS || shard_games < 1) {
+        fprintf(stderr, "Error: --players must be between %d and %d and --shard-games at least 1\n",
+                MIN_PLAYERS, MAX_PLAYERS);
+        return 2;
+    }
+    if (workers < 1) workers = 1;
+
+    int num_entries = read_job(job_file, entries, SHARD_MAX_ENTRIES);
+    if (num_entries <= 0) {
+        fprintf(stderr, "Error: Could not read any entries from %s\n", job_file);
+        return 1;
+    }
+    if (mkdir(options.dir, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "Error: Could not create %s\n", options.dir);
+        return 1;
+    }
+    if (!check_job_options(&options)) return 1;
+
+    long num_shards = 0;
+    for (int e = 0; e < num_entries; e++) num_shards += (entries[e].num_games + shard_games - 1) / shard_games;
+    Shard *shards = calloc((size_t)num_shards, sizeof(Shard));
+    if (!shards) {
+        fprintf(stderr, "Error: Could not allocate %ld shards\n", num_shards);
+        return 1;
+    }
+
+    // Cut the job and pick up the shards a previous run already finished
+    long s = 0, resumed = 0;
+    for (int e = 0; e < num_entries; e++) {
+        for (long first = 0; first < entries[e].num_games; first += shard_games, s++) {
+            Shard *shard = &shards[s];
+            GameStats stats;
+            shard->entry = e;
+            shard->first_seed = entries[e].first_seed + (unsigned int)first;
+            shard->num_games = entries[e].num_games - first < shard_games ? entries[e].num_games - first : shard_games;
+            if (snprintf(shard->path, sizeof(shard->path), "%s/%s-%u-%ld.stats", options.dir, entries[e].name,
+                         shard->first_seed, shard->num_games) >= (int)sizeof(shard->path)) {
+                fprintf(stderr, "Error: Checkpoint path for %s is too long\n", entries[e].name);
+                free(shards);
+                return 1;
+            }
+            if (load_shard(shard->path, shard->num_games, &stats)) {
+                shard->state = SHARD_DONE;
+                resumed++;
+            }
+        }
+    }
+    printf("Job %s: %d configs, %ld shards (%ld already in %s), %d workers\n", job_file, num_entries, num_shards,
+           resumed, options.dir, workers);
+
+    // Keep `workers` shards running until every shard is done or out of retries
+    double start = now_seconds();
+    long next = 0, done = resumed, failed = 0;
+    int running = 0;
+    for (;;) {
+        while (running < workers) {
+            while (next < num_shards && shards[next].state != SHARD_PENDING) next++;
+            if (next == num_shards) break;
+            Shard *shard = &shards[next];
+            shard->pid = launch_shard(shard, &entries[shard->entry], &options);
+            shard->attempts++;
+            if (shard->pid < 0) {
+                fprintf(stderr, "Error: Could not start a worker for %s\n", shard->path);
+                shard->state = SHARD_FAILED;
+                failed++;
+                continue;
+            }
+            shard->state = SHARD_RUNNING;
+            running++;
+        }
+        if (running == 0) break;
+
+        int status;
+        pid_t pid = wait(&status);
+        if (pid < 0) break;
+        for (long i = 0; i < num_shards; i++) {
+            Shard *shard = &shards[i];
+            if (shard->state != SHARD_RUNNING || shard->pid != pid) continue;
+            running--;
+            if (finish_shard(shard, status)) {
+                shard->state = SHARD_DONE;
+                done++;
+                printf("Shard %s %u+%ld done (%ld/%ld)\n", entries[shard->entry].name, shard->first_seed,
+                       shard->num_games, done, num_shards);
+            } else if (shard->attempts <= retries) {
+                fprintf(stderr, "Shard %s %u+%ld failed, retrying (attempt %d of %d)\n", entries[shard->entry].name,
+                        shard->first_seed, shard->num_games, shard->attempts + 1, retries + 1);
+                shard->state = SHARD_PENDING;
+                if (i < next) next = i;
+            } else {
+                fprintf(stderr, "Shard %s %u+%ld failed %d times, giving up\n", entries[shard->entry].name,
+                        shard->first_seed, shard->num_games, shard->attempts);
+                shard->state = SHARD_FAILED;
+                failed++;
+            }
+            break;
+        }
+    }
+    double elapsed = now_seconds() - start;
+
+    if (failed) {
+        fprintf(stderr, "Error: %ld of %ld shards failed; finished shards are kept in %s, rerun to resume\n",
+                failed, num_shards, options.dir);
+        free(shards);
+        return 1;
+    }
+
+    // Merge per config and over the whole job
+    static GameStats total, per_entry[SHARD_MAX_ENTRIES];
+    for (long i = 0; i < num_shards; i++) {
+        GameStats stats;
+        if (!load_shard(shards[i].path, shards[i].num_games, &stats)) {
+            fprintf(stderr, "Error: %s changed while the job ran\n", shards[i].path);
+            free(shards);
+            return 1;
+        }
+        stats_merge(&per_entry[shards[i].entry], &stats);
+        stats_merge(&total, &stats);
+    }
+    for (int e = 0; e < num_entries; e++) {
+        char path[600];
+        if (snprintf(path, sizeof(path), "%s/%s.json", options.dir, entries[e].name) < (int)sizeof(path)) {
+            stats_write_json(path, &per_entry[e]);
+        }
+        print_summary(entries[e].name, &per_entry[e], options.players);
+    }
+    print_summary("total", &total, options.players);
+    printf("Elapsed: %.3fs for the %ld shards run now\n", elapsed, num_shards - resumed);
+
+    if (csv_filename) stats_write_csv(csv_filename, &total);
+    if (json_filename) stats_write_json(json_filename, &total);
+    free(shards);
+    return 0;
+}
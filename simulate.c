@@ -0,0 +1,434 @@
+// simulate.c - Headless batch simulator for Maze of UCSC
+// Plays many complete games across worker threads with narration and prompts
+// disabled. Game i is seeded with base_seed + i, so results do not depend on
+// the number of threads, and a single game can be replayed interactively by
+// putting the same seed in seed.txt. Statistics are collected per thread and
+// merged once at the end.
+//
+// With --wide each thread plays its games in a lockstep batch (wide.h), which
+// gives the same results faster.
+//
+// Each thread takes its games from its own pool (arena.h), so after the first
+// game no game is set up or torn down through the heap.
+//
+// With --fast-start a player waiting in the starting area draws how many rolls
+// miss the 6 at once instead of rolling every turn (turn.c). Results have the
+// same distribution but no longer replay seed for seed.
+//
+// With --feed every thread publishes the state of its game at the end of each
+// round to a shared-memory feed (feed.h) that spectate.c can watch.
+//
+// Built with -DGAME_METRICS (and metrics.c), --metrics-file and --metrics-socket
+// export running totals in Prometheus text format (metrics.h).
+//
+// --stats-out writes the raw counters (stats_write_binary()) for shard.c to
+// merge; with "-" they go to stdout and the summary to stderr.
+//
+// --outcomes appends one record per game (winner, rounds, captures, Bawana
+// effects, final MP, ...) to a columnar store (store.h) that scan.c queries,
+// tagged with --config-id to tell sweeps over different configurations apart.
+// The per-game counts come from the statistics hooks, so without -DGAME_STATS
+// --outcomes is refused.
+//
+// Built with -DGAME_TRACE (and trace.c), --trace writes a Chrome trace of every
+// turn and turn phase (trace.h), with each game on its own track named by its seed.
+// Only games whose seed is a multiple of --trace-sample (default 100) are traced.
+//
+// Build: gcc -O2 -march=native -DGAME_STATS -pthread -o simulate simulate.c wide.c arena.c feed.c game.c turn.c stats.c store.c -lm
+// Usage: ./simulate [--games N] [--threads T] [--seed S] [--max-rounds R]
+//                   [--players P] [--config DIR] [--csv FILE] [--json FILE] [--wide] [--fast-start]
+//                   [--feed NAME] [--metrics-file PATH] [--metrics-socket PATH] [--metrics-interval MS]
+//                   [--stats-out FILE] [--outcomes FILE] [--config-id N] [--trace FILE] [--trace-sample N]
+
+#include "game.h"
+#include "arena.h"
+#include "feed.h"
+#include "metrics.h"
+#include "stats.h"
+#include "store.h"
+#include "trace.h"
+#include "wide.h"
+#include <pthread.h>
+#include <unistd.h>
+
+// Shared, read-only configuration every game starts from
+typedef struct {
+    GameConfig game;
+    long num_games;
+    unsigned int base_seed;
+    int max_rounds;
+    int num_threads;
+    int wide;                   // Play games in lockstep batches
+    int fast_start;             // Skip the misses of players waiting for a 6 (GameState.fast_start)
+    LiveFeed *feed;             // Round-by-round snapshots for spectators, or NULL
+    StoreWriter *outcomes;      // Per-game records, or NULL
+    unsigned int config_id;     // Tag for the records
+} SimConfig;
+
+typedef struct {
+    const SimConfig *config;
+    int thread_index;
+    GamePool pool;              // Game states, reused from one game to the next
+    GameStats stats;
+    StoreBuffer outcomes;       // Records waiting to be appended as a block
+} SimWorker;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Play one game to the end (or the round cap) in a game from the worker's pool;
+// returns the winner, -1 if nobody won, -2 if out of memory or -3 if the
+// outcome store could not be written
+static int play_game(SimWorker *worker, unsigned int seed) {
+    const SimConfig *config = worker->config;
+    GameStats *stats = &worker->stats;
+    TurnResult result;
+    int winner = -1;
+    int rounds_played = config->max_rounds;
+
+    GameState *game = game_pool_create(&worker->pool, &config->game, config->game.num_players, seed);
+    if (!game) return -2;
+    game->fast_start = config->fast_start;
+    // This game's counts are the difference in the thread's counters
+    uint64_t captures_before[STATS_MAX_PLAYERS], bawana_before[STATS_NUM_BAWANA], loop_resets_before = 0;
+    if (config->outcomes) {
+        memcpy(captures_before, stats->captures_by_player, sizeof(captures_before));
+        memcpy(bawana_before, stats->bawana_effects, sizeof(bawana_before));
+        loop_resets_before = stats->loop_resets;
+    }
+    METRICS_GAME_START();
+    TRACE_GAME((int)seed);
+    while (game->round_number <= config->max_rounds) {
+        int won = play_game_turn(game, &result);
+        stats_record_turn(stats, result.round_number, result.movement_points);
+        METRICS_TURN(result.movement_points);
+        if (config->feed && (won || game->next_player == 0)) feed_publish_game(config->feed, seed, game);
+        if (won) {
+            winner = result.player_id;
+            rounds_played = result.round_number;
+            break;
+        }
+    }
+
+    stats_record_game(stats, rounds_played, winner);
+    METRICS_GAME_END(winner >= 0);
+    if (config->outcomes) {
+        OutcomeRecord record = { 0 };
+        record.config_id = config->config_id;
+        record.seed = seed;
+        record.num_players = game->num_players;
+        record.winner = winner;
+        record.rounds = rounds_played;
+        record.loop_resets = (int32_t)(stats->loop_resets - loop_resets_before);
+        for (int e = 0; e < STORE_NUM_BAWANA; e++) record.bawana[e] = (int32_t)(stats->bawana_effects[e] - bawana_before[e]);
+        for (int p = 0; p < STORE_MAX_PLAYERS; p++) {
+            record.captures[p] = (int32_t)(stats->captures_by_player[p] - captures_before[p]);
+            if (p < game->num_players) record.final_mp[p] = game->players[p].movement_points;
+        }
+        if (!store_buffer_add(&worker->outcomes, &record)) {
+            game_pool_put(&worker->pool, game);
+            return -3;
+        }
+    }
+    game_pool_put(&worker->pool, game);
+    return winner;
+}
+
+// Play this thread's games in a wide batch, starting the next game in a lane as soon as one ends
+static void run_wide_batch(SimWorker *worker, WideBatch *batch) {
+    const SimConfig *config = worker->config;
+    int num_players = config->game.num_players;
+    long next_game = worker->thread_index;
+    TurnResult results[WIDE_LANES];
+
+    for (int lane = 0; lane < WIDE_LANES; lane++) {
+        if (next_game >= config->num_games) break;
+        wide_batch_start(batch, lane, config->base_seed + (unsigned int)next_game);
+        METRICS_GAME_START();
+        next_game += config->num_threads;
+    }
+
+    int played;
+    while ((played = wide_batch_step(batch, results)) != 0) {
+        for (int lane = 0; lane < WIDE_LANES; lane++) {
+            if (!(played >> lane & 1)) continue;
+            const TurnResult *result = &results[lane];
+            stats_record_turn(&worker->stats, result->round_number, result->movement_points);
+            METRICS_TURN(result->movement_points);
+            if (result->won) {
+                stats_record_game(&worker->stats, result->round_number, result->player_id);
+                METRICS_GAME_END(1);
+            } else if (result->player_id == num_players - 1 && result->round_number >= config->max_rounds) {
+                stats_record_game(&worker->stats, config->max_rounds, -1);
+                METRICS_GAME_END(0);
+            } else {
+                continue;
+            }
+
+            if (next_game < config->num_games) {
+                wide_batch_start(batch, lane, config->base_seed + (unsigned int)next_game);
+                METRICS_GAME_START();
+                next_game += config->num_threads;
+            } else {
+                wide_batch_stop(batch, lane);
+            }
+        }
+    }
+}
+
+static void *worker_main(void *arg) {
+    SimWorker *worker = arg;
+    const SimConfig *config = worker->config;
+
+    if (config->wide) {
+        WideBatch *batch = wide_batch_create(&config->game, config->game.num_players);
+        if (!batch) {
+            fprintf(stderr, "Error: Could not allocate a wide batch for thread %d\n", worker->thread_index);
+            return NULL;
+        }
+        stats_bind(&worker->stats);
+        run_wide_batch(worker, batch);
+        stats_bind(NULL);
+        wide_batch_destroy(batch);
+        return NULL;
+    }
+
+    if (config->outcomes && !store_buffer_init(&worker->outcomes, config->outcomes)) {
+        fprintf(stderr, "Error: Could not allocate an outcome buffer for thread %d\n", worker->thread_index);
+        return NULL;
+    }
+    stats_bind(&worker->stats);
+    game_pool_init(&worker->pool, game_state_size(config->game.num_players));
+    for (long game_index = worker->thread_index; game_index < config->num_games; game_index += config->num_threads) {
+        int winner = play_game(worker, config->base_seed + (unsigned int)game_index);
+        if (winner == -2) {
+            fprintf(stderr, "Error: Could not allocate a game for thread %d\n", worker->thread_index);
+            break;
+        }
+        if (winner == -3) {
+            fprintf(stderr, "Error: Could not write outcomes from thread %d\n", worker->thread_index);
+            break;
+        }
+    }
+    stats_bind(NULL);
+    if (config->outcomes) {
+        if (!store_buffer_flush(&worker->outcomes)) {
+            fprintf(stderr, "Error: Could not write outcomes from thread %d\n", worker->thread_index);
+        }
+        store_buffer_free(&worker->outcomes);
+    }
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    static SimConfig config;
+    const char *config_dir = NULL;
+    const char *csv_filename = NULL;
+    const char *json_filename = NULL;
+    const char *feed_name = NULL;
+    const char *stats_out = NULL;
+    const char *outcomes_file = NULL;
+    const char *trace_file = NULL;
+    int trace_sample = 100;
+    const char *metrics_file = NULL, *metrics_socket = NULL;
+    int metrics_interval = 1000;
+
+    config.num_games = 10000;
+    config.base_seed = 1;
+    config.max_rounds = 1000;
+    config.num_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int num_players = DEFAULT_NUM_PLAYERS;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--games") == 0 && i + 1 < argc) config.num_games = atol(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) config.num_threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) config.base_seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--max-rounds") == 0 && i + 1 < argc) config.max_rounds = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--players") == 0 && i + 1 < argc) num_players = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--config") == 0 && i + 1 < argc) config_dir = argv[++i];
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) csv_filename = argv[++i];
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) json_filename = argv[++i];
+        else if (strcmp(argv[i], "--wide") == 0) config.wide = 1;
+        else if (strcmp(argv[i], "--fast-start") == 0) config.fast_start = 1;
+        else if (strcmp(argv[i], "--feed") == 0 && i + 1 < argc) feed_name = argv[++i];
+        else if (strcmp(argv[i], "--metrics-file") == 0 && i + 1 < argc) metrics_file = argv[++i];
+        else if (strcmp(argv[i], "--metrics-socket") == 0 && i + 1 < argc) metrics_socket = argv[++i];
+        else if (strcmp(argv[i], "--metrics-interval") == 0 && i + 1 < argc) metrics_interval = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--stats-out") == 0 && i + 1 < argc) stats_out = argv[++i];
+        else if (strcmp(argv[i], "--outcomes") == 0 && i + 1 < argc) outcomes_file = argv[++i];
+        else if (strcmp(argv[i], "--config-id") == 0 && i + 1 < argc) config.config_id = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) trace_file = argv[++i];
+        else if (strcmp(argv[i], "--trace-sample") == 0 && i + 1 < argc) trace_sample = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "Usage: %s [--games N] [--threads T] [--seed S] [--max-rounds R] "
+                            "[--players P] [--config DIR] [--csv FILE] [--json FILE] [--wide] [--fast-start] [--feed NAME] "
+                            "[--metrics-file PATH] [--metrics-socket PATH] [--metrics-interval MS] [--stats-out FILE] "
+                            "[--outcomes FILE] [--config-id N] [--trace FILE] [--trace-sample N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (num_players < MIN_PLAYERS || num_players > MAX_PLAYERS) {
+        fprintf(stderr, "Error: --players must be between %d and %d\n", MIN_PLAYERS, MAX_PLAYERS);
+        return 2;
+    }
+    if (config.wide && num_players > WIDE_MAX_PLAYERS) {
+        fprintf(stderr, "Error: --wide supports at most %d players\n", WIDE_MAX_PLAYERS);
+        return 2;
+    }
+    if (config.wide && config.fast_start) {
+        fprintf(stderr, "Error: --fast-start does not apply to --wide, which replays every seed exactly\n");
+        return 2;
+    }
+    if (config.wide && feed_name) {
+        fprintf(stderr, "Error: --feed needs the full game states, which --wide does not keep\n");
+        return 2;
+    }
+    if (config.wide && outcomes_file) {
+        fprintf(stderr, "Error: --outcomes needs the full game states, which --wide does not keep\n");
+        return 2;
+    }
+#ifndef GAME_STATS
+    if (outcomes_file) {
+        fprintf(stderr, "Error: --outcomes needs a build with -DGAME_STATS and stats.c\n");
+        return 2;
+    }
+#endif
+    if (config.wide && trace_file) {
+        fprintf(stderr, "Error: --trace needs the full game states, which --wide does not keep\n");
+        return 2;
+    }
+    if (config.num_threads < 1) config.num_threads = 1;
+    static StoreWriter outcomes;
+    if (outcomes_file) {
+        if (!store_writer_open(&outcomes, outcomes_file)) {
+            fprintf(stderr, "Error: Could not open outcome store %s\n", outcomes_file);
+            return 1;
+        }
+        config.outcomes = &outcomes;
+    }
+    static LiveFeed feed;
+    if (feed_name) {
+        if (!feed_create(&feed, feed_name, 0)) {
+            fprintf(stderr, "Error: Could not create live feed %s in /dev/shm\n", feed_name);
+            return 1;
+        }
+        config.feed = &feed;
+    }
+#ifdef GAME_METRICS
+    if (metrics_file && !metrics_write_file_every(metrics_file, metrics_interval)) {
+        fprintf(stderr, "Error: Could not start writing metrics to %s\n", metrics_file);
+        return 1;
+    }
+    if (metrics_socket && !metrics_serve_socket(metrics_socket)) {
+        fprintf(stderr, "Error: Could not serve metrics on %s\n", metrics_socket);
+        return 1;
+    }
+#else
+    if (metrics_file || metrics_socket) {
+        fprintf(stderr, "Error: Metrics need a build with -DGAME_METRICS and metrics.c\n");
+        return 2;
+    }
+    (void)metrics_interval;
+#endif
+    // Opened before any worker starts, so every thread sees the trace on
+#ifdef GAME_TRACE
+    trace_set_sample(trace_sample);
+    if (trace_file && !trace_open(trace_file)) return 1;
+#else
+    if (trace_file) {
+        fprintf(stderr, "Error: Tracing needs a build with -DGAME_TRACE and trace.c\n");
+        return 2;
+    }
+    (void)trace_sample;
+#endif
+
+    game_print_enabled = 0;
+    game_prompt_enabled = 0;
+    game_config_load(&config.game, config_dir, num_players);
+
+    SimWorker *workers = calloc((size_t)config.num_threads, sizeof(SimWorker));
+    pthread_t *threads = calloc((size_t)config.num_threads, sizeof(pthread_t));
+    if (!workers || !threads) {
+        fprintf(stderr, "Error: Could not allocate %d workers\n", config.num_threads);
+        return 1;
+    }
+
+    double start = now_seconds();
+    for (int t = 0; t < config.num_threads; t++) {
+        workers[t].config = &config;
+        workers[t].thread_index = t;
+        pthread_create(&threads[t], NULL, worker_main, &workers[t]);
+    }
+
+    static GameStats total;
+    long pooled_games = 0, pool_chunks = 0;
+    for (int t = 0; t < config.num_threads; t++) {
+        pthread_join(threads[t], NULL);
+        stats_merge(&total, &workers[t].stats);
+        pooled_games += workers[t].pool.games_allocated;
+        pool_chunks += workers[t].pool.arena.heap_allocations;
+        game_pool_destroy(&workers[t].pool);
+    }
+    double elapsed = now_seconds() - start;
+#ifdef GAME_METRICS
+    metrics_stop();
+#endif
+#ifdef GAME_TRACE
+    trace_close();  // Every worker has finished recording
+#endif
+
+    // The summary moves to stderr when stdout carries the counters
+    FILE *report = (stats_out && strcmp(stats_out, "-") == 0) ? stderr : stdout;
+    fprintf(report, "Games: %llu (%llu won, %llu stopped at %d rounds)\n",
+            (unsigned long long)total.games, (unsigned long long)total.games_won,
+            (unsigned long long)(total.games - total.games_won), config.max_rounds);
+    fprintf(report, "Turns: %llu, captures: %llu, loop resets: %llu\n",
+            (unsigned long long)total.turns, (unsigned long long)total.captures,
+            (unsigned long long)total.loop_resets);
+    // Players beyond the stats slots are counted in the last one
+    int win_slots = config.game.num_players < STATS_MAX_PLAYERS ? config.game.num_players : STATS_MAX_PLAYERS;
+    fprintf(report, "Wins:");
+    for (int p = 0; p < win_slots; p++) {
+        fprintf(report, "%s %s%s %llu", p ? "," : "", get_player_name(p),
+                (p == STATS_MAX_PLAYERS - 1 && config.game.num_players > STATS_MAX_PLAYERS) ? "+" : "",
+                (unsigned long long)total.wins[p]);
+    }
+    fprintf(report, "\n");
+    if (!config.wide) {
+        fprintf(report, "Game states: %ld for %llu games, from %ld heap allocation%s\n", pooled_games,
+                (unsigned long long)total.games, pool_chunks, pool_chunks == 1 ? "" : "s");
+    }
+    fprintf(report, "Elapsed: %.3fs on %d thread%s, %.0f games/s, %.0f turns/s\n", elapsed, config.num_threads,
+            config.num_threads == 1 ? "" : "s", total.games / elapsed, total.turns / elapsed);
+
+    if (config.outcomes) {
+        fprintf(report, "Outcomes: %llu records appended to %s, %.1f bytes per game\n",
+                (unsigned long long)outcomes.records, outcomes_file,
+                outcomes.records ? (double)outcomes.bytes / (double)outcomes.records : 0.0);
+    }
+
+    if (csv_filename) stats_write_csv(csv_filename, &total);
+    if (json_filename) stats_write_json(json_filename, &total);
+    int status = 0;
+    if (stats_out) {
+        FILE *out = strcmp(stats_out, "-") == 0 ? stdout : fopen(stats_out, "wb");
+        if (!out || !stats_write_binary(out, &total)) {
+            fprintf(stderr, "Error: Could not write statistics to %s\n", stats_out);
+            status = 1;
+        }
+        if (out && out != stdout) fclose(out);
+    }
+    if ((long)total.games != config.num_games) status = 1;   // A thread ran out of memory
+    if (config.outcomes) {
+        if (outcomes.records != total.games) status = 1;
+        store_writer_close(config.outcomes);
+    }
+
+    if (config.feed) feed_close(config.feed);
+    free(workers);
+    free(threads);
+    return status;
+}
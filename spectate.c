@@ -0,0 +1,107 @@
+// spectate.c - Prints the live state of games published to a shared-memory feed (feed.h)
+// Polls the feed and prints the newest snapshot whenever a new one appears. It
+// only maps the feed read-only, so any number of spectators can watch a game
+// or a simulation without slowing it down.
+//
+// Build: gcc -O2 -o spectate spectate.c feed.c game.c turn.c -lm
+// Usage: ./spectate [--feed NAME] [--game ID] [--interval MS] [--once]
+
+#include "game.h"
+#include "feed.h"
+#include <time.h>
+
+static void print_snapshot(const FeedSnapshot *snapshot) {
+    printf("\n--- Game %llu, round %d ---\n", (unsigned long long)snapshot->game_id, snapshot->round_number);
+    printf("Flag location: [%d,%d,%d]\n", snapshot->flag_position[0], snapshot->flag_position[1],
+           snapshot->flag_position[2]);
+    printf("Stairs:");
+    for (int i = 0; i < snapshot->num_stairs; i++) {
+        static const char *direction_names[] = { "up", "down", "both" };
+        int direction = snapshot->stair_direction[i];
+        printf("%s %d %s", i ? "," : "", i,
+               direction >= STAIR_UP_ONLY && direction <= STAIR_BIDIRECTIONAL ? direction_names[direction] : "?");
+    }
+    printf("\n");
+
+    int listed = snapshot->num_players < FEED_MAX_PLAYERS ? snapshot->num_players : FEED_MAX_PLAYERS;
+    for (int p = 0; p < listed; p++) {
+        const FeedPlayer *player = &snapshot->players[p];
+        printf("Player %s: [%d,%d,%d] - ", get_player_name(p), player->pos[0], player->pos[1], player->pos[2]);
+        if (player->in_game) {
+            printf("In maze, MP: %d, facing %s", player->movement_points, get_direction_name(player->direction));
+            if (player->bawana_effect > EFFECT_NONE && player->bawana_effect < NUM_EFFECTS) {
+                printf(", Bawana effect: %s", bawana_effect_info[player->bawana_effect].name);
+                if (player->bawana_effect != EFFECT_HAPPY) {
+                    printf(" (turns left: %d)", player->bawana_turns_left);
+                }
+            }
+        } else {
+            printf("In starting area, MP: %d", player->movement_points);
+        }
+        printf("\n");
+    }
+    if (snapshot->num_players > listed) {
+        printf("(%d more players not published)\n", snapshot->num_players - listed);
+    }
+    if (snapshot->winner >= 0) {
+        printf("Player %s captured the flag!\n", get_player_name(snapshot->winner));
+    }
+    printf("-------------------\n");
+    fflush(stdout);
+}
+
+// The newest snapshot still in the ring (of game `game_id`, unless it is -1); returns 0 if there is none
+static int read_newest(const LiveFeed *feed, uint64_t published, long long game_id, FeedSnapshot *snapshot) {
+    uint64_t oldest = published > feed->header->num_slots ? published - feed->header->num_slots : 0;
+    for (uint64_t index = published; index > oldest; index--) {
+        if (feed_read(feed, index - 1, snapshot) && (game_id < 0 || snapshot->game_id == (uint64_t)game_id)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *name = "maze_feed";
+    long long game_id = -1;
+    int interval_ms = 200;
+    int once = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--feed") == 0 && i + 1 < argc) name = argv[++i];
+        else if (strcmp(argv[i], "--game") == 0 && i + 1 < argc) game_id = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc) interval_ms = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--once") == 0) once = 1;
+        else {
+            fprintf(stderr, "Usage: %s [--feed NAME] [--game ID] [--interval MS] [--once]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (interval_ms < 1) interval_ms = 1;
+
+    LiveFeed feed;
+    if (!feed_open(&feed, name)) {
+        fprintf(stderr, "Error: No live feed named %s in /dev/shm\n", name);
+        return 1;
+    }
+
+    struct timespec pause = { interval_ms / 1000, (long)(interval_ms % 1000) * 1000000L };
+    uint64_t last_index = UINT64_MAX;
+    FeedSnapshot snapshot;
+    while (1) {
+        uint64_t published = feed_published(&feed);
+        if (read_newest(&feed, published, game_id, &snapshot) && snapshot.index != last_index) {
+            last_index = snapshot.index;
+            print_snapshot(&snapshot);
+            if (once || (game_id >= 0 && snapshot.winner >= 0)) break;
+        } else if (once) {
+            fprintf(stderr, "Error: Nothing published to %s yet\n", name);
+            feed_close(&feed);
+            return 1;
+        }
+        nanosleep(&pause, NULL);
+    }
+
+    feed_close(&feed);
+    return 0;
+}
@@ -0,0 +1,218 @@
+// stats.c - Per-thread statistics blocks, merging and CSV/JSON export
+
+#include "stats.h"
+
+_Thread_local GameStats *stats_thread;
+
+static const char *bawana_names[STATS_NUM_BAWANA] = {
+    "food_poisoning", "disoriented", "triggered", "happy", "random_mp"
+};
+static const char *block_names[STATS_NUM_BLOCKS] = {
+    "none", "wall", "invalid_cell", "bawana_entrance"
+};
+
+void stats_bind(GameStats *stats) {
+    stats_thread = stats;
+}
+
+void stats_reset(GameStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+}
+
+// Add every counter of `part` into `total`; the struct holds only 64-bit counters
+void stats_merge(GameStats *total, const GameStats *part) {
+    uint64_t *to = (uint64_t *)total;
+    const uint64_t *from = (const uint64_t *)part;
+    for (size_t i = 0; i < sizeof(GameStats) / sizeof(uint64_t); i++) {
+        to[i] += from[i];
+    }
+}
+
+void stats_record_turn(GameStats *stats, int round_number, int movement_points) {
+    int round_slot = (round_number < STATS_MAX_ROUNDS) ? round_number : STATS_MAX_ROUNDS - 1;
+    stats->turns++;
+    stats->mp_sum[round_slot] += movement_points;
+    stats->mp_samples[round_slot]++;
+
+    int bucket = (movement_points <= 0) ? 0 : (movement_points - 1) / 10 + 1;
+    if (bucket >= STATS_MP_BUCKETS) bucket = STATS_MP_BUCKETS - 1;
+    stats->mp_histogram[bucket]++;
+}
+
+// winner_id is -1 when the game was stopped before anyone captured the flag
+void stats_record_game(GameStats *stats, int rounds_played, int winner_id) {
+    stats->games++;
+    stats->rounds += rounds_played;
+
+    int bucket = rounds_played / 10;
+    if (bucket >= STATS_LENGTH_BUCKETS) bucket = STATS_LENGTH_BUCKETS - 1;
+    stats->game_length[bucket]++;
+
+    if (winner_id >= 0) {
+        stats->games_won++;
+        stats->wins[winner_id < STATS_MAX_PLAYERS ? winner_id : STATS_MAX_PLAYERS - 1]++;
+    }
+}
+
+// Long format: one row per value, `key` names the bucket, player, reason or cell
+int stats_write_csv(const char *filename, const GameStats *stats) {
+    FILE *csv = fopen(filename, "w");
+    if (!csv) {
+        fprintf(stderr, "Error: Could not write statistics to %s\n", filename);
+        return 0;
+    }
+
+    fprintf(csv, "metric,key,value\n");
+    fprintf(csv, "games,,%llu\n", (unsigned long long)stats->games);
+    fprintf(csv, "games_won,,%llu\n", (unsigned long long)stats->games_won);
+    fprintf(csv, "turns,,%llu\n", (unsigned long long)stats->turns);
+    fprintf(csv, "rounds,,%llu\n", (unsigned long long)stats->rounds);
+    fprintf(csv, "captures,,%llu\n", (unsigned long long)stats->captures);
+    fprintf(csv, "loop_resets,,%llu\n", (unsigned long long)stats->loop_resets);
+
+    for (int p = 0; p < STATS_MAX_PLAYERS; p++) {
+        fprintf(csv, "wins,%c,%llu\n", 'A' + p, (unsigned long long)stats->wins[p]);
+        fprintf(csv, "captures_by_player,%c,%llu\n", 'A' + p, (unsigned long long)stats->captures_by_player[p]);
+    }
+    for (int b = 0; b < STATS_LENGTH_BUCKETS; b++) {
+        fprintf(csv, "game_length,%d-%d,%llu\n", b * 10, b * 10 + 9, (unsigned long long)stats->game_length[b]);
+    }
+    for (int r = 0; r < STATS_MAX_ROUNDS; r++) {
+        if (stats->mp_samples[r] == 0) continue;
+        fprintf(csv, "mp_mean_by_round,%d,%.3f\n", r, (double)stats->mp_sum[r] / (double)stats->mp_samples[r]);
+    }
+    for (int b = 0; b < STATS_MP_BUCKETS; b++) {
+        if (b == 0) {
+            fprintf(csv, "mp_histogram,<=0,%llu\n", (unsigned long long)stats->mp_histogram[b]);
+        } else {
+            fprintf(csv, "mp_histogram,%d-%d,%llu\n", (b - 1) * 10 + 1, b * 10, (unsigned long long)stats->mp_histogram[b]);
+        }
+    }
+    for (int e = 0; e < STATS_NUM_BAWANA; e++) {
+        fprintf(csv, "bawana_effects,%s,%llu\n", bawana_names[e], (unsigned long long)stats->bawana_effects[e]);
+    }
+    for (int b = 1; b < STATS_NUM_BLOCKS; b++) {
+        fprintf(csv, "blocked_moves,%s,%llu\n", block_names[b], (unsigned long long)stats->blocked_moves[b]);
+    }
+
+    for (int f = 0; f < NUM_FLOORS; f++) {
+        for (int w = 0; w < FLOOR_WIDTH; w++) {
+            for (int l = 0; l < FLOOR_LENGTH; l++) {
+                if (stats->visits[f][w][l]) {
+                    fprintf(csv, "visits,\"[%d,%d,%d]\",%llu\n", f, w, l, (unsigned long long)stats->visits[f][w][l]);
+                }
+                if (stats->stair_uses[f][w][l]) {
+                    fprintf(csv, "stair_uses,\"[%d,%d,%d]\",%llu\n", f, w, l, (unsigned long long)stats->stair_uses[f][w][l]);
+                }
+                if (stats->pole_uses[f][w][l]) {
+                    fprintf(csv, "pole_uses,\"[%d,%d,%d]\",%llu\n", f, w, l, (unsigned long long)stats->pole_uses[f][w][l]);
+                }
+            }
+        }
+    }
+
+    fclose(csv);
+    return 1;
+}
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t size;              // sizeof(GameStats)
+} StatsFileHeader;
+
+int stats_write_binary(FILE *out, const GameStats *stats) {
+    StatsFileHeader header;
+    memcpy(header.magic, STATS_FILE_MAGIC, sizeof(header.magic));
+    header.version = STATS_FILE_VERSION;
+    header.size = (uint32_t)sizeof(GameStats);
+    return fwrite(&header, sizeof(header), 1, out) == 1 && fwrite(stats, sizeof(*stats), 1, out) == 1 &&
+           fflush(out) == 0;
+}
+
+// Returns 0 for a short file, another format or another build's layout
+int stats_read_binary(FILE *in, GameStats *stats) {
+    StatsFileHeader header;
+    if (fread(&header, sizeof(header), 1, in) != 1) return 0;
+    if (memcmp(header.magic, STATS_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != STATS_FILE_VERSION || header.size != sizeof(GameStats)) {
+        return 0;
+    }
+    if (fread(stats, sizeof(*stats), 1, in) != 1) return 0;
+    return fgetc(in) == EOF;
+}
+
+static void write_json_counts(FILE *json, const char *name, const uint64_t *values, int count, const char *suffix) {
+    fprintf(json, "  \"%s\": [", name);
+    for (int i = 0; i < count; i++) {
+        fprintf(json, "%s%llu", i ? ", " : "", (unsigned long long)values[i]);
+    }
+    fprintf(json, "]%s\n", suffix);
+}
+
+static void write_json_heatmap(FILE *json, const char *name,
+                               const uint64_t cells[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH], const char *suffix) {
+    fprintf(json, "  \"%s\": [\n", name);
+    for (int f = 0; f < NUM_FLOORS; f++) {
+        fprintf(json, "    [\n");
+        for (int w = 0; w < FLOOR_WIDTH; w++) {
+            fprintf(json, "      [");
+            for (int l = 0; l < FLOOR_LENGTH; l++) {
+                fprintf(json, "%s%llu", l ? "," : "", (unsigned long long)cells[f][w][l]);
+            }
+            fprintf(json, "]%s\n", w + 1 < FLOOR_WIDTH ? "," : "");
+        }
+        fprintf(json, "    ]%s\n", f + 1 < NUM_FLOORS ? "," : "");
+    }
+    fprintf(json, "  ]%s\n", suffix);
+}
+
+// Heatmaps are [floor][width][length] arrays; per-round MP is null where no turn was sampled
+int stats_write_json(const char *filename, const GameStats *stats) {
+    FILE *json = fopen(filename, "w");
+    if (!json) {
+        fprintf(stderr, "Error: Could not write statistics to %s\n", filename);
+        return 0;
+    }
+
+    fprintf(json, "{\n");
+    fprintf(json, "  \"games\": %llu,\n", (unsigned long long)stats->games);
+    fprintf(json, "  \"games_won\": %llu,\n", (unsigned long long)stats->games_won);
+    fprintf(json, "  \"turns\": %llu,\n", (unsigned long long)stats->turns);
+    fprintf(json, "  \"rounds\": %llu,\n", (unsigned long long)stats->rounds);
+    fprintf(json, "  \"captures\": %llu,\n", (unsigned long long)stats->captures);
+    fprintf(json, "  \"loop_resets\": %llu,\n", (unsigned long long)stats->loop_resets);
+    write_json_counts(json, "wins", stats->wins, STATS_MAX_PLAYERS, ",");
+    write_json_counts(json, "captures_by_player", stats->captures_by_player, STATS_MAX_PLAYERS, ",");
+    write_json_counts(json, "game_length_by_10_rounds", stats->game_length, STATS_LENGTH_BUCKETS, ",");
+
+    fprintf(json, "  \"mp_mean_by_round\": [");
+    for (int r = 0; r < STATS_MAX_ROUNDS; r++) {
+        if (stats->mp_samples[r]) {
+            fprintf(json, "%s%.3f", r ? ", " : "", (double)stats->mp_sum[r] / (double)stats->mp_samples[r]);
+        } else {
+            fprintf(json, "%snull", r ? ", " : "");
+        }
+    }
+    fprintf(json, "],\n");
+    write_json_counts(json, "mp_histogram_by_10", stats->mp_histogram, STATS_MP_BUCKETS, ",");
+
+    fprintf(json, "  \"bawana_effects\": {");
+    for (int e = 0; e < STATS_NUM_BAWANA; e++) {
+        fprintf(json, "%s\"%s\": %llu", e ? ", " : "", bawana_names[e], (unsigned long long)stats->bawana_effects[e]);
+    }
+    fprintf(json, "},\n");
+    fprintf(json, "  \"blocked_moves\": {");
+    for (int b = 1; b < STATS_NUM_BLOCKS; b++) {
+        fprintf(json, "%s\"%s\": %llu", b > 1 ? ", " : "", block_names[b], (unsigned long long)stats->blocked_moves[b]);
+    }
+    fprintf(json, "},\n");
+
+    write_json_heatmap(json, "visits", stats->visits, ",");
+    write_json_heatmap(json, "stair_uses", stats->stair_uses, ",");
+    write_json_heatmap(json, "pole_uses", stats->pole_uses, "");
+    fprintf(json, "}\n");
+
+    fclose(json);
+    return 1;
+}
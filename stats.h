@@ -0,0 +1,91 @@
+// stats.h - Statistics aggregation for simulation runs
+// Each worker thread owns a GameStats block and binds it with stats_bind();
+// the engine's STATS_* hooks then count into that block without any locking
+// or atomics. Blocks are merged once at the end and exported as CSV or JSON.
+// Compile with -DGAME_STATS (and link stats.c) to build the hooks in; without
+// the flag every STATS_* macro expands to nothing.
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdint.h>
+#include "game.h"
+
+#define STATS_MAX_ROUNDS     200  // Rounds tracked for MP over time; later rounds share the last slot
+#define STATS_MP_BUCKETS     32   // MP histogram: <=0, 1-10, 11-20, ... and an open-ended last bucket
+#define STATS_LENGTH_BUCKETS 64   // Game length histogram in steps of 10 rounds
+#define STATS_MAX_PLAYERS    8    // Per-player counters; higher player ids share the last slot
+#define STATS_NUM_BAWANA     5    // BA_FOOD_POISONING .. BA_RANDOM_MP
+#define STATS_NUM_BLOCKS     4    // BLOCK_NONE .. BLOCK_BAWANA_ENTRANCE
+
+typedef struct {
+    uint64_t games;
+    uint64_t games_won;                              // Games that ended with a flag capture
+    uint64_t turns;
+    uint64_t rounds;
+    uint64_t wins[STATS_MAX_PLAYERS];
+    uint64_t game_length[STATS_LENGTH_BUCKETS];      // Rounds per game
+
+    int64_t mp_sum[STATS_MAX_ROUNDS];                // MP over time: sum and count per round
+    uint64_t mp_samples[STATS_MAX_ROUNDS];
+    uint64_t mp_histogram[STATS_MP_BUCKETS];         // MP after every turn
+
+    uint64_t bawana_effects[STATS_NUM_BAWANA];       // Effects fired, by BA_* cell type
+    uint64_t blocked_moves[STATS_NUM_BLOCKS];        // Blocked moves, by BLOCK_* reason
+    uint64_t captures;
+    uint64_t captures_by_player[STATS_MAX_PLAYERS];
+    uint64_t loop_resets;
+
+    uint64_t visits[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH];     // Every cell stepped on
+    uint64_t stair_uses[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH]; // Stair cell a player took
+    uint64_t pole_uses[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH];  // Pole cell a player slid from
+} GameStats;
+
+// Block the calling thread's hooks count into (NULL stops counting)
+extern _Thread_local GameStats *stats_thread;
+
+void stats_bind(GameStats *stats);
+void stats_reset(GameStats *stats);
+void stats_merge(GameStats *total, const GameStats *part);
+
+// Turn- and game-level samples, recorded by the simulation driver
+void stats_record_turn(GameStats *stats, int round_number, int movement_points);
+void stats_record_game(GameStats *stats, int rounds_played, int winner_id);
+
+int stats_write_csv(const char *filename, const GameStats *stats);
+int stats_write_json(const char *filename, const GameStats *stats);
+
+// Raw counters with a header, for merging the results of separate processes
+// (shard.c). Only readable by a build with the same GameStats layout.
+#define STATS_FILE_MAGIC    "MAZESTAT"
+#define STATS_FILE_VERSION  1
+int stats_write_binary(FILE *out, const GameStats *stats);
+int stats_read_binary(FILE *in, GameStats *stats);
+
+#ifdef GAME_STATS
+#define STATS_PLAYER_SLOT(id) ((id) < STATS_MAX_PLAYERS ? (id) : STATS_MAX_PLAYERS - 1)
+#define STATS_BAWANA(type) \
+    do { if (stats_thread && (type) >= 0 && (type) < STATS_NUM_BAWANA) stats_thread->bawana_effects[type]++; } while (0)
+#define STATS_BLOCKED(reason) \
+    do { if (stats_thread) stats_thread->blocked_moves[reason]++; } while (0)
+#define STATS_CAPTURE(player_id) \
+    do { if (stats_thread) { stats_thread->captures++; stats_thread->captures_by_player[STATS_PLAYER_SLOT(player_id)]++; } } while (0)
+#define STATS_LOOP_RESET() \
+    do { if (stats_thread) stats_thread->loop_resets++; } while (0)
+#define STATS_VISIT(f, w, l) \
+    do { if (stats_thread) stats_thread->visits[f][w][l]++; } while (0)
+#define STATS_STAIR(f, w, l) \
+    do { if (stats_thread) stats_thread->stair_uses[f][w][l]++; } while (0)
+#define STATS_POLE(f, w, l) \
+    do { if (stats_thread) stats_thread->pole_uses[f][w][l]++; } while (0)
+#else
+#define STATS_BAWANA(type)        ((void)0)
+#define STATS_BLOCKED(reason)     ((void)0)
+#define STATS_CAPTURE(player_id)  ((void)0)
+#define STATS_LOOP_RESET()        ((void)0)
+#define STATS_VISIT(f, w, l)      ((void)0)
+#define STATS_STAIR(f, w, l)      ((void)0)
+#define STATS_POLE(f, w, l)       ((void)0)
+#endif
+
+#endif // STATS_H
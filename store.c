@@ -0,0 +1,352 @@
+// store.c - Columnar file of per-game simulation outcomes (see store.h)
+
+#include "store.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define BLOCK_MAGIC "BLK1"
+
+const char *const store_column_names[STORE_NUM_COLUMNS] = {
+    "config", "seed", "players", "winner", "rounds", "loop_resets",
+    "bawana_food_poisoning", "bawana_disoriented", "bawana_triggered", "bawana_happy", "bawana_random_mp",
+    "captures_A", "captures_B", "captures_C", "captures_D", "captures_E", "captures_F", "captures_G", "captures_H",
+    "mp_A", "mp_B", "mp_C", "mp_D", "mp_E", "mp_F", "mp_G", "mp_H"
+};
+
+int store_column_find(const char *name) {
+    for (int c = 0; c < STORE_NUM_COLUMNS; c++) {
+        if (strcmp(store_column_names[c], name) == 0) return c;
+    }
+    return -1;
+}
+
+// Bits needed for values 0..range
+static unsigned bits_for(uint64_t range) {
+    unsigned bits = 0;
+    while (bits < 64 && (range >> bits) != 0) bits++;
+    return bits;
+}
+
+static size_t packed_bytes(int num_rows, unsigned bits) {
+    return ((size_t)num_rows * bits + 63) / 64 * 8;
+}
+
+// Values LSB-first in 64-bit words; a value may straddle two words
+static void pack(uint64_t *words, const uint64_t *values, int num_rows, unsigned bits) {
+    memset(words, 0, packed_bytes(num_rows, bits));
+    if (bits == 0) return;
+    uint64_t position = 0;
+    for (int i = 0; i < num_rows; i++, position += bits) {
+        unsigned shift = (unsigned)(position & 63);
+        size_t word = (size_t)(position >> 6);
+        words[word] |= values[i] << shift;
+        if (shift + bits > 64) words[word + 1] |= values[i] >> (64 - shift);
+    }
+}
+
+static void unpack(uint64_t *values, const uint64_t *words, int num_rows, unsigned bits) {
+    if (bits == 0) {
+        memset(values, 0, sizeof(uint64_t) * (size_t)num_rows);
+        return;
+    }
+    uint64_t mask = bits == 64 ? ~0ull : (1ull << bits) - 1;
+    uint64_t position = 0;
+    for (int i = 0; i < num_rows; i++, position += bits) {
+        unsigned shift = (unsigned)(position & 63);
+        size_t word = (size_t)(position >> 6);
+        uint64_t v = words[word] >> shift;
+        if (shift + bits > 64) v |= words[word + 1] << (64 - shift);
+        values[i] = v & mask;
+    }
+}
+
+static int compare_int64(const void *a, const void *b) {
+    int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// ---- Writing ----
+
+int store_writer_open(StoreWriter *writer, const char *path) {
+    memset(writer, 0, sizeof(*writer));
+    writer->fd = open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (writer->fd < 0) return 0;
+
+    StoreFileHeader header;
+    struct stat st;
+    if (fstat(writer->fd, &st) != 0) goto fail;
+    if (st.st_size == 0) {
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, STORE_MAGIC, sizeof(header.magic));
+        header.version = STORE_VERSION;
+        header.num_columns = STORE_NUM_COLUMNS;
+        header.block_rows = STORE_BLOCK_ROWS;
+        if (write(writer->fd, &header, sizeof(header)) != (ssize_t)sizeof(header)) goto fail;
+    } else {
+        if (pread(writer->fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+            memcmp(header.magic, STORE_MAGIC, sizeof(header.magic)) != 0 || header.version != STORE_VERSION ||
+            header.num_columns != STORE_NUM_COLUMNS) {
+            goto fail;
+        }
+        // Cut off a block left half-written by a crash, so new blocks follow the last whole one
+        off_t end = sizeof(header);
+        StoreBlockHeader block;
+        while (pread(writer->fd, &block, sizeof(block), end) == (ssize_t)sizeof(block) &&
+               memcmp(block.magic, BLOCK_MAGIC, sizeof(block.magic)) == 0 && block.size >= sizeof(block) &&
+               (uint64_t)end + block.size <= (uint64_t)st.st_size) {
+            end += (off_t)block.size;
+        }
+        if (end != st.st_size && ftruncate(writer->fd, end) != 0) goto fail;
+    }
+    pthread_mutex_init(&writer->lock, NULL);
+    return 1;
+
+fail:
+    close(writer->fd);
+    writer->fd = -1;
+    return 0;
+}
+
+int store_writer_close(StoreWriter *writer) {
+    if (writer->fd < 0) return 0;
+    int ok = close(writer->fd) == 0;
+    writer->fd = -1;
+    pthread_mutex_destroy(&writer->lock);
+    return ok;
+}
+
+int store_buffer_init(StoreBuffer *buffer, StoreWriter *writer) {
+    buffer->writer = writer;
+    buffer->num_rows = 0;
+    buffer->columns = malloc(sizeof(int64_t) * STORE_NUM_COLUMNS * STORE_BLOCK_ROWS);
+    return buffer->columns != NULL;
+}
+
+void store_buffer_free(StoreBuffer *buffer) {
+    free(buffer->columns);
+    buffer->columns = NULL;
+}
+
+int store_buffer_add(StoreBuffer *buffer, const OutcomeRecord *record) {
+    int64_t *row = buffer->columns + buffer->num_rows;
+#define SET(column, value) row[(size_t)(column) * STORE_BLOCK_ROWS] = (value)
+    SET(STORE_CONFIG, record->config_id);
+    SET(STORE_SEED, record->seed);
+    SET(STORE_PLAYERS, record->num_players);
+    SET(STORE_WINNER, record->winner);
+    SET(STORE_ROUNDS, record->rounds);
+    SET(STORE_LOOP_RESETS, record->loop_resets);
+    for (int e = 0; e < STORE_NUM_BAWANA; e++) SET(STORE_BAWANA + e, record->bawana[e]);
+    for (int p = 0; p < STORE_MAX_PLAYERS; p++) {
+        SET(STORE_CAPTURES + p, record->captures[p]);
+        SET(STORE_FINAL_MP + p, record->final_mp[p]);
+    }
+#undef SET
+    if (++buffer->num_rows == STORE_BLOCK_ROWS) return store_buffer_flush(buffer);
+    return 1;
+}
+
+// Pick the smaller encoding for one column and fill in its header entry;
+// returns the bytes it needs. `sorted` is scratch space for num_rows values.
+static size_t plan_column(StoreColumn *meta, const int64_t *values, int num_rows, int64_t *sorted) {
+    int64_t min = values[0], max = values[0];
+    for (int i = 1; i < num_rows; i++) {
+        if (values[i] < min) min = values[i];
+        if (values[i] > max) max = values[i];
+    }
+    memset(meta, 0, sizeof(*meta));
+    meta->min = min;
+    meta->max = max;
+    meta->encoding = STORE_FRAME_OF_REFERENCE;
+    meta->bits = bits_for((uint64_t)max - (uint64_t)min);
+    size_t bytes = packed_bytes(num_rows, meta->bits);
+    if (meta->bits <= 1) return bytes;      // Nothing a dictionary could save
+
+    memcpy(sorted, values, sizeof(int64_t) * (size_t)num_rows);
+    qsort(sorted, (size_t)num_rows, sizeof(int64_t), compare_int64);
+    int distinct = 1;
+    for (int i = 1; i < num_rows; i++) {
+        if (sorted[i] != sorted[distinct - 1]) sorted[distinct++] = sorted[i];
+    }
+    unsigned code_bits = bits_for((uint64_t)distinct - 1);
+    size_t dictionary_bytes = sizeof(int64_t) * (size_t)distinct + packed_bytes(num_rows, code_bits);
+    if (dictionary_bytes < bytes) {
+        meta->encoding = STORE_DICTIONARY;
+        meta->bits = code_bits;
+        meta->dictionary_size = (uint32_t)distinct;
+        bytes = dictionary_bytes;
+    }
+    return bytes;
+}
+
+static void encode_column(unsigned char *out, const StoreColumn *meta, const int64_t *values, int num_rows,
+                          const int64_t *dictionary, uint64_t *scratch) {
+    if (meta->encoding == STORE_DICTIONARY) {
+        memcpy(out, dictionary, sizeof(int64_t) * meta->dictionary_size);
+        for (int i = 0; i < num_rows; i++) {
+            int lo = 0, hi = (int)meta->dictionary_size - 1;
+            while (lo < hi) {
+                int mid = (lo + hi) / 2;
+                if (dictionary[mid] < values[i]) lo = mid + 1;
+                else hi = mid;
+            }
+            scratch[i] = (uint64_t)lo;
+        }
+        pack((uint64_t *)(out + sizeof(int64_t) * meta->dictionary_size), scratch, num_rows, meta->bits);
+    } else {
+        for (int i = 0; i < num_rows; i++) scratch[i] = (uint64_t)values[i] - (uint64_t)meta->min;
+        pack((uint64_t *)out, scratch, num_rows, meta->bits);
+    }
+}
+
+int store_buffer_flush(StoreBuffer *buffer) {
+    int num_rows = buffer->num_rows;
+    if (num_rows == 0) return 1;
+
+    // Plan every column first so the block is built in one allocation
+    StoreBlockHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BLOCK_MAGIC, sizeof(header.magic));
+    header.num_rows = (uint32_t)num_rows;
+    int64_t *sorted = malloc(sizeof(int64_t) * STORE_NUM_COLUMNS * (size_t)num_rows);
+    uint64_t *scratch = malloc(sizeof(uint64_t) * (size_t)num_rows);
+    if (!sorted || !scratch) {
+        free(sorted);
+        free(scratch);
+        return 0;
+    }
+    uint64_t size = sizeof(header);
+    for (int c = 0; c < STORE_NUM_COLUMNS; c++) {
+        size_t bytes = plan_column(&header.columns[c], buffer->columns + (size_t)c * STORE_BLOCK_ROWS, num_rows,
+                                   sorted + (size_t)c * num_rows);
+        size = (size + 7) & ~(uint64_t)7;
+        header.columns[c].offset = size;
+        header.columns[c].bytes = bytes;
+        size += bytes;
+    }
+    size = (size + 7) & ~(uint64_t)7;
+    header.size = size;
+
+    unsigned char *block = calloc(1, size);
+    if (!block) {
+        free(sorted);
+        free(scratch);
+        return 0;
+    }
+    memcpy(block, &header, sizeof(header));
+    for (int c = 0; c < STORE_NUM_COLUMNS; c++) {
+        encode_column(block + header.columns[c].offset, &header.columns[c],
+                      buffer->columns + (size_t)c * STORE_BLOCK_ROWS, num_rows, sorted + (size_t)c * num_rows,
+                      scratch);
+    }
+    free(sorted);
+    free(scratch);
+
+    // One append per block, so blocks from different threads never mix
+    StoreWriter *writer = buffer->writer;
+    int ok = 1;
+    pthread_mutex_lock(&writer->lock);
+    for (uint64_t done = 0; done < size;) {
+        ssize_t n = write(writer->fd, block + done, (size_t)(size - done));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            ok = 0;
+            break;
+        }
+        done += (uint64_t)n;
+    }
+    if (ok) {
+        writer->records += (uint64_t)num_rows;
+        writer->bytes += size;
+    }
+    pthread_mutex_unlock(&writer->lock);
+    free(block);
+    buffer->num_rows = 0;
+    return ok;
+}
+
+// ---- Reading ----
+
+int store_reader_open(StoreReader *reader, const char *path) {
+    struct stat st;
+    memset(reader, 0, sizeof(*reader));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(StoreFileHeader)) {
+        close(fd);
+        return 0;
+    }
+    void *base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return 0;
+
+    const StoreFileHeader *header = base;
+    if (memcmp(header->magic, STORE_MAGIC, sizeof(header->magic)) != 0 || header->version != STORE_VERSION ||
+        header->num_columns != STORE_NUM_COLUMNS) {
+        munmap(base, (size_t)st.st_size);
+        return 0;
+    }
+    reader->data = base;
+    reader->size = (size_t)st.st_size;
+
+    // Walk the blocks, stopping at one a crash cut short
+    int capacity = 0;
+    for (size_t offset = sizeof(StoreFileHeader); offset + sizeof(StoreBlockHeader) <= reader->size;) {
+        const StoreBlockHeader *block = (const StoreBlockHeader *)(reader->data + offset);
+        if (memcmp(block->magic, BLOCK_MAGIC, sizeof(block->magic)) != 0 || block->size < sizeof(*block) ||
+            block->size > reader->size - offset || block->num_rows == 0 || block->num_rows > STORE_BLOCK_ROWS) {
+            break;
+        }
+        int whole = 1;
+        for (int c = 0; c < STORE_NUM_COLUMNS; c++) {
+            const StoreColumn *column = &block->columns[c];
+            if (column->offset % 8 != 0 || column->offset > block->size || column->bytes > block->size - column->offset ||
+                column->bits > 64 ||
+                column->bytes < packed_bytes((int)block->num_rows, column->bits) +
+                                    sizeof(int64_t) * (column->encoding == STORE_DICTIONARY ? column->dictionary_size : 0)) {
+                whole = 0;
+            }
+        }
+        if (!whole) break;
+        if (reader->num_blocks == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            const StoreBlockHeader **blocks = realloc(reader->blocks, sizeof(*blocks) * (size_t)capacity);
+            if (!blocks) {
+                store_reader_close(reader);
+                return 0;
+            }
+            reader->blocks = blocks;
+        }
+        reader->blocks[reader->num_blocks++] = block;
+        offset += block->size;
+    }
+    return 1;
+}
+
+void store_reader_close(StoreReader *reader) {
+    if (reader->data) munmap((void *)reader->data, reader->size);
+    free(reader->blocks);
+    memset(reader, 0, sizeof(*reader));
+}
+
+void store_column_decode(const StoreBlockHeader *block, int column, int64_t *out) {
+    const StoreColumn *meta = &block->columns[column];
+    const unsigned char *data = (const unsigned char *)block + meta->offset;
+    int num_rows = (int)block->num_rows;
+    uint64_t *codes = (uint64_t *)out;
+    if (meta->encoding == STORE_DICTIONARY) {
+        const int64_t *dictionary = (const int64_t *)data;
+        unpack(codes, (const uint64_t *)(data + sizeof(int64_t) * meta->dictionary_size), num_rows, meta->bits);
+        for (int i = 0; i < num_rows; i++) {
+            out[i] = codes[i] < meta->dictionary_size ? dictionary[codes[i]] : meta->min;
+        }
+    } else {
+        unpack(codes, (const uint64_t *)data, num_rows, meta->bits);
+        for (int i = 0; i < num_rows; i++) out[i] = (int64_t)(codes[i] + (uint64_t)meta->min);
+    }
+}
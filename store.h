@@ -0,0 +1,125 @@
+// store.h - Columnar file of per-game simulation outcomes
+// One record per game (configuration id, seed, winner, rounds, loop resets,
+// Bawana effects by type, captures and final MP per player) is kept column by
+// column. Records collect in memory and are appended to the file a block of
+// up to STORE_BLOCK_ROWS games at a time; finished blocks are never rewritten.
+// In each block every column is encoded on its own, whichever is smaller:
+//  - frame of reference: value - min, bit-packed at the width of max - min
+//    (0 bits when the column is constant in the block)
+//  - dictionary: the distinct values, and each row's index bit-packed
+// Every column's min and max are in the block header, so a scan can skip a
+// block that cannot match a filter without touching its data, and decode only
+// the columns it reads. The file is read through mmap; nothing is copied
+// before decoding. A block cut short by a crash is ignored by readers.
+//
+// Several threads append to one file, each through its own StoreBuffer; blocks
+// from different threads interleave, so rows are in no particular order.
+//
+// Writers and readers both link store.c; scan.c is the query tool.
+
+#ifndef STORE_H
+#define STORE_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define STORE_MAGIC         "MAZEOUTC"
+#define STORE_VERSION       1
+#define STORE_BLOCK_ROWS    16384
+#define STORE_MAX_PLAYERS   8     // Per-player columns; captures by later players count in the last one
+#define STORE_NUM_BAWANA    5     // BA_FOOD_POISONING .. BA_RANDOM_MP
+
+// Columns, in file order
+enum {
+    STORE_CONFIG, STORE_SEED, STORE_PLAYERS, STORE_WINNER, STORE_ROUNDS, STORE_LOOP_RESETS,
+    STORE_BAWANA,                                       // STORE_NUM_BAWANA columns, by BA_* type
+    STORE_CAPTURES = STORE_BAWANA + STORE_NUM_BAWANA,   // STORE_MAX_PLAYERS columns, by capturing player
+    STORE_FINAL_MP = STORE_CAPTURES + STORE_MAX_PLAYERS, // STORE_MAX_PLAYERS columns (0 for absent players)
+    STORE_NUM_COLUMNS = STORE_FINAL_MP + STORE_MAX_PLAYERS
+};
+
+#define STORE_FRAME_OF_REFERENCE  0
+#define STORE_DICTIONARY          1
+
+// Outcome of one game
+typedef struct {
+    uint32_t config_id;
+    uint32_t seed;
+    int32_t num_players;
+    int32_t winner;             // -1 if the game was stopped at the round cap
+    int32_t rounds;
+    int32_t loop_resets;
+    int32_t bawana[STORE_NUM_BAWANA];
+    int32_t captures[STORE_MAX_PLAYERS];
+    int32_t final_mp[STORE_MAX_PLAYERS];
+} OutcomeRecord;
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t num_columns;
+    uint32_t block_rows;
+    uint32_t reserved[3];
+} StoreFileHeader;
+
+typedef struct {
+    int64_t min, max;
+    uint32_t encoding;          // STORE_FRAME_OF_REFERENCE or STORE_DICTIONARY
+    uint32_t bits;              // Width of each packed value or dictionary index
+    uint32_t dictionary_size;   // Distinct values stored in front of the packed indexes
+    uint32_t reserved;
+    uint64_t offset;            // From the start of the block, 8-byte aligned
+    uint64_t bytes;
+} StoreColumn;
+
+typedef struct {
+    char magic[4];              // "BLK1"
+    uint32_t num_rows;
+    uint64_t size;              // Whole block, header included
+    StoreColumn columns[STORE_NUM_COLUMNS];
+} StoreBlockHeader;
+
+// One file, shared by the threads appending to it
+typedef struct {
+    int fd;
+    pthread_mutex_t lock;
+    uint64_t records, bytes;    // Appended through this writer
+} StoreWriter;
+
+// One thread's rows waiting to be written as a block
+typedef struct {
+    StoreWriter *writer;
+    int num_rows;
+    int64_t *columns;           // STORE_NUM_COLUMNS x STORE_BLOCK_ROWS
+} StoreBuffer;
+
+typedef struct {
+    const unsigned char *data;
+    size_t size;
+    int num_blocks;
+    const StoreBlockHeader **blocks;
+} StoreReader;
+
+extern const char *const store_column_names[STORE_NUM_COLUMNS];
+
+// Create the file, or append to it if it is already a store; returns 0 on failure
+int store_writer_open(StoreWriter *writer, const char *path);
+int store_writer_close(StoreWriter *writer);
+
+int store_buffer_init(StoreBuffer *buffer, StoreWriter *writer);
+int store_buffer_add(StoreBuffer *buffer, const OutcomeRecord *record);  // Writes a block when full
+int store_buffer_flush(StoreBuffer *buffer);                              // Writes what is left
+void store_buffer_free(StoreBuffer *buffer);
+
+// Map a store read-only and find its blocks; returns 0 if it is not a store
+int store_reader_open(StoreReader *reader, const char *path);
+void store_reader_close(StoreReader *reader);
+
+// Column number for a name like "rounds" or "captures_B" (-1 = none)
+int store_column_find(const char *name);
+
+// Decode one column of a block into out[] (num_rows values)
+void store_column_decode(const StoreBlockHeader *block, int column, int64_t *out);
+
+#endif // STORE_H
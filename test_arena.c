@@ -0,0 +1,90 @@
+#include "game.h"
+#include "arena.h"
+#include "test_digest.h"
+#include <stdint.h>
+#include <stdio.h>
+
+// Games taken from a pool must play exactly like games from game_state_create(),
+// and once the pool has grown to fit them no further game may reach the heap.
+
+#define NUM_GAMES  300
+#define MAX_ROUNDS 300
+
+static unsigned long long play(GameState *game) {
+    TurnResult result;
+    unsigned long long digest = 0;
+    do {
+        play_game_turn(game, &result);
+        digest = mix_result(digest, &result);
+    } while (!result.won && game->round_number <= MAX_ROUNDS);
+    return digest;
+}
+
+int main(void) {
+    static GameConfig config;
+    int failures = 0;
+    game_print_enabled = 0;
+    game_prompt_enabled = 0;
+    game_config_load(&config, NULL, DEFAULT_NUM_PLAYERS);
+
+    // Arena: aligned blocks, and a reset hands out the same memory again
+    Arena arena;
+    arena_init(&arena, 4096);
+    char *first = arena_alloc(&arena, 100);
+    char *second = arena_alloc(&arena, 3000);
+    char *large = arena_alloc(&arena, 10000);
+    if (((uintptr_t)first | (uintptr_t)second | (uintptr_t)large) % ARENA_ALIGNMENT != 0) {
+        printf("✗ Arena blocks are not %d-byte aligned\n", ARENA_ALIGNMENT);
+        failures++;
+    }
+    long chunks = arena.heap_allocations;
+    arena_reset(&arena);
+    if (arena_alloc(&arena, 100) != first || arena_alloc(&arena, 3000) != second ||
+        arena_alloc(&arena, 10000) != large || arena.heap_allocations != chunks) {
+        printf("✗ Arena did not reuse its chunks after a reset\n");
+        failures++;
+    }
+    arena_destroy(&arena);
+
+    // Pool: games of one size class share blocks, games of another do not
+    GamePool pool;
+    game_pool_init(&pool, 0);
+    GameState *small = game_pool_get(&pool, 3);
+    game_state_init(small, &config, 3, 1);
+    game_pool_put(&pool, small);
+    GameState *same_class = game_pool_get(&pool, 4);
+    GameState *other_class = game_pool_get(&pool, 7);
+    if (same_class != small || other_class == small) {
+        printf("✗ Pool did not recycle games by size class\n");
+        failures++;
+    }
+    same_class->num_players = 4;
+    other_class->num_players = 7;
+    game_pool_put(&pool, same_class);
+    game_pool_put(&pool, other_class);
+
+    // Pooled games replay the same as heap games, without new heap allocations
+    long allocations = pool.arena.heap_allocations;
+    for (int g = 0; g < NUM_GAMES; g++) {
+        int num_players = 2 + g % 6;
+        GameState *reference = game_state_create(&config, num_players, 5000 + g);
+        GameState *pooled = game_pool_create(&pool, &config, num_players, 5000 + g);
+        if (play(reference) != play(pooled)) {
+            if (failures < 5) printf("✗ Game %d plays differently from the pool\n", g);
+            failures++;
+        }
+        game_state_destroy(reference);
+        game_pool_put(&pool, pooled);
+    }
+    long games_allocated = pool.games_allocated;
+    if (pool.arena.heap_allocations != allocations) {
+        printf("✗ Pool reached the heap %ld times in steady state\n", pool.arena.heap_allocations - allocations);
+        failures++;
+    }
+    game_pool_destroy(&pool);
+
+    if (failures == 0) {
+        printf("✓ Arena test passed: %d games from %ld pooled game states.\n", NUM_GAMES, games_allocated);
+    }
+    return failures ? 1 : 0;
+}
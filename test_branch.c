@@ -0,0 +1,103 @@
+#include "game.h"
+#include "branch.h"
+#include "test_digest.h"
+#include <stdio.h>
+
+// A forked game must play on exactly like the game it was copied from, a
+// forced roll must be the roll the turn uses, and branch outcomes must not
+// depend on the number of threads.
+
+#define FORK_TURNS  40
+#define MAX_ROUNDS  300
+
+static unsigned long long play_out(GameState *game) {
+    TurnResult result;
+    unsigned long long digest = 0;
+    while (game->winner < 0 && game->round_number <= MAX_ROUNDS) {
+        play_game_turn(game, &result);
+        digest = mix_result(digest, &result);
+    }
+    return digest;
+}
+
+int main(void) {
+    static GameConfig config;
+    int failures = 0;
+    game_print_enabled = 0;
+    game_prompt_enabled = 0;
+    game_config_load(&config, NULL, DEFAULT_NUM_PLAYERS);
+
+    // Forks, taken between turns and in the middle of a paused turn, replay the original
+    for (int g = 0; g < 50; g++) {
+        GameState *game = game_state_create(&config, DEFAULT_NUM_PLAYERS, 300 + g);
+        TurnResult result;
+        for (int t = 0; t < FORK_TURNS && game->winner < 0; t++) play_game_turn(game, &result);
+        if (g % 2) game_turn_resume(game, &result);
+
+        GameState *fork = game_state_fork(game);
+        if (play_out(fork) != play_out(game)) {
+            printf("✗ Fork of game %d played differently from the original\n", g);
+            failures++;
+        }
+        game_state_destroy(fork);
+        game_state_destroy(game);
+    }
+
+    // A forced movement roll is the roll the next turn uses
+    GameState *game = game_state_create(&config, DEFAULT_NUM_PLAYERS, 77);
+    TurnResult result;
+    for (int t = 0; t < FORK_TURNS; t++) play_game_turn(game, &result);
+    for (int roll = 1; roll <= 6; roll++) {
+        GameState *fork = game_state_fork(game);
+        BranchSpec branch = { BRANCH_MOVEMENT_ROLL, roll, -1 };
+        branch_apply(fork, &branch);
+        play_game_turn(fork, &result);
+        if (result.movement_roll != roll && result.movement_roll != 0) {
+            printf("✗ Forced roll %d came out as %d\n", roll, result.movement_roll);
+            failures++;
+        }
+        game_state_destroy(fork);
+    }
+
+    // Outcomes are the same on one thread and on four
+    BranchSpec branches[4];
+    branch_parse("as-is", &branches[0]);
+    branch_parse("roll=6", &branches[1]);
+    branch_parse("direction=2", &branches[2]);
+    branch_parse("stair=both", &branches[3]);
+    BranchOutcome single[4], parallel[4];
+    if (!branch_explore(game, branches, 4, 200, MAX_ROUNDS, 1, 9, single) ||
+        !branch_explore(game, branches, 4, 200, MAX_ROUNDS, 4, 9, parallel)) {
+        printf("✗ Branch exploration failed\n");
+        failures++;
+    } else if (memcmp(single, parallel, sizeof(single)) != 0) {
+        printf("✗ Branch outcomes depend on the number of threads\n");
+        failures++;
+    }
+    // Forcing stair directions starts one new stair epoch, and only if a direction changed
+    GameState *fork = game_state_fork(game);
+    BranchSpec all_up = { BRANCH_STAIR_DIRECTION, STAIR_UP_ONLY, -1 };
+    unsigned int epoch = fork->stair_epoch.epoch;
+    int changed[MAX_STAIRS], expected = 0;
+    for (int i = 0; i < fork->num_stairs; i++) expected += fork->stairs[i].direction_type != STAIR_UP_ONLY;
+    branch_apply(fork, &all_up);
+    branch_apply(fork, &all_up);
+    if (fork->stair_epoch.epoch != epoch + (expected > 0) ||
+        stair_epoch_changed_since(&fork->stair_epoch, fork->num_stairs, epoch, changed) != expected) {
+        printf("✗ Stair epoch %u -> %u after forcing %d stairs up\n", epoch, fork->stair_epoch.epoch, expected);
+        failures++;
+    }
+    game_state_destroy(fork);
+
+    BranchSpec bad = { BRANCH_STAIR_DIRECTION, STAIR_UP_ONLY, MAX_STAIRS };
+    if (branch_explore(game, &bad, 1, 10, MAX_ROUNDS, 1, 9, single)) {
+        printf("✗ A branch for a missing stair was accepted\n");
+        failures++;
+    }
+    game_state_destroy(game);
+
+    if (failures == 0) {
+        printf("✓ Branch test passed: forks replay, forced rolls apply, outcomes match across threads.\n");
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,156 @@
+#include "game.h"
+#include "check.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Each kind of mistake in a config directory must be reported with its code,
+// file and line; the corpus layouts must report only what is really wrong with
+// them; and the fast layout build the checker relies on must match the
+// reference build for any walls, stairs and poles, even ones outside the maze.
+
+static char base_dir[] = "/tmp/test_check_XXXXXX";
+
+static void write_file(const char *dir, const char *name, const char *text) {
+    char path[640];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    FILE *file = fopen(path, "w");
+    fputs(text, file);
+    fclose(file);
+}
+
+// A directory holding one file, with the defaults for the rest
+static const char *make_dir(const char *label, const char *name, const char *text) {
+    static char dir[512];
+    snprintf(dir, sizeof(dir), "%s/%s", base_dir, label);
+    mkdir(dir, 0755);
+    write_file(dir, name, text);
+    return dir;
+}
+
+static int expect(ConfigCheck *check, const char *label, const char *name, const char *text, const char *code, int line) {
+    const char *dir = make_dir(label, name, text);
+    config_check(check, dir);
+    for (int i = 0; i < check->num_issues && i < CHECK_MAX_ISSUES; i++) {
+        if (strcmp(check->issues[i].code, code) == 0 && strcmp(check->issues[i].file, name) == 0 &&
+            check->issues[i].line == line) {
+            return 0;
+        }
+    }
+    printf("✗ %s: expected %s at %s:%d, got %d issue(s)%s%s\n", label, code, name, line, check->num_issues,
+           check->num_issues ? ", first " : "", check->num_issues ? check->issues[0].code : "");
+    return 1;
+}
+
+static int expect_clean(ConfigCheck *check, const char *label, const char *dir) {
+    if (config_check(check, dir) == 0) return 0;
+    printf("✗ %s: expected no issues, first is %s at %s:%d (%s)\n", label, check->issues[0].code,
+           check->issues[0].file, check->issues[0].line, check->issues[0].message);
+    return 1;
+}
+
+static int random_coordinate(int limit) {
+    return rand() % (limit + 4) - 2;   // Mostly in the maze, sometimes just outside
+}
+
+int main(void) {
+    static ConfigCheck check;
+    static MazeLayout fast, reference;
+    int failures = 0;
+    game_print_enabled = 0;
+    game_prompt_enabled = 0;
+    if (!mkdtemp(base_dir)) {
+        printf("✗ Could not create a temporary directory\n");
+        return 1;
+    }
+
+    // One mistake per directory
+    failures += expect_clean(&check, "Defaults", make_dir("defaults", "seed.txt", "1\n"));
+    failures += expect(&check, "Bad line", "stairs.txt", "[0,5,10,1,5,10]\n[0,5,10]\n", "parse_error", 2);
+    failures += expect(&check, "Stair off the maze", "stairs.txt", "[0,5,10,1,5,10]\n[0,5,10,3,5,10]\n", "out_of_bounds", 2);
+    failures += expect(&check, "Flat stair", "stairs.txt", "[1,3,3,1,3,4]\n", "stair_same_floor", 1);
+    failures += expect(&check, "Stair in the starting area", "stairs.txt", "[0,7,10,1,5,10]\n", "stair_invalid_cell", 1);
+    failures += expect(&check, "Stair off the floor plan", "stairs.txt", "[0,5,10,2,5,2]\n", "stair_invalid_cell", 1);
+    failures += expect(&check, "Stair on a skipped cell", "stairs.txt", "[0,4,12,2,4,12]\n[1,4,12,2,3,12]\n",
+                       "stair_invalid_cell", 2);
+    failures += expect(&check, "Pole up", "poles.txt", "[0,2,4,12]\n", "pole_not_downward", 1);
+    failures += expect(&check, "Pole into the Bawana", "poles.txt", "[1,0,8,22]\n", "pole_invalid_cell", 1);
+    failures += expect(&check, "Diagonal wall", "walls.txt", "[1,0,2,8,2]\n[0,1,1,3,3]\n", "wall_not_straight", 2);
+    failures += expect(&check, "Wall by a spawn", "walls.txt", "[0,4,10,4,14]\n", "wall_on_protected_cell", 1);
+    failures += expect(&check, "Wall in the Bawana", "walls.txt", "[0,6,20,9,20]\n[0,8,22,8,24]\n", "wall_on_protected_cell", 2);
+    failures += expect(&check, "Wall off the maze", "walls.txt", "[0,0,20,0,25]\n", "out_of_bounds", 1);
+    failures += expect(&check, "Too many walls", "walls.txt",
+                       "[1,0,0,0,1]\n[1,0,2,0,3]\n[1,0,4,0,5]\n[1,0,6,0,7]\n[1,0,17,0,18]\n[1,0,19,0,20]\n[1,0,21,0,22]\n"
+                       "[1,1,0,1,1]\n[1,1,2,1,3]\n[1,1,4,1,5]\n[1,1,6,1,7]\n[1,1,17,1,18]\n[1,1,19,1,20]\n[1,1,21,1,22]\n"
+                       "[1,2,0,2,1]\n[1,2,2,2,3]\n[1,2,4,2,5]\n[1,2,6,2,7]\n[1,2,17,2,18]\n[1,2,19,2,20]\n[1,2,21,2,22]\n",
+                       "too_many_entries", 21);
+    failures += expect(&check, "Flag on a wall", "flag.txt", "[0,6,20]\n", "flag_invalid_cell", 1);
+    failures += expect(&check, "Flag off the maze", "flag.txt", "[3,0,0]\n", "out_of_bounds", 1);
+    failures += expect(&check, "Short players file", "players.txt", "[0,6,12,0,5,12,0]\n", "too_few_players", 0);
+    failures += expect(&check, "Spawn in a wall", "players.txt", "[0,6,12,0,5,12,0]\n[0,9,8,0,7,12,3]\n",
+                       "spawn_invalid_cell", 2);
+    failures += expect(&check, "Spawn facing nowhere", "players.txt", "[0,6,12,0,5,12,0]\n[0,9,8,0,9,7,4]\n",
+                       "spawn_bad_direction", 2);
+    failures += expect(&check, "Stair and pole in a circle", "poles.txt", "[2,0,5,24]\n[1,0,5,10]\n", "teleport_cycle", 2);
+
+    // A flag walled in on floor 1 cannot be reached
+    make_dir("Walled-in flag", "walls.txt", "[1,0,2,8,2]\n[1,0,0,0,0]\n");
+    failures += expect(&check, "Walled-in flag", "flag.txt", "[1,0,0]\n", "flag_unreachable", 1);
+    // ...unless a player enters beside it
+    make_dir("Flag by an entry", "walls.txt", "[1,0,2,8,2]\n[1,2,0,2,2]\n");
+    failures += expect(&check, "Flag by an entry", "flag.txt", "[1,1,1]\n", "flag_unreachable", 1);
+    const char *by_entry = make_dir("Flag by an entry", "players.txt",
+                                    "[0,6,12,0,5,12,0]\n[0,9,8,0,9,7,3]\n[0,9,16,0,9,17,1]\n[0,6,14,1,0,0,2]\n");
+    failures += expect_clean(&check, "Flag by a player's entry", by_entry);
+
+    // Layouts the game ships with
+    failures += expect_clean(&check, "Walled corpus", "bench/corpus/walled");
+    config_check(&check, "bench/corpus/dense");
+    int dense_poles = 0;
+    for (int i = 0; i < check.num_issues; i++) dense_poles += strcmp(check.issues[i].code, "pole_invalid_cell") == 0;
+    if (check.num_issues != 3 || dense_poles != 3) {
+        printf("✗ Dense corpus: expected its 3 pole bottoms off the plan, got %d issues\n", check.num_issues);
+        failures++;
+    }
+
+    // The fast layout build matches the reference build
+    srand(11);
+    for (int round = 0; round < 2000; round++) {
+        Stair stairs[MAX_STAIRS];
+        Pole poles[MAX_POLES];
+        Wall walls[MAX_WALLS];
+        int num_stairs = rand() % (MAX_STAIRS + 1), num_poles = rand() % (MAX_POLES + 1), num_walls = rand() % (MAX_WALLS + 1);
+        for (int i = 0; i < num_stairs; i++) {
+            stairs[i] = (Stair){ rand() % NUM_FLOORS, rand() % FLOOR_WIDTH, rand() % FLOOR_LENGTH,
+                                 rand() % NUM_FLOORS, rand() % FLOOR_WIDTH, rand() % FLOOR_LENGTH, STAIR_BIDIRECTIONAL };
+        }
+        for (int i = 0; i < num_poles; i++) {
+            poles[i] = (Pole){ random_coordinate(NUM_FLOORS), random_coordinate(NUM_FLOORS), random_coordinate(FLOOR_WIDTH),
+                               random_coordinate(FLOOR_LENGTH) };
+        }
+        for (int i = 0; i < num_walls; i++) {
+            int w = random_coordinate(FLOOR_WIDTH), l = random_coordinate(FLOOR_LENGTH);
+            int along = rand() % 8;
+            walls[i] = (Wall){ random_coordinate(NUM_FLOORS), w, l, rand() % 2 ? w : w + along, rand() % 2 ? l + along : l };
+        }
+        game_fast_paths_enabled = 1;
+        maze_layout_build(&fast, stairs, num_stairs, poles, num_poles, walls, num_walls);
+        game_fast_paths_enabled = 0;
+        maze_layout_build(&reference, stairs, num_stairs, poles, num_poles, walls, num_walls);
+        game_fast_paths_enabled = 1;
+        if (memcmp(&fast, &reference, sizeof(fast)) != 0) {
+            printf("✗ Layout %d: fast build differs from the reference build\n", round);
+            failures++;
+            break;
+        }
+    }
+
+    if (failures == 0) {
+        printf("✓ Every issue is reported at its file and line; corpus layouts check out; fast layout builds match.\n");
+    }
+    char command[600];
+    snprintf(command, sizeof(command), "rm -rf %s", base_dir);
+    if (system(command) != 0) printf("  (could not remove %s)\n", base_dir);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,23 @@
+// test_digest.h - Order-sensitive digests the engine tests compare games by
+// Two runs of a game that play the same turns give the same digest; any
+// difference in a turn result or a field changes it (FNV-1a style mixing).
+
+#ifndef TEST_DIGEST_H
+#define TEST_DIGEST_H
+
+#include "game.h"
+
+// Mix `count` ints into `digest`
+static inline unsigned long long digest_ints(unsigned long long digest, const int *fields, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        digest = (digest ^ (unsigned int)fields[i]) * 1099511628211ULL;
+    }
+    return digest;
+}
+
+// Mix every field of a turn's result into `digest`
+static inline unsigned long long mix_result(unsigned long long digest, const TurnResult *result) {
+    return digest_ints(digest, (const int *)result, sizeof(TurnResult) / sizeof(int));
+}
+
+#endif // TEST_DIGEST_H
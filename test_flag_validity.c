@@ -1,7 +1,8 @@
 #include "game.h"
 #include <stdio.h>
 
-static int is_excluded(Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH], int f, int w, int l) {
+static int is_excluded(const MazeLayout *layout, int f, int w, int l) {
+    const Cell (*maze)[FLOOR_WIDTH][FLOOR_LENGTH] = layout->cells;
     if (!maze[f][w][l].is_valid) return 1;
     if (maze[f][w][l].is_starting_area) return 1;
     if (maze[f][w][l].has_wall) return 1;
@@ -15,9 +16,10 @@ int main(void) {
     int failures = 0;
     for (int t = 0; t < 200; t++) {
         int seed = 1000 + t;
-        srand((unsigned int)seed);
+        game_srand((unsigned int)seed);
         
-        Cell maze[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH];
+        static MazeLayout layout;
+        static Maze maze;
         Player players[3];
         Stair stairs[MAX_STAIRS];
         Pole poles[MAX_POLES];
@@ -25,23 +27,52 @@ int main(void) {
         int num_stairs, num_poles, num_walls;
         int flag[3];
         
-        initialize_maze(maze);
-        initialize_players(players);
+        initialize_players(players, 3, NULL);
         initialize_stairs(stairs, &num_stairs);
         initialize_poles(poles, &num_poles);
         initialize_walls(walls, &num_walls);
+        maze_layout_build(&layout, stairs, num_stairs, poles, num_poles, walls, num_walls);
+        initialize_maze(&maze, &layout);
         
-        place_random_flag(flag, maze);
+        place_random_flag(flag, &layout);
         int f = flag[0], w = flag[1], l = flag[2];
         
-        if (is_excluded(maze, f, w, l)) {
+        if (is_excluded(&layout, f, w, l)) {
             printf("✗ Invalid flag at [%d,%d,%d] on iteration %d\n", f, w, l, t);
             failures++;
             break;
         }
     }
+
+    // A flag walled into a corner is reachable only for a player who enters inside it
+    {
+        static MazeLayout layout;
+        Stair stairs[MAX_STAIRS];
+        Pole poles[MAX_POLES];
+        Wall walls[MAX_WALLS];
+        int num_stairs, num_poles, num_walls;
+        int flag[3] = {0, 0, 0};
+        PlayerSpawn spawns[4] = {
+            {{0, 6, 12}, {0, 5, 12}, DIR_NORTH},
+            {{0, 9, 8},  {0, 9, 7},  DIR_WEST},
+            {{0, 9, 16}, {0, 9, 17}, DIR_EAST},
+            {{0, 6, 14}, {0, 1, 1},  DIR_NORTH}
+        };
+        initialize_stairs(stairs, &num_stairs);
+        initialize_poles(poles, &num_poles);
+        initialize_walls(walls, &num_walls);
+        walls[num_walls++] = (Wall){0, 1, 0, 1, 1};
+        walls[num_walls++] = (Wall){0, 0, 1, 1, 1};
+        maze_layout_build(&layout, stairs, num_stairs, poles, num_poles, walls, num_walls);
+        if (is_flag_reachable(&layout, stairs, poles, num_poles, NULL, 0, flag) ||
+            is_flag_reachable(&layout, stairs, poles, num_poles, spawns, 3, flag) ||
+            !is_flag_reachable(&layout, stairs, poles, num_poles, spawns, 4, flag)) {
+            printf("✗ Flag reachability ignores the players' entry cells\n");
+            failures++;
+        }
+    }
     if (failures == 0) {
-        printf("✓ Flag placement test passed across 200 iterations.\n");
+        printf("✓ Flag placement test passed across 200 iterations; reachability follows the spawns.\n");
     }
     return failures ? 1 : 0;
 }
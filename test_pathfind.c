@@ -0,0 +1,163 @@
+#include "game.h"
+#include "pathfind.h"
+#include <stdio.h>
+
+// The cluster graph must give the same distances as a breadth-first search of
+// every cell, for every stair direction, after syncing stairs through the
+// StairEpoch and after a layout change rebuilt only some clusters.
+
+#define SOURCE_STRIDE 7     // Every 7th cell is a source, against every target cell
+
+// Fewest moves from `source` to every cell, with the edges of is_flag_reachable()
+static void full_bfs(const MazeLayout *layout, const Stair stairs[], int num_stairs, const Pole poles[],
+                     int num_poles, const int source[3], int distance[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH]) {
+    static const int dw[4] = {0, 1, 0, -1}, dl[4] = {-1, 0, 1, 0};
+    static int queue[PATH_NUM_CELLS][3];
+    int head = 0, tail = 0;
+    for (int f = 0; f < NUM_FLOORS; f++)
+        for (int w = 0; w < FLOOR_WIDTH; w++)
+            for (int l = 0; l < FLOOR_LENGTH; l++) distance[f][w][l] = -1;
+    if (!is_valid_position(layout, source[0], source[1], source[2])) return;
+
+#define VISIT(f, w, l, d) \
+    do { \
+        if (is_valid_position(layout, f, w, l) && distance[f][w][l] < 0) { \
+            distance[f][w][l] = (d); \
+            queue[tail][0] = (f); queue[tail][1] = (w); queue[tail][2] = (l); tail++; \
+        } \
+    } while (0)
+    VISIT(source[0], source[1], source[2], 0);
+    while (head < tail) {
+        int f = queue[head][0], w = queue[head][1], l = queue[head][2];
+        int d = distance[f][w][l] + 1;
+        head++;
+        for (int dir = 0; dir < 4; dir++) {
+            if (!maze_wall_blocks(layout, f, w, l, dir)) VISIT(f, w + dw[dir], l + dl[dir], d);
+        }
+        for (int i = 0; i < num_stairs; i++) {
+            const Stair *s = &stairs[i];
+            if (f == s->start_floor && w == s->start_w && l == s->start_l && s->direction_type != STAIR_DOWN_ONLY) {
+                VISIT(s->end_floor, s->end_w, s->end_l, d);
+            }
+            if (f == s->end_floor && w == s->end_w && l == s->end_l && s->direction_type != STAIR_UP_ONLY) {
+                VISIT(s->start_floor, s->start_w, s->start_l, d);
+            }
+        }
+        for (int p = 0; p < num_poles; p++) {
+            if (poles[p].start_floor == f && poles[p].w == w && poles[p].l == l) VISIT(poles[p].end_floor, w, l, d);
+        }
+    }
+#undef VISIT
+}
+
+static int compare_all(const char *label, const PathGraph *graph, const MazeLayout *layout, const Stair stairs[],
+                       int num_stairs, const Pole poles[], int num_poles, long *queries) {
+    static int expected[NUM_FLOORS][FLOOR_WIDTH][FLOOR_LENGTH];
+    int failures = 0;
+    for (int cell = 0; cell < PATH_NUM_CELLS; cell += SOURCE_STRIDE) {
+        int source[1][3] = { { cell / (FLOOR_WIDTH * FLOOR_LENGTH), cell / FLOOR_LENGTH % FLOOR_WIDTH,
+                               cell % FLOOR_LENGTH } };
+        full_bfs(layout, stairs, num_stairs, poles, num_poles, source[0], expected);
+        for (int f = 0; f < NUM_FLOORS; f++) {
+            for (int w = 0; w < FLOOR_WIDTH; w++) {
+                for (int l = 0; l < FLOOR_LENGTH; l++) {
+                    int target[3] = { f, w, l };
+                    int actual = path_graph_distance(graph, source, 1, target);
+                    (*queries)++;
+                    if (actual != expected[f][w][l]) {
+                        if (failures < 5) {
+                            printf("✗ %s: [%d,%d,%d] to [%d,%d,%d] is %d moves, BFS says %d\n", label, source[0][0],
+                                   source[0][1], source[0][2], f, w, l, actual, expected[f][w][l]);
+                        }
+                        failures++;
+                    }
+                }
+            }
+        }
+    }
+    // The default players, and two entering on the upper floors
+    const PlayerSpawn spawns[2] = { {{0, 6, 12}, {1, 3, 12}, DIR_NORTH}, {{0, 9, 8}, {2, 5, 12}, DIR_WEST} };
+    for (int f = 0; f < NUM_FLOORS; f++) {
+        for (int w = 0; w < FLOOR_WIDTH; w++) {
+            for (int l = 0; l < FLOOR_LENGTH; l++) {
+                int flag[3] = { f, w, l };
+                if (path_graph_flag_reachable(graph, layout, NULL, 0, flag) !=
+                        is_flag_reachable(layout, (Stair *)stairs, (Pole *)poles, num_poles, NULL, 0, flag) ||
+                    path_graph_flag_reachable(graph, layout, spawns, 2, flag) !=
+                        is_flag_reachable(layout, (Stair *)stairs, (Pole *)poles, num_poles, spawns, 2, flag)) {
+                    if (failures < 5) printf("✗ %s: flag reachability differs at [%d,%d,%d]\n", label, f, w, l);
+                    failures++;
+                }
+            }
+        }
+    }
+    return failures;
+}
+
+static int run_config(const char *label, const char *config_dir) {
+    static GameConfig config;
+    static PathGraph graph, fresh;
+    static MazeLayout layout;
+    int failures = 0;
+    long queries = 0;
+    game_config_load(&config, config_dir, DEFAULT_NUM_PLAYERS);
+
+    // Every re-roll of a game's stairs, synced through the epoch
+    Stair stairs[MAX_STAIRS];
+    StairEpoch epoch;
+    memcpy(stairs, config.stairs, sizeof(stairs));
+    stair_epoch_init(&epoch);
+    path_graph_build(&graph, &config.layout, stairs, config.num_stairs, config.poles, config.num_poles, &epoch);
+    GameRng rng;
+    game_rng_seed(&rng, 7);
+    game_rng_bind(&rng);
+    for (int round = 0; round < 4 * STAIR_REROLL_ROUNDS; round += STAIR_REROLL_ROUNDS) {
+        update_stair_directions(stairs, config.num_stairs, round, &epoch);
+        int synced = path_graph_sync_stairs(&graph, stairs, &epoch);
+        if (synced != epoch.num_changed || graph.stair_epoch != epoch.epoch ||
+            path_graph_sync_stairs(&graph, stairs, &epoch) != 0) {
+            printf("✗ %s: synced %d stairs at epoch %u, %d changed\n", label, synced, epoch.epoch, epoch.num_changed);
+            failures++;
+        }
+        failures += compare_all(label, &graph, &config.layout, stairs, config.num_stairs, config.poles,
+                                config.num_poles, &queries);
+    }
+    game_rng_bind(NULL);
+
+    // Drop each wall in turn: only the clusters around it are rebuilt
+    int total = NUM_FLOORS * PATH_CLUSTERS_W * PATH_CLUSTERS_L, most_rebuilt = 0;
+    for (int i = 0; i < config.num_walls; i++) {
+        Wall walls[MAX_WALLS];
+        memcpy(walls, config.walls, sizeof(walls));
+        memmove(&walls[i], &walls[i + 1], sizeof(Wall) * (size_t)(config.num_walls - i - 1));
+        maze_layout_build(&layout, config.stairs, config.num_stairs, config.poles, config.num_poles,
+                          walls, config.num_walls - 1);
+        path_graph_build(&graph, &config.layout, config.stairs, config.num_stairs, config.poles, config.num_poles,
+                         NULL);
+        int rebuilt = path_graph_update_layout(&graph, &layout);
+        if (rebuilt > most_rebuilt) most_rebuilt = rebuilt;
+        path_graph_build(&fresh, &layout, config.stairs, config.num_stairs, config.poles, config.num_poles, NULL);
+        if (memcmp(graph.clusters, fresh.clusters, sizeof(graph.clusters)) != 0 ||
+            memcmp(graph.node_of_cell, fresh.node_of_cell, sizeof(graph.node_of_cell)) != 0) {
+            printf("✗ %s: graph updated for wall %d differs from one built afresh\n", label, i);
+            failures++;
+        }
+    }
+
+    if (failures == 0) {
+        printf("✓ %s: %ld distances match BFS; a wall change rebuilt at most %d of %d clusters.\n", label, queries,
+               most_rebuilt, total);
+    }
+    return failures;
+}
+
+int main(void) {
+    game_print_enabled = 0;
+    game_prompt_enabled = 0;
+
+    int failures = 0;
+    failures += run_config("Default layout", NULL);
+    failures += run_config("Dense corpus layout", "bench/corpus/dense");
+    failures += run_config("Walled corpus layout", "bench/corpus/walled");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,124 @@
+#include "game.h"
+#include "scheduler.h"
+#include "test_digest.h"
+#include <pthread.h>
+#include <stdio.h>
+
+// Games paused for input are resumed by the main thread in a scrambled order,
+// standing in for players who roll at different times. Every game must play
+// exactly the turns it plays when run straight through on one thread.
+
+#define NUM_GAMES   400
+#define NUM_THREADS 4
+#define MAX_ROUNDS  300
+
+typedef struct {
+    char *games;                    // NUM_GAMES game states, `stride` bytes apart
+    size_t stride;
+    unsigned long long digest[NUM_GAMES];
+    int pauses[NUM_GAMES];
+
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    GameState *waiting[NUM_GAMES];  // Games paused for a roll
+    int num_waiting;
+    int num_finished;
+} TestState;
+
+static int game_index(TestState *test, GameState *game) {
+    return (int)(((char *)game - test->games) / test->stride);
+}
+
+static int on_game_event(GameState *game, int stage, const TurnResult *result, void *user_data) {
+    TestState *test = user_data;
+    int index = game_index(test, game);
+
+    if (stage == TURN_DONE) {
+        test->digest[index] = mix_result(test->digest[index], result);
+        if (!result->won && game->round_number <= MAX_ROUNDS) return 1;
+        pthread_mutex_lock(&test->lock);
+        test->num_finished++;
+        pthread_cond_signal(&test->changed);
+        pthread_mutex_unlock(&test->lock);
+        return 0;
+    }
+
+    test->pauses[index]++;
+    pthread_mutex_lock(&test->lock);
+    test->waiting[test->num_waiting++] = game;
+    pthread_cond_signal(&test->changed);
+    pthread_mutex_unlock(&test->lock);
+    return 0;
+}
+
+int main(void) {
+    static TestState test;
+    static GameConfig config;
+    game_print_enabled = 0;
+    game_prompt_enabled = 0;
+    game_config_load(&config, NULL, DEFAULT_NUM_PLAYERS);
+
+    test.stride = game_state_size(DEFAULT_NUM_PLAYERS);
+    test.stride = (test.stride + 63) & ~(size_t)63;
+    test.games = calloc(NUM_GAMES, test.stride);
+    pthread_mutex_init(&test.lock, NULL);
+    pthread_cond_init(&test.changed, NULL);
+
+    GameScheduler *scheduler = scheduler_create(NUM_THREADS, NUM_GAMES, on_game_event, &test);
+    for (int g = 0; g < NUM_GAMES; g++) {
+        GameState *game = (GameState *)(test.games + (size_t)g * test.stride);
+        game_state_init(game, &config, DEFAULT_NUM_PLAYERS, 1000 + g);
+        scheduler_submit(scheduler, game);
+    }
+
+    // Roll for waiting games, picking from the middle of the list to scramble the order
+    unsigned int pick = 12345;
+    pthread_mutex_lock(&test.lock);
+    while (test.num_finished < NUM_GAMES) {
+        while (test.num_waiting == 0 && test.num_finished < NUM_GAMES) {
+            pthread_cond_wait(&test.changed, &test.lock);
+        }
+        while (test.num_waiting > 0) {
+            pick = pick * 1103515245u + 12345u;
+            int slot = (int)((pick >> 8) % (unsigned int)test.num_waiting);
+            GameState *game = test.waiting[slot];
+            test.waiting[slot] = test.waiting[--test.num_waiting];
+            pthread_mutex_unlock(&test.lock);
+            scheduler_submit(scheduler, game);
+            pthread_mutex_lock(&test.lock);
+        }
+    }
+    pthread_mutex_unlock(&test.lock);
+    scheduler_drain(scheduler);
+    scheduler_destroy(scheduler);
+
+    // Replay every game straight through and compare
+    int failures = 0;
+    long total_pauses = 0;
+    GameState *reference = malloc(game_state_size(DEFAULT_NUM_PLAYERS));
+    for (int g = 0; g < NUM_GAMES; g++) {
+        TurnResult result;
+        unsigned long long digest = 0;
+        int rolls = 0;
+        game_state_init(reference, &config, DEFAULT_NUM_PLAYERS, 1000 + g);
+        do {
+            play_game_turn(reference, &result);
+            digest = mix_result(digest, &result);
+            rolls += (result.direction_roll != 0) + (result.movement_roll != 0);
+        } while (!result.won && reference->round_number <= MAX_ROUNDS);
+
+        if (digest != test.digest[g] || rolls != test.pauses[g]) {
+            printf("✗ Game %d differs when scheduled (%d pauses, %d rolls)\n", g, test.pauses[g], rolls);
+            failures++;
+        }
+        total_pauses += test.pauses[g];
+    }
+    free(reference);
+    free(test.games);
+
+    if (failures == 0) {
+        printf("✓ Scheduler test passed: %d games, %ld pauses for input, %d threads.\n",
+               NUM_GAMES, total_pauses, NUM_THREADS);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,172 @@
+#include "store.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Records written through two buffers, and appended again after reopening the
+// store, must read back column for column, and a range filter answered the way
+// scan.c answers it (block min/max first, then the decoded column) must keep
+// exactly the games a plain pass over the records keeps.
+
+#define NUM_RECORDS  (2 * STORE_BLOCK_ROWS + 1000)  // Two full blocks and a short one per batch
+#define NUM_BATCHES  2
+
+// A record whose fields depend on the seed only; rounds grow with the seed so
+// that blocks cover separate ranges and a filter can skip whole blocks
+static OutcomeRecord make_record(uint32_t seed) {
+    OutcomeRecord record = { 0 };
+    record.config_id = seed < NUM_RECORDS ? 1 : 2;
+    record.seed = seed;
+    record.num_players = 3;
+    record.winner = (int32_t)(seed * 7 % 4) - 1;
+    record.rounds = (int32_t)(seed / 64) + (int32_t)(seed % 5);
+    record.loop_resets = (int32_t)(seed % 3);
+    for (int e = 0; e < STORE_NUM_BAWANA; e++) record.bawana[e] = (int32_t)((seed >> e) % 2);
+    for (int p = 0; p < 3; p++) {
+        record.captures[p] = (int32_t)((seed + (uint32_t)p) % 6);
+        record.final_mp[p] = (int32_t)(seed % 997) - 400 + p;
+    }
+    return record;
+}
+
+static int64_t record_column(const OutcomeRecord *record, int column) {
+    switch (column) {
+    case STORE_CONFIG: return record->config_id;
+    case STORE_SEED: return record->seed;
+    case STORE_PLAYERS: return record->num_players;
+    case STORE_WINNER: return record->winner;
+    case STORE_ROUNDS: return record->rounds;
+    case STORE_LOOP_RESETS: return record->loop_resets;
+    }
+    if (column < STORE_CAPTURES) return record->bawana[column - STORE_BAWANA];
+    if (column < STORE_FINAL_MP) return record->captures[column - STORE_CAPTURES];
+    return record->final_mp[column - STORE_FINAL_MP];
+}
+
+// Seeds are even in one buffer and odd in the other, so both interleave in the file
+static int write_batch(const char *path, uint32_t first_seed) {
+    static StoreWriter writer;
+    StoreBuffer buffers[2];
+    if (!store_writer_open(&writer, path)) return 0;
+    int ok = store_buffer_init(&buffers[0], &writer) && store_buffer_init(&buffers[1], &writer);
+    for (uint32_t seed = first_seed; ok && seed < first_seed + NUM_RECORDS; seed++) {
+        OutcomeRecord record = make_record(seed);
+        ok = store_buffer_add(&buffers[seed % 2], &record);
+    }
+    for (int b = 0; b < 2; b++) {
+        if (ok) ok = store_buffer_flush(&buffers[b]);
+        store_buffer_free(&buffers[b]);
+    }
+    return store_writer_close(&writer) && ok;
+}
+
+int main(void) {
+    char path[] = "/tmp/test_store_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        printf("✗ Could not create a temporary store\n");
+        return 1;
+    }
+    close(fd);
+    int failures = 0;
+
+    for (int batch = 0; batch < NUM_BATCHES; batch++) {
+        if (!write_batch(path, (uint32_t)(batch * NUM_RECORDS))) {
+            printf("✗ Could not write batch %d to %s\n", batch, path);
+            unlink(path);
+            return 1;
+        }
+    }
+
+    StoreReader reader;
+    if (!store_reader_open(&reader, path)) {
+        printf("✗ %s does not read back as a store\n", path);
+        unlink(path);
+        return 1;
+    }
+
+    // Every value of every column must come back, and every seed exactly once
+    static int64_t values[STORE_NUM_COLUMNS][STORE_BLOCK_ROWS];
+    unsigned char *seen = calloc(NUM_BATCHES * NUM_RECORDS, 1);
+    long rows = 0, mismatches = 0;
+    for (int b = 0; b < reader.num_blocks; b++) {
+        const StoreBlockHeader *block = reader.blocks[b];
+        for (int c = 0; c < STORE_NUM_COLUMNS; c++) {
+            store_column_decode(block, c, values[c]);
+            for (int i = 0; i < (int)block->num_rows; i++) {
+                if (values[c][i] < block->columns[c].min || values[c][i] > block->columns[c].max) mismatches++;
+            }
+        }
+        for (int i = 0; i < (int)block->num_rows; i++) {
+            int64_t seed = values[STORE_SEED][i];
+            if (seed < 0 || seed >= NUM_BATCHES * NUM_RECORDS || seen[seed]++) {
+                mismatches++;
+                continue;
+            }
+            OutcomeRecord expected = make_record((uint32_t)seed);
+            for (int c = 0; c < STORE_NUM_COLUMNS; c++) mismatches += values[c][i] != record_column(&expected, c);
+        }
+        rows += block->num_rows;
+    }
+    if (rows != NUM_BATCHES * NUM_RECORDS || mismatches) {
+        printf("✗ Read back %ld of %d records, %ld wrong values\n", rows, NUM_BATCHES * NUM_RECORDS, mismatches);
+        failures++;
+    } else {
+        printf("✓ %ld records in %d blocks read back column for column after an append\n", rows, reader.num_blocks);
+    }
+
+    // config=2, rounds=:560: blocks outside the range are skipped on their header
+    const struct { int column; int64_t lo, hi; } filters[] = { { STORE_CONFIG, 2, 2 }, { STORE_ROUNDS, INT64_MIN, 560 } };
+    const int num_filters = (int)(sizeof(filters) / sizeof(filters[0]));
+    long expected_matches = 0, matches = 0;
+    int blocks_skipped = 0;
+    for (uint32_t seed = 0; seed < NUM_BATCHES * NUM_RECORDS; seed++) {
+        OutcomeRecord record = make_record(seed);
+        int keep = 1;
+        for (int f = 0; f < num_filters; f++) {
+            int64_t v = record_column(&record, filters[f].column);
+            keep &= v >= filters[f].lo && v <= filters[f].hi;
+        }
+        expected_matches += keep;
+    }
+    for (int b = 0; b < reader.num_blocks; b++) {
+        const StoreBlockHeader *block = reader.blocks[b];
+        int skip = 0;
+        for (int f = 0; f < num_filters; f++) {
+            const StoreColumn *column = &block->columns[filters[f].column];
+            skip |= column->max < filters[f].lo || column->min > filters[f].hi;
+        }
+        if (skip) {
+            blocks_skipped++;
+            continue;
+        }
+        for (int f = 0; f < num_filters; f++) store_column_decode(block, filters[f].column, values[filters[f].column]);
+        for (int i = 0; i < (int)block->num_rows; i++) {
+            int keep = 1;
+            for (int f = 0; f < num_filters; f++) {
+                int64_t v = values[filters[f].column][i];
+                keep &= v >= filters[f].lo && v <= filters[f].hi;
+            }
+            matches += keep;
+        }
+    }
+    if (matches != expected_matches || blocks_skipped == 0) {
+        printf("✗ Filter kept %ld games, expected %ld (%d blocks skipped)\n", matches, expected_matches, blocks_skipped);
+        failures++;
+    } else {
+        printf("✓ Filter config=2 rounds=:560 kept %ld games, %d of %d blocks skipped on their header\n", matches,
+               blocks_skipped, reader.num_blocks);
+    }
+
+    free(seen);
+    store_reader_close(&reader);
+    unlink(path);
+    if (failures) {
+        printf("✗ %d store check%s failed\n", failures, failures == 1 ? "" : "s");
+        return 1;
+    }
+    printf("✓ Store test passed\n");
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include "game.h"
+#include "test_digest.h"
+#include "wide.h"
+#include <stdio.h>
+
+// Games played in a wide batch, with lanes refilled as games end, must play
+// exactly the turns they play on the scalar engine and end in the same state.
+
+#define NUM_GAMES  1000
+#define MAX_ROUNDS 300
+
+static unsigned long long mix_players(unsigned long long digest, const GameState *game) {
+    for (int p = 0; p < game->num_players; p++) {
+        const Player *player = &game->players[p];
+        int fields[] = { player->pos[0], player->pos[1], player->pos[2], player->in_game, player->direction,
+                         player->movement_points, player->roll_count, player->captured, player->bawana_effect,
+                         player->bawana_turns_left, player->bawana_random_mp, player->just_entered };
+        digest = digest_ints(digest, fields, sizeof(fields) / sizeof(fields[0]));
+    }
+    return digest;
+}
+
+static int run_config(const char *label, const char *config_dir, int num_players) {
+    static GameConfig config;
+    static unsigned long long digest[NUM_GAMES];
+    game_config_load(&config, config_dir, num_players);
+
+    WideBatch *batch = wide_batch_create(&config, num_players);
+    if (!batch) {
+        printf("✗ %s: could not create a batch\n", label);
+        return 1;
+    }
+    int lane_game[WIDE_LANES];
+    int next_game = 0;
+    for (int lane = 0; lane < WIDE_LANES && next_game < NUM_GAMES; lane++) {
+        lane_game[lane] = next_game;
+        digest[next_game] = 0;
+        wide_batch_start(batch, lane, 1000 + next_game++);
+    }
+
+    TurnResult results[WIDE_LANES];
+    int played;
+    while ((played = wide_batch_step(batch, results)) != 0) {
+        for (int lane = 0; lane < WIDE_LANES; lane++) {
+            if (!(played >> lane & 1)) continue;
+            int g = lane_game[lane];
+            digest[g] = mix_result(digest[g], &results[lane]);
+            int last_turn = results[lane].won ||
+                            (results[lane].player_id == num_players - 1 && results[lane].round_number >= MAX_ROUNDS);
+            if (!last_turn) continue;
+
+            digest[g] = mix_players(digest[g], wide_batch_game(batch, lane));
+            if (next_game < NUM_GAMES) {
+                lane_game[lane] = next_game;
+                digest[next_game] = 0;
+                wide_batch_start(batch, lane, 1000 + next_game++);
+            } else {
+                wide_batch_stop(batch, lane);
+            }
+        }
+    }
+    long fast_turns, scalar_turns;
+    wide_batch_counts(batch, &fast_turns, &scalar_turns);
+    wide_batch_destroy(batch);
+
+    // Replay every game on the scalar engine and compare
+    int failures = 0;
+    GameState *reference = malloc(game_state_size(num_players));
+    for (int g = 0; g < NUM_GAMES; g++) {
+        TurnResult result;
+        unsigned long long expected = 0;
+        game_state_init(reference, &config, num_players, 1000 + g);
+        do {
+            play_game_turn(reference, &result);
+            expected = mix_result(expected, &result);
+        } while (!result.won && reference->round_number <= MAX_ROUNDS);
+        expected = mix_players(expected, reference);
+
+        if (expected != digest[g]) {
+            if (failures < 5) printf("✗ %s: game %d differs in the wide engine\n", label, g);
+            failures++;
+        }
+    }
+    free(reference);
+
+    if (failures == 0) {
+        printf("✓ %s: %d games match, %.1f%% of %ld turns on the vector path (%d lanes).\n", label, NUM_GAMES,
+               100.0 * fast_turns / (fast_turns + scalar_turns), fast_turns + scalar_turns, WIDE_LANES);
+    }
+    return failures;
+}
+
+int main(void) {
+    game_print_enabled = 0;
+    game_prompt_enabled = 0;
+
+    int failures = 0;
+    failures += run_config("Default layout, 3 players", NULL, DEFAULT_NUM_PLAYERS);
+    failures += run_config("Default layout, 7 players", NULL, 7);
+    failures += run_config("Dense corpus layout, 4 players", "bench/corpus/dense", 4);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,234 @@
+// trace.c - Per-thread trace buffers flushed to a Chrome trace-event JSON file
+
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#define TRACE_BUFFER_RECORDS  32768     // Records per thread before a flush (~1 MB)
+#define TRACE_TEXT_BLOCK      (1 << 16) // JSON is written to the file in blocks of this size
+
+// One event as stored in the hot path; formatted to JSON only on flush
+typedef struct {
+    uint64_t start_ns;
+    uint32_t duration_ns;
+    int32_t value;
+    int32_t game_id;
+    int16_t player_id;
+    uint8_t name;
+    int16_t pos[3];
+} TraceRecord;
+
+// Buffer owned by one thread; kept on a global list so trace_close can flush it
+typedef struct TraceBuffer {
+    TraceRecord records[TRACE_BUFFER_RECORDS];
+    int count;
+    int tid;
+    struct TraceBuffer *next;
+} TraceBuffer;
+
+static const char *event_names[TRACE_NUM_EVENTS] = {
+    "round", "turn", "roll", "validate", "move", "teleport", "effects", "capture"
+};
+
+atomic_int trace_enabled = 0;
+_Thread_local int trace_game_skipped;
+
+static FILE *trace_file;
+static uint64_t trace_origin_ns;
+static TraceBuffer *all_buffers;
+static int next_tid = 1;
+static int sample_every = 1;
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static _Thread_local TraceBuffer *thread_buffer;
+static _Thread_local int thread_game_id;
+
+uint64_t trace_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// Minimal text builder used by the flush path (much cheaper than fprintf per event)
+typedef struct {
+    char text[TRACE_TEXT_BLOCK];
+    size_t length;
+} TextBlock;
+
+static void text_flush(TextBlock *block) {
+    fwrite(block->text, 1, block->length, trace_file);
+    block->length = 0;
+}
+
+static void text_append(TextBlock *block, const char *s) {
+    while (*s) block->text[block->length++] = *s++;
+}
+
+static void text_append_uint(TextBlock *block, uint64_t value) {
+    char digits[24];
+    int n = 0;
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    while (n) block->text[block->length++] = digits[--n];
+}
+
+static void text_append_int(TextBlock *block, int64_t value) {
+    if (value < 0) {
+        block->text[block->length++] = '-';
+        value = -value;
+    }
+    text_append_uint(block, (uint64_t)value);
+}
+
+// Nanoseconds as microseconds with three decimals, as the trace format expects
+static void text_append_us(TextBlock *block, uint64_t ns) {
+    uint64_t fraction = ns % 1000;
+    text_append_uint(block, ns / 1000);
+    block->text[block->length++] = '.';
+    block->text[block->length++] = (char)('0' + fraction / 100);
+    block->text[block->length++] = (char)('0' + (fraction / 10) % 10);
+    block->text[block->length++] = (char)('0' + fraction % 10);
+}
+
+static void format_record(TextBlock *block, const TraceRecord *record, int tid) {
+    text_append(block, "{\"name\":\"");
+    text_append(block, event_names[record->name]);
+    text_append(block, "\",\"ph\":\"X\",\"pid\":");
+    text_append_int(block, record->game_id);
+    text_append(block, ",\"tid\":");
+    text_append_int(block, tid);
+    text_append(block, ",\"ts\":");
+    text_append_us(block, record->start_ns);
+    text_append(block, ",\"dur\":");
+    text_append_us(block, record->duration_ns);
+    text_append(block, ",\"args\":{");
+    if (record->name == TRACE_ROUND) {
+        text_append(block, "\"round\":");
+        text_append_int(block, record->value);
+    } else {
+        text_append(block, "\"player\":\"");
+        if (record->player_id < 26) {
+            block->text[block->length++] = (char)('A' + record->player_id);
+        } else {
+            block->text[block->length++] = 'P';
+            text_append_int(block, record->player_id + 1);
+        }
+        text_append(block, "\",\"pos\":[");
+        text_append_int(block, record->pos[0]);
+        block->text[block->length++] = ',';
+        text_append_int(block, record->pos[1]);
+        block->text[block->length++] = ',';
+        text_append_int(block, record->pos[2]);
+        text_append(block, "],\"mp\":");
+        text_append_int(block, record->value);
+    }
+    text_append(block, "}},\n");
+}
+
+// Format and write a buffer's records; caller holds trace_lock
+static void flush_buffer_locked(TraceBuffer *buffer) {
+    static TextBlock block;
+    for (int i = 0; i < buffer->count; i++) {
+        if (block.length > TRACE_TEXT_BLOCK - 512) text_flush(&block);
+        format_record(&block, &buffer->records[i], buffer->tid);
+    }
+    text_flush(&block);
+    buffer->count = 0;
+}
+
+static TraceBuffer *register_thread(void) {
+    TraceBuffer *buffer = malloc(sizeof(TraceBuffer));
+    if (!buffer) {
+        fprintf(stderr, "Error: Could not allocate trace buffer\n");
+        exit(1);
+    }
+    buffer->count = 0;
+
+    pthread_mutex_lock(&trace_lock);
+    buffer->tid = next_tid++;
+    buffer->next = all_buffers;
+    all_buffers = buffer;
+    pthread_mutex_unlock(&trace_lock);
+
+    thread_buffer = buffer;
+    return buffer;
+}
+
+// Flush every thread's buffer, or only the calling thread's, and finish the JSON document
+static void finish_trace(int all_threads) {
+    if (!trace_file) return;
+    atomic_store(&trace_enabled, 0);
+
+    pthread_mutex_lock(&trace_lock);
+    for (TraceBuffer *buffer = all_buffers; buffer; buffer = buffer->next) {
+        if (all_threads || buffer == thread_buffer) flush_buffer_locked(buffer);
+    }
+    // The metadata event closes the array without a trailing comma
+    fputs("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"Maze of UCSC\"}}\n]}\n", trace_file);
+    fclose(trace_file);
+    trace_file = NULL;
+    pthread_mutex_unlock(&trace_lock);
+}
+
+// Other threads may still be recording, so only the exiting thread's buffer is safe to read
+static void close_at_exit(void) {
+    finish_trace(0);
+}
+
+int trace_open(const char *filename) {
+    trace_file = fopen(filename, "w");
+    if (!trace_file) {
+        fprintf(stderr, "Warning: Could not open trace file %s. Tracing disabled.\n", filename);
+        return 0;
+    }
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", trace_file);
+    trace_origin_ns = trace_now();
+    atomic_store(&trace_enabled, 1);
+    atexit(close_at_exit);
+    return 1;
+}
+
+void trace_close(void) {
+    finish_trace(1);
+}
+
+void trace_set_sample(int every) {
+    sample_every = every > 1 ? every : 1;
+}
+
+void trace_set_game(int game_id) {
+    thread_game_id = game_id;
+    trace_game_skipped = game_id % sample_every != 0;
+}
+
+void trace_record(TraceEventName name, uint64_t start_ns, int player_id, const int pos[3], int value) {
+    uint64_t end_ns = trace_now();
+    TraceBuffer *buffer = thread_buffer ? thread_buffer : register_thread();
+
+    if (buffer->count == TRACE_BUFFER_RECORDS) {
+        pthread_mutex_lock(&trace_lock);
+        if (trace_file) flush_buffer_locked(buffer);
+        buffer->count = 0;
+        pthread_mutex_unlock(&trace_lock);
+    }
+
+    TraceRecord *record = &buffer->records[buffer->count++];
+    record->start_ns = start_ns - trace_origin_ns;
+    record->duration_ns = (uint32_t)(end_ns - start_ns);
+    record->value = value;
+    record->game_id = thread_game_id;
+    record->player_id = (int16_t)player_id;
+    record->name = (uint8_t)name;
+    if (pos) {
+        record->pos[0] = (int16_t)pos[0];
+        record->pos[1] = (int16_t)pos[1];
+        record->pos[2] = (int16_t)pos[2];
+    } else {
+        record->pos[0] = record->pos[1] = record->pos[2] = 0;
+    }
+}
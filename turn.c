@@ -0,0 +1,544 @@
+// turn.c - Turn flow for Maze of UCSC
+// Contains the per-player turn logic and the game status display
+
+#include "game.h"
+#include "profile.h"
+#include "trace.h"
+
+// Everything a turn reads or changes, passed between the resumable phases
+typedef struct {
+    Player *players;
+    Occupancy *occupancy;
+    Maze *maze;
+    Stair *stairs;
+    int num_stairs;
+    Pole *poles;
+    int num_poles;
+    Wall *walls;
+    int num_walls;
+    int *flag_location;
+} TurnWorld;
+
+// Simple function to pause execution and wait for user input
+static void wait_for_enter(const char *message_prompt) {
+    char user_input[100];
+    if (!game_prompt_enabled) return; // Headless runs roll without pausing
+    GAME_PRINT("%s", message_prompt);
+    fflush(stdout);
+    if (fgets(user_input, sizeof(user_input), stdin) == NULL) {
+        // Handle potential input error gracefully
+    }
+}
+
+// The turn is split into phases so it can pause before each die roll:
+//   start     - turn header and food poisoning (may end the turn)
+//   direction - direction die, every fourth roll of a player in the maze
+//   movement  - movement die, the move itself, effects, captures and the flag check
+// Each phase returns the stage the turn waits in next, or TURN_DONE.
+// Dice, movement and capture outcomes are recorded in turn->result.
+
+static int turn_phase_start(TurnState *turn, const TurnWorld *world) {
+    int player_id = turn->result.player_id;
+    Player *current_player = &world->players[player_id];
+    Maze *maze = world->maze;
+    
+    GAME_PRINT("\n=== Player %s's Turn ===\n", get_player_name(player_id));
+    
+    // Handle food poisoning effect first - player misses their turn
+    if (current_player->bawana_effect == EFFECT_FOOD_POISONING) {
+        current_player->bawana_turns_left--;
+        GAME_PRINT("%s is still food poisoned and misses the turn.\n", get_player_name(player_id));
+        
+        if (current_player->bawana_turns_left == 0) {
+            current_player->bawana_effect = EFFECT_NONE;
+            
+            // If MP is depleted when recovering, send to Bawana
+            if (current_player->movement_points <= 0) {
+                int bawana_interior_cells[12][2] = {
+                    {6,21}, {6,22}, {6,23}, {6,24},
+                    {7,21}, {7,22}, {7,23}, {7,24},
+                    {8,21}, {8,22}, {8,23}, {8,24}
+                };
+                int random_cell_idx = game_rand() % 12;
+                current_player->pos[0] = 0;
+                current_player->pos[1] = bawana_interior_cells[random_cell_idx][0];
+                current_player->pos[2] = bawana_interior_cells[random_cell_idx][1];
+                
+                // Get the cell type for proper message display
+                int cell_effect_type = maze_bawana_type(maze, current_player->pos[0], current_player->pos[1], current_player->pos[2]);
+                const char* effect_type_names[] = {"food poisoning", "disoriented", "triggered", "happy", "random MP"};
+                const char* effect_name = (cell_effect_type >= 0 && cell_effect_type < 5) ? effect_type_names[cell_effect_type] : "random";
+                
+                GAME_PRINT("%s is now fit to proceed from the food poisoning episode and now placed on a %s cell and the effects take place.\n", 
+                       get_player_name(player_id), effect_name);
+                PROFILE_BEGIN(PROF_BAWANA_EFFECT);
+                TRACE_BEGIN(trace_effect_start);
+                apply_bawana_effect(current_player, maze, player_id);
+                TRACE_END(trace_effect_start, TRACE_EFFECTS, player_id, current_player);
+                PROFILE_END(PROF_BAWANA_EFFECT);
+            } else {
+                GAME_PRINT(bawana_effect_info[EFFECT_FOOD_POISONING].recovery, get_player_name(player_id));
+            }
+        }
+        return TURN_DONE; // Skip rest of turn due to food poisoning
+    }
+    
+    // Direction dice logic - each player has their own timing based on their individual roll count
+    int total_throws = current_player->roll_count - 1; // Subtract 1 since roll_count increments after each turn
+    turn->should_roll_direction = (current_player->in_game && total_throws > 0 && (total_throws % 4 == 3));
+    turn->rolled_direction_name = "";
+    return turn->should_roll_direction ? TURN_AWAIT_DIRECTION_ROLL : TURN_AWAIT_MOVEMENT_ROLL;
+}
+
+static int turn_phase_direction(TurnState *turn, const TurnWorld *world) {
+    int player_id = turn->result.player_id;
+    Player *current_player = &world->players[player_id];
+    Maze *maze = world->maze;
+    TurnResult *result = &turn->result;
+
+    PROFILE_BEGIN(PROF_DIRECTION_ROLL);
+    TRACE_BEGIN(trace_direction_start);
+    int direction_roll = roll_direction_dice();
+    if (turn->forced_direction_roll) {
+        // What-if branch: the die is still rolled so later rolls stay the same
+        direction_roll = turn->forced_direction_roll;
+        turn->forced_direction_roll = 0;
+    }
+    result->direction_roll = direction_roll;
+    
+    // If at Bawana entrance, force direction to North and ignore the die
+    if (maze->layout->cells[current_player->pos[0]][current_player->pos[1]][current_player->pos[2]].is_bawana_entrance) {
+        GAME_PRINT("Direction die: %d (ignored at Bawana entrance)\n", direction_roll);
+        current_player->direction = DIR_NORTH;
+        turn->rolled_direction_name = "North";
+        GAME_PRINT("Direction forced to: %s (Bawana entrance)\n", get_direction_name(current_player->direction));
+    } else {
+        // Map die roll to direction
+        if (direction_roll == 2) { 
+            current_player->direction = DIR_NORTH; 
+            turn->rolled_direction_name = "North";
+        } else if (direction_roll == 3) { 
+            current_player->direction = DIR_EAST;  
+            turn->rolled_direction_name = "East";
+        } else if (direction_roll == 4) { 
+            current_player->direction = DIR_SOUTH; 
+            turn->rolled_direction_name = "South";
+        } else if (direction_roll == 5) { 
+            current_player->direction = DIR_WEST;  
+            turn->rolled_direction_name = "West";
+        } else { 
+            turn->rolled_direction_name = "Empty"; // Roll of 1 or 6 means no change
+        }
+        
+        GAME_PRINT("Direction die: %d (%s)\n", direction_roll, turn->rolled_direction_name);
+        
+        if (direction_roll == 1 || direction_roll == 6) {
+            GAME_PRINT("Direction unchanged: %s\n", get_direction_name(current_player->direction));
+        } else {
+            GAME_PRINT("Direction changed to: %s\n", get_direction_name(current_player->direction));
+        }
+    }
+    TRACE_END(trace_direction_start, TRACE_ROLL, player_id, current_player);
+    PROFILE_END(PROF_DIRECTION_ROLL);
+    return TURN_AWAIT_MOVEMENT_ROLL;
+}
+
+static int turn_phase_movement(TurnState *turn, const TurnWorld *world) {
+    int player_id = turn->result.player_id;
+    Player *current_player = &world->players[player_id];
+    Player *players = world->players;
+    Occupancy *occupancy = world->occupancy;
+    Maze *maze = world->maze;
+    Stair *stairs = world->stairs;
+    Pole *poles = world->poles;
+    int *flag_location = world->flag_location;
+    TurnResult *result = &turn->result;
+    int should_roll_direction_dice = turn->should_roll_direction;
+    const char* rolled_direction_name = turn->rolled_direction_name;
+
+    // Roll movement die
+    PROFILE_BEGIN(PROF_MOVEMENT_ROLL);
+    TRACE_BEGIN(trace_roll_start);
+    int movement_roll = roll_movement_dice();
+    if (turn->forced_movement_roll) {
+        movement_roll = turn->forced_movement_roll;
+        turn->forced_movement_roll = 0;
+    }
+    result->movement_roll = movement_roll;
+    GAME_PRINT("Movement die: %d\n", movement_roll);
+    TRACE_END(trace_roll_start, TRACE_ROLL, player_id, current_player);
+    PROFILE_END(PROF_MOVEMENT_ROLL);
+    
+    // Handle players in starting area (need to roll 6 to enter maze)
+    if (!current_player->in_game) {
+        if (movement_roll == 6) {
+            // Check if player is at Player A's starting area (after being captured/reset)
+            if (current_player->pos[0] == 0 && current_player->pos[1] == 6 && current_player->pos[2] == 12) {
+                // Enter maze like Player A
+                enter_maze_like_player_a(current_player);
+                GAME_PRINT("%s is at Player A's starting area and rolls 6 on the movement dice and is placed on Player A's first maze cell %s.\n", 
+                       get_player_name(player_id), format_position(current_player->pos[0], current_player->pos[1], current_player->pos[2]));
+            } else {
+                // Normal entry for players at their original starting positions
+                enter_maze(current_player);
+            GAME_PRINT("%s is at the starting area and rolls 6 on the movement dice and is placed on %s of the maze.\n", 
+                   get_player_name(player_id), format_position(current_player->pos[0], current_player->pos[1], current_player->pos[2]));
+            }
+            
+            GAME_PRINT("%s moved 0 cells that cost 0 movement points and is left with %d and is moving in the %s.\n", 
+                   get_player_name(player_id), current_player->movement_points, get_direction_name(current_player->direction));
+            
+            return TURN_DONE;
+        } else {
+            GAME_PRINT("%s is at the starting area and rolls %d on the movement dice cannot enter the maze.\n", 
+                   get_player_name(player_id), movement_roll);
+            
+            // If MP is depleted, send to Bawana for replenishment
+            if (current_player->movement_points <= 0) {
+                reset_to_bawana(current_player, player_id);
+                // Apply Bawana effects after transportation
+                PROFILE_BEGIN(PROF_BAWANA_EFFECT);
+                TRACE_BEGIN(trace_effect_start);
+                apply_bawana_effect(current_player, maze, player_id);
+                TRACE_END(trace_effect_start, TRACE_EFFECTS, player_id, current_player);
+                PROFILE_END(PROF_BAWANA_EFFECT);
+            }
+            
+            return TURN_DONE;
+        }
+    }
+
+    // Player is in the maze - handle actual movement
+    int original_dice_roll = movement_roll;
+    int movement_cost_total = 0;
+    int steps_actually_taken = 0;
+    int movement_blocked_reason = BLOCK_NONE;
+    
+    // Apply Bawana effects that modify movement
+    if (current_player->bawana_effect == EFFECT_DISORIENTED) {
+        current_player->direction = game_rand() % 4; // Random direction when disoriented
+    } else if (current_player->bawana_effect == EFFECT_TRIGGERED) {
+        movement_roll *= 2; // Triggered players move double the rolled amount
+    }
+
+    // Store position before movement for comparison
+    int position_before_move[3] = {current_player->pos[0], current_player->pos[1], current_player->pos[2]};
+    
+    // Print appropriate movement message based on current state
+    if (should_roll_direction_dice) {
+        if (current_player->bawana_effect == EFFECT_TRIGGERED) {
+            GAME_PRINT("%s is triggered and rolls and %d on the movement dice and move in the %s and moves %d cells", 
+                   get_player_name(player_id), original_dice_roll, get_direction_name(current_player->direction), movement_roll);
+        } else if (current_player->bawana_effect == EFFECT_DISORIENTED) {
+            GAME_PRINT("%s rolls and %d on the movement dice and is disoriented and move in the %s and moves %d cells", 
+                   get_player_name(player_id), original_dice_roll, get_direction_name(current_player->direction), original_dice_roll);
+        } else {
+            GAME_PRINT("%s rolls and %d on the movement dice and %s on the direction dice, changes direction to %s and moves %d cells", 
+                   get_player_name(player_id), original_dice_roll, rolled_direction_name, get_direction_name(current_player->direction), original_dice_roll);
+        }
+    } else {
+        if (current_player->bawana_effect == EFFECT_TRIGGERED) {
+            GAME_PRINT("%s is triggered and rolls and %d on the movement dice and move in the %s and moves %d cells", 
+                   get_player_name(player_id), original_dice_roll, get_direction_name(current_player->direction), movement_roll);
+        } else if (current_player->bawana_effect == EFFECT_DISORIENTED) {
+            GAME_PRINT("%s rolls and %d on the movement dice and is disoriented and move in the %s and moves %d cells", 
+                   get_player_name(player_id), original_dice_roll, get_direction_name(current_player->direction), original_dice_roll);
+        } else {
+            GAME_PRINT("%s rolls and %d on the movement dice and moves %s by %d cells", 
+                   get_player_name(player_id), original_dice_roll, get_direction_name(current_player->direction), original_dice_roll);
+        }
+    }
+    
+    // Attempt movement with comprehensive error handling
+    PROFILE_BEGIN(PROF_MOVE);
+    TRACE_BEGIN(trace_move_start);
+    move_player_with_teleport(current_player, maze, stairs, poles,
+                              movement_roll, player_id, flag_location,
+                              &movement_cost_total, &steps_actually_taken, &movement_blocked_reason);
+    TRACE_END(trace_move_start, TRACE_MOVE, player_id, current_player);
+    PROFILE_END(PROF_MOVE);
+    result->steps_taken = steps_actually_taken;
+    result->movement_cost = movement_cost_total;
+    result->blocked_reason = movement_blocked_reason;
+
+    // Generate appropriate output based on movement results
+    if (position_before_move[0] == current_player->pos[0] && position_before_move[1] == current_player->pos[1] && position_before_move[2] == current_player->pos[2]) {
+        // Player didn't move (blocked by something)
+        if (movement_blocked_reason != BLOCK_NONE) {
+            GAME_PRINT(" and cannot move in the %s due to %s. Player remains at %s\n", 
+                   get_direction_name(current_player->direction), 
+                   get_blockage_reason_description(movement_blocked_reason),
+                   format_position(current_player->pos[0], current_player->pos[1], current_player->pos[2]));
+        } else {
+            GAME_PRINT(" and cannot move in the %s. Player remains at %s\n", 
+                   get_direction_name(current_player->direction), 
+                   format_position(current_player->pos[0], current_player->pos[1], current_player->pos[2]));
+        }
+        
+        // Deduct movement cost even when blocked
+        current_player->movement_points -= movement_cost_total;
+        
+        GAME_PRINT("%s moved 0 cells that cost %d movement points and is left with %d and is moving in the %s.\n", 
+               get_player_name(player_id), movement_cost_total, current_player->movement_points, get_direction_name(current_player->direction));
+    } else {
+        // Player successfully moved
+        current_player->movement_points -= movement_cost_total;
+        
+        // Different message formats based on Bawana effects
+        if (current_player->bawana_effect == EFFECT_DISORIENTED) {
+            GAME_PRINT(" and moves %d cells and is placed at %s.\n", steps_actually_taken, format_position(current_player->pos[0], current_player->pos[1], current_player->pos[2]));
+        } else if (current_player->bawana_effect == EFFECT_TRIGGERED) {
+            GAME_PRINT(" and moves %d cells and is placed at %s.\n", steps_actually_taken, format_position(current_player->pos[0], current_player->pos[1], current_player->pos[2]));
+        } else {
+            GAME_PRINT(" and is now at %s.\n", format_position(current_player->pos[0], current_player->pos[1], current_player->pos[2]));
+        }
+        
+        GAME_PRINT("%s moved %d cells that cost %d movement points and is left with %d and is moving in the %s.\n", 
+               get_player_name(player_id), steps_actually_taken, movement_cost_total, current_player->movement_points, get_direction_name(current_player->direction));
+    }
+
+    // Handle countdown for other lasting Bawana effects (food poisoning counts down at the turn start)
+    const BawanaEffectInfo *effect = &bawana_effect_info[current_player->bawana_effect];
+    if (effect->duration > 0 && current_player->bawana_effect != EFFECT_FOOD_POISONING) {
+        current_player->bawana_turns_left--;
+        if (current_player->bawana_turns_left == 0) {
+            GAME_PRINT(effect->recovery, get_player_name(player_id));
+            current_player->bawana_effect = EFFECT_NONE;
+        }
+    }
+
+    // Check if movement points are completely depleted
+    if (current_player->movement_points <= 0) {
+        reset_to_bawana(current_player, player_id);
+        // Apply Bawana effects after transportation
+        PROFILE_BEGIN(PROF_BAWANA_EFFECT);
+        TRACE_BEGIN(trace_effect_start);
+        apply_bawana_effect(current_player, maze, player_id);
+        TRACE_END(trace_effect_start, TRACE_EFFECTS, player_id, current_player);
+        PROFILE_END(PROF_BAWANA_EFFECT);
+    }
+
+    // Check for player captures (when players occupy the same cell)
+    PROFILE_BEGIN(PROF_CAPTURE_CHECK);
+    TRACE_BEGIN(trace_capture_start);
+    result->captured_player = check_player_capture(players, occupancy, player_id);
+    TRACE_END(trace_capture_start, TRACE_CAPTURE, player_id, current_player);
+    PROFILE_END(PROF_CAPTURE_CHECK);
+
+    // Check if player captured the flag (win condition)
+    PROFILE_BEGIN(PROF_FLAG_CHECK);
+    int flag_captured = check_flag_capture(current_player, flag_location);
+    PROFILE_END(PROF_FLAG_CHECK);
+    if (flag_captured) {
+        GAME_PRINT("Player %s has captured the flag!\n", get_player_name(player_id));
+        GAME_PRINT("Player %s wins the game!\n", get_player_name(player_id));
+        turn->won = 1;
+        return TURN_DONE; // Game over
+    }
+
+    current_player->roll_count++; // Increment for direction dice timing
+    return TURN_DONE;
+}
+
+// Start `player_id`'s turn and run it up to its first pause
+// The mover is taken off the occupancy grid until the turn ends
+static void turn_finish(TurnState *turn, const TurnWorld *world);
+
+static int turn_begin(TurnState *turn, const TurnWorld *world, int player_id) {
+    Player *player = &world->players[player_id];
+    memset(&turn->result, 0, sizeof(turn->result));
+    turn->result.player_id = player_id;
+    turn->result.captured_player = -1;
+    memcpy(turn->result.start_pos, player->pos, sizeof(turn->result.start_pos));
+    turn->won = 0;
+
+    occupancy_remove(world->occupancy, world->players, player_id);
+    turn->stage = turn_phase_start(turn, world);
+    if (turn->stage == TURN_DONE) turn_finish(turn, world);
+    return turn->stage;
+}
+
+// Roll the die the turn is waiting for and run on to the next pause (or the end)
+static int turn_resume(TurnState *turn, const TurnWorld *world) {
+    if (turn->stage == TURN_AWAIT_DIRECTION_ROLL) {
+        turn->stage = turn_phase_direction(turn, world);
+    } else if (turn->stage == TURN_AWAIT_MOVEMENT_ROLL) {
+        turn->stage = turn_phase_movement(turn, world);
+    }
+    if (turn->stage == TURN_DONE) turn_finish(turn, world);
+    return turn->stage;
+}
+
+// List the mover at its new cell and record where the turn left it
+static void turn_finish(TurnState *turn, const TurnWorld *world) {
+    int player_id = turn->result.player_id;
+    Player *player = &world->players[player_id];
+    if (player->in_game) occupancy_add(world->occupancy, world->players, player_id);
+
+    memcpy(turn->result.end_pos, player->pos, sizeof(turn->result.end_pos));
+    turn->result.in_game = player->in_game;
+    turn->result.direction = player->direction;
+    turn->result.movement_points = player->movement_points;
+    turn->result.bawana_effect = player->bawana_effect;
+    turn->result.won = turn->won;
+}
+
+static const char* turn_prompt(int stage) {
+    return stage == TURN_AWAIT_DIRECTION_ROLL ? "Press Enter to roll direction die: "
+                                              : "Press Enter to roll movement die: ";
+}
+
+// Play one turn, blocking at each pause until the player presses Enter
+// The phases are timed individually; this times and traces the whole turn
+// Returns 1 if this player captured the flag and won the game, 0 otherwise
+int play_turn(int player_id, Player players[], Occupancy *occupancy,
+              Maze *maze,
+              Stair stairs[], int num_stairs, Pole poles[], int num_poles,
+              Wall walls[], int num_walls, int flag_location[3]) {
+    TurnWorld world = { players, occupancy, maze, stairs, num_stairs, poles, num_poles,
+                        walls, num_walls, flag_location };
+    TurnState turn = { 0 };
+    PROFILE_BEGIN(PROF_TURN);
+    TRACE_BEGIN(trace_turn_start);
+
+    int stage = turn_begin(&turn, &world, player_id);
+    while (stage != TURN_DONE) {
+        wait_for_enter(turn_prompt(stage));
+        stage = turn_resume(&turn, &world);
+    }
+
+    TRACE_END(trace_turn_start, TRACE_TURN, player_id, &players[player_id]);
+    PROFILE_END(PROF_TURN);
+    return turn.won;
+}
+
+// Fast start: each roll of a player waiting in the starting area misses the 6 with
+// probability 5/6 and changes nothing else, so the number of misses before the 6 is
+// geometric. It is drawn once when the wait begins; the missed turns then pass without
+// rolling, and the turn after them rolls a forced 6. Turn order, stair re-rolls and the
+// other players' turns are untouched, and games play out with the same odds, but not
+// the same dice as a seed replayed without it. Returns 1 if this turn was a miss.
+static int turn_fast_start_miss(TurnState *turn, const TurnWorld *world, int player_id) {
+    Player *player = &world->players[player_id];
+    if (player->in_game || player->bawana_effect == EFFECT_FOOD_POISONING ||
+        player->movement_points <= 0 || turn->forced_movement_roll) {
+        player->start_wait = -1; // A miss with no MP left sends the player to Bawana: roll it out
+        return 0;
+    }
+    if (player->start_wait < 0) {
+        double uniform = (game_rand() + 1.0) / 2147483648.0; // (0, 1]
+        player->start_wait = (int)(log(uniform) / log(5.0 / 6.0));
+    }
+    if (player->start_wait == 0) {
+        player->start_wait = -1;
+        turn->forced_movement_roll = 6;
+        return 0;
+    }
+    player->start_wait--;
+
+    memset(&turn->result, 0, sizeof(turn->result));
+    turn->result.player_id = player_id;
+    turn->result.captured_player = -1;
+    memcpy(turn->result.start_pos, player->pos, sizeof(turn->result.start_pos));
+    turn->won = 0;
+    turn->stage = TURN_DONE;
+    GAME_PRINT("\n=== Player %s's Turn ===\n", get_player_name(player_id));
+    GAME_PRINT("%s is at the starting area and misses the 6 (fast start).\n", get_player_name(player_id));
+    turn_finish(turn, world);
+    return 1;
+}
+
+// Shared by game_turn_resume() and play_game_turn(); with `run_to_end` set no pause is made
+static int game_turn_advance(GameState *game, TurnResult *result, int run_to_end) {
+    const GameConfig *config = game->config;
+    TurnState *turn = &game->turn;
+    TurnWorld world = { game->players, &game->occupancy, &game->maze, game->stairs, game->num_stairs,
+                        (Pole *)config->poles, config->num_poles, (Wall *)config->walls, config->num_walls,
+                        game->flag_position };
+
+    if (game->winner >= 0) {
+        memset(result, 0, sizeof(*result));
+        result->player_id = game->winner;
+        result->round_number = game->round_number;
+        result->captured_player = -1;
+        result->won = 1;
+        return TURN_DONE;
+    }
+
+    game_rng_bind(&game->rng);
+    int stage;
+    if (turn->stage == TURN_DONE) {
+        int stairs_changed = 0;
+        if (game->next_player == 0) {
+            stairs_changed = update_stair_directions(game->stairs, game->num_stairs, game->round_number,
+                                                     &game->stair_epoch);
+        }
+        if (game->fast_start && turn_fast_start_miss(turn, &world, game->next_player)) {
+            stage = TURN_DONE;
+        } else {
+            stage = turn_begin(turn, &world, game->next_player);
+        }
+        turn->result.round_number = game->round_number;
+        turn->result.stairs_changed = stairs_changed;
+    } else {
+        stage = turn_resume(turn, &world);
+    }
+    while (run_to_end && stage != TURN_DONE) {
+        stage = turn_resume(turn, &world);
+    }
+    game_rng_bind(NULL);
+
+    if (stage == TURN_DONE) {
+        *result = turn->result;
+        if (turn->won) {
+            game->winner = turn->result.player_id;
+        } else if (++game->next_player == game->num_players) {
+            game->next_player = 0;
+            game->round_number++;
+        }
+    }
+    return stage;
+}
+
+// Run a self-contained game until it needs the player to roll a die, or until the
+// current turn ends. If the game is paused waiting for a roll, that roll is made first;
+// otherwise the next player's turn starts (re-rolling stair directions at the start of
+// each round like main() does). The game's own generator is used for every die.
+// Returns the TURN_AWAIT_* stage the game now waits in, or TURN_DONE with `result` filled
+int game_turn_resume(GameState *game, TurnResult *result) {
+    return game_turn_advance(game, result, 0);
+}
+
+// Play the rest of the current turn (or the next turn) without pausing
+// Returns 1 if the turn won the game (or the game was already over)
+int play_game_turn(GameState *game, TurnResult *result) {
+    TRACE_BEGIN(trace_turn_start);
+    game_turn_advance(game, result, 1);
+    TRACE_END(trace_turn_start, TRACE_TURN, result->player_id, &game->players[result->player_id]);
+    return result->won;
+}
+
+// Display current game state for all players
+void print_game_status(Player players[], int num_players, int flag_location[3]) {
+    GAME_PRINT("\n--- Game Status ---\n");
+    GAME_PRINT("Flag location: [%d,%d,%d]\n", flag_location[0], flag_location[1], flag_location[2]);
+    
+    for (int player_idx = 0; player_idx < num_players; player_idx++) {
+        GAME_PRINT("Player %s: [%d,%d,%d] - ", get_player_name(player_idx), players[player_idx].pos[0], players[player_idx].pos[1], players[player_idx].pos[2]);
+        
+        if (players[player_idx].in_game) {
+            GAME_PRINT("In maze, MP: %d", players[player_idx].movement_points);
+            if (players[player_idx].bawana_effect > EFFECT_NONE) {
+                GAME_PRINT(", Bawana effect: %s", bawana_effect_info[players[player_idx].bawana_effect].name);
+                if (players[player_idx].bawana_effect != EFFECT_HAPPY) {
+                    GAME_PRINT(" (turns left: %d)", players[player_idx].bawana_turns_left);
+                }
+            }
+        } else {
+            GAME_PRINT("In starting area, MP: %d", players[player_idx].movement_points);
+        }
+        GAME_PRINT("\n");
+    }
+    GAME_PRINT("-------------------\n");
+}
+
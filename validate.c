@@ -0,0 +1,259 @@
+// validate.c - Checks whole trees of configuration directories across threads
+// Every PATH is searched recursively, and each directory holding any of the
+// config files (stairs.txt, poles.txt, walls.txt, flag.txt, players.txt) is
+// checked with config_check() (check.h). Directory i of the sorted list goes
+// to thread i % T, and the output is printed in list order once all threads
+// are done, so it does not depend on the thread count. A directory reached
+// through more than one PATH (or a symlink) is checked once, under the first
+// name it was found by.
+//
+// Output is one JSON object per line and directory:
+//   {"config": "DIR", "issues": [{"code": "...", "file": "...", "line": N, "message": "..."}, ...]}
+// with --failing only directories that have issues. A summary goes to stderr.
+// Exit status: 0 if every directory is clean, 1 if any has issues, 2 on bad usage.
+//
+// Build: gcc -O2 -pthread -o validate validate.c check.c game.c turn.c -lm
+// Usage: ./validate [--threads T] [--failing] PATH...
+
+#include "check.h"
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+    char **paths;
+    char **keys;                // Canonical path of each entry (realpath()), to find duplicates
+    int num_paths, capacity;
+} PathList;
+
+typedef struct {
+    const PathList *dirs;
+    int thread_index, num_threads;
+    int failing_only;
+    char **results;             // One output line per directory (NULL = nothing to print)
+    long issues, dirs_with_issues;
+    double check_seconds;       // Time spent in config_check()
+} ValidateWorker;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int path_list_add(PathList *list, const char *path) {
+    if (list->num_paths == list->capacity) {
+        int capacity = list->capacity ? list->capacity * 2 : 256;
+        char **paths = realloc(list->paths, sizeof(char *) * (size_t)capacity);
+        if (paths) list->paths = paths;
+        char **keys = paths ? realloc(list->keys, sizeof(char *) * (size_t)capacity) : NULL;
+        if (!keys) return 0;
+        list->keys = keys;
+        list->capacity = capacity;
+    }
+    char *key = realpath(path, NULL);
+    if (!key) key = strdup(path);
+    char *copy = strdup(path);
+    if (!key || !copy) {
+        free(key);
+        free(copy);
+        return 0;
+    }
+    list->paths[list->num_paths] = copy;
+    list->keys[list->num_paths++] = key;
+    return 1;
+}
+
+// Add `dir` if it is a config directory, then look through its subdirectories
+static int find_config_dirs(PathList *list, const char *dir) {
+    if (config_check_is_config_dir(dir) && !path_list_add(list, dir)) return 0;
+    DIR *handle = opendir(dir);
+    if (!handle) return 1;
+    struct dirent *entry;
+    int ok = 1;
+    while (ok && (entry = readdir(handle)) != NULL) {
+        if (entry->d_name[0] == '.') continue;
+        char path[1024];
+        struct stat st;
+        if (snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name) >= (int)sizeof(path)) continue;
+        if (entry->d_type == DT_DIR || ((entry->d_type == DT_UNKNOWN || entry->d_type == DT_LNK) &&
+                                        stat(path, &st) == 0 && S_ISDIR(st.st_mode))) {
+            ok = find_config_dirs(list, path);
+        }
+    }
+    closedir(handle);
+    return ok;
+}
+
+// Sort by canonical path, then by the order the paths were found in
+static const PathList *sort_list;
+
+static int compare_paths(const void *a, const void *b) {
+    int i = *(const int *)a, j = *(const int *)b;
+    int order = strcmp(sort_list->keys[i], sort_list->keys[j]);
+    return order ? order : i - j;
+}
+
+// Sort the list and keep the first of each run of entries naming the same directory
+static void sort_and_dedupe(PathList *list) {
+    int *order = malloc(sizeof(int) * (size_t)(list->num_paths + 1));
+    char **paths = malloc(sizeof(char *) * (size_t)(list->num_paths + 1));
+    char **keys = malloc(sizeof(char *) * (size_t)(list->num_paths + 1));
+    if (!order || !paths || !keys) {
+        fprintf(stderr, "Error: Out of memory sorting %d directories\n", list->num_paths);
+        exit(1);
+    }
+    for (int i = 0; i < list->num_paths; i++) order[i] = i;
+    sort_list = list;
+    qsort(order, (size_t)list->num_paths, sizeof(int), compare_paths);
+    int kept = 0;
+    for (int i = 0; i < list->num_paths; i++) {
+        int from = order[i];
+        if (kept > 0 && strcmp(keys[kept - 1], list->keys[from]) == 0) {
+            free(list->paths[from]);
+            free(list->keys[from]);
+            continue;
+        }
+        paths[kept] = list->paths[from];
+        keys[kept++] = list->keys[from];
+    }
+    free(list->paths);
+    free(list->keys);
+    free(order);
+    list->paths = paths;
+    list->keys = keys;
+    list->num_paths = list->capacity = kept;
+}
+
+static void json_string(FILE *out, const char *text) {
+    fputc('"', out);
+    for (; *text; text++) {
+        unsigned char c = (unsigned char)*text;
+        if (c == '"' || c == '\\') fprintf(out, "\\%c", c);
+        else if (c < 0x20) fprintf(out, "\\u%04x", c);
+        else fputc(c, out);
+    }
+    fputc('"', out);
+}
+
+static char *format_result(const char *dir, const ConfigCheck *check) {
+    char *text = NULL;
+    size_t size = 0;
+    FILE *out = open_memstream(&text, &size);
+    if (!out) return NULL;
+    fprintf(out, "{\"config\": ");
+    json_string(out, dir);
+    fprintf(out, ", \"issues\": [");
+    int shown = check->num_issues < CHECK_MAX_ISSUES ? check->num_issues : CHECK_MAX_ISSUES;
+    for (int i = 0; i < shown; i++) {
+        const ConfigIssue *issue = &check->issues[i];
+        fprintf(out, "%s{\"code\": \"%s\", \"file\": \"%s\", \"line\": %d, \"message\": ", i ? ", " : "",
+                issue->code, issue->file, issue->line);
+        json_string(out, issue->message);
+        fprintf(out, "}");
+    }
+    fprintf(out, "]");
+    if (check->num_issues > shown) fprintf(out, ", \"issues_not_shown\": %d", check->num_issues - shown);
+    fprintf(out, "}\n");
+    fclose(out);
+    return text;
+}
+
+static void *worker_main(void *arg) {
+    ValidateWorker *worker = arg;
+    ConfigCheck *check = malloc(sizeof(ConfigCheck));
+    if (!check) {
+        fprintf(stderr, "Error: Could not allocate a checker for thread %d\n", worker->thread_index);
+        return NULL;
+    }
+    for (int i = worker->thread_index; i < worker->dirs->num_paths; i += worker->num_threads) {
+        const char *dir = worker->dirs->paths[i];
+        double start = now_seconds();
+        int issues = config_check(check, dir);
+        worker->check_seconds += now_seconds() - start;
+        worker->issues += issues;
+        if (issues) worker->dirs_with_issues++;
+        if (issues || !worker->failing_only) worker->results[i] = format_result(dir, check);
+    }
+    free(check);
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    PathList dirs = { NULL, NULL, 0, 0 };
+    int num_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int failing_only = 0, num_roots = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) num_threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--failing") == 0) failing_only = 1;
+        else if (argv[i][0] != '-') {
+            struct stat st;
+            if (stat(argv[i], &st) != 0 || !S_ISDIR(st.st_mode)) {
+                fprintf(stderr, "Error: %s is not a directory\n", argv[i]);
+                return 2;
+            }
+            if (!find_config_dirs(&dirs, argv[i])) {
+                fprintf(stderr, "Error: Out of memory listing %s\n", argv[i]);
+                return 1;
+            }
+            num_roots++;
+        } else {
+            fprintf(stderr, "Usage: %s [--threads T] [--failing] PATH...\n", argv[0]);
+            return 2;
+        }
+    }
+    if (num_roots == 0) {
+        fprintf(stderr, "Usage: %s [--threads T] [--failing] PATH...\n", argv[0]);
+        return 2;
+    }
+    sort_and_dedupe(&dirs);
+    if (num_threads < 1) num_threads = 1;
+    if (num_threads > dirs.num_paths && dirs.num_paths > 0) num_threads = dirs.num_paths;
+
+    game_print_enabled = 0;
+    game_prompt_enabled = 0;
+
+    char **results = calloc((size_t)dirs.num_paths + 1, sizeof(char *));
+    ValidateWorker *workers = calloc((size_t)num_threads, sizeof(ValidateWorker));
+    pthread_t *threads = calloc((size_t)num_threads, sizeof(pthread_t));
+    if (!results || !workers || !threads) {
+        fprintf(stderr, "Error: Could not allocate %d workers\n", num_threads);
+        return 1;
+    }
+
+    double start = now_seconds();
+    for (int t = 0; t < num_threads; t++) {
+        workers[t] = (ValidateWorker){ &dirs, t, num_threads, failing_only, results, 0, 0, 0.0 };
+        pthread_create(&threads[t], NULL, worker_main, &workers[t]);
+    }
+    long issues = 0, dirs_with_issues = 0;
+    double check_seconds = 0.0;
+    for (int t = 0; t < num_threads; t++) {
+        pthread_join(threads[t], NULL);
+        issues += workers[t].issues;
+        dirs_with_issues += workers[t].dirs_with_issues;
+        check_seconds += workers[t].check_seconds;
+    }
+    double elapsed = now_seconds() - start;
+
+    for (int i = 0; i < dirs.num_paths; i++) {
+        if (results[i]) fputs(results[i], stdout);
+        free(results[i]);
+        free(dirs.paths[i]);
+        free(dirs.keys[i]);
+    }
+    fprintf(stderr, "Checked %d config directories: %ld with issues, %ld issues\n", dirs.num_paths, dirs_with_issues,
+            issues);
+    fprintf(stderr, "Elapsed: %.3fs on %d thread%s, %.1f us per directory per thread\n", elapsed, num_threads,
+            num_threads == 1 ? "" : "s", dirs.num_paths ? check_seconds * 1e6 / dirs.num_paths : 0.0);
+
+    free(results);
+    free(workers);
+    free(threads);
+    free(dirs.paths);
+    free(dirs.keys);
+    return dirs_with_issues ? 1 : 0;
+}
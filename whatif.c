@@ -0,0 +1,114 @@
+// whatif.c - Branching what-if analysis from a game in progress
+// Plays game `seed` for a number of turns, then explores each branch given on
+// the command line from that position (branch.h) and prints how often each
+// player wins, how often the game is still running at the round cap, and how
+// long the won games take. Without branches it compares every movement roll.
+//
+// Build: gcc -O2 -pthread -o whatif whatif.c branch.c game.c turn.c -lm
+// Usage: ./whatif [--seed S] [--turns N] [--players P] [--config DIR] [--runs R]
+//                 [--threads T] [--max-rounds M] [--run-seed X] [branch ...]
+// Branches: as-is, roll=N, direction=N, stair=up|down|both, stairI=up|down|both
+
+#include "game.h"
+#include "branch.h"
+#include <unistd.h>
+
+#define WHATIF_MAX_BRANCHES 64
+
+int main(int argc, char *argv[]) {
+    static GameConfig config;
+    static BranchSpec branches[WHATIF_MAX_BRANCHES];
+    static BranchOutcome outcomes[WHATIF_MAX_BRANCHES];
+    const char *config_dir = NULL;
+    unsigned int seed = 1, run_seed = 1;
+    int turns = 30, num_players = DEFAULT_NUM_PLAYERS, runs = 1000, max_rounds = 1000;
+    int num_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int num_branches = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--turns") == 0 && i + 1 < argc) turns = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--players") == 0 && i + 1 < argc) num_players = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--config") == 0 && i + 1 < argc) config_dir = argv[++i];
+        else if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) runs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) num_threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--max-rounds") == 0 && i + 1 < argc) max_rounds = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--run-seed") == 0 && i + 1 < argc) run_seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if (argv[i][0] != '-' && num_branches < WHATIF_MAX_BRANCHES && branch_parse(argv[i], &branches[num_branches])) {
+            num_branches++;
+        } else {
+            fprintf(stderr, "Usage: %s [--seed S] [--turns N] [--players P] [--config DIR] [--runs R] [--threads T] "
+                            "[--max-rounds M] [--run-seed X] [as-is|roll=N|direction=N|stair[I]=up|down|both ...]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (num_players < MIN_PLAYERS || num_players > MAX_PLAYERS) {
+        fprintf(stderr, "Error: --players must be between %d and %d\n", MIN_PLAYERS, MAX_PLAYERS);
+        return 2;
+    }
+    if (num_branches == 0) {
+        branches[num_branches++].kind = BRANCH_AS_IS;
+        for (int roll = 1; roll <= 6; roll++) {
+            branches[num_branches].kind = BRANCH_MOVEMENT_ROLL;
+            branches[num_branches++].value = roll;
+        }
+    }
+
+    game_print_enabled = 0;
+    game_prompt_enabled = 0;
+    game_config_load(&config, config_dir, num_players);
+
+    // Play up to the position the branches start from
+    GameState *game = game_state_create(&config, num_players, seed);
+    if (!game) {
+        fprintf(stderr, "Error: Could not allocate the game\n");
+        return 1;
+    }
+    TurnResult result;
+    for (int t = 0; t < turns && game->winner < 0; t++) {
+        play_game_turn(game, &result);
+    }
+    if (game->winner >= 0) {
+        printf("Game %u was won by %s in round %d before turn %d.\n", seed, get_player_name(game->winner),
+               game->round_number, turns);
+        game_state_destroy(game);
+        return 0;
+    }
+
+    printf("Game %u after %d turns: round %d, %s to play, flag at [%d,%d,%d]\n", seed, turns, game->round_number,
+           get_player_name(game->next_player), game->flag_position[0], game->flag_position[1], game->flag_position[2]);
+    for (int p = 0; p < num_players && p < BRANCH_MAX_PLAYERS; p++) {
+        const Player *player = &game->players[p];
+        printf("  %s: %s [%d,%d,%d], facing %s, MP %d\n", get_player_name(p), player->in_game ? "in maze" : "start",
+               player->pos[0], player->pos[1], player->pos[2], get_direction_name(player->direction),
+               player->movement_points);
+    }
+
+    if (!branch_explore(game, branches, num_branches, runs, max_rounds, num_threads, run_seed, outcomes)) {
+        fprintf(stderr, "Error: A branch does not apply to this game, or out of memory\n");
+        game_state_destroy(game);
+        return 1;
+    }
+
+    // One row per branch: win share per player, unfinished share, mean rounds to a win
+    int columns = num_players < BRANCH_MAX_PLAYERS ? num_players : BRANCH_MAX_PLAYERS;
+    printf("\n%-16s %7s", "Branch", "Runs");
+    for (int p = 0; p < columns; p++) {
+        printf(" %6s%s", get_player_name(p), (p == BRANCH_MAX_PLAYERS - 1 && num_players > BRANCH_MAX_PLAYERS) ? "+" : " ");
+    }
+    printf(" %10s %11s\n", "Unfinished", "Mean rounds");
+    for (int b = 0; b < num_branches; b++) {
+        const BranchOutcome *outcome = &outcomes[b];
+        long won = outcome->runs - outcome->unfinished;
+        printf("%-16s %7ld", branch_describe(&branches[b]), outcome->runs);
+        for (int p = 0; p < columns; p++) {
+            printf(" %6.1f%%", 100.0 * outcome->wins[p] / outcome->runs);
+        }
+        printf(" %9.1f%%", 100.0 * outcome->unfinished / outcome->runs);
+        if (won > 0) printf(" %11.1f\n", (double)outcome->rounds_to_win / won);
+        else printf(" %11s\n", "-");
+    }
+
+    game_state_destroy(game);
+    return 0;
+}
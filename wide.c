@@ -0,0 +1,502 @@
+// wide.c - Lockstep multi-game engine (see wide.h)
+// Every step gathers the current player of each lane into vectors, runs the
+// turn for all lanes at once speculatively, then commits the lanes whose turn
+// stayed on the modelled path and replays the others on the scalar engine.
+// Nothing is written before the commit, so a replayed lane starts its turn
+// from exactly the state the scalar engine would see.
+
+#include "wide.h"
+#include "stats.h"
+#include "metrics.h"
+#include <stddef.h>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#define WIDE_CELLS      (NUM_FLOORS * FLOOR_WIDTH * FLOOR_LENGTH)
+#define WIDE_MAX_STEPS  12   // A triggered player moves twice the roll
+#define WIDE_MAX_DRAWS  3    // Direction die, movement die, disoriented direction
+
+// Cell kinds in the shared table
+#define KIND_TELEPORT          1   // Stair end or pole top (leaves the fast path)
+#define KIND_BAWANA            2   // Bawana interior (leaves the fast path if the move is not blocked)
+#define KIND_ENTRANCE          4   // The Bawana entrance cell itself
+#define KIND_ENTRANCE_COLUMN   8   // Entrance width/length on any floor, as can_enter_bawana_entrance() checks it
+
+#define CELL_A_START  ((0 * FLOOR_WIDTH + 6) * FLOOR_LENGTH + 12)  // [0,6,12], where captured players go
+#define CELL_A_ENTRY  ((0 * FLOOR_WIDTH + 5) * FLOOR_LENGTH + 12)  // [0,5,12], where they re-enter
+
+// Offsets in ints (or bytes) into a lane's game state, for gathers relative to the batch's games
+#define GAME_OFFSET(member)      ((int)(offsetof(GameState, member) / sizeof(int)))
+#define GAME_BYTE_OFFSET(member) ((int)offsetof(GameState, member))
+
+typedef int WideInt __attribute__((vector_size(WIDE_LANES * sizeof(int))));
+typedef unsigned int WideUint __attribute__((vector_size(WIDE_LANES * sizeof(int))));
+
+struct WideBatch {
+    WideInt lane_id;            // 0, 1, 2, ...
+    WideInt lane_bit;           // 1 << lane
+    WideInt lane_base;          // Offset of each lane's game state, in ints
+    WideInt flag_cell;          // Each game's flag
+
+    const GameConfig *config;
+    int num_players;
+    size_t stride;              // Bytes between the lanes' game states
+    char *games;                // WIDE_LANES game states
+    int running;                // Bit per lane with a game in progress
+    long fast_turns;
+    long scalar_turns;
+
+    // Player state as a structure of arrays: field[player * WIDE_LANES + lane].
+    // While a game runs in a batch these are authoritative; the Player structs
+    // are brought up to date only around scalar turns.
+    int *cell;
+    int *direction;
+    int *movement_points;
+    int *roll_count;
+    int *bawana_effect;
+    int *bawana_turns_left;
+    int *in_game;
+    int *entry_cell;
+
+    // Shared by every lane: next_cell[cell * 4 + direction] is the neighbouring
+    // cell, or -BLOCK_* when a wall or an invalid cell stops the step there
+    int next_cell[WIDE_CELLS * 4];
+    int cell_kind[WIDE_CELLS];
+    int value_slot[WIDE_CELLS];     // The layout's value slots, for gathers from the overlays
+};
+
+static inline WideInt wide_gather(const int *base, WideInt index) {
+#if defined(__AVX512F__)
+    return (WideInt)_mm512_i32gather_epi32((__m512i)index, base, 4);
+#elif defined(__AVX2__)
+    return (WideInt)_mm256_i32gather_epi32(base, (__m256i)index, 4);
+#else
+    WideInt gathered;
+    for (int lane = 0; lane < WIDE_LANES; lane++) gathered[lane] = base[index[lane]];
+    return gathered;
+#endif
+}
+
+// The byte at base + offset in each lane (reads the three bytes after it too)
+static inline WideInt wide_gather_byte(const char *base, WideInt offset) {
+#if defined(__AVX512F__)
+    WideInt word = (WideInt)_mm512_i32gather_epi32((__m512i)offset, base, 1);
+#elif defined(__AVX2__)
+    WideInt word = (WideInt)_mm256_i32gather_epi32((const int *)base, (__m256i)offset, 1);
+#else
+    WideInt word;
+    for (int lane = 0; lane < WIDE_LANES; lane++) word[lane] = (unsigned char)base[offset[lane]];
+#endif
+    return word & 0xFF;
+}
+
+// Lanes of `mask` (all ones or all zeros per lane) as a bit mask
+static inline int wide_bits(WideInt mask) {
+#if defined(__AVX512F__)
+    return (int)_mm512_test_epi32_mask((__m512i)mask, (__m512i)mask);
+#elif defined(__AVX2__)
+    return _mm256_movemask_ps((__m256)mask);
+#else
+    int bits = 0;
+    for (int lane = 0; lane < WIDE_LANES; lane++) bits |= (mask[lane] & 1) << lane;
+    return bits;
+#endif
+}
+
+static inline WideInt wide_select(WideInt mask, WideInt when_set, WideInt otherwise) {
+    return (when_set & mask) | (otherwise & ~mask);
+}
+
+static inline WideInt wide_load(const int *source) {
+    WideInt loaded;
+    memcpy(&loaded, source, sizeof(loaded));
+    return loaded;
+}
+
+static int cell_index(const int pos[3]) {
+    return (pos[0] * FLOOR_WIDTH + pos[1]) * FLOOR_LENGTH + pos[2];
+}
+
+static void cell_position(int cell, int pos[3]) {
+    pos[0] = cell / (FLOOR_WIDTH * FLOOR_LENGTH);
+    pos[1] = cell / FLOOR_LENGTH % FLOOR_WIDTH;
+    pos[2] = cell % FLOOR_LENGTH;
+}
+
+static GameState* lane_game(const WideBatch *batch, int lane) {
+    return (GameState *)(batch->games + (size_t)lane * batch->stride);
+}
+
+// Neighbour and cell-kind tables; only the configuration's shared layout matters,
+// so they are built once per batch
+static void build_tables(WideBatch *batch) {
+    const MazeLayout *layout = &batch->config->layout;
+
+    for (int cell = 0; cell < WIDE_CELLS; cell++) {
+        int pos[3];
+        cell_position(cell, pos);
+        const Cell *info = &layout->cells[pos[0]][pos[1]][pos[2]];
+        int kind = 0;
+        if (info->stair_mask != 0 || info->pole != -1) kind |= KIND_TELEPORT;
+        if (pos[0] == 0 && pos[1] >= 6 && pos[1] <= 9 && pos[2] >= 20 && pos[2] <= 24) kind |= KIND_BAWANA;
+        if (info->is_bawana_entrance) kind |= KIND_ENTRANCE;
+        if (layout->cells[0][pos[1]][pos[2]].is_bawana_entrance) kind |= KIND_ENTRANCE_COLUMN;
+        batch->cell_kind[cell] = kind;
+        batch->value_slot[cell] = info->value_slot;
+
+        for (int direction = DIR_NORTH; direction <= DIR_WEST; direction++) {
+            int next_w = pos[1], next_l = pos[2];
+            switch (direction) {
+                case DIR_NORTH: next_l--; break;
+                case DIR_EAST:  next_w++; break;
+                case DIR_SOUTH: next_l++; break;
+                case DIR_WEST:  next_w--; break;
+            }
+            int next;
+            if (maze_wall_blocks(layout, pos[0], pos[1], pos[2], direction)) {
+                next = -BLOCK_WALL;
+            } else if (!is_valid_position(layout, pos[0], next_w, next_l)) {
+                next = -BLOCK_INVALID_CELL;
+            } else {
+                next = (pos[0] * FLOOR_WIDTH + next_w) * FLOOR_LENGTH + next_l;
+            }
+            batch->next_cell[cell * 4 + direction] = next;
+        }
+    }
+}
+
+WideBatch* wide_batch_create(const GameConfig *config, int num_players) {
+    if (num_players < MIN_PLAYERS || num_players > WIDE_MAX_PLAYERS) return NULL;
+    size_t batch_size = (sizeof(WideBatch) + 63) & ~(size_t)63;
+    WideBatch *batch = aligned_alloc(64, batch_size);
+    if (!batch) return NULL;
+    memset(batch, 0, sizeof(WideBatch));
+
+    batch->config = config;
+    batch->num_players = num_players;
+    batch->stride = (game_state_size(num_players) + 63) & ~(size_t)63;
+    batch->games = calloc(WIDE_LANES, batch->stride);
+    int *fields = calloc((size_t)8 * num_players * WIDE_LANES, sizeof(int));
+    if (!batch->games || !fields) {
+        free(batch->games);
+        free(fields);
+        free(batch);
+        return NULL;
+    }
+    size_t field_size = (size_t)num_players * WIDE_LANES;
+    batch->cell = fields;
+    batch->direction = fields + field_size;
+    batch->movement_points = fields + 2 * field_size;
+    batch->roll_count = fields + 3 * field_size;
+    batch->bawana_effect = fields + 4 * field_size;
+    batch->bawana_turns_left = fields + 5 * field_size;
+    batch->in_game = fields + 6 * field_size;
+    batch->entry_cell = fields + 7 * field_size;
+
+    for (int lane = 0; lane < WIDE_LANES; lane++) {
+        batch->lane_id[lane] = lane;
+        batch->lane_bit[lane] = 1 << lane;
+        batch->lane_base[lane] = (int)((size_t)lane * batch->stride / sizeof(int));
+    }
+    build_tables(batch);
+    return batch;
+}
+
+void wide_batch_destroy(WideBatch *batch) {
+    if (!batch) return;
+    free(batch->cell);
+    free(batch->games);
+    free(batch);
+}
+
+// Copy a lane's players from the Player structs into the batch
+static void load_lane(WideBatch *batch, int lane) {
+    GameState *game = lane_game(batch, lane);
+    for (int player_id = 0; player_id < batch->num_players; player_id++) {
+        const Player *player = &game->players[player_id];
+        int slot = player_id * WIDE_LANES + lane;
+        batch->cell[slot] = cell_index(player->pos);
+        batch->direction[slot] = player->direction;
+        batch->movement_points[slot] = player->movement_points;
+        batch->roll_count[slot] = player->roll_count;
+        batch->bawana_effect[slot] = player->bawana_effect;
+        batch->bawana_turns_left[slot] = player->bawana_turns_left;
+        batch->in_game[slot] = player->in_game;
+    }
+}
+
+// Copy a lane's players back into the Player structs and re-list them on the
+// occupancy grid, which the kernels do not maintain
+static void store_lane(WideBatch *batch, int lane) {
+    GameState *game = lane_game(batch, lane);
+    for (int player_id = 0; player_id < batch->num_players; player_id++) {
+        occupancy_remove(&game->occupancy, game->players, player_id);
+    }
+    for (int player_id = 0; player_id < batch->num_players; player_id++) {
+        Player *player = &game->players[player_id];
+        int slot = player_id * WIDE_LANES + lane;
+        cell_position(batch->cell[slot], player->pos);
+        player->direction = batch->direction[slot];
+        player->movement_points = batch->movement_points[slot];
+        player->roll_count = batch->roll_count[slot];
+        player->bawana_effect = batch->bawana_effect[slot];
+        player->bawana_turns_left = batch->bawana_turns_left[slot];
+        player->in_game = batch->in_game[slot];
+        if (player->in_game) occupancy_add(&game->occupancy, game->players, player_id);
+    }
+}
+
+void wide_batch_start(WideBatch *batch, int lane, unsigned int seed) {
+    GameState *game = lane_game(batch, lane);
+    game_state_init(game, batch->config, batch->num_players, seed);
+    load_lane(batch, lane);
+    for (int player_id = 0; player_id < batch->num_players; player_id++) {
+        batch->entry_cell[player_id * WIDE_LANES + lane] = cell_index(game->players[player_id].entry_pos);
+    }
+    batch->flag_cell[lane] = cell_index(game->flag_position);
+    batch->running |= 1 << lane;
+}
+
+void wide_batch_stop(WideBatch *batch, int lane) {
+    batch->running &= ~(1 << lane);
+}
+
+GameState* wide_batch_game(WideBatch *batch, int lane) {
+    store_lane(batch, lane);
+    return lane_game(batch, lane);
+}
+
+void wide_batch_counts(const WideBatch *batch, long *fast_turns, long *scalar_turns) {
+    if (fast_turns) *fast_turns = batch->fast_turns;
+    if (scalar_turns) *scalar_turns = batch->scalar_turns;
+}
+
+static void play_scalar_turn(WideBatch *batch, int lane, TurnResult *result) {
+    GameState *game = lane_game(batch, lane);
+    store_lane(batch, lane);
+    play_game_turn(game, result);
+    load_lane(batch, lane);
+    if (result->won) batch->running &= ~(1 << lane);
+    batch->scalar_turns++;
+}
+
+int wide_batch_step(WideBatch *batch, TurnResult results[WIDE_LANES]) {
+    int running = batch->running;
+    if (!running) return 0;
+    const int *games = (const int *)batch->games;
+    const WideInt lane_base = batch->lane_base;
+    const WideInt zero = { 0 };
+
+    WideInt active = (batch->lane_bit & running) != 0;
+    WideInt player = wide_gather(games, lane_base + GAME_OFFSET(next_player));
+    WideInt round = wide_gather(games, lane_base + GAME_OFFSET(round_number));
+    WideInt slot = player * WIDE_LANES + batch->lane_id;
+
+    WideInt cell = wide_gather(batch->cell, slot);
+    WideInt direction = wide_gather(batch->direction, slot);
+    WideInt movement_points = wide_gather(batch->movement_points, slot);
+    WideInt roll_count = wide_gather(batch->roll_count, slot);
+    WideInt effect = wide_gather(batch->bawana_effect, slot);
+    WideInt turns_left = wide_gather(batch->bawana_turns_left, slot);
+    WideInt in_maze = wide_gather(batch->in_game, slot) != 0;
+    WideInt kind = wide_gather(batch->cell_kind, cell);
+
+    // Turns the kernels do not model go to the scalar engine
+    WideInt fast = active & (effect != EFFECT_FOOD_POISONING);
+    fast &= ~((player == 0) & (round % STAIR_REROLL_ROUNDS == 0));                      // Stair directions are re-rolled first
+
+    WideInt throws = roll_count - 1;
+    WideInt roll_direction = in_maze & (throws > 0) & ((throws & 3) == 3);
+    fast &= ~(roll_direction & ((kind & KIND_ENTRANCE) != 0));         // Direction die ignored at the entrance
+
+    // Peek the next draws of every generator without advancing it: with
+    // r[i] = r[i-31] + r[i-3], the next three values only read older state
+    WideInt rng_index = wide_gather(games, lane_base + GAME_OFFSET(rng.index));
+    WideInt rng_state = lane_base + GAME_OFFSET(rng.state);
+    WideUint raw[WIDE_MAX_DRAWS];
+    WideInt value[WIDE_MAX_DRAWS];
+    for (int k = 0; k < WIDE_MAX_DRAWS; k++) {
+        WideInt older = rng_index + (k + GAME_RNG_DEGREE - 31);
+        WideInt recent = rng_index + (k + GAME_RNG_DEGREE - 3);
+        older -= (older >= GAME_RNG_DEGREE) & GAME_RNG_DEGREE;
+        recent -= (recent >= GAME_RNG_DEGREE) & GAME_RNG_DEGREE;
+        raw[k] = (WideUint)wide_gather(games, rng_state + older) + (WideUint)wide_gather(games, rng_state + recent);
+        value[k] = (WideInt)(raw[k] >> 1);
+    }
+
+    // Direction die, then the movement die
+    WideInt direction_roll = (value[0] % 6 + 1) & roll_direction;
+    WideInt movement_roll = wide_select(roll_direction, value[1], value[0]) % 6 + 1;
+    WideInt turned = (direction_roll >= 2) & (direction_roll <= 5);
+    direction = wide_select(turned, direction_roll - 2, direction);
+
+    // Effects that change the move
+    WideInt disoriented = in_maze & (effect == EFFECT_DISORIENTED);
+    WideInt disoriented_draw = wide_select(roll_direction, value[2], value[1]);
+    direction = wide_select(disoriented, disoriented_draw % 4, direction);
+    WideInt steps = wide_select(in_maze & (effect == EFFECT_TRIGGERED), movement_roll * 2, movement_roll);
+    WideInt draws_used = 1 - roll_direction - disoriented;
+
+    // Players in the starting area enter on a 6; a miss with no MP left is a Bawana trip
+    WideInt entering = active & ~in_maze & (movement_roll == 6);
+    WideInt at_a_start = cell == CELL_A_START;
+    WideInt entry = wide_select(at_a_start, zero + CELL_A_ENTRY, wide_gather(batch->entry_cell, slot));
+    fast &= in_maze | entering | (movement_points > 0);
+
+    // Walk the move through the neighbour table. Cost and bonuses are taken
+    // along the way and only kept if no step turns out to be blocked.
+    WideInt walking = active & in_maze;
+    WideInt entrance_open = movement_points <= 0;
+    WideInt position = cell;
+    WideInt points = movement_points;
+    WideInt cost = zero;
+    WideInt blocked_reason = zero;
+    WideInt touched_bawana = zero;
+    WideInt teleport = zero;
+    WideInt path[WIDE_MAX_STEPS];
+    const WideInt value_base = lane_base * (int)sizeof(int) + GAME_BYTE_OFFSET(maze.overlay.cell_value);
+    const WideInt used_base = lane_base + GAME_OFFSET(maze.overlay.bonus_used);
+    for (int s = 0; s < WIDE_MAX_STEPS; s++) {
+        walking &= steps > s;
+        if (!wide_bits(walking)) break;
+        WideInt next = wide_gather(batch->next_cell, position * 4 + direction);
+        WideInt target = next & ~(next >> 31);
+        WideInt target_kind = wide_gather(batch->cell_kind, target);
+
+        WideInt stopped = walking & (next < 0);
+        WideInt entrance_shut = walking & ~stopped & ((target_kind & KIND_ENTRANCE_COLUMN) != 0) & ~entrance_open;
+        blocked_reason = wide_select(stopped, -next, blocked_reason);
+        blocked_reason = wide_select(entrance_shut, zero + BLOCK_BAWANA_ENTRANCE, blocked_reason);
+        WideInt step = walking & ~stopped & ~entrance_shut;
+
+        // Consumable value and bonus from the lane's overlay; a collected bonus is gone
+        WideInt value_slot = wide_gather(batch->value_slot, target);
+        WideInt has_value = value_slot >= 0;
+        value_slot &= has_value;
+        WideInt value = wide_gather_byte((const char *)games, value_base + value_slot) & has_value;
+        WideInt used = wide_gather(games, used_base + (value_slot >> 5)) >> (value_slot & 31) & 1;
+        WideInt consumable = value & 0x0F;
+        WideInt bonus = (value >> 4) & (used - 1);
+        cost += consumable & step;
+        points = wide_select(step & (bonus >= BONUS_ADD_1) & (bonus <= BONUS_ADD_5), points + bonus, points);
+        points = wide_select(step & (bonus == BONUS_MULTIPLY_2), points * 2, points);
+        points = wide_select(step & (bonus == BONUS_MULTIPLY_3), points * 3, points);
+
+        teleport |= step & ((target_kind & KIND_TELEPORT) != 0);
+        touched_bawana |= step & ((target_kind & KIND_BAWANA) != 0);
+        path[s] = target;
+        position = wide_select(step, target, position);
+        walking = step & ~teleport;
+    }
+
+    WideInt blocked = blocked_reason != 0;
+    WideInt clear = in_maze & ~blocked;
+    fast &= ~teleport & ~(touched_bawana & clear);
+    cost = wide_select(blocked, zero + 2, cost & clear);
+    WideInt final_cell = wide_select(clear, position, wide_select(entering, entry, cell));
+    direction = wide_select(entering & at_a_start, zero + DIR_NORTH, direction);
+    movement_points = wide_select(clear, points, movement_points) - (cost & in_maze);
+    WideInt steps_taken = steps & clear;
+
+    // Effect countdown; running out of MP sends the player to the Bawana
+    WideInt counting = in_maze & ((effect == EFFECT_DISORIENTED) | (effect == EFFECT_TRIGGERED) |
+                                  (effect == EFFECT_RANDOM_MP));
+    turns_left += counting;
+    effect = wide_select(counting & (turns_left == 0), zero + EFFECT_NONE, effect);
+    fast &= ~(in_maze & (movement_points <= 0));
+
+    // Capture the lowest-numbered other player on the final cell
+    WideInt captured = zero - 1;
+    for (int other = 0; other < batch->num_players; other++) {
+        WideInt other_cell = wide_load(&batch->cell[other * WIDE_LANES]);
+        WideInt other_in_game = wide_load(&batch->in_game[other * WIDE_LANES]);
+        WideInt hit = in_maze & (player != other) & (other_in_game != 0) & (other_cell == final_cell) & (captured < 0);
+        captured = wide_select(hit, zero + other, captured);
+    }
+
+    WideInt won = in_maze & (final_cell == batch->flag_cell);
+    roll_count -= in_maze & ~won;
+
+    // Commit
+    int fast_lanes = wide_bits(fast);
+    for (int lane = 0; lane < WIDE_LANES; lane++) {
+        if (!(running >> lane & 1)) continue;
+        TurnResult *result = &results[lane];
+        if (!(fast_lanes >> lane & 1)) {
+            play_scalar_turn(batch, lane, result);
+            continue;
+        }
+        GameState *game = lane_game(batch, lane);
+        int player_id = player[lane];
+        int player_slot = slot[lane];
+
+        GameRng *rng = &game->rng;
+        for (int k = 0; k < draws_used[lane]; k++) {
+            rng->state[rng->index] = raw[k][lane];
+            rng->index = (rng->index + 1) % GAME_RNG_DEGREE;
+        }
+
+        batch->cell[player_slot] = final_cell[lane];
+        batch->direction[player_slot] = direction[lane];
+        batch->movement_points[player_slot] = movement_points[lane];
+        batch->roll_count[player_slot] = roll_count[lane];
+        batch->bawana_effect[player_slot] = effect[lane];
+        batch->bawana_turns_left[player_slot] = turns_left[lane];
+        if (entering[lane]) {
+            batch->in_game[player_slot] = 1;
+            game->players[player_id].just_entered = 1;
+        }
+
+        if (clear[lane]) {
+            for (int s = 0; s < steps[lane]; s++) {
+                int pos[3];
+                cell_position(path[s][lane], pos);
+                if (maze_bonus_type(&game->maze, pos[0], pos[1], pos[2]) != BONUS_NONE) {
+                    maze_use_bonus(&game->maze, pos[0], pos[1], pos[2]); // One-time bonus
+                }
+                STATS_VISIT(pos[0], pos[1], pos[2]);
+            }
+        } else if (blocked[lane]) {
+            STATS_BLOCKED(blocked_reason[lane]);
+            METRICS_BLOCKED(blocked_reason[lane]);
+        }
+
+        if (captured[lane] >= 0) {
+            int captured_slot = captured[lane] * WIDE_LANES + lane;
+            batch->in_game[captured_slot] = 0;
+            batch->cell[captured_slot] = CELL_A_START;
+            batch->direction[captured_slot] = DIR_NORTH;
+            game->players[captured[lane]].captured = 1;
+            STATS_CAPTURE(player_id);
+            METRICS_CAPTURE();
+        }
+
+        memset(result, 0, sizeof(*result));
+        result->player_id = player_id;
+        result->round_number = round[lane];
+        result->direction_roll = direction_roll[lane];
+        result->movement_roll = movement_roll[lane];
+        cell_position(cell[lane], result->start_pos);
+        cell_position(final_cell[lane], result->end_pos);
+        result->in_game = batch->in_game[player_slot];
+        result->direction = direction[lane];
+        result->movement_points = movement_points[lane];
+        result->steps_taken = steps_taken[lane];
+        result->movement_cost = cost[lane];
+        result->blocked_reason = blocked_reason[lane];
+        result->captured_player = captured[lane];
+        result->bawana_effect = effect[lane];
+        result->won = won[lane] != 0;
+
+        if (result->won) {
+            game->winner = player_id;
+            batch->running &= ~(1 << lane);
+        } else if (++game->next_player == game->num_players) {
+            game->next_player = 0;
+            game->round_number++;
+        }
+        batch->fast_turns++;
+    }
+    return running;
+}
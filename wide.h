@@ -0,0 +1,54 @@
+// wide.h - Lockstep engine that advances a batch of games with vector kernels
+// A batch holds WIDE_LANES games, one per vector lane. Each step plays the next
+// turn of every running game: the hot player fields are kept as a structure of
+// arrays across lanes, dice are peeked from every game's generator at once, and
+// a straight move is walked through a precomputed neighbour table with gathers.
+// A lane whose turn needs anything the kernels do not model (stairs, poles, the
+// Bawana, food poisoning, running out of MP, a stair re-roll round) plays that
+// turn through play_game_turn() instead. Either way every game plays exactly the
+// turns it plays on the scalar engine for the same seed.
+//
+// Lanes are 16 wide when built with AVX-512, 8 with AVX2 and 4 otherwise. Gathers
+// use AVX2 or AVX-512 instructions when the compiler targets them (-mavx2,
+// -march=native) and plain loads when not.
+// The wide engine never prints; run it with game_print_enabled = 0.
+
+#ifndef WIDE_H
+#define WIDE_H
+
+#include "game.h"
+
+#if defined(__AVX512F__)
+#define WIDE_LANES 16
+#elif defined(__AVX2__)
+#define WIDE_LANES 8
+#else
+#define WIDE_LANES 4
+#endif
+
+// Captures are checked against every other player, so batches are for small games
+#define WIDE_MAX_PLAYERS 16
+
+typedef struct WideBatch WideBatch;
+
+// Returns NULL if out of memory or num_players is above WIDE_MAX_PLAYERS
+WideBatch* wide_batch_create(const GameConfig *config, int num_players);
+void wide_batch_destroy(WideBatch *batch);
+
+// Start a new game in `lane` (0 .. WIDE_LANES - 1), replacing whatever ran there
+void wide_batch_start(WideBatch *batch, int lane, unsigned int seed);
+// Leave `lane` idle until a game is started in it again
+void wide_batch_stop(WideBatch *batch, int lane);
+
+// Play one turn in every running lane, filling results[lane] for each.
+// A lane stops running once its game is won. Returns a bit mask of the lanes
+// that played a turn (0 once no lane is running).
+int wide_batch_step(WideBatch *batch, TurnResult results[WIDE_LANES]);
+
+// The game in `lane`, with its players brought up to date from the batch
+GameState* wide_batch_game(WideBatch *batch, int lane);
+
+// Turns played by the vector kernels and by the scalar engine
+void wide_batch_counts(const WideBatch *batch, long *fast_turns, long *scalar_turns);
+
+#endif // WIDE_H